@@ -0,0 +1,193 @@
+#include "Generators.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace scatha;
+using namespace bench;
+
+/// Generates \p numFunctions functions with loops and branches that call each
+/// other in a chain
+static std::string generateFunctions(size_t numFunctions) {
+    std::string result;
+    for (size_t i = 0; i < numFunctions; ++i) {
+        auto n = std::to_string(i);
+        result += "public fn f" + n + "(x: int, y: int) -> int {\n";
+        result += "    var sum = 0;\n";
+        result += "    for j = 0; j < x; ++j {\n";
+        result += "        if j % 3 == 0 { sum += j * y; }\n";
+        result += "        else { sum -= (j << 2) & 0xFF; }\n";
+        result += "    }\n";
+        if (i == 0) {
+            result += "    return sum;\n";
+        }
+        else {
+            auto prev = std::to_string(i - 1);
+            result += "    return sum + f" + prev + "(x / 2, y + 1);\n";
+        }
+        result += "}\n";
+    }
+    result += "public fn main() -> int {\n";
+    result += "    return f" + std::to_string(numFunctions - 1) + "(10, 3);\n";
+    result += "}\n";
+    return result;
+}
+
+/// Nesting depth of the expressions generated by `generateNesting()`
+static constexpr size_t ExpressionDepth = 256;
+
+/// Generates \p numFunctions functions that each return an expression of
+/// depth `ExpressionDepth`. The operands alternate between the parameters so
+/// the expressions cannot be folded
+static std::string generateNesting(size_t numFunctions) {
+    static constexpr std::array<char const*, 6> ops = { " + ", " * ", " - ",
+                                                        " ^ ", " & ", " | " };
+    std::string result;
+    for (size_t i = 0; i < numFunctions; ++i) {
+        result += "public fn g" + std::to_string(i) +
+                  "(x: int, y: int) -> int {\n";
+        result += "    return ";
+        for (size_t d = 0; d < ExpressionDepth; ++d) {
+            result += "(";
+            result += d % 2 == 0 ? "x" : "y";
+            result += ops[(d + i) % ops.size()];
+        }
+        result += std::to_string(i);
+        result.append(ExpressionDepth, ')');
+        result += ";\n}\n";
+    }
+    result += "public fn main() -> int {\n";
+    result += "    return g0(1, 2);\n";
+    result += "}\n";
+    return result;
+}
+
+/// Number of members of the structs generated by `generateStructs()`
+static constexpr size_t NumStructMembers = 256;
+
+/// Generates \p numStructs structs with `NumStructMembers` members of mixed
+/// types and functions that read, write and copy them
+static std::string generateStructs(size_t numStructs) {
+    static constexpr std::array<char const*, 4> types = { "int", "int",
+                                                          "double", "bool" };
+    std::string result;
+    for (size_t i = 0; i < numStructs; ++i) {
+        auto n = std::to_string(i);
+        result += "struct S" + n + " {\n";
+        for (size_t m = 0; m < NumStructMembers; ++m) {
+            result += "    var m" + std::to_string(m) + ": " +
+                      types[m % types.size()] + ";\n";
+        }
+        result += "}\n";
+        result += "public fn sum" + n + "(s: &S" + n + ") -> int {\n";
+        result += "    var r = 0;\n";
+        result += "    var d = 0.0;\n";
+        for (size_t m = 0; m < NumStructMembers; ++m) {
+            auto member = "s.m" + std::to_string(m);
+            switch (m % types.size()) {
+            case 2:
+                result += "    d += " + member + ";\n";
+                break;
+            case 3:
+                result += "    if " + member + " { r += 1; }\n";
+                break;
+            default:
+                result += "    r += " + member + ";\n";
+                break;
+            }
+        }
+        result += "    return d > 0.0 ? r : -r;\n";
+        result += "}\n";
+        result += "public fn update" + n + "(s: &mut S" + n + ") {\n";
+        for (size_t m = 0; m < NumStructMembers; m += types.size()) {
+            result += "    s.m" + std::to_string(m) + " += " +
+                      std::to_string(m) + ";\n";
+        }
+        result += "}\n";
+        result += "public fn make" + n + "() -> S" + n + " {\n";
+        result += "    var s: S" + n + ";\n";
+        result += "    update" + n + "(s);\n";
+        result += "    var t = s;\n";
+        result += "    update" + n + "(t);\n";
+        result += "    return t;\n";
+        result += "}\n";
+    }
+    result += "public fn main() -> int {\n";
+    result += "    var s = make0();\n";
+    result += "    return sum0(s);\n";
+    result += "}\n";
+    return result;
+}
+
+/// Number of functions generated by `generateStraightLine()`
+static constexpr size_t NumStraightLineFunctions = 8;
+
+/// Generates functions with a single basic block of \p numStatements
+/// statements. Each value is used by the following statements, so many values
+/// are live at the same time
+static std::string generateStraightLine(size_t numStatements) {
+    static constexpr std::array<char const*, 5> ops = { " + ", " * ", " ^ ",
+                                                        " - ", " | " };
+    std::string result;
+    for (size_t k = 0; k < NumStraightLineFunctions; ++k) {
+        result += "public fn line" + std::to_string(k) +
+                  "(a: int, b: int) -> int {\n";
+        result += "    let v0 = a;\n";
+        result += "    let v1 = b;\n";
+        for (size_t i = 2; i < numStatements; ++i) {
+            size_t window = std::min<size_t>(i - 1, 16);
+            size_t other = i - 2 - (i * 7 + k) % window;
+            result += "    let v" + std::to_string(i) + " = v" +
+                      std::to_string(i - 1) + ops[(i + k) % ops.size()] + "v" +
+                      std::to_string(other) + ";\n";
+        }
+        result += "    return v" + std::to_string(numStatements - 1) + ";\n";
+        result += "}\n";
+    }
+    result += "public fn main() -> int {\n";
+    result += "    return line0(1, 2);\n";
+    result += "}\n";
+    return result;
+}
+
+/// Generates \p numOverloads structs and two overloads of the same function
+/// per struct, and a function that calls every overload
+static std::string generateOverloads(size_t numOverloads) {
+    std::string result;
+    for (size_t i = 0; i < numOverloads; ++i) {
+        auto n = std::to_string(i);
+        result += "struct T" + n + " { var value: int; }\n";
+        result += "public fn over(t: &T" + n + ") -> int {\n";
+        result += "    return t.value + " + n + ";\n";
+        result += "}\n";
+        result += "public fn over(t: &T" + n + ", n: int) -> int {\n";
+        result += "    return t.value * n;\n";
+        result += "}\n";
+    }
+    result += "public fn main() -> int {\n";
+    result += "    var sum = 0;\n";
+    for (size_t i = 0; i < numOverloads; ++i) {
+        auto n = std::to_string(i);
+        result += "    var t" + n + ": T" + n + ";\n";
+        result += "    sum += over(t" + n + ");\n";
+        result += "    sum += over(t" + n + ", " + n + ");\n";
+    }
+    result += "    return sum;\n";
+    result += "}\n";
+    return result;
+}
+
+static constexpr Workload Workloads[] = {
+    { "functions", "Thousands of small functions with loops and calls", 4000,
+      generateFunctions },
+    { "nesting", "Deeply nested arithmetic expressions", 100,
+      generateNesting },
+    { "structs", "Large structs with mixed member types", 40,
+      generateStructs },
+    { "straightline", "Long basic blocks with many live values", 4000,
+      generateStraightLine },
+    { "overloads", "Many overloads of one function name", 300,
+      generateOverloads },
+};
+
+std::span<Workload const> bench::workloads() { return Workloads; }
@@ -0,0 +1,33 @@
+#ifndef SCATHA_COMPILEBENCHMARK_GENERATORS_H_
+#define SCATHA_COMPILEBENCHMARK_GENERATORS_H_
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace scatha::bench {
+
+/// A synthetic program that stresses one aspect of the compiler
+struct Workload {
+    /// Name used to select the workload and to identify it in the output
+    std::string_view name;
+
+    /// Short description of what the workload stresses
+    std::string_view description;
+
+    /// Size parameter of the workload at scale 1. What it counts depends on
+    /// the workload, e.g. the number of functions or statements
+    size_t defaultSize;
+
+    /// Generates the source text of the workload with size parameter \p size
+    std::string (*generate)(size_t size);
+};
+
+/// \Returns all workloads. The generated programs are deterministic, so
+/// results are comparable across commits
+std::span<Workload const> workloads();
+
+} // namespace scatha::bench
+
+#endif // SCATHA_COMPILEBENCHMARK_GENERATORS_H_
@@ -0,0 +1,450 @@
+/// Compile time benchmark. Generates large synthetic programs and measures
+/// every phase of the compiler separately.
+///
+///     scatha-compile-benchmark [--json] [--out <file>] [--repeat <n>]
+///                              [--scale <factor>] [--label <text>]
+///                              [--regalloc <auto|graph|linear-scan>]
+///                              [--list] [workloads...]
+///
+/// Each workload is compiled `--repeat` times and the minimum and median time
+/// of each phase is reported, together with the peak of
+/// `AllocationStats::liveBytes()` during each phase. `--scale` multiplies the size of all workloads.
+/// With `--json` the results are written as JSON, which together with
+/// `--label` (e.g. the commit hash) can be collected to track regressions
+/// across commits. `--regalloc` selects the register allocator, so the
+/// codegen time and the register window sizes of both allocators can be
+/// compared on the same workloads.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <scatha/Assembly/Assembler.h>
+#include <scatha/Assembly/AssemblyStream.h>
+#include <scatha/CodeGen/CodeGen.h>
+#include <scatha/Common/Allocator.h>
+#include <scatha/Common/SourceFile.h>
+#include <scatha/IR/CFG/Function.h>
+#include <scatha/IR/Context.h>
+#include <scatha/IR/Module.h>
+#include <scatha/IRGen/IRGen.h>
+#include <scatha/Issue/IssueHandler.h>
+#include <scatha/Opt/Passes.h>
+#include <scatha/Parser/Lexer.h>
+#include <scatha/Parser/Parser.h>
+#include <scatha/Sema/Analyze.h>
+#include <scatha/Sema/SymbolTable.h>
+
+#include "Generators.h"
+
+using namespace scatha;
+using namespace bench;
+using nlohmann::json;
+
+namespace {
+
+/// The measured phases in pipeline order. `parse` includes lexing because the
+/// parser lexes its input itself, `lex` measures the lexer alone
+enum class Phase {
+    Lex,
+    Parse,
+    Sema,
+    IRGen,
+    Optimize,
+    CodeGen,
+    Assemble,
+    LAST = Assemble
+};
+
+constexpr size_t NumPhases = static_cast<size_t>(Phase::LAST) + 1;
+
+constexpr std::array<std::string_view, NumPhases> PhaseNames = {
+    "lex", "parse", "sema", "irgen", "optimize", "codegen", "assemble"
+};
+
+struct Options {
+    std::vector<std::string> workloads;
+    std::filesystem::path outFile;
+    std::string label;
+    std::string registerAllocator = "auto";
+    size_t repeat = 5;
+    double scale = 1.0;
+    bool json = false;
+    bool list = false;
+};
+
+/// Measurements of one workload
+struct Result {
+    Workload const* workload = nullptr;
+    size_t size = 0;
+    size_t sourceBytes = 0;
+    size_t numTokens = 0;
+    size_t instsBeforeOpt = 0;
+    size_t instsAfterOpt = 0;
+    size_t binaryBytes = 0;
+    size_t totalRegisters = 0;
+    size_t maxRegisters = 0;
+
+    /// Milliseconds per phase and repetition
+    std::array<std::vector<double>, NumPhases> times;
+
+    /// Largest peak of `AllocationStats::liveBytes()` per phase over all
+    /// repetitions
+    std::array<size_t, NumPhases> peakBytes{};
+};
+
+/// Writes the time since construction to `ms` on destruction
+struct PhaseTimer {
+    using Clock = std::chrono::steady_clock;
+
+    explicit PhaseTimer(double& ms): ms(ms) {}
+    PhaseTimer(PhaseTimer const&) = delete;
+    ~PhaseTimer() {
+        ms = std::chrono::duration<double, std::milli>(Clock::now() - begin)
+                 .count();
+    }
+
+    double& ms;
+    Clock::time_point begin = Clock::now();
+};
+
+/// Writes the peak of `AllocationStats::liveBytes()` since construction to
+/// `bytes` on destruction, if it exceeds the current value
+struct PeakTracker {
+    explicit PeakTracker(size_t& bytes): bytes(bytes) {
+        AllocationStats::resetPeakBytes();
+    }
+    PeakTracker(PeakTracker const&) = delete;
+    ~PeakTracker() { bytes = std::max(bytes, AllocationStats::peakBytes()); }
+
+    size_t& bytes;
+};
+
+} // namespace
+
+/// Invokes \p fn and writes the time it took to \p ms
+template <typename F>
+static decltype(auto) timed(double& ms, F&& fn) {
+    PhaseTimer timer(ms);
+    return std::invoke(fn);
+}
+
+
+static size_t countInstructions(ir::Module const& mod) {
+    size_t count = 0;
+    for (auto& function: mod) {
+        for ([[maybe_unused]] auto& inst: function.instructions()) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// Throws if \p issues contains errors
+static void checkIssues(IssueHandler const& issues,
+                        std::span<SourceFile const> sources,
+                        std::string_view phase) {
+    if (issues.haveErrors()) {
+        issues.print(sources, std::cerr);
+        throw std::runtime_error(std::string(phase) + " failed");
+    }
+}
+
+static std::optional<cg::RegisterAllocator> parseRegisterAllocator(
+    std::string_view name) {
+    if (name == "auto") {
+        return std::nullopt;
+    }
+    if (name == "graph") {
+        return cg::RegisterAllocator::Graph;
+    }
+    if (name == "linear-scan") {
+        return cg::RegisterAllocator::LinearScan;
+    }
+    throw std::runtime_error("Unknown register allocator " +
+                             std::string(name));
+}
+
+/// Compiles \p sources once and appends the time of each phase to \p result
+static void compileOnce(std::span<SourceFile const> sources,
+                        Options const& options, Result& result) {
+    std::array<double, NumPhases> ms{};
+    /// Times the phase \p p and tracks its peak memory
+    auto phase = [&]<typename F>(Phase p, F&& fn) -> decltype(auto) {
+        size_t index = static_cast<size_t>(p);
+        PeakTracker tracker(result.peakBytes[index]);
+        return timed(ms[index], std::forward<F>(fn));
+    };
+    IssueHandler issues;
+    result.numTokens = phase(Phase::Lex, [&] {
+        size_t numTokens = 0;
+        for (auto& source: sources) {
+            numTokens += parser::lex(source.text(), issues).size();
+        }
+        return numTokens;
+    });
+    checkIssues(issues, sources, "Lexing");
+    auto ast =
+        phase(Phase::Parse, [&] { return parser::parse(sources, issues); });
+    checkIssues(issues, sources, "Parsing");
+    if (!ast) {
+        throw std::runtime_error("Parsing failed");
+    }
+    sema::SymbolTable sym;
+    auto analysisResult = phase(Phase::Sema, [&] {
+        return sema::analyze(*ast, sym, issues);
+    });
+    checkIssues(issues, sources, "Semantic analysis");
+    ir::Context ctx;
+    ir::Module mod;
+    phase(Phase::IRGen, [&] {
+        irgen::generateIR(ctx, mod, *ast, sym, analysisResult,
+                          { .sourceFiles = sources });
+    });
+    result.instsBeforeOpt = countInstructions(mod);
+    phase(Phase::Optimize, [&] { opt::optimize(ctx, mod); });
+    result.instsAfterOpt = countInstructions(mod);
+    cg::NullLogger logger;
+    cg::CodegenStats stats;
+    cg::CodegenOptions codegenOptions{
+        .registerAllocator = parseRegisterAllocator(options.registerAllocator),
+        .stats = &stats
+    };
+    auto asmStream = phase(Phase::CodeGen, [&] {
+        return cg::codegen(mod, logger, codegenOptions);
+    });
+    result.totalRegisters = stats.totalRegisters;
+    result.maxRegisters = stats.maxRegisters;
+    auto asmResult =
+        phase(Phase::Assemble, [&] { return Asm::assemble(asmStream); });
+    result.binaryBytes = asmResult.program.size();
+    for (size_t i = 0; i < NumPhases; ++i) {
+        result.times[i].push_back(ms[i]);
+    }
+}
+
+static Result runWorkload(Workload const& workload, Options const& options) {
+    Result result;
+    result.workload = &workload;
+    result.size = std::max<size_t>(
+        1, static_cast<size_t>(static_cast<double>(workload.defaultSize) *
+                               options.scale));
+    std::vector<SourceFile> sources;
+    sources.push_back(SourceFile::make(workload.generate(result.size)));
+    result.sourceBytes = sources.front().text().size();
+    for (size_t i = 0; i < options.repeat; ++i) {
+        compileOnce(sources, options, result);
+    }
+    return result;
+}
+
+static double minimum(std::vector<double> const& values) {
+    return *std::min_element(values.begin(), values.end());
+}
+
+static double median(std::vector<double> values) {
+    auto mid = values.begin() + static_cast<ptrdiff_t>(values.size() / 2);
+    std::nth_element(values.begin(), mid, values.end());
+    return *mid;
+}
+
+/// \Returns the total time of each repetition
+static std::vector<double> totalTimes(Result const& result) {
+    std::vector<double> totals(result.times.front().size());
+    for (auto& phase: result.times) {
+        for (size_t i = 0; i < totals.size(); ++i) {
+            totals[i] += phase[i];
+        }
+    }
+    return totals;
+}
+
+static json toJSON(std::vector<double> const& times) {
+    return { { "min_ms", minimum(times) }, { "median_ms", median(times) } };
+}
+
+static json toJSON(std::span<Result const> results, Options const& options) {
+    json workloads = json::array();
+    for (auto& result: results) {
+        json phases = json::object();
+        for (size_t i = 0; i < NumPhases; ++i) {
+            auto phase = toJSON(result.times[i]);
+            phase["peak_bytes"] = result.peakBytes[i];
+            phases[std::string(PhaseNames[i])] = std::move(phase);
+        }
+        workloads.push_back({
+            { "name", result.workload->name },
+            { "size", result.size },
+            { "sourceBytes", result.sourceBytes },
+            { "tokens", result.numTokens },
+            { "irInstsBeforeOpt", result.instsBeforeOpt },
+            { "irInstsAfterOpt", result.instsAfterOpt },
+            { "binaryBytes", result.binaryBytes },
+            { "totalRegisters", result.totalRegisters },
+            { "maxRegisters", result.maxRegisters },
+            { "phases", std::move(phases) },
+            { "total", toJSON(totalTimes(result)) },
+        });
+    }
+    return { { "label", options.label },
+             { "registerAllocator", options.registerAllocator },
+             { "repeat", options.repeat },
+             { "scale", options.scale },
+             { "workloads", std::move(workloads) } };
+}
+
+static void printTable(std::span<Result const> results, std::ostream& str) {
+    str << std::left << std::setw(14) << "Workload" << std::right;
+    for (auto name: PhaseNames) {
+        str << std::setw(11) << name;
+    }
+    str << std::setw(11) << "total" << std::setw(11) << "peak MB"
+        << std::setw(11) << "max regs" << "   (min ms)\n";
+    str << std::fixed << std::setprecision(2);
+    for (auto& result: results) {
+        str << std::left << std::setw(14) << result.workload->name
+            << std::right;
+        for (auto& times: result.times) {
+            str << std::setw(11) << minimum(times);
+        }
+        size_t peakBytes = std::ranges::max(result.peakBytes);
+        str << std::setw(11) << minimum(totalTimes(result)) << std::setw(11)
+            << static_cast<double>(peakBytes) / (1 << 20) << std::setw(11)
+            << result.maxRegisters << "\n";
+    }
+}
+
+static void printUsage(std::ostream& str) {
+    str << "Usage: scatha-compile-benchmark [--json] [--out <file>] "
+           "[--repeat <n>] [--scale <factor>] [--label <text>] "
+           "[--regalloc <auto|graph|linear-scan>] [--list] [workloads...]\n";
+}
+
+template <typename T>
+static T parseNumber(std::string_view text) {
+    T value{};
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        throw std::runtime_error("Invalid number: " + std::string(text));
+    }
+    return value;
+}
+
+static Options parseOptions(int argc, char const* const* argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> std::string_view {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " +
+                                         std::string(arg));
+            }
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            options.json = true;
+        }
+        else if (arg == "--list") {
+            options.list = true;
+        }
+        else if (arg == "--out") {
+            options.outFile = value();
+        }
+        else if (arg == "--label") {
+            options.label = value();
+        }
+        else if (arg == "--regalloc") {
+            options.registerAllocator = value();
+            parseRegisterAllocator(options.registerAllocator);
+        }
+        else if (arg == "--repeat") {
+            options.repeat = std::max<size_t>(1, parseNumber<size_t>(value()));
+        }
+        else if (arg == "--scale") {
+            options.scale = parseNumber<double>(value());
+        }
+        else if (arg.starts_with("--")) {
+            throw std::runtime_error("Unknown option " + std::string(arg));
+        }
+        else {
+            options.workloads.push_back(std::string(arg));
+        }
+    }
+    return options;
+}
+
+static std::vector<Workload const*> selectWorkloads(Options const& options) {
+    std::vector<Workload const*> result;
+    for (auto& workload: workloads()) {
+        if (options.workloads.empty() ||
+            std::find(options.workloads.begin(), options.workloads.end(),
+                      workload.name) != options.workloads.end())
+        {
+            result.push_back(&workload);
+        }
+    }
+    if (result.size() < options.workloads.size()) {
+        throw std::runtime_error("Unknown workload");
+    }
+    return result;
+}
+
+int main(int argc, char const* const* argv) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    }
+    catch (std::exception const& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        printUsage(std::cerr);
+        return 1;
+    }
+    try {
+        if (options.list) {
+            for (auto& workload: workloads()) {
+                std::cout << std::left << std::setw(14) << workload.name
+                          << workload.description << "\n";
+            }
+            return 0;
+        }
+        std::vector<Result> results;
+        for (auto* workload: selectWorkloads(options)) {
+            std::cerr << "Running " << workload->name << "..." << std::endl;
+            results.push_back(runWorkload(*workload, options));
+        }
+        std::ofstream file;
+        if (!options.outFile.empty()) {
+            file.open(options.outFile);
+            if (!file) {
+                throw std::runtime_error("Failed to open " +
+                                         options.outFile.string());
+            }
+        }
+        std::ostream& out = file.is_open() ? file : std::cout;
+        if (options.json) {
+            out << std::setw(2) << toJSON(results, options) << std::endl;
+        }
+        else {
+            printTable(results, out);
+        }
+        return 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
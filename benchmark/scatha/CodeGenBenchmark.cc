@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch_test_macros.hpp>
+#include <scatha/Assembly/AssemblyStream.h>
+#include <scatha/CodeGen/CodeGen.h>
+#include <scatha/IR/Context.h>
+#include <scatha/IR/IRParser.h>
+#include <scatha/IR/Module.h>
+
+using namespace scatha;
+
+/// Generates an IR module with \p numFunctions functions. Each function
+/// contains a loop with enough live values to keep the register allocator
+/// busy and calls its predecessor
+static std::string generateModule(size_t numFunctions) {
+    std::string result;
+    for (size_t i = 0; i < numFunctions; ++i) {
+        auto n = std::to_string(i);
+        result += "func i64 @f" + n + "(i64 %n, i64 %x) {\n";
+        result += "  %entry:\n";
+        result += "    goto label %header\n";
+        result += "  %header:\n";
+        result += "    %i = phi i64 [label %entry : 0], [label %body : %i.1]\n";
+        result += "    %s = phi i64 [label %entry : %x], [label %body : %s.1]\n";
+        result += "    %ls = scmp ls i64 %i, i64 %n\n";
+        result += "    branch i1 %ls, label %body, label %end\n";
+        result += "  %body:\n";
+        result += "    %a = mul i64 %i, i64 " + n + "\n";
+        result += "    %b = add i64 %a, i64 %s\n";
+        result += "    %c = xor i64 %b, i64 %x\n";
+        result += "    %d = lshr i64 %c, i64 3\n";
+        result += "    %e = sub i64 %d, i64 %a\n";
+        result += "    %s.1 = add i64 %e, i64 %b\n";
+        result += "    %i.1 = add i64 %i, i64 1\n";
+        result += "    goto label %header\n";
+        result += "  %end:\n";
+        if (i == 0) {
+            result += "    return i64 %s\n";
+        }
+        else {
+            auto prev = std::to_string(i - 1);
+            result += "    %r = call i64 @f" + prev + ", i64 %n, i64 %s\n";
+            result += "    return i64 %r\n";
+        }
+        result += "}\n";
+    }
+    return result;
+}
+
+/// Generates an IR module with a single function of \p numValues additions in
+/// one basic block. Every value is added to the value \p window definitions
+/// before it, so about \p window values are live at any point
+static std::string generateLargeFunction(size_t numValues, size_t window) {
+    std::string result = "func i64 @large(i64 %x) {\n  %entry:\n";
+    auto value = [](size_t index) { return "%v" + std::to_string(index); };
+    for (size_t i = 0; i < numValues; ++i) {
+        auto lhs = i == 0 ? std::string("%x") : value(i - 1);
+        auto rhs = i < window ? std::string("%x") : value(i - window);
+        result += "    " + value(i) + " = add i64 " + lhs + ", i64 " + rhs +
+                  "\n";
+    }
+    result += "    return i64 " + value(numValues - 1) + "\n}\n";
+    return result;
+}
+
+/// \Returns the shortest time in seconds of \p count invocations of \p f
+static double bestOf(int count, auto f) {
+    using Clock = std::chrono::steady_clock;
+    double bestSeconds = std::numeric_limits<double>::max();
+    for (int i = 0; i < count; ++i) {
+        auto begin = Clock::now();
+        f();
+        auto end = Clock::now();
+        bestSeconds = std::min(bestSeconds,
+                               std::chrono::duration<double>(end - begin)
+                                   .count());
+    }
+    return bestSeconds;
+}
+
+TEST_CASE("Codegen time") {
+    size_t const numFunctions = 4000;
+    auto [ctx, mod] = ir::parse(generateModule(numFunctions)).value();
+    double bestSeconds = bestOf(5, [&] { auto assembly = cg::codegen(mod); });
+    std::cout << "Generated code for " << numFunctions << " functions in "
+              << bestSeconds * 1000 << " ms\n";
+}
+
+/// Prints codegen time and register window sizes of the module \p text for
+/// both register allocators
+static void compareAllocators(std::string_view name, std::string const& text) {
+    auto [ctx, mod] = ir::parse(text).value();
+    for (auto allocator:
+         { cg::RegisterAllocator::Graph, cg::RegisterAllocator::LinearScan })
+    {
+        cg::NullLogger logger;
+        cg::CodegenStats stats;
+        cg::CodegenOptions options{ .registerAllocator = allocator,
+                                    .stats = &stats };
+        double bestSeconds = bestOf(3, [&] {
+            auto assembly = cg::codegen(mod, logger, options);
+        });
+        bool graph = allocator == cg::RegisterAllocator::Graph;
+        std::cout << name << ", "
+                  << (graph ? "graph coloring" : "linear scan") << ": "
+                  << bestSeconds * 1000 << " ms, " << stats.totalRegisters
+                  << " registers in total, " << stats.maxRegisters
+                  << " in the largest window\n";
+    }
+}
+
+TEST_CASE("Register allocator comparison") {
+    compareAllocators("4000 small functions", generateModule(4000));
+    compareAllocators("one function with 20000 values",
+                      generateLargeFunction(20000, 32));
+}
+
+/// Measures both allocators on functions around
+/// `CodegenOptions::linearScanThreshold`, to check where linear scan starts to
+/// pay off
+TEST_CASE("Register allocator threshold") {
+    size_t const sizes[] = { 250, 500, 1000, 2000, 4000, 8000 };
+    for (size_t numValues: sizes) {
+        compareAllocators("one function with " + std::to_string(numValues) +
+                              " values",
+                          generateLargeFunction(numValues, 32));
+    }
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <scatha/IR/BinSerialize.h>
+#include <scatha/IR/Context.h>
+#include <scatha/IR/IRParser.h>
+#include <scatha/IR/Module.h>
+
+using namespace scatha;
+
+/// Generates an IR module with \p numFunctions functions that resembles the
+/// object code of a static library
+static std::string generateModule(size_t numFunctions) {
+    std::string result = "struct @Pair { i64, i64 }\n";
+    for (size_t i = 0; i < numFunctions; ++i) {
+        auto n = std::to_string(i);
+        result += "func i64 @f" + n + "(ptr byval(@Pair) %p, i64 %n) {\n";
+        result += "  %entry:\n";
+        result += "    %pair = load @Pair, ptr %p\n";
+        result += "    %x = extract_value @Pair %pair, 0\n";
+        result += "    %y.addr = getelementptr inbounds @Pair, ptr %p, i64 0, 1\n";
+        result += "    %y = load i64, ptr %y.addr\n";
+        result += "    goto label %header\n";
+        result += "  %header:\n";
+        result += "    %i = phi i64 [label %entry : 0], [label %body : %i.1]\n";
+        result += "    %s = phi i64 [label %entry : %x], [label %body : %s.1]\n";
+        result += "    %ls = scmp ls i64 %i, i64 %n\n";
+        result += "    branch i1 %ls, label %body, label %end\n";
+        result += "  %body:\n";
+        result += "    %a = mul i64 %i, i64 " + n + "\n";
+        result += "    %b = add i64 %a, i64 %y\n";
+        result += "    %s.1 = xor i64 %b, i64 %s\n";
+        result += "    %i.1 = add i64 %i, i64 1\n";
+        result += "    goto label %header\n";
+        result += "  %end:\n";
+        result += "    return i64 %s\n";
+        result += "}\n";
+    }
+    return result;
+}
+
+/// \Returns the best time in milliseconds of five invocations of \p fn
+static double bestOfFive(auto fn) {
+    using Clock = std::chrono::steady_clock;
+    double bestSeconds = std::numeric_limits<double>::max();
+    for (int i = 0; i < 5; ++i) {
+        auto begin = Clock::now();
+        fn();
+        auto end = Clock::now();
+        bestSeconds = std::min(bestSeconds,
+                               std::chrono::duration<double>(end - begin)
+                                   .count());
+    }
+    return bestSeconds * 1000;
+}
+
+TEST_CASE("IR import time") {
+    size_t const numFunctions = 4000;
+    auto text = generateModule(numFunctions);
+    auto [ctx, mod] = ir::parse(text).value();
+    std::stringstream sstr;
+    ir::serializeBinary(mod, sstr);
+    auto binary = std::move(sstr).str();
+    std::vector<unsigned char> data(binary.begin(), binary.end());
+    double textMs = bestOfFive([&] {
+        ir::Context ctx;
+        ir::Module mod;
+        auto issues = ir::parseTo(text, ctx, mod, { .assertInvariants = false });
+        REQUIRE(issues.empty());
+    });
+    double binaryMs = bestOfFive([&] {
+        ir::Context ctx;
+        ir::Module mod;
+        REQUIRE(ir::deserializeBinary(ctx, mod, data,
+                                      { .assertInvariants = false }));
+    });
+    /// Importing lazily and using a single function, like a program that
+    /// calls one function of a large library
+    double lazyMs = bestOfFive([&] {
+        ir::Context ctx;
+        ir::Module mod;
+        auto import = ir::LazyModuleImport::Open(ctx, mod, data);
+        REQUIRE(import);
+        REQUIRE(import->materialize(mod.front()));
+    });
+    std::cout << "Imported " << numFunctions << " functions\n"
+              << "  Text:   " << textMs << " ms, " << text.size() << " bytes\n"
+              << "  Binary: " << binaryMs << " ms, " << data.size()
+              << " bytes\n"
+              << "  Lazy:   " << lazyMs << " ms\n";
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+#include <catch2/benchmark/catch_benchmark_all.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <scatha/Issue/IssueHandler.h>
+#include <scatha/Parser/Lexer.h>
+
+using namespace scatha;
+
+/// Generates approximately \p size bytes of valid source text from a set of
+/// snippets that cover identifiers, keywords, numeric, string and char
+/// literals, operators and comments
+static std::string generateSource(size_t size) {
+    static constexpr std::string_view snippets[] = {
+        "fn fib(n: int) -> int {\n"
+        "    return n < 2 ? n : fib(n - 1) + fib(n - 2);\n"
+        "}\n",
+        "// Computes the sum of all elements\n"
+        "fn sum(data: &[double]) -> double {\n"
+        "    var result = 0.0;\n"
+        "    for i = 0; i < data.count; ++i {\n"
+        "        result += data[i];\n"
+        "    }\n"
+        "    return result;\n"
+        "}\n",
+        "/* Multi line\n   comment */\n"
+        "struct Vec3 {\n"
+        "    var x: f32; var y: f32; var z: f32;\n"
+        "}\n",
+        "fn greet(name: &str) {\n"
+        "    __builtin_putstr(\"Hello, \\(name)!\\n\");\n"
+        "    let c = '\\t';\n"
+        "}\n",
+        "fn bits(mut value: u64) -> u64 {\n"
+        "    value ^= value >> 33; value *= 0xff51afd7ed558ccd;\n"
+        "    value <<= 2; value |= 0x10; return value & ~0x3;\n"
+        "}\n",
+        "fn cond(a: bool, b: bool) -> bool {\n"
+        "    return a && !b || a != b && 1.5 <= 2.25;\n"
+        "}\n",
+    };
+    std::mt19937_64 rng(0);
+    std::uniform_int_distribution<size_t> dist(0, std::size(snippets) - 1);
+    std::string result;
+    result.reserve(size + 512);
+    while (result.size() < size) {
+        result += snippets[dist(rng)];
+    }
+    return result;
+}
+
+TEST_CASE("Lexer throughput") {
+    size_t const size = 16 << 20;
+    std::string const text = generateSource(size);
+    using Clock = std::chrono::steady_clock;
+    double bestSeconds = std::numeric_limits<double>::max();
+    size_t numTokens = 0;
+    for (int i = 0; i < 5; ++i) {
+        IssueHandler issues;
+        auto begin = Clock::now();
+        auto tokens = parser::lex(text, issues);
+        auto end = Clock::now();
+        REQUIRE(issues.empty());
+        numTokens = tokens.size();
+        bestSeconds = std::min(bestSeconds,
+                               std::chrono::duration<double>(end - begin)
+                                   .count());
+    }
+    double const megabytes = static_cast<double>(text.size()) / (1 << 20);
+    std::cout << "Lexed " << megabytes << " MB (" << numTokens
+              << " tokens) at " << megabytes / bestSeconds << " MB/s\n";
+    BENCHMARK("Lex 16 MB") {
+        IssueHandler issues;
+        return parser::lex(text, issues);
+    };
+}
@@ -0,0 +1,62 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+#include <scatha/Issue/IssueHandler.h>
+#include <scatha/Parser/Parser.h>
+
+using namespace scatha;
+
+/// Generates a source file with \p numFunctions functions that exercise
+/// expressions, statements and declarations
+static std::string generateSource(size_t numFunctions) {
+    std::string result;
+    for (size_t i = 0; i < numFunctions; ++i) {
+        auto n = std::to_string(i);
+        result += "struct S" + n + " { var a: int; var b: [double, 4]; }\n";
+        result += "fn f" + n + "(x: int, y: &mut S" + n + ") -> int {\n";
+        result += "    var sum = 0;\n";
+        result += "    for i = 0; i < x; ++i {\n";
+        result += "        if i % 3 == 0 { sum += i * " + n + "; }\n";
+        result += "        else { sum -= (i << 2) & 0xFF; }\n";
+        result += "    }\n";
+        result += "    y.a = sum > 0 ? sum : -sum;\n";
+        result += "    return f" + n + "(x - 1, y) + y.a;\n";
+        result += "}\n";
+    }
+    return result;
+}
+
+TEST_CASE("Parse and free time") {
+    std::vector<SourceFile> sources;
+    for (int i = 0; i < 8; ++i) {
+        sources.push_back(SourceFile::make(generateSource(5000)));
+    }
+    using Clock = std::chrono::steady_clock;
+    using Seconds = std::chrono::duration<double>;
+    double bestParse = std::numeric_limits<double>::max();
+    double bestFree = std::numeric_limits<double>::max();
+    for (int i = 0; i < 5; ++i) {
+        IssueHandler issues;
+        auto begin = Clock::now();
+        auto ast = parser::parse(sources, issues);
+        auto parsed = Clock::now();
+        REQUIRE(ast);
+        REQUIRE(issues.empty());
+        ast.reset();
+        auto freed = Clock::now();
+        bestParse = std::min(bestParse, Seconds(parsed - begin).count());
+        bestFree = std::min(bestFree, Seconds(freed - parsed).count());
+    }
+    size_t numBytes = 0;
+    for (auto& source: sources) {
+        numBytes += source.text().size();
+    }
+    double const megabytes = static_cast<double>(numBytes) / (1 << 20);
+    std::cout << "Parsed " << megabytes << " MB in " << bestParse * 1000
+              << " ms, freed the AST in " << bestFree * 1000 << " ms\n";
+}
@@ -0,0 +1,356 @@
+/// VM runtime benchmark. Runs every workload at every optimization level
+/// under both dispatch modes of the VM and reports the number of executed
+/// instructions, the wall time and the peak VM heap size.
+///
+///     scatha-vm-benchmark [--json] [--out <file>] [--repeat <n>]
+///                         [--min-sample-ms <ms>] [--label <text>]
+///                         [--examples-dir <dir>] [--list] [workloads...]
+///
+/// Each sample runs the program often enough to take at least
+/// `--min-sample-ms` and reports the time per run. Instruction count and
+/// heap size are measured in a separate stepwise run, so counting does not
+/// affect the timings. With `--json` the results are written as JSON, which
+/// together with `--label` (e.g. the commit hash) can be collected to track
+/// regressions across commits.
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+#include <scatha/Invocation/CompilerInvocation.h>
+#include <svm/Util.h>
+#include <svm/VirtualMachine.h>
+
+#include "Workloads.h"
+
+using namespace scatha;
+using namespace bench;
+using nlohmann::json;
+
+namespace {
+
+/// The dispatch modes of the VM
+enum class Mode { JumpThread, NoJumpThread };
+
+constexpr std::array<Mode, 2> Modes = { Mode::JumpThread, Mode::NoJumpThread };
+
+/// The optimization levels the workloads are compiled with
+constexpr std::array<int, 2> OptLevels = { 0, 1 };
+
+std::string_view toString(Mode mode) {
+    switch (mode) {
+    case Mode::JumpThread:
+        return "execute";
+    case Mode::NoJumpThread:
+        return "executeNoJumpThread";
+    }
+    return {};
+}
+
+struct Options {
+    std::vector<std::string> workloads;
+    std::filesystem::path outFile;
+    std::filesystem::path examplesDir = SCATHA_EXAMPLES_DIR;
+    std::string label;
+    size_t repeat = 5;
+    double minSampleMs = 20;
+    bool json = false;
+    bool list = false;
+};
+
+/// Measurements of one workload at one optimization level in one mode
+struct Result {
+    Workload const* workload = nullptr;
+    int optLevel = 0;
+    Mode mode = Mode::JumpThread;
+    size_t instructions = 0;
+    size_t peakHeapBytes = 0;
+    size_t runsPerSample = 0;
+
+    /// Milliseconds per run of each sample
+    std::vector<double> times;
+};
+
+/// A null stream that swallows the output of the programs
+class NullStream: public std::ostream {
+public:
+    NullStream(): std::ostream(nullptr) {}
+};
+
+} // namespace
+
+static SourceFile loadSource(Workload const& workload,
+                             Options const& options) {
+    if (workload.exampleFile.empty()) {
+        return SourceFile::make(workload.source);
+    }
+    auto path = options.examplesDir / workload.exampleFile;
+    if (!std::filesystem::exists(path)) {
+        throw std::runtime_error("Example file " + path.string() +
+                                 " does not exist");
+    }
+    return SourceFile::load(path);
+}
+
+static std::vector<uint8_t> compile(Workload const& workload, int optLevel,
+                                    Options const& options) {
+    CompilerInvocation invocation(TargetType::Executable, workload.name);
+    invocation.addInput(loadSource(workload, options));
+    invocation.setOptLevel(optLevel);
+    invocation.setLinkerOptions({ .searchHost = true });
+    std::stringstream errors;
+    invocation.setErrorStream(errors);
+    auto target = invocation.run();
+    if (!target) {
+        throw std::runtime_error("Failed to compile " + workload.name + ":\n" +
+                                 errors.str());
+    }
+    auto binary = target->binary();
+    return std::vector<uint8_t>(binary.begin(), binary.end());
+}
+
+static void execute(svm::VirtualMachine& vm, Mode mode,
+                    std::span<uint64_t const> arguments) {
+    switch (mode) {
+    case Mode::JumpThread:
+        vm.execute(arguments);
+        return;
+    case Mode::NoJumpThread:
+        vm.executeNoJumpThread(arguments);
+        return;
+    }
+}
+
+/// Runs the program stepwise and writes the executed instructions and the
+/// peak heap size to \p result
+static void countInstructions(svm::VirtualMachine& vm,
+                              std::span<uint64_t const> arguments,
+                              Result& result) {
+    vm.resetStats();
+    vm.beginExecution(arguments);
+    while (vm.running()) {
+        vm.stepExecution();
+    }
+    vm.endExecution();
+    auto stats = vm.stats();
+    result.instructions = stats.executedInstructions;
+    result.peakHeapBytes = stats.peakHeapBytes;
+}
+
+static Result runWorkload(Workload const& workload, int optLevel, Mode mode,
+                          std::span<uint8_t const> binary,
+                          Options const& options) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    Result result{ .workload = &workload, .optLevel = optLevel, .mode = mode };
+    NullStream nullStream;
+    std::istringstream emptyInput;
+    svm::VirtualMachine vm;
+    vm.setIOStreams(&emptyInput, &nullStream);
+    vm.loadBinary(binary.data());
+    auto arguments = svm::setupArguments(vm, workload.arguments);
+    countInstructions(vm, arguments, result);
+    /// The first run warms up the caches and calibrates the number of runs
+    /// per sample
+    auto begin = Clock::now();
+    execute(vm, mode, arguments);
+    double once = Milliseconds(Clock::now() - begin).count();
+    result.runsPerSample = static_cast<size_t>(
+        std::ceil(options.minSampleMs / std::max(once, 1e-3)));
+    result.runsPerSample = std::max<size_t>(1, result.runsPerSample);
+    for (size_t i = 0; i < options.repeat; ++i) {
+        auto begin = Clock::now();
+        for (size_t j = 0; j < result.runsPerSample; ++j) {
+            execute(vm, mode, arguments);
+        }
+        double total = Milliseconds(Clock::now() - begin).count();
+        result.times.push_back(total /
+                               static_cast<double>(result.runsPerSample));
+    }
+    return result;
+}
+
+static double minimum(std::vector<double> const& values) {
+    return *std::min_element(values.begin(), values.end());
+}
+
+static double median(std::vector<double> values) {
+    auto mid = values.begin() + static_cast<ptrdiff_t>(values.size() / 2);
+    std::nth_element(values.begin(), mid, values.end());
+    return *mid;
+}
+
+static json toJSON(std::span<Result const> results, Options const& options) {
+    json list = json::array();
+    for (auto& result: results) {
+        list.push_back({
+            { "workload", result.workload->name },
+            { "optLevel", result.optLevel },
+            { "mode", toString(result.mode) },
+            { "instructions", result.instructions },
+            { "peakHeapBytes", result.peakHeapBytes },
+            { "runsPerSample", result.runsPerSample },
+            { "min_ms", minimum(result.times) },
+            { "median_ms", median(result.times) },
+        });
+    }
+    return { { "label", options.label },
+             { "repeat", options.repeat },
+             { "results", std::move(list) } };
+}
+
+static void printTable(std::span<Result const> results, std::ostream& str) {
+    str << std::left << std::setw(18) << "Workload" << std::setw(5) << "-O"
+        << std::setw(22) << "Mode" << std::right << std::setw(14)
+        << "Instructions" << std::setw(14) << "Peak heap" << std::setw(12)
+        << "Min (ms)" << std::setw(12) << "Median (ms)" << "\n";
+    str << std::fixed << std::setprecision(3);
+    for (auto& result: results) {
+        str << std::left << std::setw(18) << result.workload->name
+            << std::setw(5) << result.optLevel << std::setw(22)
+            << toString(result.mode) << std::right << std::setw(14)
+            << result.instructions << std::setw(14) << result.peakHeapBytes
+            << std::setw(12) << minimum(result.times) << std::setw(12)
+            << median(result.times) << "\n";
+    }
+}
+
+static void printUsage(std::ostream& str) {
+    str << "Usage: scatha-vm-benchmark [--json] [--out <file>] "
+           "[--repeat <n>] [--min-sample-ms <ms>] [--label <text>] "
+           "[--examples-dir <dir>] [--list] [workloads...]\n";
+}
+
+template <typename T>
+static T parseNumber(std::string_view text) {
+    T value{};
+    auto [ptr, ec] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || ptr != text.data() + text.size()) {
+        throw std::runtime_error("Invalid number: " + std::string(text));
+    }
+    return value;
+}
+
+static Options parseOptions(int argc, char const* const* argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        auto value = [&]() -> std::string_view {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("Missing value for " +
+                                         std::string(arg));
+            }
+            return argv[++i];
+        };
+        if (arg == "--json") {
+            options.json = true;
+        }
+        else if (arg == "--list") {
+            options.list = true;
+        }
+        else if (arg == "--out") {
+            options.outFile = value();
+        }
+        else if (arg == "--label") {
+            options.label = value();
+        }
+        else if (arg == "--examples-dir") {
+            options.examplesDir = value();
+        }
+        else if (arg == "--repeat") {
+            options.repeat = std::max<size_t>(1, parseNumber<size_t>(value()));
+        }
+        else if (arg == "--min-sample-ms") {
+            options.minSampleMs = parseNumber<double>(value());
+        }
+        else if (arg.starts_with("--")) {
+            throw std::runtime_error("Unknown option " + std::string(arg));
+        }
+        else {
+            options.workloads.push_back(std::string(arg));
+        }
+    }
+    return options;
+}
+
+static std::vector<Workload const*> selectWorkloads(Options const& options) {
+    std::vector<Workload const*> result;
+    for (auto& workload: workloads()) {
+        if (options.workloads.empty() ||
+            std::find(options.workloads.begin(), options.workloads.end(),
+                      workload.name) != options.workloads.end())
+        {
+            result.push_back(&workload);
+        }
+    }
+    if (result.size() < options.workloads.size()) {
+        throw std::runtime_error("Unknown workload");
+    }
+    return result;
+}
+
+int main(int argc, char const* const* argv) {
+    Options options;
+    try {
+        options = parseOptions(argc, argv);
+    }
+    catch (std::exception const& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        printUsage(std::cerr);
+        return 1;
+    }
+    try {
+        if (options.list) {
+            for (auto& workload: workloads()) {
+                std::cout << workload.name << "\n";
+            }
+            return 0;
+        }
+        std::vector<Result> results;
+        for (auto* workload: selectWorkloads(options)) {
+            for (int optLevel: OptLevels) {
+                std::cerr << "Running " << workload->name << " -O" << optLevel
+                          << "..." << std::endl;
+                auto binary = compile(*workload, optLevel, options);
+                for (auto mode: Modes) {
+                    results.push_back(runWorkload(*workload, optLevel, mode,
+                                                  binary, options));
+                }
+            }
+        }
+        std::ofstream file;
+        if (!options.outFile.empty()) {
+            file.open(options.outFile);
+            if (!file) {
+                throw std::runtime_error("Failed to open " +
+                                         options.outFile.string());
+            }
+        }
+        std::ostream& out = file.is_open() ? file : std::cout;
+        if (options.json) {
+            out << std::setw(2) << toJSON(results, options) << std::endl;
+        }
+        else {
+            printTable(results, out);
+        }
+        return 0;
+    }
+    catch (std::exception const& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        return 1;
+    }
+}
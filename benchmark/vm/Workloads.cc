@@ -0,0 +1,91 @@
+#include "Workloads.h"
+
+#include <cstdint>
+
+using namespace scatha;
+using namespace bench;
+
+#if defined(__GNUC__)
+#define SC_BENCH_EXPORT __attribute__((visibility("default")))
+#elif defined(_MSC_VER)
+#define SC_BENCH_EXPORT __declspec(dllexport)
+#else
+#error Unsupported compiler
+#endif
+
+extern "C" {
+/// Called by the `ffi-call` workload. The linker finds it in the host
+/// executable
+SC_BENCH_EXPORT int64_t scatha_bench_ffi(int64_t n) { return 3 * n + 1; }
+}
+
+/// Allocates and frees buffers of varying sizes, then builds and destroys
+/// binary trees of unique pointers
+static constexpr char const* AllocatorChurn = R"(
+struct Node {
+    fn new(&mut this, level: int) {
+        if level > 0 {
+            this.left = unique Node(level - 1);
+            this.right = unique Node(level - 1);
+        }
+    }
+
+    var left: *unique mut Node;
+    var right: *unique mut Node;
+}
+
+fn main() -> int {
+    var sum = 0;
+    for i = 0; i < 20000; ++i {
+        let size = 16 + (i % 97) * 24;
+        let buffer = __builtin_alloc(size, 8);
+        sum += buffer.count;
+        __builtin_dealloc(buffer, 8);
+    }
+    for i = 0; i < 50; ++i {
+        let root = unique Node(10);
+    }
+    return sum;
+})";
+
+/// Calls a function of the host executable through the FFI
+static constexpr char const* FFICall = R"(
+extern "C" fn scatha_bench_ffi(n: int) -> int;
+
+fn main() -> int {
+    var sum = 0;
+    for i = 0; i < 100000; ++i {
+        sum += scatha_bench_ffi(i);
+    }
+    return sum;
+})";
+
+/// Calls math builtins in a loop
+static constexpr char const* BuiltinCall = R"(
+fn main() -> int {
+    var sum = 0.0;
+    for i = 0; i < 100000; ++i {
+        let x = double(i);
+        sum += __builtin_sqrt_f64(x) + __builtin_abs_f64(x - 50000.0);
+    }
+    return int(sum);
+})";
+
+std::span<Workload const> bench::workloads() {
+    static std::vector<Workload> const result = {
+        { .name = "mandelbrotset", .exampleFile = "mandelbrotset.sc" },
+        { .name = "primesieve",
+          .exampleFile = "primesieve.sc",
+          .arguments = { "200000" } },
+        { .name = "hashtable", .exampleFile = "hashtable.sc" },
+        { .name = "matrix", .exampleFile = "matrix.sc" },
+        { .name = "binary-tree",
+          .exampleFile = "binary-tree.sc",
+          .arguments = { "12" } },
+        { .name = "vector", .exampleFile = "vector.sc" },
+        { .name = "allocator-churn", .source = AllocatorChurn },
+        { .name = "ffi-call", .source = FFICall },
+        { .name = "builtin-call", .source = BuiltinCall },
+    };
+    return result;
+}
@@ -0,0 +1,32 @@
+#ifndef SCATHA_VMBENCHMARK_WORKLOADS_H_
+#define SCATHA_VMBENCHMARK_WORKLOADS_H_
+
+#include <span>
+#include <string>
+#include <vector>
+
+namespace scatha::bench {
+
+/// A program that is executed by the VM benchmark
+struct Workload {
+    /// Name used to select the workload and to identify it in the output
+    std::string name;
+
+    /// File name of the program in the examples directory. Empty if the
+    /// program is given by `source`
+    std::string exampleFile;
+
+    /// Source text of the program if `exampleFile` is empty
+    std::string source;
+
+    /// Command line arguments passed to `main()`
+    std::vector<std::string> arguments;
+};
+
+/// \Returns all workloads. The example programs come first, followed by
+/// microbenchmarks of allocation, foreign function calls and builtin calls
+std::span<Workload const> workloads();
+
+} // namespace scatha::bench
+
+#endif // SCATHA_VMBENCHMARK_WORKLOADS_H_
@@ -19,6 +19,7 @@ set(scatha_headers
   include/scatha/Common/APFloat.h
   include/scatha/Common/APInt.h
   include/scatha/Common/Allocator.h
+  include/scatha/Common/InternedString.h
   include/scatha/Common/Base.h
   include/scatha/Common/DebugInfo.h
   include/scatha/Common/Dyncast.h
@@ -31,9 +32,12 @@ set(scatha_headers
   include/scatha/Common/Ranges.h
   include/scatha/Common/SourceFile.h
   include/scatha/Common/SourceLocation.h
+  include/scatha/Common/TimeTrace.h
   include/scatha/Common/UniquePtr.h
   include/scatha/Common/Utility.h
 
+  include/scatha/IR/AnalysisManager.h
+  include/scatha/IR/BinSerialize.h
   include/scatha/IR/CFG/BasicBlock.h
   include/scatha/IR/CFG/Constant.h
   include/scatha/IR/CFG/Constants.h
@@ -43,6 +47,7 @@ set(scatha_headers
   include/scatha/IR/CFG/Instruction.h
   include/scatha/IR/CFG/Instructions.h
   include/scatha/IR/CFG/Iterator.h
+  include/scatha/IR/CFG/Use.h
   include/scatha/IR/CFG/User.h
   include/scatha/IR/CFG/Value.h
   include/scatha/IR/CFG.h
@@ -52,6 +57,7 @@ set(scatha_headers
   include/scatha/IR/IRParser.h
   include/scatha/IR/Lists.def.h
   include/scatha/IR/Module.h
+  include/scatha/IR/NodeAllocator.h
   include/scatha/IR/Parser/IRIssue.h
   include/scatha/IR/Parser/IRSourceLocation.h
   include/scatha/IR/Parser/IRToken.h
@@ -65,8 +71,10 @@ set(scatha_headers
 
   include/scatha/IRGen/IRGen.h
 
+  include/scatha/Invocation/CompilationCache.h
   include/scatha/Invocation/CompilerInvocation.h
   include/scatha/Invocation/ExecutableWriter.h
+  include/scatha/Invocation/LibraryCache.h
   include/scatha/Invocation/Target.h
 
   include/scatha/Issue/Issue.h
@@ -150,6 +158,8 @@ set(scatha_sources
     src/scatha/CodeGen/InterferenceGraph.cc
     src/scatha/CodeGen/InterferenceGraph.h
     src/scatha/CodeGen/JumpElision.cc
+    src/scatha/CodeGen/LinearScan.cc
+    src/scatha/CodeGen/LinearScan.h
     src/scatha/CodeGen/Logger.cc
     src/scatha/CodeGen/LowerToASM.cc
     src/scatha/CodeGen/LowerToMIR.cc
@@ -168,7 +178,9 @@ set(scatha_sources
     src/scatha/CodeGen/ValueMap.h
 
     src/scatha/Common/Allocator.cc
+    src/scatha/Common/InternedString.cc
     src/scatha/Common/Base.cc
+    src/scatha/Common/BinaryIO.h
     src/scatha/Common/Builtin.cc
     src/scatha/Common/Builtin.h
     src/scatha/Common/DebugInfo.cc
@@ -183,16 +195,19 @@ set(scatha_sources
     src/scatha/Common/PrintUtil.h
     src/scatha/Common/SourceFile.cc
     src/scatha/Common/SourceLocation.cc
+    src/scatha/Common/ThreadPool.cc
+    src/scatha/Common/ThreadPool.h
+    src/scatha/Common/TimeTrace.cc
     src/scatha/Common/TreeFormatter.cc
     src/scatha/Common/TreeFormatter.h
 
     src/scatha/Debug/DebugGraphviz.cc
     src/scatha/Debug/DebugGraphviz.h
 
+    src/scatha/IR/AnalysisManager.cc
     src/scatha/IR/Attributes.h
     src/scatha/IR/Attributes.cc
     src/scatha/IR/BinSerialize.cc
-    src/scatha/IR/BinSerialize.h
     src/scatha/IR/Builder.cc
     src/scatha/IR/Builder.h
     src/scatha/IR/CFG/BasicBlock.cc
@@ -222,6 +237,7 @@ set(scatha_sources
     src/scatha/IR/Loop.cc
     src/scatha/IR/Loop.h
     src/scatha/IR/Module.cc
+    src/scatha/IR/NodeAllocator.cc
     src/scatha/IR/Parser/IRIssue.cc
     src/scatha/IR/Parser/IRLexer.cc
     src/scatha/IR/Parser/IRLexer.h
@@ -267,8 +283,13 @@ set(scatha_sources
     src/scatha/IRGen/Value.cc
     src/scatha/IRGen/Value.h
 
+    src/scatha/Invocation/BuildId.cc
+    src/scatha/Invocation/BuildId.h
+    src/scatha/Invocation/CompilationCache.cc
     src/scatha/Invocation/CompilerInvocation.cc
+    src/scatha/Invocation/ContentHash.h
     src/scatha/Invocation/ExecutableWriter.cc
+    src/scatha/Invocation/LibraryCache.cc
     src/scatha/Invocation/Target.cc
     src/scatha/Invocation/TargetNames.h
 
@@ -290,6 +311,8 @@ set(scatha_sources
     src/scatha/MIR/Instructions.h
     src/scatha/MIR/LiveInterval.cc
     src/scatha/MIR/LiveInterval.h
+    src/scatha/MIR/LiveSet.cc
+    src/scatha/MIR/LiveSet.h
     src/scatha/MIR/Module.cc
     src/scatha/MIR/Print.cc
     src/scatha/MIR/Register.cc
@@ -323,6 +346,7 @@ set(scatha_sources
     src/scatha/Opt/LoopRankView.h
     src/scatha/Opt/LoopRotate.cc
     src/scatha/Opt/LoopUnroll.cc
+    src/scatha/Opt/LoopVectorize.cc
     src/scatha/Opt/MemToReg.cc
     src/scatha/Opt/MemberTree.cc
     src/scatha/Opt/MemberTree.h
@@ -399,10 +423,15 @@ set(scatha_sources
 set(scatha_test_sources
     test/scatha/Assembly/Assembler.t.cc
 
+    test/scatha/CodeGen/CodeGen.t.cc
     test/scatha/CodeGen/DataFlow.t.cc
+    test/scatha/CodeGen/RegisterAllocator.t.cc
 
     test/scatha/Common/Allocator.t.cc
+    test/scatha/Common/InternedString.t.cc
     test/scatha/Common/Expected.t.cc
+    test/scatha/Common/ThreadPool.t.cc
+    test/scatha/Common/TimeTrace.t.cc
 
     test/scatha/EndToEndTests/BitwiseOperations.t.cc
     test/scatha/EndToEndTests/BooleanOperations.t.cc
@@ -429,9 +458,15 @@ set(scatha_test_sources
     test/scatha/EndToEndTests/StaticData.t.cc
     test/scatha/EndToEndTests/Strings.t.cc
     test/scatha/EndToEndTests/Structures.t.cc
+    test/scatha/EndToEndTests/Vectors.t.cc
 
+    test/scatha/Invocation/CompilationCache.t.cc
     test/scatha/Invocation/CompilerInvocation.t.cc
+    test/scatha/Invocation/LibraryCache.t.cc
+    test/scatha/Invocation/Server.t.cc
 
+    test/scatha/IR/AnalysisManager.t.cc
+    test/scatha/IR/BinSerialize.t.cc
     test/scatha/IR/Clone.t.cc
     test/scatha/IR/DataFlow.t.cc
     test/scatha/IR/Dominance.t.cc
@@ -450,6 +485,7 @@ set(scatha_test_sources
     test/scatha/IRGen/ConditionalExpr.t.cc
     test/scatha/IRGen/ConversionExpr.t.cc
     test/scatha/IRGen/FunctionCalls.t.cc
+    test/scatha/IRGen/LibImport.t.cc
     test/scatha/IRGen/MemberAccess.t.cc
     test/scatha/IRGen/ObjectConstruction.t.cc
     test/scatha/IRGen/ParameterGeneration.t.cc
@@ -472,6 +508,7 @@ set(scatha_test_sources
     test/scatha/Opt/Inliner.t.cc
     test/scatha/Opt/InstCombine.t.cc
     test/scatha/Opt/LoopRotate.t.cc
+    test/scatha/Opt/LoopVectorize.t.cc
     test/scatha/Opt/MemToReg.t.cc
     test/scatha/Opt/PassTest.cc
     test/scatha/Opt/PassTest.h
@@ -515,4 +552,20 @@ set(scatha_test_sources
 
 set(scatha_benchmark_sources
   benchmark/scatha/Benchmark.cc
+  benchmark/scatha/CodeGenBenchmark.cc
+  benchmark/scatha/IRImportBenchmark.cc
+  benchmark/scatha/LexerBenchmark.cc
+  benchmark/scatha/ParserBenchmark.cc
+)
+
+set(scatha_compile_benchmark_sources
+  benchmark/compile/Generators.cc
+  benchmark/compile/Generators.h
+  benchmark/compile/Main.cc
+)
+
+set(scatha_vm_benchmark_sources
+  benchmark/vm/Main.cc
+  benchmark/vm/Workloads.cc
+  benchmark/vm/Workloads.h
 )
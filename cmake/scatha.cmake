@@ -1,11 +1,25 @@
 include(cmake/scatha-files.cmake)
 
+# Compilation cache keys include the build id, so builds of different commits
+# never share cache entries. Trees outside of git fall back to the configure
+# time
+execute_process(
+  COMMAND git rev-parse HEAD
+  WORKING_DIRECTORY ${PROJECT_SOURCE_DIR}
+  OUTPUT_VARIABLE SCATHA_BUILD_ID
+  OUTPUT_STRIP_TRAILING_WHITESPACE
+  ERROR_QUIET
+)
+if(NOT SCATHA_BUILD_ID)
+  string(TIMESTAMP SCATHA_BUILD_ID UTC)
+endif()
+
 # scatha
 add_library(scatha SHARED)
 set_target_properties(scatha PROPERTIES LINKER_LANGUAGE CXX)
 SCSetCompilerOptions(scatha)
 target_compile_definitions(scatha
-  PRIVATE SC_APIEXPORT
+  PRIVATE SC_APIEXPORT SCATHA_BUILD_ID="${SCATHA_BUILD_ID}"
   INTERFACE SC_APIIMPORT)
 
 target_include_directories(scatha
@@ -30,6 +44,8 @@ target_link_libraries(scatha
     microtar
     graphgen
     termfmt
+    Threads::Threads
+    ${CMAKE_DL_LIBS}
 )
 
 target_sources(scatha
@@ -75,6 +91,14 @@ target_sources(scatha-test
 )
 source_group(TREE ${PROJECT_SOURCE_DIR}/test/scatha FILES ${scatha_test_sources})
 
+# The compiler server is part of scathac, we test it without the executable
+target_include_directories(scatha-test PRIVATE src/scathac)
+target_sources(scatha-test
+  PRIVATE
+    src/scathac/Server.cc
+    src/scathac/Util.cc
+)
+
 # Library used to test foreign function import
 add_library(ffi-testlib SHARED ${PROJECT_SOURCE_DIR}/test/scatha/ffi-testlib/lib.cc)
 # We create a copy of the library in a nested folder to test importing nested
@@ -108,3 +132,55 @@ target_sources(scatha-benchmark
     ${scatha_benchmark_sources}
 )
 source_group(TREE ${PROJECT_SOURCE_DIR}/benchmark/scatha FILES ${scatha_benchmark_sources})
+
+# scatha-compile-benchmark
+add_executable(scatha-compile-benchmark)
+set_target_properties(scatha-compile-benchmark PROPERTIES LINKER_LANGUAGE CXX)
+SCSetCompilerOptions(scatha-compile-benchmark)
+
+target_include_directories(scatha-compile-benchmark
+    PRIVATE
+      include
+      benchmark/compile
+)
+
+target_link_libraries(scatha-compile-benchmark
+  PRIVATE
+    scatha
+    nlohmann_json
+)
+
+target_sources(scatha-compile-benchmark
+  PRIVATE
+    ${scatha_compile_benchmark_sources}
+)
+source_group(TREE ${PROJECT_SOURCE_DIR}/benchmark/compile FILES ${scatha_compile_benchmark_sources})
+
+# scatha-vm-benchmark
+add_executable(scatha-vm-benchmark)
+set_target_properties(scatha-vm-benchmark PROPERTIES LINKER_LANGUAGE CXX)
+# The ffi-call workload calls a function of the executable
+set_target_properties(scatha-vm-benchmark PROPERTIES ENABLE_EXPORTS ON)
+SCSetCompilerOptions(scatha-vm-benchmark)
+
+target_include_directories(scatha-vm-benchmark
+    PRIVATE
+      include
+      benchmark/vm
+)
+
+target_link_libraries(scatha-vm-benchmark
+  PRIVATE
+    scatha
+    libsvm
+    nlohmann_json
+)
+
+target_compile_definitions(scatha-vm-benchmark
+  PRIVATE SCATHA_EXAMPLES_DIR="${PROJECT_SOURCE_DIR}/examples")
+
+target_sources(scatha-vm-benchmark
+  PRIVATE
+    ${scatha_vm_benchmark_sources}
+)
+source_group(TREE ${PROJECT_SOURCE_DIR}/benchmark/vm FILES ${scatha_vm_benchmark_sources})
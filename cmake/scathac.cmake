@@ -23,6 +23,8 @@ set(scathac_sources
     src/scathac/Inspect.h
     src/scathac/Options.cc
     src/scathac/Options.h
+    src/scathac/Server.cc
+    src/scathac/Server.h
     src/scathac/Util.cc
     src/scathac/Util.h
     src/scathac/Main.cc
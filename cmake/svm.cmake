@@ -49,7 +49,11 @@ set(libsvm_sources
     src/svm/Memory.h
     src/svm/OpCode.cc
     src/svm/Program.cc
+    src/svm/StringOps.cc
+    src/svm/StringOps.h
     src/svm/Util.cc
+    src/svm/VectorOps.cc
+    src/svm/VectorOps.h
     src/svm/VMImpl.h
     src/svm/VirtualMachine.cc
     src/svm/VirtualMemory.cc
@@ -31,7 +31,10 @@ void ParserFuzzer::runRandom() {
 
 void ParserFuzzer::runModify() {
     IssueHandler iss;
-    auto baseTokens = parser::lex(text, iss);
+    /// Tokens refer to the text they were lexed from, so we keep a copy of the
+    /// base text because `text` is overwritten below
+    std::string const baseText = text;
+    auto baseTokens = parser::lex(baseText, iss);
     assert(iss.empty());
     for (int i = 0;; ++i) {
         auto tokens = baseTokens;
@@ -1,7 +1,11 @@
 #ifndef SCATHA_CODEGEN_CODEGEN_H_
 #define SCATHA_CODEGEN_CODEGEN_H_
 
+#include <cstddef>
+#include <optional>
+
 #include <scatha/CodeGen/Logger.h>
+#include <scatha/CodeGen/Passes.h>
 #include <scatha/Common/Base.h>
 
 namespace scatha::ir {
@@ -18,10 +22,48 @@ class AssemblyStream;
 
 namespace scatha::cg {
 
+/// Statistics of one `codegen()` invocation
+struct CodegenStats {
+    /// Number of generated functions
+    size_t numFunctions = 0;
+
+    /// Sum of the register window sizes of all functions
+    size_t totalRegisters = 0;
+
+    /// Largest register window of all functions
+    size_t maxRegisters = 0;
+};
+
+/// Options structure for `codegen()`
+struct CodegenOptions {
+    /// Register allocator used for all functions. If unset, linear scan is used
+    /// for unoptimized builds and for functions with more than
+    /// `linearScanThreshold` instructions and graph coloring otherwise
+    std::optional<RegisterAllocator> registerAllocator;
+
+    /// Set to `false` for unoptimized builds, which favor compile time over
+    /// code quality
+    bool optimize = true;
+
+    /// See `registerAllocator`. Building and coloring the interference graph
+    /// grows faster than the size of the function, while linear scan stays
+    /// linear but may use more registers. The threshold keeps graph coloring
+    /// for functions of ordinary size and only switches for very large,
+    /// mostly generated functions. The value has not been measured yet. The
+    /// "Register allocator threshold" benchmark measures both allocators
+    /// around it, and `scatha-compile-benchmark --regalloc` compares them on
+    /// whole programs
+    size_t linearScanThreshold = 2000;
+
+    /// If non-null, receives the statistics of the invocation
+    CodegenStats* stats = nullptr;
+};
+
 SCATHA_API Asm::AssemblyStream codegen(ir::Module const& mod);
 
 SCATHA_API Asm::AssemblyStream codegen(ir::Module const& mod,
-                                       cg::Logger& logger);
+                                       cg::Logger& logger,
+                                       CodegenOptions const& options = {});
 
 } // namespace scatha::cg
 
@@ -20,12 +20,19 @@ public:
     virtual ~Logger() = default;
 
     virtual void log(std::string_view stage, mir::Module const& mod) = 0;
+
+    /// \Returns `false` if `log()` ignores its arguments. Code generation then
+    /// runs the per-function pipeline without materializing intermediate
+    /// module states
+    virtual bool isEnabled() const { return true; }
 };
 
 /// Logs nothing
 class SCATHA_API NullLogger: public Logger {
 public:
     void log(std::string_view, mir::Module const&) override {}
+
+    bool isEnabled() const override { return false; }
 };
 
 /// Write verbose debug logs to `ostream`
@@ -56,11 +56,24 @@ SCATHA_API void destroySSA(mir::Context& ctx, mir::Function& F);
 /// live ranges to be computed
 SCATHA_API void coalesceCopies(mir::Context& ctx, mir::Function& F);
 
-/// Convert registers of function \p F to hardware registers. Redundant copy
-/// instructions will be elided.
+/// Algorithms that `allocateRegisters()` can use to assign hardware registers
+enum class RegisterAllocator {
+    /// Colors the interference graph of the function. Usually needs the fewest
+    /// registers
+    Graph,
+
+    /// Assigns registers in a single pass over the live intervals. Much faster
+    /// than graph coloring for large functions but may need more registers
+    LinearScan
+};
+
+/// Convert registers of function \p F to hardware registers using \p allocator.
+/// Redundant copy instructions will be elided.
 ///
 /// \pre Requires \p F to be in virtual register form
-SCATHA_API void allocateRegisters(mir::Context& ctx, mir::Function& F);
+SCATHA_API void allocateRegisters(
+    mir::Context& ctx, mir::Function& F,
+    RegisterAllocator allocator = RegisterAllocator::Graph);
 
 /// Reorder the basic blocks of function \p F to elide terminating jump
 /// instructions
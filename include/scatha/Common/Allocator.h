@@ -8,6 +8,29 @@
 
 namespace scatha {
 
+/// Process wide statistics of the memory held by the compiler's data
+/// structures. This counts the chunks of all monotonic buffer allocators, the
+/// slabs of all IR node allocators and the MIR values and instructions. Other
+/// heap allocations like the vectors inside of nodes are not counted
+class SCATHA_API AllocationStats {
+public:
+    /// \Returns the number of bytes that are currently held
+    static size_t liveBytes();
+
+    /// \Returns the largest value of `liveBytes()` since the last call to
+    /// `resetPeakBytes()`
+    static size_t peakBytes();
+
+    /// Sets the peak to the current number of live bytes
+    static void resetPeakBytes();
+
+    /// Adds \p size bytes to the live bytes
+    static void add(size_t size);
+
+    /// Removes \p size bytes from the live bytes
+    static void remove(size_t size);
+};
+
 /// "Arena" allocator. Allocation increases a pointer in the current memory
 /// block or allocates a new block. New blocks grow geometrically in size.
 /// Deallocation is a no-op. Memory gets freed when the allocator is destroyed
@@ -88,8 +111,28 @@ inline void* operator new(size_t size,
 }
 
 namespace scatha::internal {
+
 /// Exposed in the header to be able to test it
 SCATHA_API u8* alignPointer(u8* ptr, size_t alignment);
+
+/// Allocates \p size bytes on the heap and counts them in `AllocationStats`.
+/// The size is stored in front of the memory, because lists deallocate their
+/// nodes without knowing the most derived type
+SCATHA_API void* allocateTracked(size_t size);
+
+/// Deallocates memory returned by `allocateTracked()`
+SCATHA_API void deallocateTracked(void* ptr);
+
 } // namespace scatha::internal
 
+/// Declares class specific `operator new` and `operator delete` that allocate
+/// the class and its subclasses with `internal::allocateTracked()`
+#define SC_TRACKED_HEAP_ALLOCATION()                                           \
+    static void* operator new(size_t size) {                                   \
+        return ::scatha::internal::allocateTracked(size);                      \
+    }                                                                          \
+    static void operator delete(void* ptr) {                                   \
+        ::scatha::internal::deallocateTracked(ptr);                            \
+    }
+
 #endif // SCATHA_COMMON_ALLOCATOR_H_
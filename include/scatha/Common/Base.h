@@ -200,7 +200,8 @@ void SCATHA_API assertionFailure(char const* file, int line,
                                  char const* function, char const* expr,
                                  char const* msg);
 
-/// Calls `std::abort()`
+/// Calls `std::abort()`, or throws an `AssertionFailure` if the installed
+/// assertion handler is `Throw`
 [[noreturn]] void SCATHA_API relfail();
 
 /// Calls `std::abort()`
@@ -209,9 +210,14 @@ void SCATHA_API assertionFailure(char const* file, int line,
 /// Different ways to handle assertion failures
 enum class AssertFailureHandler { Break, Abort, Throw };
 
-/// Retrieve the way to handle assertion failures set by the environment
+/// Retrieve the way to handle assertion failures set by
+/// `setAssertFailureHandler()` or else by the environment
 SCATHA_API AssertFailureHandler getAssertFailureHandler();
 
+/// Overrides the way to handle assertion failures set by the environment for
+/// the entire process
+SCATHA_API void setAssertFailureHandler(AssertFailureHandler handler);
+
 [[noreturn]]
 #if defined(__GNUC__)
 __attribute__((always_inline, nodebug)) inline
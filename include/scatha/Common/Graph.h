@@ -428,6 +428,15 @@ public:
         Base::addEdgeImpl(_children, child);
     }
 
+    /// Remove \p child from the children of this node. The parent pointer of
+    /// \p child will be cleared
+    /// \pre \p child must be a child of this node
+    void removeChild(Self* child) {
+        SC_ASSERT(child->_parent == _self(), "Not a child of this node");
+        child->_parent = nullptr;
+        Base::removeEdgeImpl(_children, child);
+    }
+
     /// Traverse the tree from this node in DFS order and invoke callable \p f
     /// on every node before visiting its successors.
     template <typename F>
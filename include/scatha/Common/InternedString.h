@@ -0,0 +1,84 @@
+#ifndef SCATHA_COMMON_INTERNEDSTRING_H_
+#define SCATHA_COMMON_INTERNEDSTRING_H_
+
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <scatha/Common/Base.h>
+
+namespace scatha {
+
+/// Interned string. All interned strings with the same text refer to the same
+/// entry in a process wide table, so they are compared and hashed by identity
+/// and duplicate names share their storage. Entries are only freed at the end
+/// of an `InternedStringScope`.
+/// The table is thread safe, so strings can be interned concurrently.
+class SCATHA_API InternedString {
+public:
+    /// Constructs the empty string
+    InternedString() = default;
+
+    /// Interns \p text
+    explicit InternedString(std::string_view text);
+
+    /// \Returns the interned string with text \p text if it has been
+    /// interned before. This never adds an entry to the table
+    static std::optional<InternedString> find(std::string_view text);
+
+    /// \Returns the text of this string
+    std::string_view str() const { return entry ? *entry : std::string_view{}; }
+
+    /// \overload
+    operator std::string_view() const { return str(); }
+
+    /// \Returns `true` if this is the empty string
+    bool empty() const { return !entry; }
+
+    /// \Returns the identity of this string
+    size_t id() const { return reinterpret_cast<size_t>(entry); }
+
+    /// Compares by identity
+    bool operator==(InternedString const&) const = default;
+
+private:
+    explicit InternedString(std::string_view const* entry): entry(entry) {}
+
+    std::string_view const* entry = nullptr;
+};
+
+/// Bounds the lifetime of the strings that are interned for the first time
+/// while the scope is alive. When the last alive scope is destroyed, these
+/// entries are removed from the table and their text is freed. Entries that
+/// existed before the first scope was created are not affected. Long running
+/// processes like the compiler server wrap each request in a scope, so the
+/// table does not grow without bound.
+///
+/// \pre Strings that were interned while a scope was alive must not be used
+/// after the last scope has been destroyed, and no thread may intern strings
+/// while the last scope is being destroyed
+class SCATHA_API InternedStringScope {
+public:
+    InternedStringScope();
+    InternedStringScope(InternedStringScope const&) = delete;
+    InternedStringScope& operator=(InternedStringScope const&) = delete;
+    ~InternedStringScope();
+};
+
+/// Prints the text of \p str to \p ostream
+SCATHA_API std::ostream& operator<<(std::ostream& ostream,
+                                   InternedString str);
+
+} // namespace scatha
+
+template <>
+struct std::hash<scatha::InternedString> {
+    size_t operator()(scatha::InternedString str) const {
+        /// Entries are aligned, so we mix the address to use all bits
+        return (str.id() >> 4) * 0x9E3779B97F4A7C15ull;
+    }
+};
+
+#endif // SCATHA_COMMON_INTERNEDSTRING_H_
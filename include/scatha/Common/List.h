@@ -62,7 +62,16 @@ class DynAllocator: public std::allocator<T> {
 public:
     void destroy(T* ptr) { do_destroy(*ptr); }
 
-    void deallocate(T* ptr, size_t count) { ::operator delete(ptr, count); }
+    /// Types with class specific allocation functions are deallocated with
+    /// them
+    void deallocate(T* ptr, size_t count) {
+        if constexpr (requires { T::operator delete(ptr); }) {
+            T::operator delete(ptr);
+        }
+        else {
+            ::operator delete(ptr, count);
+        }
+    }
 };
 
 template <typename T>
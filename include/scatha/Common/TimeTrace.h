@@ -0,0 +1,131 @@
+#ifndef SCATHA_COMMON_TIMETRACE_H_
+#define SCATHA_COMMON_TIMETRACE_H_
+
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <scatha/Common/Base.h>
+
+namespace scatha {
+
+/// A timed section of a compilation
+struct TraceEvent {
+    /// Name of the stage or pass
+    std::string name;
+
+    /// Category of the event, like "stage", "pass" or "codegen"
+    std::string category;
+
+    /// Name of the function the event applies to. Empty for events that apply
+    /// to the whole module
+    std::string function;
+
+    /// Start time in microseconds since the trace was created
+    int64_t begin = 0;
+
+    /// Duration in microseconds
+    int64_t duration = 0;
+
+    /// Index of the thread that recorded the event
+    size_t thread = 0;
+
+    /// Number of IR instructions before and after the event, if applicable
+    std::optional<size_t> instCountBefore, instCountAfter;
+
+    /// Highest value of `AllocationStats::liveBytes()` during the event, if
+    /// applicable
+    std::optional<size_t> peakBytes;
+};
+
+/// Collects the trace events of compilations. While a trace is active, the
+/// compiler stages and every named pass record events into it. Recording is
+/// thread safe
+class SCATHA_API TimeTrace {
+public:
+    TimeTrace();
+
+    /// \Returns the active trace or null if no trace is active
+    static TimeTrace* active();
+
+    /// Makes a trace active for its lifetime. Only one trace can be active at
+    /// a time
+    class SCATHA_API Activation {
+    public:
+        explicit Activation(TimeTrace* trace);
+        Activation(Activation const&) = delete;
+        ~Activation();
+
+    private:
+        TimeTrace* prev;
+    };
+
+    /// \Returns the time in microseconds since this trace was created
+    int64_t now() const;
+
+    /// Adds \p event to this trace
+    void record(TraceEvent event);
+
+    /// \Returns a copy of all recorded events in order of completion
+    std::vector<TraceEvent> events() const;
+
+    /// Prints a table of the time spent per stage and pass and the slowest
+    /// function pass invocations to \p ostream
+    void printReport(std::ostream& ostream) const;
+
+    /// Writes the events in Chrome trace event format to \p ostream. The
+    /// output can be viewed with `chrome://tracing` or Perfetto
+    void writeChromeTrace(std::ostream& ostream) const;
+
+private:
+    std::chrono::steady_clock::time_point start;
+    mutable std::mutex mutex;
+    std::vector<std::thread::id> threads;
+    std::vector<TraceEvent> _events;
+};
+
+/// Records an event into the active trace for the lifetime of this object.
+/// Does nothing if no trace is active
+class SCATHA_API TraceScope {
+public:
+    /// Begins the event \p name of category \p category
+    TraceScope(std::string_view name, std::string_view category);
+
+    TraceScope(TraceScope const&) = delete;
+
+    /// Ends the event and records it
+    ~TraceScope();
+
+    /// \Returns `true` if a trace is active. Callers can use this to skip
+    /// computing event details
+    bool isActive() const { return trace != nullptr; }
+
+    /// Sets the name of the function the event applies to
+    void setFunction(std::string_view name);
+
+    /// Sets the number of IR instructions before the event
+    void setInstCountBefore(size_t count);
+
+    /// Sets the number of IR instructions after the event
+    void setInstCountAfter(size_t count);
+
+    /// Records the peak of `AllocationStats::liveBytes()` during the event.
+    /// This resets the process wide peak, so it must only be used for events
+    /// that don't overlap, like the top level compiler stages
+    void trackPeakBytes();
+
+private:
+    TimeTrace* trace;
+    TraceEvent event;
+    bool trackPeak = false;
+};
+
+} // namespace scatha
+
+#endif // SCATHA_COMMON_TIMETRACE_H_
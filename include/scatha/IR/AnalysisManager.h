@@ -0,0 +1,166 @@
+#ifndef SCATHA_IR_ANALYSISMANAGER_H_
+#define SCATHA_IR_ANALYSISMANAGER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include <scatha/Common/Base.h>
+#include <scatha/IR/Fwd.h>
+
+namespace scatha::ir {
+
+/// The analyses that are cached per function
+enum class Analysis : uint8_t {
+    DomInfo,
+    PostDomInfo,
+    LoopNestingForest,
+    LAST = LoopNestingForest
+};
+
+/// Number of cached analyses
+inline constexpr size_t NumAnalyses = size_t(Analysis::LAST) + 1;
+
+/// \Returns the name of \p analysis
+SCATHA_API std::string_view toString(Analysis analysis);
+
+/// Set of analyses that remain valid after a pass modified a function. Passes
+/// declare this set when they are registered. When a pass reports a
+/// modification, all analyses it does not preserve are invalidated
+class PreservedAnalyses {
+public:
+    /// Nothing is preserved. This is the default for all passes
+    static constexpr PreservedAnalyses None() { return PreservedAnalyses(); }
+
+    /// Everything is preserved. Used by passes that only schedule other passes
+    /// and therefore leave invalidation to them
+    static constexpr PreservedAnalyses All() {
+        return PreservedAnalyses((AllBit << 1) - 1);
+    }
+
+    /// All analyses that only depend on the control flow graph are preserved.
+    /// Used by passes that rewrite instructions but never add, remove or
+    /// reconnect basic blocks
+    static constexpr PreservedAnalyses CFG() {
+        return PreservedAnalyses()
+            .preserve(Analysis::DomInfo)
+            .preserve(Analysis::PostDomInfo)
+            .preserve(Analysis::LoopNestingForest);
+    }
+
+    constexpr PreservedAnalyses() = default;
+
+    /// Adds \p analysis to the set
+    constexpr PreservedAnalyses& preserve(Analysis analysis) {
+        bits |= bit(analysis);
+        return *this;
+    }
+
+    /// \Returns `true` if \p analysis is in the set
+    constexpr bool preserves(Analysis analysis) const {
+        return (bits & bit(analysis)) != 0;
+    }
+
+    /// \Returns `true` if the set was created by `All()`. Unlike a set that
+    /// contains every analysis, this also means that the pass has not changed
+    /// any instructions that cached results may refer to
+    constexpr bool preservesAll() const { return (bits & AllBit) != 0; }
+
+    /// \Returns the analyses that are in both sets
+    constexpr PreservedAnalyses intersect(PreservedAnalyses rhs) const {
+        return PreservedAnalyses(bits & rhs.bits);
+    }
+
+    bool operator==(PreservedAnalyses const&) const = default;
+
+private:
+    constexpr explicit PreservedAnalyses(uint32_t bits): bits(bits) {}
+
+    static constexpr uint32_t AllBit = uint32_t(1) << NumAnalyses;
+
+    static constexpr uint32_t bit(Analysis analysis) {
+        return uint32_t(1) << size_t(analysis);
+    }
+
+    uint32_t bits = 0;
+};
+
+/// Usage statistics of the analysis caches of all functions
+struct AnalysisStats {
+    /// Number of requests that were served by a cached result
+    size_t hits = 0;
+
+    /// Number of requests that computed the analysis
+    size_t misses = 0;
+
+    /// Number of cached results that were dropped
+    size_t invalidations = 0;
+};
+
+/// Caches the analyses of one function. Every function owns an analysis
+/// manager, which is accessed through the `getOrCompute*()` functions of
+/// `Function`.
+///
+/// Analyses can depend on other analyses. The loop nesting forest for example
+/// is computed from the dominator tree. Invalidating an analysis also
+/// invalidates all cached analyses that depend on it.
+class SCATHA_API AnalysisManager {
+public:
+    explicit AnalysisManager(Function& function);
+
+    AnalysisManager(AnalysisManager const&) = delete;
+    AnalysisManager& operator=(AnalysisManager const&) = delete;
+
+    ~AnalysisManager();
+
+    /// \Returns the dominance information of the function. Computes it if it
+    /// is not cached
+    DominanceInfo& domInfo();
+
+    /// \Returns the post-dominance information of the function. Computes it if
+    /// it is not cached
+    DominanceInfo& postDomInfo();
+
+    /// \Returns the loop nesting forest of the function. Computes it if it is
+    /// not cached
+    LoopNestingForest& LNF();
+
+    /// \Returns `true` if the result of \p analysis is cached
+    bool isCached(Analysis analysis) const;
+
+    /// Invalidates \p analysis and all analyses that depend on it
+    void invalidate(Analysis analysis);
+
+    /// Invalidates all analyses not in \p preserved and all analyses that
+    /// depend on an invalidated analysis
+    void invalidate(PreservedAnalyses preserved);
+
+    /// Invalidates \p analysis but keeps the analyses that depend on it. Only
+    /// for transforms that keep the dependent analyses up to date themselves,
+    /// like loop simplification which maintains the loop nesting forest
+    void invalidateNonTransitive(Analysis analysis);
+
+    /// \Returns the analyses that \p analysis is computed from
+    static std::span<Analysis const> dependencies(Analysis analysis);
+
+    /// \Returns the statistics of \p analysis summed over all functions and
+    /// threads
+    static AnalysisStats stats(Analysis analysis);
+
+    /// Resets the statistics of all analyses to zero
+    static void resetStats();
+
+private:
+    void drop(Analysis analysis);
+
+    Function& function;
+    std::unique_ptr<DominanceInfo> _domInfo;
+    std::unique_ptr<DominanceInfo> _postDomInfo;
+    std::unique_ptr<LoopNestingForest> _LNF;
+};
+
+} // namespace scatha::ir
+
+#endif // SCATHA_IR_ANALYSISMANAGER_H_
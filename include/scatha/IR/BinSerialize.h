@@ -0,0 +1,90 @@
+#ifndef SCATHA_IR_BINSERIALIZE_H_
+#define SCATHA_IR_BINSERIALIZE_H_
+
+#include <iosfwd>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <scatha/Common/Base.h>
+#include <scatha/IR/Fwd.h>
+#include <scatha/IR/IRParser.h>
+
+namespace scatha::ir {
+
+/// Writes a binary representation of the contents of the IR module \p mod to
+/// the ostream \p out
+///
+/// The format is versioned and consists of a string table, a type table, the
+/// declarations of all globals, a constant pool and the definitions of all
+/// globals. The definitions are indexed by offset so they can be decoded
+/// individually. Integers are encoded as variable length integers and values
+/// are referenced by index
+SCATHA_API void serializeBinary(ir::Module const& mod, std::ostream& out);
+
+/// Parses the binary module representation in the istream \p in into the module
+/// \p mod. The callbacks in \p options are invoked like they are by
+/// `parseTo()`.
+/// \Returns `false` if \p in does not contain a well formed module of the
+/// current format version or if the module is not valid IR
+SCATHA_API bool deserializeBinary(ir::Context& ctx, ir::Module& mod,
+                                  std::istream& in,
+                                  ParseOptions const& options = {});
+
+/// \overload for data already in memory
+SCATHA_API bool deserializeBinary(ir::Context& ctx, ir::Module& mod,
+                                  std::span<unsigned char const> data,
+                                  ParseOptions const& options = {});
+
+/// Binary module whose function bodies are decoded on demand. Opening it
+/// declares all types and globals and defines all global variables and foreign
+/// functions. Functions are declared without body until `materialize()` is
+/// called for them
+class SCATHA_API LazyModuleImport {
+public:
+    /// Declares the contents of \p data to \p mod. The callbacks in \p options
+    /// are invoked like they are by `deserializeBinary()`.
+    /// \Returns null if \p data is not a well formed module of the current
+    /// format version
+    static std::unique_ptr<LazyModuleImport> Open(
+        ir::Context& ctx, ir::Module& mod, std::vector<unsigned char> data,
+        ParseOptions const& options = {});
+
+    /// \overload for data that is shared with other imports, like the object
+    /// code held by the library cache
+    static std::unique_ptr<LazyModuleImport> Open(
+        ir::Context& ctx, ir::Module& mod,
+        std::shared_ptr<std::vector<unsigned char> const> data,
+        ParseOptions const& options = {});
+
+    LazyModuleImport(LazyModuleImport const&) = delete;
+    LazyModuleImport& operator=(LazyModuleImport const&) = delete;
+    ~LazyModuleImport();
+
+    /// \Returns `true` if \p global has been declared by this import
+    bool isImported(ir::Global const& global) const;
+
+    /// \Returns `true` if \p function has been declared by this import and
+    /// its body has not been decoded yet
+    bool isPending(ir::Function const& function) const;
+
+    /// Decodes the body of \p function
+    /// \Pre `isPending(function)`
+    /// \Returns `false` if the body is malformed
+    bool materialize(ir::Function& function);
+
+    /// Makes bodies that are decoded later reference \p replacement instead of
+    /// \p global. Must be called before \p global is erased from the module
+    void replaceGlobal(ir::Global const& global, ir::Global& replacement);
+
+    struct Impl;
+
+private:
+    explicit LazyModuleImport(std::unique_ptr<Impl> impl);
+
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace scatha::ir
+
+#endif // SCATHA_IR_BINSERIALIZE_H_
@@ -8,6 +8,7 @@
 #include <scatha/IR/CFG/Iterator.h>
 #include <scatha/IR/CFG/Value.h>
 #include <scatha/IR/Fwd.h>
+#include <scatha/IR/NodeAllocator.h>
 
 namespace scatha::ir {
 
@@ -37,6 +38,10 @@ public:
 
     explicit BasicBlock(Context& context, std::string name);
 
+    /// Basic blocks are allocated in the current `NodeAllocatorScope` if there
+    /// is one
+    SC_IR_NODE_ALLOCATION()
+
     /// Clear operands of all instructions of this basic block. Use this before
     /// removing a (dead) basic block from a function.
     void clearAllOperands() {
@@ -10,6 +10,7 @@
 #include <scatha/IR/CFG/BasicBlock.h>
 #include <scatha/IR/CFG/Global.h>
 #include <scatha/IR/Fwd.h>
+#include <scatha/IR/NodeAllocator.h>
 #include <scatha/IR/UniqueName.h>
 
 namespace scatha::ir {
@@ -114,6 +115,9 @@ public:
 
     ~Function();
 
+    /// The allocator for the nodes of this function. See `NodeAllocatorScope`
+    NodeAllocator& nodeAllocator() { return *_nodeAllocator; }
+
     /// \returns the entry basic block of this function
     BasicBlock& entry() { return front(); }
 
@@ -130,6 +134,9 @@ public:
         return getInstructionsImpl<ConstInstructionIterator>(*this);
     }
 
+    /// \Returns the cache of analyses of this function
+    AnalysisManager& analysisManager() { return *_analysisManager; }
+
     /// Access this functions dominator tree.
     DomTree& getOrComputeDomTree() {
         return const_cast<DomTree&>(
@@ -166,7 +173,9 @@ public:
     /// \overload
     LoopNestingForest const& getOrComputeLNF() const;
 
-    /// Invalidate dominance and post-dominance analysis
+    /// Invalidate dominance and post-dominance analysis. The loop nesting
+    /// forest is kept, so callers that keep it up to date by hand can continue
+    /// to use it
     void invalidateDomInfo();
 
     /// Invalidate dominance and loop analysis
@@ -186,10 +195,12 @@ private:
         void* dest,
         utl::function_view<void(Constant const*, void*)> callback) const;
 
-    struct AnalysisData;
-
     UniqueNameFactory nameFac;
-    std::unique_ptr<AnalysisData> analysisData;
+    std::unique_ptr<AnalysisManager> _analysisManager;
+    /// Holds one reference. The nodes of this function hold the others, so
+    /// the allocator outlives the blocks that are destroyed after our
+    /// destructor body
+    NodeAllocator* _nodeAllocator;
 };
 
 /// Represents a foreign function.
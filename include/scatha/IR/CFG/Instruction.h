@@ -10,6 +10,7 @@
 #include <scatha/Common/Ranges.h>
 #include <scatha/IR/CFG/User.h>
 #include <scatha/IR/Fwd.h>
+#include <scatha/IR/NodeAllocator.h>
 
 namespace scatha::ir {
 
@@ -26,6 +27,10 @@ public:
                          std::span<Value* const> operands = {},
                          std::span<Type const* const> typeOperands = {});
 
+    /// Instructions are allocated in the current `NodeAllocatorScope` if there
+    /// is one
+    SC_IR_NODE_ALLOCATION()
+
     /// \returns a view of all instructions using this value.
     ///
     /// \details This casts the elements in
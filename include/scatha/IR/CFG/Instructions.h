@@ -100,7 +100,8 @@ private:
     Conversion conv;
 };
 
-/// `*cmp` instruction.
+/// `*cmp` instruction. Comparisons of scalars produce an `i1`, comparisons of
+/// vectors produce a lane mask (see `Context::maskType()`)
 class SCATHA_API CompareInst: public BinaryInstruction {
 public:
     explicit CompareInst(Context& context, Value* lhs, Value* rhs,
@@ -161,7 +162,13 @@ public:
 
     void setOperation(ArithmeticOperation op) { _op = op; }
 
-    ArithmeticType const* type() const;
+    /// \Returns the type of this instruction. This is either an
+    /// `ArithmeticType` or a `VectorType` for lane wise arithmetic
+    Type const* type() const { return Value::type(); }
+
+    /// \Returns the type of the scalar operands or the lane type of vector
+    /// operands
+    ArithmeticType const* scalarType() const;
 
 private:
     ArithmeticOperation _op;
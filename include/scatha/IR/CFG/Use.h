@@ -0,0 +1,113 @@
+#ifndef SCATHA_IR_CFG_USE_H_
+#define SCATHA_IR_CFG_USE_H_
+
+#include <cstddef>
+#include <iterator>
+
+#include <range/v3/view/interface.hpp>
+
+#include <scatha/Common/Base.h>
+#include <scatha/IR/Fwd.h>
+
+namespace scatha::ir {
+
+/// Represents the use of a value by one operand slot of a `User`
+/// Every operand slot of a user owns one `Use`. All uses of a value are linked
+/// into an intrusive list headed by the value, so adding and removing uses
+/// does not allocate.
+class SCATHA_API Use {
+public:
+    /// The user that owns this use
+    User* user() const { return _user; }
+
+    /// The next use of the same value or `nullptr`
+    Use const* next() const { return _next; }
+
+    /// The index of the operand slot of `user()` this use represents
+    size_t operandIndex() const;
+
+    /// The used value
+    Value* value() const;
+
+    /// \Returns `true` if the used value counts `user()` as a user by this use.
+    /// Of all uses of the same value by the same user exactly one counts the
+    /// user
+    bool countsUser() const { return _countsUser; }
+
+    /// \Returns `true` if this use is linked into the use list of a value
+    bool isLinked() const { return _prev != nullptr; }
+
+private:
+    friend class User;
+
+    User* _user = nullptr;
+    Use* _next = nullptr;
+    /// Points to the `_next` field of the previous use or to the list head in
+    /// the used value
+    Use** _prev = nullptr;
+    bool _countsUser = false;
+};
+
+} // namespace scatha::ir
+
+namespace scatha::ir::internal {
+
+/// Iterator over the distinct users of a value. Walks the use list and skips
+/// the uses that don't count their user, so every user is visited once
+class UserIterator {
+public:
+    using value_type = User*;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = User*;
+    using iterator_category = std::forward_iterator_tag;
+    using iterator_concept = std::forward_iterator_tag;
+
+    UserIterator() = default;
+
+    explicit UserIterator(Use const* use): use(skip(use)) {}
+
+    User* operator*() const { return use->user(); }
+
+    UserIterator& operator++() {
+        use = skip(use->next());
+        return *this;
+    }
+
+    UserIterator operator++(int) {
+        auto result = *this;
+        ++*this;
+        return result;
+    }
+
+    bool operator==(UserIterator const&) const = default;
+
+private:
+    static Use const* skip(Use const* use) {
+        while (use && !use->countsUser()) {
+            use = use->next();
+        }
+        return use;
+    }
+
+    Use const* use = nullptr;
+};
+
+/// View over the distinct users of a value
+class UserRange: public ranges::view_interface<UserRange> {
+public:
+    UserRange() = default;
+
+    explicit UserRange(Use const* first): first(first) {}
+
+    UserIterator begin() const { return UserIterator(first); }
+
+    UserIterator end() const { return UserIterator(); }
+
+private:
+    Use const* first = nullptr;
+};
+
+} // namespace scatha::ir::internal
+
+#endif // SCATHA_IR_CFG_USE_H_
@@ -59,6 +59,9 @@ public:
     /// \returns `true` if \p value is an operand of this user.
     bool directlyUses(Value const* value) const;
 
+    /// \Returns the use of the operand slot at index \p index
+    Use const& useAt(size_t index) const { return _uses[index]; }
+
 protected:
     explicit User(NodeType nodeType, Type const* type, std::string name = {},
                   std::span<Value* const> operands = {});
@@ -67,7 +70,9 @@ protected:
     /// User lists are updated.
     void setOperands(std::span<Value* const> operands);
 
-    void setOperandCount(size_t count) { _operands.resize(count); }
+    /// Resize the operand list to \p count operands. New operands are
+    /// `nullptr`. User lists are updated.
+    void setOperandCount(size_t count);
 
     /// Append an operand to the end of our operand list.
     void addOperand(Value* op);
@@ -78,8 +83,30 @@ protected:
     void removeOperand(size_t index);
 
 private:
-    friend class BinaryInstruction;
+    friend class Use;
+
+    /// Links the use of operand slot \p index into the use list of the operand.
+    /// If \p countUser is `true`, the use counts this user and increments the
+    /// user count of the operand
+    void linkUse(size_t index, bool countUser);
+
+    /// Unlinks the use of operand slot \p index from the use list of the
+    /// operand. If the use counts this user, \p heir counts it from now on. If
+    /// \p heir is null, the user count of the operand is decremented instead.
+    /// Passing the use itself keeps the count when the use is linked again
+    void unlinkUse(size_t index, Use* heir);
+
+    /// \Returns the use of an operand slot other than \p index that holds the
+    /// same operand as slot \p index or null
+    Use* findOtherUse(size_t index);
+
+    /// Resizes the operand and use lists. Uses that are moved by a
+    /// reallocation are relinked, new slots are `nullptr`
+    void resizeOperands(size_t count);
+
     utl::small_vector<Value*, 2> _operands;
+    /// Parallel to `_operands`
+    utl::small_vector<Use, 2> _uses;
 };
 
 } // namespace scatha::ir
@@ -2,6 +2,7 @@
 #define SCATHA_IR_CFG_VALUE_H_
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 
@@ -12,6 +13,7 @@
 #include <scatha/Common/Metadata.h>
 #include <scatha/Common/Ranges.h>
 #include <scatha/Common/UniquePtr.h>
+#include <scatha/IR/CFG/Use.h>
 #include <scatha/IR/Fwd.h>
 
 namespace scatha::ir {
@@ -42,16 +44,17 @@ public:
     /// Set the name of this value.
     void setName(std::string name);
 
-    /// View of all users using this value.
-    auto users() const { return _users | ranges::views::keys; }
+    /// View of all users using this value. Every user appears once, even if
+    /// it uses this value in multiple operand slots.
+    internal::UserRange users() const { return internal::UserRange(_uses); }
 
-    /// View of all users with use counts using this value.
-    auto const& countedUsers() const { return _users; }
+    /// The first use in the list of uses of this value or `nullptr`
+    Use const* firstUse() const { return _uses; }
 
     /// Number of users using this value. Multiple uses by the same user are
     /// counted as one.
     /// TODO: Rename to numUsers()
-    size_t userCount() const { return _users.size(); }
+    size_t userCount() const { return _numUsers; }
 
     /// \Returns `true` if this value has no users
     bool unused() const { return userCount() == 0; }
@@ -80,7 +83,8 @@ public:
 
     /// \Returns a view over the attributes of this value (`[Attribute const*]`)
     auto attributes() const {
-        return _attribs.values() | ranges::views::values | ToConstAddress;
+        return attributeMap().values() | ranges::views::values |
+               ToConstAddress;
     }
 
     /// Constructs the attribute type \p Attrib from \p args... and adds it to
@@ -114,14 +118,26 @@ private:
     friend class User;
     friend class ValueRef;
 
-    /// Register a user of this value. Won't affect \p user
-    /// This function and `removeUserWeak()` are solely intended to be used be
-    /// class `User`
-    void addUserWeak(User* user);
+    using AttributeMap = utl::hashmap<AttributeType, UniquePtr<Attribute>>;
 
-    /// Unregister a user of this value. `this` will _not_ be cleared from the
-    /// operand list of \p user
-    void removeUserWeak(User* user);
+    /// Data that only few values have. It is allocated on first use so the
+    /// common case of a value without attributes and references stays small
+    struct SideTable {
+        utl::hashset<ValueRef*> references;
+        AttributeMap attribs;
+    };
+
+    /// \Returns the side table of this value and allocates it if necessary
+    SideTable& sideTable();
+
+    /// \Returns the attributes of this value or an empty map
+    AttributeMap const& attributeMap() const;
+
+    /// Constants and globals are shared by all functions of a module, so
+    /// functions that are built concurrently may modify their user and
+    /// reference lists at the same time. \Returns a lock that guards these
+    /// lists if this value is a constant and an empty lock otherwise
+    std::unique_lock<std::mutex> lockUseLists() const;
 
     friend class BasicBlock;
     friend class Function;
@@ -134,11 +150,13 @@ private:
 
     NodeType _nodeType;
     uint16_t _ptrInfoArrayCount = 0;
+    /// Number of distinct users. Maintained by `User`
+    uint32_t _numUsers = 0;
     Type const* _type;
     std::string _name;
-    utl::hashmap<User*, uint16_t> _users;
-    utl::hashset<ValueRef*> _references;
-    utl::hashmap<AttributeType, UniquePtr<Attribute>> _attribs;
+    /// Head of the intrusive list of uses. Maintained by `User`
+    Use* _uses = nullptr;
+    std::unique_ptr<SideTable> _sideTable;
     std::unique_ptr<PointerInfo> ptrInfo;
 };
 
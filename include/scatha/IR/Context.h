@@ -13,6 +13,9 @@
 namespace scatha::ir {
 
 /// Manages types and constants
+/// Creating types and constants is thread safe, so multiple functions can be
+/// generated concurrently against the same context. All other member functions
+/// must not be called concurrently
 class SCATHA_API Context {
 public:
     /// Construct an empty `Context` object
@@ -59,6 +62,22 @@ public:
     /// \returns The array type of `i8` with \p count elements
     ArrayType const* byteArrayType(size_t count);
 
+    /// \returns The vector type of \p count elements of type \p elementType
+    /// \pre `VectorType::isValid(elementType, count)`
+    VectorType const* vectorType(ArithmeticType const* elementType,
+                                 size_t count);
+
+    /// \returns The widest vector type of \p elementType, i.e. the vector of
+    /// `VectorType::MaxByteSize` bytes
+    /// \pre `elementType` must be at most half as large as
+    /// `VectorType::MaxByteSize`
+    VectorType const* vectorType(ArithmeticType const* elementType);
+
+    /// \returns The type of lane masks of \p type, i.e. the integral vector
+    /// with the same number and width of lanes. Vector comparisons produce
+    /// masks and lane wise `select` instructions consume them
+    VectorType const* maskType(VectorType const* type);
+
     /// \returns The global integral constant with value \p value
     IntegralConstant* intConstant(APInt value);
 
@@ -176,6 +176,10 @@ SCATHA_API bool isShift(ArithmeticOperation op);
 /// \Returns `true` if \p op is commutative
 SCATHA_API bool isCommutative(ArithmeticOperation op);
 
+/// \Returns `true` if \p op can be applied to vector operands. Only these
+/// operations have a packed VM instruction
+SCATHA_API bool hasVectorForm(ArithmeticOperation op);
+
 /// ## Forward declarations of type categories
 
 #define SC_TYPE_CATEGORY_DEF(TypeCat, ...) class TypeCat;
@@ -288,6 +292,9 @@ SCATHA_API void do_delete(ir::Type& type);
 /// Insulated call to destructor on the most derived base of \p type
 SCATHA_API void do_destroy(ir::Type& type);
 
+class AnalysisManager;
+class NodeAllocator;
+class Use;
 class ValueRef;
 class DomTree;
 class DominanceInfo;
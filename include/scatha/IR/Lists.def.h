@@ -200,6 +200,7 @@ SC_TYPE_CATEGORY_DEF(FloatType,      ArithmeticType, Concrete)
 SC_TYPE_CATEGORY_DEF(RecordType,     Type,           Abstract)
 SC_TYPE_CATEGORY_DEF(StructType,     RecordType,     Concrete)
 SC_TYPE_CATEGORY_DEF(ArrayType,      RecordType,     Concrete)
+SC_TYPE_CATEGORY_DEF(VectorType,     ArrayType,      Concrete)
 SC_TYPE_CATEGORY_DEF(FunctionType,   Type,           Concrete) // Update LAST if this changes!
 
 #undef SC_TYPE_CATEGORY_DEF
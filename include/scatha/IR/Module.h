@@ -73,6 +73,11 @@ public:
     /// \Returns a view over all struct types in the module
     auto structTypes() const { return structs | ToAddress; }
 
+    /// Moves the globals \p globals to the end of their respective lists in
+    /// the given order. This is used to establish a deterministic order of
+    /// globals that have been added concurrently
+    void moveToBack(std::span<Global* const> globals);
+
     /// Erase the global  \p global from this module.  \p global can also be a
     /// function
     void erase(Global* global);
@@ -0,0 +1,126 @@
+#ifndef SCATHA_IR_NODEALLOCATOR_H_
+#define SCATHA_IR_NODEALLOCATOR_H_
+
+#include <array>
+#include <cstddef>
+
+#include <scatha/Common/Base.h>
+#include <scatha/IR/Fwd.h>
+
+namespace scatha::ir {
+
+/// Slab allocator for the instructions and basic blocks of one function.
+/// Memory is carved in program order from slabs that grow geometrically. Freed
+/// nodes are put on the free list of their size class and are reused by the
+/// next allocation of the same size class.
+///
+/// Every node holds a reference to the allocator it was allocated in, so
+/// nodes can be moved to other functions. The allocator frees all slabs at
+/// once when its owner and all of its nodes are gone.
+///
+/// The allocator is not thread safe. The nodes of one function must not be
+/// allocated or freed on multiple threads at the same time. Therefore the body
+/// of a function must be built in the scope of that function and never in the
+/// scope of another function, which may be processed on another thread.
+/// Parameters are created before their function exists, so they are always
+/// allocated on the heap.
+class SCATHA_API NodeAllocator {
+public:
+    /// Granularity of the size classes
+    static constexpr size_t SizeClassGranularity = 16;
+
+    /// Allocations larger than `NumSizeClasses * SizeClassGranularity` bytes
+    /// are served by the heap
+    static constexpr size_t NumSizeClasses = 48;
+
+    /// Size of the first slab. Every further slab is twice as large up to
+    /// `MaxSlabSize`
+    static constexpr size_t InitialSlabSize = 2048;
+
+    /// Maximum size of a slab
+    static constexpr size_t MaxSlabSize = size_t(64) << 10;
+
+    /// Creates an allocator. The caller holds one reference
+    static NodeAllocator* create();
+
+    NodeAllocator(NodeAllocator const&) = delete;
+    NodeAllocator& operator=(NodeAllocator const&) = delete;
+
+    /// Adds a reference
+    void retain() { ++refCount; }
+
+    /// Drops a reference and destroys the allocator if it was the last
+    void release();
+
+    /// \Returns the number of bytes in all slabs
+    size_t slabBytes() const { return numSlabBytes; }
+
+    /// \Returns the number of nodes that are currently allocated
+    size_t liveNodes() const { return numLiveNodes; }
+
+    /// Allocates a block of size class \p sizeClass
+    void* allocate(size_t sizeClass);
+
+    /// Puts \p block onto the free list of size class \p sizeClass
+    void deallocate(void* block, size_t sizeClass);
+
+private:
+    struct SlabHeader;
+    struct FreeBlock;
+
+    NodeAllocator() = default;
+    ~NodeAllocator();
+
+    void addSlab(size_t minSize);
+
+    std::array<FreeBlock*, NumSizeClasses> freeLists{};
+    SlabHeader* slabs = nullptr;
+    char* current = nullptr;
+    char* end = nullptr;
+    size_t numSlabBytes = 0;
+    size_t numLiveNodes = 0;
+    size_t refCount = 1;
+};
+
+/// While a `NodeAllocatorScope` is alive, all instructions and basic blocks
+/// that are allocated on the calling thread are placed in the node allocator
+/// of the function passed to the constructor. Nodes allocated
+/// outside of any scope use the heap. Scopes nest.
+class SCATHA_API NodeAllocatorScope {
+public:
+    explicit NodeAllocatorScope(Function& function);
+
+    NodeAllocatorScope(NodeAllocatorScope const&) = delete;
+    NodeAllocatorScope& operator=(NodeAllocatorScope const&) = delete;
+
+    ~NodeAllocatorScope();
+
+private:
+    NodeAllocator* prev;
+};
+
+namespace internal {
+
+/// Allocates \p size bytes in the allocator of the current scope or on the
+/// heap. The memory is preceded by a header that records where it was
+/// allocated
+SCATHA_API void* allocateNodeMemory(size_t size);
+
+/// Deallocates memory returned by `allocateNodeMemory()`
+SCATHA_API void deallocateNodeMemory(void* ptr);
+
+} // namespace internal
+
+} // namespace scatha::ir
+
+/// Declares class specific `operator new` and `operator delete` that allocate
+/// the class and its subclasses with `ir::internal::allocateNodeMemory()`
+#define SC_IR_NODE_ALLOCATION()                                                \
+    static void* operator new(size_t size) {                                   \
+        return ::scatha::ir::internal::allocateNodeMemory(size);               \
+    }                                                                          \
+    static void operator delete(void* ptr) {                                   \
+        ::scatha::ir::internal::deallocateNodeMemory(ptr);                     \
+    }
+
+#endif // SCATHA_IR_NODEALLOCATOR_H_
@@ -40,6 +40,7 @@ enum class TokenKind {
     Ptr,
     IntType,
     FloatType,
+    VectorType,
 
     Alloca,
     Load,
@@ -128,7 +129,8 @@ public:
     TokenKind kind() const { return _kind; }
 
     /// Width of integral or float type. Only applicable if `kind() == IntType`
-    /// or `kind() == FloatType`
+    /// or `kind() == FloatType`. For `VectorType` this is the width of the
+    /// element type
     unsigned width() const { return _width; }
 
 private:
@@ -10,6 +10,7 @@
 #include <utl/hashtable.hpp>
 
 #include <scatha/Common/Base.h>
+#include <scatha/IR/AnalysisManager.h>
 #include <scatha/IR/Fwd.h>
 
 namespace scatha::ir {
@@ -221,6 +222,10 @@ public:
     /// \Returns the pass arguments
     PassArgumentMap const& arguments() const { return _args; }
 
+    /// The analyses that remain valid when this pass modifies a function. Only
+    /// respected by function passes
+    PreservedAnalyses preservedAnalyses() const { return _preserved; }
+
     /// Matches the argument at \p key against \p value
     ArgumentMatchResult matchArgument(std::string_view key,
                                       std::string_view value) {
@@ -228,10 +233,14 @@ public:
     }
 
 protected:
-    PassBase(): PassBase({}, {}, PassCategory::Other) {}
-
-    PassBase(PassArgumentMap args, std::string name, PassCategory category):
-        _args(std::move(args)), _name(std::move(name)), _cat(category) {
+    PassBase(): PassBase({}, {}, PassCategory::Other, {}) {}
+
+    PassBase(PassArgumentMap args, std::string name, PassCategory category,
+             PreservedAnalyses preserved):
+        _args(std::move(args)),
+        _name(std::move(name)),
+        _cat(category),
+        _preserved(preserved) {
         if (_name.empty()) {
             _name = "anonymous";
         }
@@ -241,6 +250,7 @@ private:
     PassArgumentMap _args;
     std::string _name;
     PassCategory _cat;
+    PreservedAnalyses _preserved;
 };
 
 template <typename Derived, typename Sig>
@@ -257,8 +267,9 @@ public:
 
     PassMixin(std::function<Sig> p, PassArgumentMap params = {},
               std::string name = {},
-              PassCategory category = PassCategory::Other):
-        PassBase(std::move(params), std::move(name), category),
+              PassCategory category = PassCategory::Other,
+              PreservedAnalyses preserved = PreservedAnalyses::None()):
+        PassBase(std::move(params), std::move(name), category, preserved),
         p(std::move(p)) {}
 
     /// \Returns `true` is the pass is non-empty
@@ -281,13 +292,14 @@ public:
                      std::invoke_result_t<P, Context&, LNFNode&>, bool> &&
                  (!std::derived_from<std::remove_cvref_t<P>, PassBase>)
     LoopPass(P&& p, PassArgumentMap params = {}, std::string name = {},
-             PassCategory category = PassCategory::Other):
+             PassCategory category = PassCategory::Other,
+             PreservedAnalyses preserved = PreservedAnalyses::None()):
         LoopPass(
             [p = std::forward<P>(p)](Context& ctx, LNFNode& loop,
                                      PassArgumentMap const&) {
                 return std::invoke(p, ctx, loop);
             },
-            std::move(params), std::move(name), category) {}
+            std::move(params), std::move(name), category, preserved) {}
 
     /// Invoke the pass
     bool operator()(Context& ctx, LNFNode& loop) const {
@@ -308,13 +320,14 @@ public:
                      std::invoke_result_t<P, Context&, Function&>, bool> &&
                  (!std::derived_from<std::remove_cvref_t<P>, PassBase>)
     FunctionPass(P&& p, PassArgumentMap params = {}, std::string name = {},
-                 PassCategory category = PassCategory::Other):
+                 PassCategory category = PassCategory::Other,
+                 PreservedAnalyses preserved = PreservedAnalyses::None()):
         FunctionPass(
             [p = std::forward<P>(p)](Context& ctx, Function& F, LoopPass const&,
                                      PassArgumentMap const&) {
                 return std::invoke(p, ctx, F);
             },
-            std::move(params), std::move(name), category) {}
+            std::move(params), std::move(name), category, preserved) {}
 
     ///
     template <std::invocable<Context&, Function&, PassArgumentMap const&> P>
@@ -323,19 +336,20 @@ public:
                                  PassArgumentMap const&>,
             bool>
     FunctionPass(P&& p, PassArgumentMap params = {}, std::string name = {},
-                 PassCategory category = PassCategory::Other):
+                 PassCategory category = PassCategory::Other,
+                 PreservedAnalyses preserved = PreservedAnalyses::None()):
         FunctionPass(
             [p = std::forward<P>(p)](Context& ctx, Function& F, LoopPass const&,
                                      PassArgumentMap const& args) {
                 return std::invoke(p, ctx, F, args);
             },
-            std::move(params), std::move(name), category) {}
+            std::move(params), std::move(name), category, preserved) {}
 
-    /// Invoke the pass
-    bool operator()(Context& ctx, Function& function,
-                    LoopPass const& loopPass = {}) const {
-        return p && p(ctx, function, loopPass, arguments());
-    }
+    /// Invoke the pass. Named passes are recorded in the active time trace.
+    /// If the pass modifies \p function, the analyses of \p function that
+    /// the pass does not preserve are invalidated
+    SCATHA_API bool operator()(Context& ctx, Function& function,
+                               LoopPass const& loopPass = {}) const;
 };
 
 /// Represents a global pass that operates on a module
@@ -347,11 +361,9 @@ public:
 
     ModulePass(Sig* p): ModulePass(p, {}) {}
 
-    /// Invoke the pass
-    bool operator()(Context& ctx, Module& mod,
-                    FunctionPass const& functionPass) const {
-        return p && p(ctx, mod, functionPass, arguments());
-    }
+    /// Invoke the pass. Named passes are recorded in the active time trace
+    SCATHA_API bool operator()(Context& ctx, Module& mod,
+                               FunctionPass const& functionPass) const;
 };
 
 } // namespace scatha::ir
@@ -0,0 +1,83 @@
+#ifndef SCATHA_INVOCATION_COMPILATIONCACHE_H_
+#define SCATHA_INVOCATION_COMPILATIONCACHE_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <scatha/Common/Base.h>
+
+namespace scatha {
+
+/// Usage statistics of a `CompilationCache`
+struct CompilationCacheStats {
+    /// Number of lookups that found a valid entry
+    size_t hits = 0;
+
+    /// Number of lookups that found no entry or a corrupted entry
+    size_t misses = 0;
+
+    /// Number of entries removed to keep the cache below its size limit
+    size_t evictions = 0;
+};
+
+/// On-disk cache of compilation results. Entries are files in a directory,
+/// named by a hash of everything the cached result depends on. Entries are
+/// written atomically, so multiple processes can share the same directory.
+/// All errors are ignored, a failing cache behaves like an empty cache
+class SCATHA_API CompilationCache {
+public:
+    /// Default size limit of 256 MiB
+    static constexpr size_t DefaultMaxSize = size_t{ 256 } << 20;
+
+    /// Opens the cache in \p directory, which is created if it does not
+    /// exist. When the entries exceed \p maxSize bytes the least recently used
+    /// entries are evicted
+    explicit CompilationCache(std::filesystem::path directory,
+                              size_t maxSize = DefaultMaxSize);
+
+    /// \Returns the data stored under \p key or `std::nullopt` if there is no
+    /// valid entry
+    std::optional<std::vector<unsigned char>> lookup(std::string_view key);
+
+    /// Stores \p data under \p key and evicts entries if the cache exceeds its
+    /// size limit. The size is tracked in memory, so the directory is only
+    /// listed when the limit appears to be exceeded. Entries added by other
+    /// processes are accounted for at the next eviction
+    void store(std::string_view key, std::span<unsigned char const> data);
+
+    /// Removes all entries
+    void clear();
+
+    /// \Returns the statistics of lookups performed through this object
+    CompilationCacheStats stats() const;
+
+    /// \Returns the total size in bytes of all entries
+    size_t size() const;
+
+    /// \Returns the directory of the cache
+    std::filesystem::path const& directory() const { return dir; }
+
+    /// \Returns the size limit of the cache in bytes
+    size_t maxSize() const { return _maxSize; }
+
+private:
+    std::filesystem::path entryPath(std::string_view key) const;
+    void evict(std::filesystem::path const& keep);
+
+    std::filesystem::path dir;
+    size_t _maxSize;
+    mutable std::mutex mutex;
+    CompilationCacheStats _stats;
+    /// Total size of the entries as of the last directory listing plus the
+    /// entries stored since
+    size_t estimatedSize = 0;
+};
+
+} // namespace scatha
+
+#endif // SCATHA_INVOCATION_COMPILATIONCACHE_H_
@@ -14,6 +14,7 @@
 #include <scatha/Assembly/Fwd.h>
 #include <scatha/Assembly/Options.h>
 #include <scatha/CodeGen/Logger.h>
+#include <scatha/CodeGen/Passes.h>
 #include <scatha/Common/SourceFile.h>
 #include <scatha/IR/Fwd.h>
 #include <scatha/Invocation/Target.h>
@@ -21,6 +22,9 @@
 
 namespace scatha {
 
+class CompilationCache;
+class TimeTrace;
+
 /// Different compiler frontends
 enum class FrontendType { Scatha, IR };
 
@@ -86,11 +90,43 @@ public:
         optPipeline = std::move(pipeline);
     }
 
+    /// Sets the register allocator to \p allocator
+    /// If unset, the allocator is chosen per function: Linear scan is used at
+    /// optimization level 0 and for very large functions, graph coloring
+    /// otherwise.
+    /// Defaults to unset
+    void setRegisterAllocator(std::optional<cg::RegisterAllocator> allocator) {
+        registerAllocator = allocator;
+    }
+
+    /// Sets the number of threads used for compilation to \p count
+    /// Zero leaves the process wide setting unchanged, which defaults to the
+    /// number of hardware threads. The compiled target does not depend on this
+    /// setting.
+    /// Defaults to 0
+    void setNumThreads(size_t count) { numThreads = count; }
+
     /// Sets the linker options passed to the `link` command
     void setLinkerOptions(Asm::LinkerOptions options) {
         linkerOptions = options;
     }
 
+    /// Sets the compilation cache to \p cache
+    /// If a cache is set, the target is looked up in the cache before running
+    /// any stage and stored after a successful compilation. Frontend results
+    /// are cached separately, so changing only the optimization options skips
+    /// parsing, semantic analysis and IR generation. Callbacks of skipped
+    /// stages are not invoked and warnings of cached compilations are not
+    /// reported again. The cache must outlive this invocation.
+    /// Defaults to null
+    void setCache(CompilationCache* cache) { this->cache = cache; }
+
+    /// Sets the time trace to \p trace
+    /// If a trace is set, it is active while `run()` executes and records the
+    /// compiler stages and every named pass. The trace must outlive this
+    /// invocation. Defaults to null
+    void setTimeTrace(TimeTrace* trace) { timeTrace = trace; }
+
     /// Sets the codegen logger to \p logger
     /// Defaults to an instance of `cg::NullLogger`
     void setCodegenLogger(cg::Logger& logger) { codegenLogger = &logger; }
@@ -121,6 +157,25 @@ private:
 
     void handleError();
 
+    std::optional<Target> runImpl();
+
+    std::optional<Target> emitTarget(sema::SymbolTable& semaSym,
+                                     ir::Context& irContext,
+                                     ir::Module& irModule);
+
+    /// Compilation cache helpers
+    std::string frontendKey() const;
+    std::string targetKey(std::string const& inputsKey) const;
+    std::optional<std::string> lookupInputsKey(std::string const& frontendKey);
+    void storeManifest(std::string const& frontendKey,
+                       std::span<std::string const> libPaths);
+    std::optional<Target> lookupTarget(std::string const& key);
+    void storeTarget(std::string const& key, Target const& target);
+    bool lookupModule(std::string const& key, sema::SymbolTable& sym,
+                      ir::Context& ctx, ir::Module& mod);
+    void storeModule(std::string const& key, sema::SymbolTable const& sym,
+                     std::string_view irData);
+
     TargetType targetType;
     std::string name;
     std::vector<SourceFile> sources;
@@ -131,7 +186,11 @@ private:
     Asm::LinkerOptions linkerOptions;
     std::ostream* errStream;
     cg::Logger* codegenLogger = nullptr;
+    CompilationCache* cache = nullptr;
+    TimeTrace* timeTrace = nullptr;
     int optLevel = 0;
+    std::optional<cg::RegisterAllocator> registerAllocator;
+    size_t numThreads = 0;
     FrontendType frontend = FrontendType::Scatha;
     bool genDebugInfo = false;
     bool continueCompilation = true;
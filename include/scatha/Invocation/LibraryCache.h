@@ -0,0 +1,64 @@
+#ifndef SCATHA_INVOCATION_LIBRARYCACHE_H_
+#define SCATHA_INVOCATION_LIBRARYCACHE_H_
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <scatha/Common/Base.h>
+#include <scatha/Sema/Serialize.h>
+
+namespace scatha {
+
+/// Contents of a native library file. Files that are not present in the
+/// library are null or empty optionals
+struct LibraryFiles {
+    /// Symbol table in binary format
+    std::shared_ptr<std::vector<unsigned char> const> binarySymbolTable;
+
+    /// Decoded index of `binarySymbolTable`. Null if the library has no binary
+    /// symbol table or if it is malformed
+    std::shared_ptr<sema::LazySymbolTable::Index const> symbolTableIndex;
+
+    /// Symbol table in JSON format of libraries built before the binary format
+    std::optional<std::string> symbolTable;
+
+    /// Object code in binary IR format
+    std::shared_ptr<std::vector<unsigned char> const> objectCode;
+
+    /// Object code in textual IR format of libraries built before the binary
+    /// format
+    std::optional<std::string> textObjectCode;
+};
+
+/// Process wide cache of the contents of native libraries. Semantic analysis
+/// and IR generation read imported libraries through this cache. It is
+/// disabled by default, so every compilation reads libraries from disk. When
+/// enabled, libraries are only read again when their file has changed, which
+/// makes repeated compilations in one process skip reading and unpacking the
+/// libraries and decoding the symbol table index. The cached data is immutable
+/// and compilations share it without copying. Each compilation declares the
+/// symbols and decodes the function bodies it uses
+class SCATHA_API LibraryCache {
+public:
+    /// Enables or disables the cache. Disabling the cache also clears it
+    static void setEnabled(bool enabled);
+
+    /// \Returns `true` if the cache is enabled
+    static bool isEnabled();
+
+    /// Removes all cached libraries
+    static void clear();
+
+    /// \Returns the contents of the library at \p path or null if it cannot be
+    /// opened. If the cache is enabled and holds the library and the file has
+    /// not been modified since, the cached contents are returned
+    static std::shared_ptr<LibraryFiles const> load(
+        std::filesystem::path const& path);
+};
+
+} // namespace scatha
+
+#endif // SCATHA_INVOCATION_LIBRARYCACHE_H_
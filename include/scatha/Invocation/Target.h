@@ -24,9 +24,9 @@ class SCATHA_API Target {
 public:
     /// Temporary type until we have a better static library representation
     struct StaticLib {
-        /// Serialized symbol table
+        /// Serialized symbol table in binary representation
         std::string symbolTable;
-        /// Serialized object code in IR representation
+        /// Serialized object code in binary IR representation
         std::string objectCode;
     };
 
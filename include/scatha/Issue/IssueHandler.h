@@ -40,9 +40,21 @@ public:
         push(std::make_unique<T>(std::forward<Args>(args)...));
     }
 
+    /// Moves all issues of \p other to the end of this issue handler
+    void append(IssueHandler&& other) {
+        for (auto& issue: other._issues) {
+            _issues.push_back(std::move(issue));
+        }
+        other._issues.clear();
+    }
+
     /// Erase all issues
     void clear() { _issues.clear(); }
 
+    /// Stably sorts the issues from index \p begin on by their source
+    /// locations. Issues of different source files are ordered by file index
+    void sortBySourceLocation(size_t begin = 0);
+
     /// Begin iterator
     auto begin() const { return issueView().begin(); }
 
@@ -2,6 +2,7 @@
 #define SCATHA_MIR_CONTEXT_H_
 
 #include <memory>
+#include <mutex>
 
 #include <utl/hashtable.hpp>
 
@@ -10,7 +11,9 @@
 
 namespace scatha::mir {
 
-/// Basically a constant pool for the MIR module
+/// Basically a constant pool for the MIR module.
+/// Constants can be requested concurrently, so functions of the same module
+/// can be compiled in parallel
 class SCATHA_API Context {
 public:
     Context();
@@ -31,6 +34,7 @@ public:
 private:
     utl::hashmap<std::pair<uint64_t, size_t>, std::unique_ptr<Constant>>
         constants;
+    std::unique_ptr<std::mutex> constantMutex;
     std::unique_ptr<UndefValue> _undef;
 };
 
@@ -50,6 +50,8 @@ SC_MIR_INSTCLASS_DEF(UnaryArithmeticInst, UnaryInstruction, Concrete)
 SC_MIR_INSTCLASS_DEF(ArithmeticInst,      Instruction,      Abstract)
 SC_MIR_INSTCLASS_DEF(ValueArithmeticInst, ArithmeticInst,   Concrete)
 SC_MIR_INSTCLASS_DEF(LoadArithmeticInst,  ArithmeticInst,   Concrete)
+SC_MIR_INSTCLASS_DEF(VectorArithmeticInst, ArithmeticInst, Concrete)
+SC_MIR_INSTCLASS_DEF(VectorCompareInst,   Instruction,      Concrete)
 SC_MIR_INSTCLASS_DEF(ConversionInst,      UnaryInstruction, Concrete)
 SC_MIR_INSTCLASS_DEF(TerminatorInst,      Instruction,      Abstract)
 SC_MIR_INSTCLASS_DEF(JumpBase,            TerminatorInst,   Abstract)
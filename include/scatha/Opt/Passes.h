@@ -9,7 +9,8 @@ namespace scatha::opt {
 
 /// # Module passes
 
-/// Global optimization pass that is equal to `inline, globaldce, splitreturns`
+/// Global optimization pass that is equal to
+/// `inline, globaldce, loopvectorize, splitreturns`
 /// \param FunctionPass is ignored
 SCATHA_API bool optimize(ir::Context& ctx, ir::Module& mod,
                          ir::FunctionPass const& = {},
@@ -106,6 +107,11 @@ SCATHA_API bool loopSchedule(ir::Context& context, ir::Function& function,
 /// Unrolls loops with constant trip count
 SCATHA_API bool loopUnroll(ir::Context& context, ir::Function& function);
 
+/// Widens counted single block loops with unit stride array accesses to vector
+/// instructions followed by a scalar epilogue. Loops whose element type has no
+/// vector type are interleaved instead
+SCATHA_API bool loopVectorize(ir::Context& context, ir::Function& function);
+
 } // namespace scatha::opt
 
 #endif // SCATHA_OPT_PASSES_H_
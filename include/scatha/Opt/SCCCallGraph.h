@@ -204,10 +204,20 @@ public:
     /// e.g., devirtualized calls
     RecomputeCalleesResult recomputeCallees(FunctionNode& node);
 
+    /// \Returns `true` if the function of \p node contains direct calls that
+    /// are not represented in the call graph, i.e., if `recomputeCallees()`
+    /// would add call edges. This does not modify the graph
+    bool hasNewCallees(FunctionNode const& node) const;
+
     /// Checks if the call graph still correctly represents the structure of the
     /// module and traps if errors are found
     void validate() const;
 
+    /// Enables or disables the checks by `validate()` after every modification.
+    /// The checks inspect every function of the module, so they must be
+    /// disabled while other threads modify functions
+    void setValidateOnModify(bool value) { validateOnModify = value; }
+
     /// Updates the function of the node
     /// It's neceessary to have this cumbersome interface because the function
     /// nodes are hashed via their function pointers, so we extract the node and
@@ -239,6 +249,9 @@ private:
 
     /// List of SCCs
     std::vector<std::unique_ptr<SCCNode>> _sccs;
+
+    /// See `setValidateOnModify()`
+    bool validateOnModify = true;
 };
 
 /// Writes graphviz code representing \p graph to \p ostream
@@ -4,9 +4,11 @@
 #define SCATHA_AST_TOKEN_H_
 
 #include <string>
+#include <string_view>
 
 #include <scatha/Common/APMathFwd.h>
 #include <scatha/Common/Base.h>
+#include <scatha/Common/InternedString.h>
 #include <scatha/Common/SourceLocation.h>
 
 namespace scatha::parser {
@@ -40,22 +42,48 @@ bool isID(TokenKind kind);
 /// a name in certain contexts like `move`
 bool isExtendedID(TokenKind kind);
 
-///
-///
-///
+/// A lexical token. The text of a token is a view into the source text it was
+/// lexed from, so tokens must not outlive their source text. Only string and
+/// char literals that contain escape sequences store their decoded text
+/// themselves. Identifiers and keywords are interned and refer to their
+/// interned text
 struct SCATHA_API Token {
     ///
     Token() = default;
 
-    ///
-    explicit Token(std::string id, TokenKind kind, SourceRange sourceRange):
-        _id(std::move(id)), _kind(kind), _sourceRange(sourceRange) {}
+    /// Constructs a token that refers to the text \p id
+    explicit Token(std::string_view id, TokenKind kind,
+                   SourceRange sourceRange):
+        _id(id), _kind(kind), _sourceRange(sourceRange) {}
+
+    /// Constructs a token that refers to the interned text \p text
+    explicit Token(InternedString text, TokenKind kind,
+                   SourceRange sourceRange):
+        _id(text.str()),
+        _interned(text),
+        _kind(kind),
+        _sourceRange(sourceRange) {}
+
+    /// Constructs a token that owns its text \p id
+    static Token MakeOwning(std::string id, TokenKind kind,
+                            SourceRange sourceRange) {
+        Token token({}, kind, sourceRange);
+        token._storage = std::move(id);
+        token._owning = true;
+        return token;
+    }
 
     ///
-    bool empty() const { return _id.empty(); }
+    bool empty() const { return id().empty(); }
 
     ///
-    std::string const& id() const { return _id; }
+    std::string_view id() const { return _owning ? _storage : _id; }
+
+    /// \Returns the interned text of this token. For tokens that are not
+    /// constructed from interned text the text is interned on demand
+    InternedString interned() const {
+        return _interned.empty() ? InternedString(id()) : _interned;
+    }
 
     ///
     TokenKind kind() const { return _kind; }
@@ -79,11 +107,17 @@ struct SCATHA_API Token {
     APFloat toFloat(APFloatPrec precision) const;
 
     ///
-    bool operator==(Token const& rhs) const = default;
+    bool operator==(Token const& rhs) const {
+        return id() == rhs.id() && kind() == rhs.kind() &&
+               sourceRange() == rhs.sourceRange();
+    }
 
 private:
-    std::string _id;
-    TokenKind _kind;
+    std::string_view _id;
+    InternedString _interned;
+    std::string _storage;
+    bool _owning = false;
+    TokenKind _kind{};
     SourceRange _sourceRange;
 };
 
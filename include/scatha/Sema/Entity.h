@@ -3,7 +3,9 @@
 
 #include <array>
 #include <concepts>
+#include <functional>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 #include <string_view>
@@ -16,6 +18,7 @@
 
 #include <scatha/AST/Fwd.h>
 #include <scatha/Common/Base.h>
+#include <scatha/Common/InternedString.h>
 #include <scatha/Common/Ranges.h>
 #include <scatha/Common/SourceLocation.h>
 #include <scatha/Common/UniquePtr.h>
@@ -77,10 +80,13 @@ namespace scatha::sema {
 class SCATHA_API Entity {
 public:
     /// The name of this entity
-    std::string_view name() const { return _name; }
+    std::string_view name() const { return _name.str(); }
+
+    /// The interned name of this entity
+    InternedString internedName() const { return _name; }
 
     /// Sets the primary name of this entity to \p name
-    void setName(std::string name) { _name = std::move(name); }
+    void setName(std::string_view name) { _name = InternedString(name); }
 
     /// \Returns `true` if this entity is unnamed
     bool isAnonymous() const { return name().empty(); }
@@ -181,7 +187,7 @@ private:
     bool _isVisible = true;
     AccessControl accessCtrl = InvalidAccessControl;
     Scope* _parent = nullptr;
-    std::string _name;
+    InternedString _name;
     utl::small_ptr_vector<Alias*> _aliases;
     ast::ASTNode* _astNode = nullptr;
 };
@@ -389,6 +395,14 @@ public:
     utl::small_ptr_vector<Entity const*> findEntities(
         std::string_view name, bool findHiddenEntities = false) const;
 
+    /// \overload
+    utl::small_ptr_vector<Entity*> findEntities(
+        InternedString name, bool findHiddenEntities = false);
+
+    /// \overload
+    utl::small_ptr_vector<Entity const*> findEntities(
+        InternedString name, bool findHiddenEntities = false) const;
+
     /// Find the property \p prop in this scope
     Property* findProperty(PropertyKind prop) {
         return const_cast<Property*>(std::as_const(*this).findProperty(prop));
@@ -437,6 +451,11 @@ public:
     /// because scopes don't own their children.
     void removeChild(Entity* entity);
 
+    /// Moves the entities in \p added behind all other entities of this scope
+    /// and orders them by name. Used by the symbol table to make the order
+    /// independent of the order in which concurrent threads added them
+    void canonicalizeOrder(utl::hashset<Entity const*> const& added);
+
 protected:
     explicit Scope(EntityType entityType, ScopeKind, std::string name,
                    Scope* parent, ast::ASTNode* astNode = nullptr);
@@ -447,11 +466,15 @@ private:
 
     template <typename E, typename S>
     static utl::small_ptr_vector<E*> findEntitiesImpl(S* self,
-                                                      std::string_view name,
+                                                      InternedString name,
                                                       bool findHidden);
 
+    /// Types are added to the scope of their element or pointee type while
+    /// other threads look up names in that scope
+    mutable std::shared_mutex _mutex;
     utl::hashset<Scope*> _children;
-    utl::hashmap<std::string, utl::small_ptr_vector<Entity*>> _names;
+    /// Keyed by interned names, so lookups hash and compare pointers
+    utl::hashmap<InternedString, utl::small_ptr_vector<Entity*>> _names;
     utl::hashmap<PropertyKind, Property*> _properties;
     ScopeKind _kind;
 };
@@ -514,8 +537,34 @@ public:
     /// \Returns the resolved location of the library
     std::filesystem::path const& path() const { return _path; }
 
+    /// Callback that declares the symbols of this library on demand. It is
+    /// invoked with a name when that name is looked up and with `std::nullopt`
+    /// to declare all symbols. It must do nothing for symbols that have already
+    /// been declared
+    using SymbolLoader = std::function<void(std::optional<InternedString>)>;
+
+    /// Sets the callback that declares the symbols of this library
+    void setSymbolLoader(SymbolLoader loader) { _loader = std::move(loader); }
+
+    /// Declares the symbols named \p name if they have not been declared yet.
+    /// This is called by name lookup, so library symbols are only declared
+    /// when they are first referenced
+    void loadSymbols(InternedString name) const {
+        if (_loader) {
+            _loader(name);
+        }
+    }
+
+    /// Declares all symbols of this library that have not been declared yet
+    void loadAllSymbols() const {
+        if (_loader) {
+            _loader(std::nullopt);
+        }
+    }
+
 private:
     std::filesystem::path _path;
+    SymbolLoader _loader;
 };
 
 /// Represents an imported foreign library. Does not contain any child symbols
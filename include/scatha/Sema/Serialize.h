@@ -2,8 +2,11 @@
 #define SCATHA_SEMA_SERIALIZE_H_
 
 #include <iosfwd>
+#include <memory>
+#include <vector>
 
 #include <scatha/Common/Base.h>
+#include <scatha/Common/InternedString.h>
 #include <scatha/Sema/Fwd.h>
 
 namespace scatha::sema {
@@ -19,6 +22,69 @@ bool SCATHA_API deserialize(SymbolTable& sym, std::istream& istream);
 /// \overload
 bool SCATHA_API deserialize(SymbolTable& sym, std::string_view text);
 
+/// Writes public declarations in the global scope in \p sym in binary format
+/// to \p ostream. The top level symbols are indexed by name so they can be
+/// loaded individually by `LazySymbolTable`
+void SCATHA_API serializeBinary(SymbolTable const& sym, std::ostream& ostream);
+
+/// Symbol table in the binary format written by `serializeBinary()`. Only the
+/// name index is read up front. Symbols are declared when they are first
+/// loaded. All `load` functions declare to the current scope of the symbol
+/// table and must be invoked with the same scope current
+class SCATHA_API LazySymbolTable {
+public:
+    /// Decoded header, strings and entry offsets of a binary symbol table. The
+    /// index is immutable, so tables of different compilations can be opened
+    /// from the same index
+    struct Index;
+
+    /// Decodes the index of \p data.
+    /// \Returns null if \p data is not a symbol table of the current format
+    /// version
+    static std::shared_ptr<Index const> ReadIndex(
+        std::shared_ptr<std::vector<unsigned char> const> data);
+
+    /// Opens a symbol table from \p index.
+    /// \Returns null if \p index is null
+    static std::unique_ptr<LazySymbolTable> FromIndex(
+        std::shared_ptr<Index const> index);
+
+    /// Reads the header and the name index of \p data.
+    /// \Returns null if \p data is not a symbol table of the current format
+    /// version
+    static std::unique_ptr<LazySymbolTable> Open(
+        std::vector<unsigned char> data);
+
+    LazySymbolTable(LazySymbolTable const&) = delete;
+    LazySymbolTable& operator=(LazySymbolTable const&) = delete;
+    ~LazySymbolTable();
+
+    /// Imports the libraries the symbols depend on. If the current scope of
+    /// \p sym is a library the imported libraries become its dependencies
+    void loadDependencies(SymbolTable& sym);
+
+    /// \Returns `true` if symbols named \p name exist that have not been
+    /// loaded yet. This function is lock free and may be called concurrently
+    /// with any other function
+    bool isPending(InternedString name) const;
+
+    /// Declares all symbols named \p name and the symbols they refer to.
+    /// Symbols that have already been loaded are skipped.
+    /// \Returns `false` if the data is malformed
+    bool load(SymbolTable& sym, InternedString name);
+
+    /// Declares all symbols that have not been loaded yet
+    /// \Returns `false` if the data is malformed
+    bool loadAll(SymbolTable& sym);
+
+    struct Impl;
+
+private:
+    explicit LazySymbolTable(std::unique_ptr<Impl> impl);
+
+    std::unique_ptr<Impl> impl;
+};
+
 } // namespace scatha::sema
 
 #endif // SCATHA_SEMA_SERIALIZE_H_
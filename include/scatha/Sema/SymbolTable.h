@@ -14,6 +14,7 @@
 #include <scatha/Common/Base.h>
 #include <scatha/Common/Expected.h>
 #include <scatha/Common/FFI.h>
+#include <scatha/Common/InternedString.h>
 #include <scatha/Common/SourceLocation.h>
 #include <scatha/Sema/Fwd.h>
 #include <scatha/Sema/QualType.h>
@@ -31,6 +32,27 @@ public:
     /// This is public so static functions in the implementation can name it
     struct Impl;
 
+    /// State of a thread with a `LocalState`, public for the same reason
+    struct LocalStateData;
+
+    /// While an instance is alive, the calling thread has its own current
+    /// scope, issue handler and temporary counter in the symbol table. Threads
+    /// that analyze function bodies concurrently each create one. Creation of
+    /// entities and types is serialized by the symbol table, lookups of
+    /// existing types are not.
+    /// Local states must only exist between `beginConcurrentAnalysis()` and
+    /// `endConcurrentAnalysis()`
+    class SCATHA_API LocalState {
+    public:
+        LocalState(SymbolTable& sym, IssueHandler& issueHandler);
+        LocalState(LocalState const&) = delete;
+        LocalState& operator=(LocalState const&) = delete;
+        ~LocalState();
+
+    private:
+        std::unique_ptr<LocalStateData> data;
+    };
+
     SymbolTable();
     SymbolTable(SymbolTable&&) noexcept;
     SymbolTable& operator=(SymbolTable&&) noexcept;
@@ -167,7 +189,9 @@ public:
                           AccessControl accessControl,
                           ast::ASTNode* astNode = nullptr);
 
-    /// Creates a new unique temporary object of type \p type
+    /// Creates a new temporary object of type \p type. Temporaries created by
+    /// a thread with a `LocalState` are numbered by that local state, so their
+    /// IDs are unique within one function body and don't depend on scheduling
     Temporary* temporary(ast::ASTNode* astNode, QualType type);
 
     /// Declares an anonymous scope within the current scope.
@@ -320,8 +344,13 @@ public:
     utl::small_vector<Entity*> unqualifiedLookup(
         std::string_view name, bool findHiddenEntities = false);
 
+    /// \overload for interned names
+    utl::small_vector<Entity*> unqualifiedLookup(
+        InternedString name, bool findHiddenEntities = false);
+
     /// Set the issue handler for this symbol table.
     /// Setting the issue handler is necessary for making declarations.
+    /// Threads with a `LocalState` use their own issue handler instead
     void setIssueHandler(IssueHandler& issueHandler);
 
     ///
@@ -365,6 +394,16 @@ public:
     FloatType const* Double() const { return F64(); }
     /// @}
 
+    /// Must be called before threads with a `LocalState` start to analyze
+    void beginConcurrentAnalysis();
+
+    /// Must be called after all threads with a `LocalState` have finished.
+    /// These threads add derived types and lazily loaded library entities to
+    /// shared scopes in scheduling order. This restores a deterministic order:
+    /// Entities added to a scope concurrently are ordered by name after all
+    /// entities that existed before
+    void endConcurrentAnalysis();
+
     /// Used by instantiation. This function traverses all instantiated types
     /// (only array types at this point) which may not have their lifetime
     /// analyzed, because they have been instantiated before their element type
@@ -219,4 +219,38 @@ SVM_BUILTIN_DEF(exit,    None,  { S64() }, Void())
 /// Quick and dirty randon number generation.
 SVM_BUILTIN_DEF(rand_i64, None,  {  }, S64())
 
+/// ## Memory comparison, search and hashing
+/// These functions are vectorized by the VM where the host supports it.
+/// They are declared last so the indices of the older builtins, which compiled
+/// programs refer to, stay the same
+
+/// Signature: `(lhs: *[byte], rhs: *[byte]) -> int`
+/// Lexicographically compares \p lhs and \p rhs
+/// \Returns `-1` if \p lhs is less than \p rhs, `0` if both are equal and `1`
+/// if \p lhs is greater than \p rhs
+SVM_BUILTIN_DEF(memcmp, Pure, {
+    pointer(QualType::Const(arrayType(Byte()))),
+    pointer(QualType::Const(arrayType(Byte())))
+}, S64())
+
+/// Signature: `(data: *[byte], value: byte) -> int`
+/// \Returns the index of the first occurence of \p value in \p data or `-1`
+SVM_BUILTIN_DEF(memchr, Pure, {
+    pointer(QualType::Const(arrayType(Byte()))),
+    Byte()
+}, S64())
+
+/// Signature: `(data: *[byte], needle: *[byte]) -> int`
+/// \Returns the index of the first occurence of \p needle in \p data or `-1`
+SVM_BUILTIN_DEF(memfind, Pure, {
+    pointer(QualType::Const(arrayType(Byte()))),
+    pointer(QualType::Const(arrayType(Byte())))
+}, S64())
+
+/// Signature: `(data: *[byte]) -> u64`
+/// \Returns a fast non-cryptographic hash of the bytes in \p data
+SVM_BUILTIN_DEF(hash, Pure, {
+    pointer(QualType::Const(arrayType(Byte())))
+}, U64())
+
 #undef SVM_BUILTIN_DEF
@@ -517,4 +517,23 @@ SVM_INSTRUCTION_DEF(f64tou16,  R) //  (u8 regIdx)
 SVM_INSTRUCTION_DEF(f64tou32,  R) //  (u8 regIdx)
 SVM_INSTRUCTION_DEF(f64tou64,  R) //  (u8 regIdx)
 
+/// ## Packed vector operations
+/// The instructions operate on one register holding 8 bytes of lanes. Wider
+/// vectors are held in several registers and use one instruction per register.
+/// Lane types and operations are encoded as `VectorLane` and `VectorOperation`
+/// (see "OpCode.h")
+
+/// Lane wise `a = a op b`
+/// Comparisons set all bits of a lane if the comparison holds and clear them
+/// otherwise
+SVM_INSTRUCTION_DEF(vop,    Other) // (u8 op, u8 lane, u8 a, u8 b)
+
+/// Broadcasts the low lane of register `src` into all lanes of `dest`
+SVM_INSTRUCTION_DEF(vsplat, Other) // (u8 lane, u8 dest, u8 src)
+
+/// 8 byte moves that do not check alignment. Vectors only need to be aligned
+/// to their lane type, so we can't use `mov64RM` and `mov64MR`
+SVM_INSTRUCTION_DEF(vmovRM, RM)   // (u8 destRegIdx,  MEMORY_POINTER)
+SVM_INSTRUCTION_DEF(vmovMR, MR)   // (MEMORY_POINTER, u8 sourceRegIdx)
+
 #undef SVM_INSTRUCTION_DEF
@@ -94,6 +94,10 @@ inline constexpr size_t codeSize(OpCode code) {
             return sizeof(OpCode) + 1 + 2;
         case OpCode::lincsp:
             return sizeof(OpCode) + 1 + 2;
+        case OpCode::vop:
+            return sizeof(OpCode) + 2 + 2;
+        case OpCode::vsplat:
+            return sizeof(OpCode) + 1 + 2;
         default:
             unreachable();
         }
@@ -121,6 +125,58 @@ inline constexpr size_t codeSize(OpCode code) {
     unreachable();
 }
 
+/// Lane types of the packed vector instructions. Signedness only matters for
+/// `Div`, `Min`, `Max` and the comparisons
+enum class VectorLane : u8 { S8, S16, S32, S64, U8, U16, U32, U64, F32, F64 };
+
+/// \Returns the size of a lane of type \p lane in bytes
+inline constexpr size_t laneSize(VectorLane lane) {
+    using enum VectorLane;
+    switch (lane) {
+    case S8:
+    case U8:
+        return 1;
+    case S16:
+    case U16:
+        return 2;
+    case S32:
+    case U32:
+    case F32:
+        return 4;
+    case S64:
+    case U64:
+    case F64:
+        return 8;
+    }
+    unreachable();
+}
+
+/// Lane wise operations performed by the `vop` instruction
+enum class VectorOperation : u8 {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Min,
+    Max,
+    CmpEq,
+    CmpLt,
+    CmpGt,
+    And,
+    Or,
+    XOr,
+    /// Declared last to keep the encoding of the operations above
+    CmpNe,
+    CmpLe,
+    CmpGe,
+};
+
+///
+std::string_view toString(VectorLane);
+
+///
+std::string_view toString(VectorOperation);
+
 } // namespace svm
 
 #endif // SVM_OPCODE_H_
@@ -20,9 +20,16 @@ struct ExecutionFrame {
     VirtualPointer stackPtr{};
 };
 
-///
+/// Execution statistics of a virtual machine
 struct VMStats {
+    /// Number of instructions executed with `stepExecution()`
     size_t executedInstructions = 0;
+
+    /// Number of bytes currently allocated on the heap
+    size_t heapBytes = 0;
+
+    /// Highest number of bytes allocated on the heap at the same time
+    size_t peakHeapBytes = 0;
 };
 
 } // namespace svm
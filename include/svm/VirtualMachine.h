@@ -79,6 +79,13 @@ public:
     /// Reset the VM to initial state
     void reset();
 
+    /// \Returns the execution statistics of this VM
+    VMStats stats() const;
+
+    /// Resets the executed instruction count and sets the peak heap bytes to
+    /// the currently allocated heap bytes
+    void resetStats();
+
     /// \Returns the instruction pointer offset from the beginning of the binary
     size_t instructionPointerOffset() const;
 
@@ -114,6 +114,18 @@ public:
     ///
     void resizeStaticSlot(size_t size);
 
+    /// \Returns the number of bytes currently allocated with `allocate()`
+    size_t allocatedBytes() const { return numAllocatedBytes; }
+
+    /// \Returns the highest number of bytes allocated at the same time since
+    /// construction or the last call to `resetPeakAllocatedBytes()`
+    size_t peakAllocatedBytes() const { return numPeakAllocatedBytes; }
+
+    /// Sets the peak allocated bytes to the currently allocated bytes
+    void resetPeakAllocatedBytes() {
+        numPeakAllocatedBytes = numAllocatedBytes;
+    }
+
     /// \Returns the number of bytes at which the pointer \p ptr is
     /// dereferencable. If the pointer is not valid a negative number is
     /// returned
@@ -154,6 +166,8 @@ private:
     std::vector<Slot> slots;
     std::vector<PoolAllocator> pools;
     std::vector<size_t> freeSlots;
+    size_t numAllocatedBytes = 0;
+    size_t numPeakAllocatedBytes = 0;
 };
 
 } // namespace svm
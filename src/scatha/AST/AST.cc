@@ -1,5 +1,8 @@
 #include "AST/AST.h"
 
+#include <cstddef>
+#include <new>
+
 #include <range/v3/algorithm.hpp>
 #include <utl/utility.hpp>
 
@@ -10,6 +13,66 @@
 using namespace scatha;
 using namespace ast;
 
+namespace {
+
+/// Precedes every allocation made by `allocateNodeMemory()`
+struct alignas(std::max_align_t) NodeMemoryHeader {
+    /// The arena the memory was allocated in or null for heap memory
+    NodeArena* arena;
+};
+
+} // namespace
+
+void* NodeArena::allocate(size_t size, size_t align) {
+    numLive.fetch_add(1, std::memory_order_relaxed);
+    return alloc.allocate(size, align);
+}
+
+void NodeArena::deallocate() {
+    SC_ASSERT(liveAllocations() > 0, "Deallocation without allocation");
+    numLive.fetch_sub(1, std::memory_order_relaxed);
+}
+
+static thread_local NodeArena* currentArena = nullptr;
+
+ArenaScope::ArenaScope(NodeArena& arena): prev(currentArena) {
+    currentArena = &arena;
+}
+
+ArenaScope::~ArenaScope() { currentArena = prev; }
+
+void* ast::internal::allocateNodeMemory(size_t size) {
+    size_t const totalSize = sizeof(NodeMemoryHeader) + size;
+    void* memory = currentArena ?
+                       currentArena->allocate(totalSize,
+                                              alignof(NodeMemoryHeader)) :
+                       ::operator new(totalSize);
+    auto* header = ::new (memory) NodeMemoryHeader{ currentArena };
+    return header + 1;
+}
+
+void ast::internal::deallocateNodeMemory(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<NodeMemoryHeader*>(ptr) - 1;
+    if (header->arena) {
+        header->arena->deallocate();
+    }
+    else {
+        ::operator delete(header);
+    }
+}
+
+TranslationUnit::~TranslationUnit() {
+    clearChildren();
+    for (auto& arena: arenas) {
+        SC_ASSERT(arena->liveAllocations() == 0,
+                  "Nodes extracted from the AST must be destroyed before "
+                  "the translation unit");
+    }
+}
+
 void ast::do_delete(ASTNode& node) {
     visit(node, [](auto& derived) { delete &derived; });
 }
@@ -1,6 +1,7 @@
 #ifndef SCATHA_AST_AST_H_
 #define SCATHA_AST_AST_H_
 
+#include <atomic>
 #include <concepts>
 #include <iosfwd>
 #include <memory>
@@ -8,6 +9,7 @@
 #include <string>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <range/v3/view.hpp>
 #include <utl/utility.hpp>
@@ -15,8 +17,10 @@
 
 #include "AST/Fwd.h"
 #include "AST/SpecifierList.h"
+#include "Common/Allocator.h"
 #include "Common/APFloat.h"
 #include "Common/APInt.h"
+#include "Common/InternedString.h"
 #include "Common/SourceLocation.h"
 #include "Common/UniquePtr.h"
 #include "Sema/CleanupStack.h"
@@ -139,8 +143,79 @@
 
 namespace scatha::ast {
 
+/// Memory for the AST nodes of one source file. The arena counts the
+/// allocations that have not been deallocated yet, so the owner can verify
+/// that no node outlives it
+class SCATHA_API NodeArena {
+public:
+    /// Allocates \p size bytes aligned to \p align
+    void* allocate(size_t size, size_t align);
+
+    /// Marks one allocation as dead. The memory is freed with the arena
+    void deallocate();
+
+    /// \Returns the number of allocations that are still alive
+    size_t liveAllocations() const {
+        return numLive.load(std::memory_order_relaxed);
+    }
+
+private:
+    MonotonicBufferAllocator alloc;
+    std::atomic<size_t> numLive = 0;
+};
+
+/// While an `ArenaScope` is alive, all AST nodes and child arrays that are
+/// allocated on the calling thread are placed in the arena passed to the
+/// constructor. Nodes allocated outside of any scope use the heap.
+/// Destroying arena allocated nodes runs their destructors but does not free
+/// any memory, so the arena must outlive all nodes allocated in it. The parser
+/// hands its arenas to the `TranslationUnit`, which releases them after its
+/// children have been destroyed.
+class SCATHA_API ArenaScope {
+public:
+    explicit ArenaScope(NodeArena& arena);
+
+    ArenaScope(ArenaScope const&) = delete;
+    ArenaScope& operator=(ArenaScope const&) = delete;
+
+    ~ArenaScope();
+
+private:
+    NodeArena* prev;
+};
+
 namespace internal {
 
+/// Allocates \p size bytes in the current arena or on the heap. The memory is
+/// preceded by a header that records where it was allocated
+SCATHA_API void* allocateNodeMemory(size_t size);
+
+/// Deallocates memory returned by `allocateNodeMemory()`. This is a no-op for
+/// arena memory
+SCATHA_API void deallocateNodeMemory(void* ptr);
+
+/// Stateless allocator for the child arrays of AST nodes
+template <typename T>
+struct ChildAllocator {
+    using value_type = T;
+
+    ChildAllocator() = default;
+
+    template <typename U>
+    ChildAllocator(ChildAllocator<U> const&) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(allocateNodeMemory(count * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t) { deallocateNodeMemory(ptr); }
+
+    template <typename U>
+    bool operator==(ChildAllocator<U> const&) const {
+        return true;
+    }
+};
+
 class Decoratable {
 public:
     bool isDecorated() const { return decorated; }
@@ -181,6 +256,16 @@ public:
     ASTNode(ASTNode const&) = delete;
     ASTNode& operator=(ASTNode const&) = delete;
 
+    /// Nodes are allocated in the current `ArenaScope` if there is one
+    static void* operator new(size_t size) {
+        return internal::allocateNodeMemory(size);
+    }
+
+    /// \overload
+    static void operator delete(void* ptr) {
+        internal::deallocateNodeMemory(ptr);
+    }
+
     /// Runtime type of this node
     NodeType nodeType() const { return _type; }
 
@@ -261,6 +346,9 @@ public:
     }
 
     /// Extract the the child at index \p index
+    /// \Warning Nodes created by the parser live in the arenas of the
+    /// translation unit. Extracted nodes must be reinserted or destroyed before
+    /// the translation unit is destroyed
     template <typename AST = ASTNode>
     UniquePtr<AST> extractChild(size_t index) {
         auto* child = _children[index].release();
@@ -294,6 +382,7 @@ public:
     }
 
     /// Extract this node from its parent
+    /// \Warning The same restriction as for `extractChild()` applies
     UniquePtr<ASTNode> extractFromParent();
 
     /// Replace the child \p old with new node \p repl
@@ -335,6 +424,9 @@ protected:
 
     void setSourceRange(SourceRange sourceRange) { _sourceRange = sourceRange; }
 
+    /// Destroys all children of this node
+    void clearChildren() { _children.clear(); }
+
 private:
     template <typename C>
     void addChildren(C&& child) {
@@ -361,7 +453,9 @@ private:
     NodeType _type;
     SourceRange _sourceRange;
     ASTNode* _parent = nullptr;
-    utl::small_vector<UniquePtr<ASTNode>> _children;
+    std::vector<UniquePtr<ASTNode>,
+                internal::ChildAllocator<UniquePtr<ASTNode>>>
+        _children;
 };
 
 /// \overload
@@ -491,16 +585,22 @@ private:
 /// Concrete node representing an identifier.
 class SCATHA_API Identifier: public Expression {
 public:
-    explicit Identifier(SourceRange sourceRange, std::string id):
+    explicit Identifier(SourceRange sourceRange, InternedString id):
         Expression(NodeType::Identifier, sourceRange), _value(id) {}
 
+    explicit Identifier(SourceRange sourceRange, std::string_view id):
+        Identifier(sourceRange, InternedString(id)) {}
+
     AST_DERIVED_COMMON(Identifier)
 
     /// Literal string value as declared in the source.
-    std::string const& value() const { return _value; }
+    std::string_view value() const { return _value.str(); }
+
+    /// Interned string value
+    InternedString interned() const { return _value; }
 
 private:
-    std::string _value;
+    InternedString _value;
 };
 
 /// Concrete node representing a literal.
@@ -1010,15 +1110,26 @@ public:
     TranslationUnit(UniquePtr<SourceFile> file):
         TranslationUnit(toSmallVector(std::move(file))) {}
 
-    TranslationUnit(utl::small_vector<UniquePtr<SourceFile>> files):
-        ASTNode(NodeType::TranslationUnit, SourceRange{}, std::move(files)) {
+    /// \p arenas are the arenas that the nodes of \p files are allocated in.
+    /// The translation unit owns them and releases them on destruction
+    TranslationUnit(utl::small_vector<UniquePtr<SourceFile>> files,
+                    utl::small_vector<std::unique_ptr<NodeArena>> arenas = {}):
+        ASTNode(NodeType::TranslationUnit, SourceRange{}, std::move(files)),
+        arenas(std::move(arenas)) {
         markDecorated();
     }
 
+    /// Destroys all nodes before releasing the arenas
+    /// \pre All nodes extracted from this tree must have been destroyed
+    ~TranslationUnit();
+
     AST_DERIVED_COMMON(TranslationUnit)
 
     /// List of source files in the translation unit.
     AST_RANGE_PROPERTY(0, SourceFile, sourceFile, SourceFile)
+
+private:
+    utl::small_vector<std::unique_ptr<NodeArena>> arenas;
 };
 
 /// Concrete node representing a source file
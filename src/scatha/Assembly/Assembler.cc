@@ -52,6 +52,7 @@ struct Assembler: AsmWriter {
     void dispatch(Instruction const& inst);
     void translate(MoveInst const&);
     void translate(CMoveInst const&);
+    void translate(VectorMoveInst const&);
     void translate(JumpInst const&);
     void translate(CallInst const&);
     void translate(CallExtInst const&);
@@ -64,6 +65,8 @@ struct Assembler: AsmWriter {
     void translate(SetInst const&);
     void translate(UnaryArithmeticInst const&);
     void translate(ArithmeticInst const&);
+    void translate(VectorArithmeticInst const&);
+    void translate(VectorCompareInst const&);
     void translate(TruncExtInst const&);
     void translate(ConvertInst const&);
 
@@ -195,6 +198,12 @@ void Assembler::translate(CMoveInst const& cmov) {
     dispatch(promote(cmov.source(), size));
 }
 
+void Assembler::translate(VectorMoveInst const& mov) {
+    put(mov.dest().is<RegisterIndex>() ? OpCode::vmovRM : OpCode::vmovMR);
+    dispatch(mov.dest());
+    dispatch(mov.source());
+}
+
 void Assembler::translate(JumpInst const& jmp) {
     OpCode opcode = mapJump(jmp.condition()).value();
     put(opcode);
@@ -304,6 +313,125 @@ void Assembler::translate(ArithmeticInst const& inst) {
     dispatch(inst.source());
 }
 
+static svm::VectorOperation mapVectorOperation(ArithmeticOperation op) {
+    using enum ArithmeticOperation;
+    using svm::VectorOperation;
+    switch (op) {
+    case Add:
+        [[fallthrough]];
+    case FAdd:
+        return VectorOperation::Add;
+    case Sub:
+        [[fallthrough]];
+    case FSub:
+        return VectorOperation::Sub;
+    case Mul:
+        [[fallthrough]];
+    case FMul:
+        return VectorOperation::Mul;
+    case SDiv:
+        [[fallthrough]];
+    case UDiv:
+        [[fallthrough]];
+    case FDiv:
+        return VectorOperation::Div;
+    case And:
+        return VectorOperation::And;
+    case Or:
+        return VectorOperation::Or;
+    case XOr:
+        return VectorOperation::XOr;
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
+static svm::VectorLane mapVectorLane(Type type, size_t width) {
+    using svm::VectorLane;
+    switch (type) {
+    case Type::Signed:
+        switch (width) {
+        case 1:
+            return VectorLane::S8;
+        case 2:
+            return VectorLane::S16;
+        case 4:
+            return VectorLane::S32;
+        case 8:
+            return VectorLane::S64;
+        default:
+            SC_UNREACHABLE();
+        }
+    case Type::Unsigned:
+        switch (width) {
+        case 1:
+            return VectorLane::U8;
+        case 2:
+            return VectorLane::U16;
+        case 4:
+            return VectorLane::U32;
+        case 8:
+            return VectorLane::U64;
+        default:
+            SC_UNREACHABLE();
+        }
+    case Type::Float:
+        switch (width) {
+        case 4:
+            return VectorLane::F32;
+        case 8:
+            return VectorLane::F64;
+        default:
+            SC_UNREACHABLE();
+        }
+    }
+    SC_UNREACHABLE();
+}
+
+void Assembler::translate(VectorArithmeticInst const& inst) {
+    put(OpCode::vop);
+    put<u8>(utl::to_underlying(mapVectorOperation(inst.operation())));
+    put<u8>(utl::to_underlying(
+        mapVectorLane(inst.laneType(), inst.laneWidth())));
+    translate(inst.dest());
+    translate(inst.source());
+}
+
+static svm::VectorOperation mapVectorCompare(CompareOperation op,
+                                             bool select) {
+    using enum CompareOperation;
+    using svm::VectorOperation;
+    if (select) {
+        return op == Less ? VectorOperation::Min : VectorOperation::Max;
+    }
+    switch (op) {
+    case Less:
+        return VectorOperation::CmpLt;
+    case LessEq:
+        return VectorOperation::CmpLe;
+    case Greater:
+        return VectorOperation::CmpGt;
+    case GreaterEq:
+        return VectorOperation::CmpGe;
+    case Eq:
+        return VectorOperation::CmpEq;
+    case NotEq:
+        return VectorOperation::CmpNe;
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
+void Assembler::translate(VectorCompareInst const& inst) {
+    put(OpCode::vop);
+    put<u8>(utl::to_underlying(
+        mapVectorCompare(inst.operation(), inst.select())));
+    put<u8>(utl::to_underlying(
+        mapVectorLane(inst.laneType(), inst.laneWidth())));
+    translate(inst.dest());
+    translate(inst.source());
+}
+
 void Assembler::translate(TruncExtInst const& inst) {
     auto const opcode = [&] {
         if (inst.type() == Type::Signed) {
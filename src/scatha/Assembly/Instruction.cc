@@ -39,6 +39,57 @@ void ArithmeticInst::verify() const {
     }
 }
 
+void VectorMoveInst::verify() const {
+    bool const load =
+        dest().is<RegisterIndex>() && source().is<MemoryAddress>();
+    bool const store =
+        dest().is<MemoryAddress>() && source().is<RegisterIndex>();
+    SC_ASSERT(load || store, "Invalid operands");
+}
+
+static void verifyLaneWidth(Type laneType, size_t laneWidth) {
+    if (laneType == Type::Float) {
+        SC_ASSERT(laneWidth == 4 || laneWidth == 8, "Invalid lane width");
+    }
+    else {
+        SC_ASSERT(laneWidth == 1 || laneWidth == 2 || laneWidth == 4 ||
+                      laneWidth == 8,
+                  "Invalid lane width");
+    }
+}
+
+void VectorArithmeticInst::verify() const {
+    using enum ArithmeticOperation;
+    switch (operation()) {
+    case Add:
+    case Sub:
+    case Mul:
+    case SDiv:
+    case UDiv:
+    case FAdd:
+    case FSub:
+    case FMul:
+    case FDiv:
+    case And:
+    case Or:
+    case XOr:
+        break;
+    default:
+        SC_ASSERT(false, "Operation has no vector form");
+    }
+    verifyLaneWidth(laneType(), laneWidth());
+}
+
+void VectorCompareInst::verify() const {
+    SC_ASSERT(operation() != CompareOperation::None, "Invalid comparison");
+    if (select()) {
+        SC_ASSERT(operation() == CompareOperation::Less ||
+                      operation() == CompareOperation::Greater,
+                  "Only minimum and maximum can select lanes");
+    }
+    verifyLaneWidth(laneType(), laneWidth());
+}
+
 static void verifyWidth(Type type, size_t bits) {
     switch (type) {
     case Type::Signed:
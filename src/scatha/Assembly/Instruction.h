@@ -42,6 +42,26 @@ private:
     size_t _numBytes;
 };
 
+/// Represents the `vmov` instructions, i.e. 8 byte moves between a register
+/// and memory that do not check alignment
+class VectorMoveInst: public InstructionBase {
+public:
+    explicit VectorMoveInst(Value dest, Value source):
+        _dest(dest), _src(source) {
+        verify();
+    }
+
+    Value dest() const { return _dest; }
+
+    Value source() const { return _src; }
+
+private:
+    SCTEST_API void verify() const;
+
+private:
+    Value _dest, _src;
+};
+
 /// Represents a `cmov` instruction.
 class CMoveInst: public InstructionBase {
 public:
@@ -278,6 +298,94 @@ private:
     size_t _width;
 };
 
+/// Represents the lane wise `vop` instruction on packed vectors
+class VectorArithmeticInst: public InstructionBase {
+public:
+    explicit VectorArithmeticInst(ArithmeticOperation op, Type laneType,
+                                  size_t laneWidth, RegisterIndex dest,
+                                  RegisterIndex source):
+        _op(op),
+        _laneType(laneType),
+        _laneWidth(utl::narrow_cast<u8>(laneWidth)),
+        _dest(dest),
+        _src(source) {
+        verify();
+    }
+
+    /// \Returns The arithmetic operation to perform.
+    ArithmeticOperation operation() const { return _op; }
+
+    /// \Returns The type of the lanes
+    Type laneType() const { return _laneType; }
+
+    /// \Returns The width of one lane in bytes
+    size_t laneWidth() const { return _laneWidth; }
+
+    /// \Returns The register holding the LHS operand and the result
+    RegisterIndex dest() const { return _dest; }
+
+    /// \Returns The register holding the RHS operand
+    RegisterIndex source() const { return _src; }
+
+private:
+    SCTEST_API void verify() const;
+
+private:
+    ArithmeticOperation _op;
+    Type _laneType;
+    u8 _laneWidth;
+    RegisterIndex _dest, _src;
+};
+
+/// Represents the comparing forms of the `vop` instruction. Lanes of `dest`
+/// where the comparison holds are set to all ones and the other lanes are
+/// cleared. If `select()` is true, the lanes of `dest` where the comparison
+/// holds are kept and the other lanes are taken from `source` instead, which
+/// computes the lane wise minimum for `Less` and the maximum for `Greater`.
+class VectorCompareInst: public InstructionBase {
+public:
+    explicit VectorCompareInst(CompareOperation op, Type laneType,
+                               size_t laneWidth, bool select,
+                               RegisterIndex dest, RegisterIndex source):
+        _op(op),
+        _laneType(laneType),
+        _laneWidth(utl::narrow_cast<u8>(laneWidth)),
+        _select(select),
+        _dest(dest),
+        _src(source) {
+        verify();
+    }
+
+    /// \Returns The comparison to perform
+    CompareOperation operation() const { return _op; }
+
+    /// \Returns The type of the lanes
+    Type laneType() const { return _laneType; }
+
+    /// \Returns The width of one lane in bytes
+    size_t laneWidth() const { return _laneWidth; }
+
+    /// \Returns `true` if this instruction selects lanes instead of computing
+    /// a mask
+    bool select() const { return _select; }
+
+    /// \Returns The register holding the LHS operand and the result
+    RegisterIndex dest() const { return _dest; }
+
+    /// \Returns The register holding the RHS operand
+    RegisterIndex source() const { return _src; }
+
+private:
+    SCTEST_API void verify() const;
+
+private:
+    CompareOperation _op;
+    Type _laneType;
+    u8 _laneWidth;
+    bool _select;
+    RegisterIndex _dest, _src;
+};
+
 /// Represents the `sext*`, `trunc*`, `fext` and `ftrunc`  instructions.
 class TruncExtInst: public InstructionBase {
 public:
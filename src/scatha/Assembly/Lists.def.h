@@ -14,6 +14,7 @@
 
 SC_ASM_INSTRUCTION_DEF(MoveInst)            SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(CMoveInst)           SC_ASM_INSTRUCTION_SEPARATOR
+SC_ASM_INSTRUCTION_DEF(VectorMoveInst)      SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(JumpInst)            SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(CallInst)            SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(CallExtInst)         SC_ASM_INSTRUCTION_SEPARATOR
@@ -26,6 +27,8 @@ SC_ASM_INSTRUCTION_DEF(TestInst)            SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(SetInst)             SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(UnaryArithmeticInst) SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(ArithmeticInst)      SC_ASM_INSTRUCTION_SEPARATOR
+SC_ASM_INSTRUCTION_DEF(VectorArithmeticInst) SC_ASM_INSTRUCTION_SEPARATOR
+SC_ASM_INSTRUCTION_DEF(VectorCompareInst)   SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(TruncExtInst)        SC_ASM_INSTRUCTION_SEPARATOR
 SC_ASM_INSTRUCTION_DEF(ConvertInst)
 
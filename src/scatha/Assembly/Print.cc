@@ -34,6 +34,29 @@ static std::string_view typeToChar(Type type) {
     SC_UNREACHABLE();
 }
 
+static std::string_view vectorCompareName(VectorCompareInst const& inst) {
+    using enum CompareOperation;
+    if (inst.select()) {
+        return inst.operation() == Less ? "min" : "max";
+    }
+    switch (inst.operation()) {
+    case Less:
+        return "cmpl";
+    case LessEq:
+        return "cmple";
+    case Greater:
+        return "cmpg";
+    case GreaterEq:
+        return "cmpge";
+    case Eq:
+        return "cmpe";
+    case NotEq:
+        return "cmpne";
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
 namespace {
 
 struct OStreamRestore {
@@ -96,6 +119,10 @@ struct PrintCtx {
             << mov.source();
     }
 
+    void printImpl(VectorMoveInst const& mov) {
+        str << instName("vmov") << " " << mov.dest() << ", " << mov.source();
+    }
+
     void printImpl(CMoveInst const& cmov) {
         str << instName(toCMoveInstName(cmov.condition()), 8 * cmov.numBytes())
             << " " << cmov.dest() << ", " << cmov.source();
@@ -110,6 +137,18 @@ struct PrintCtx {
             << inst.dest() << ", " << inst.source();
     }
 
+    void printImpl(VectorArithmeticInst const& inst) {
+        str << instName("v", inst.operation(), typeToChar(inst.laneType()),
+                        8 * inst.laneWidth())
+            << " " << inst.dest() << ", " << inst.source();
+    }
+
+    void printImpl(VectorCompareInst const& inst) {
+        str << instName("v", vectorCompareName(inst),
+                        typeToChar(inst.laneType()), 8 * inst.laneWidth())
+            << " " << inst.dest() << ", " << inst.source();
+    }
+
     void printImpl(JumpInst const& jmp) {
         str << instName(toJumpInstName(jmp.condition())) << " "
             << label(jmp.target());
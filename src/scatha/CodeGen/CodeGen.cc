@@ -1,11 +1,17 @@
 #include "CodeGen/CodeGen.h"
 
+#include <algorithm>
 #include <memory>
+#include <span>
+#include <vector>
 
-#include <range/v3/algorithm.hpp>
+#include <range/v3/range/conversion.hpp>
+#include <range/v3/view.hpp>
 
 #include "Assembly/AssemblyStream.h"
 #include "CodeGen/Passes.h"
+#include "Common/ThreadPool.h"
+#include "Common/TimeTrace.h"
 #include "MIR/CFG.h"
 #include "MIR/Context.h"
 #include "MIR/Module.h"
@@ -17,38 +23,128 @@ Asm::AssemblyStream cg::codegen(ir::Module const& irMod) {
     return codegen(irMod, *std::make_unique<NullLogger>());
 }
 
-static void forEach(mir::Context& ctx, mir::Module& mod, auto transform) {
-    ranges::for_each(mod, [&](auto& F) { transform(ctx, F); });
-}
+namespace {
 
-Asm::AssemblyStream cg::codegen(ir::Module const& irMod, cg::Logger& logger) {
-    mir::Context ctx;
-    auto mod = cg::lowerToMIR(ctx, irMod);
-    logger.log("Initial MIR module", mod);
+/// One step of the per-function MIR pipeline
+struct Stage {
+    /// Name of the stage in time traces
+    std::string_view name;
 
-    forEach(ctx, mod, cg::instSimplify);
-    logger.log("MIR module after simplification", mod);
+    /// Title of the module state after this stage
+    std::string_view logTitle;
 
-    forEach(ctx, mod, cg::commonSubexpressionElimination);
-    logger.log("MIR module after CSE", mod);
+    /// Transforms a single function
+    void (*transform)(mir::Context&, mir::Function&, CodegenOptions const&);
+};
 
-    forEach(ctx, mod, cg::deadCodeElim);
-    logger.log("MIR module after DCE", mod);
+} // namespace
 
-    /// We compute live sets just before we leave SSA form
-    forEach(ctx, mod, cg::computeLiveSets);
-    logger.log("MIR module after life set computation", mod);
+/// Adapts passes that take no options to the common stage signature
+template <auto Pass>
+static void runPass(mir::Context& ctx, mir::Function& F,
+                    CodegenOptions const&) {
+    Pass(ctx, F);
+}
+
+/// \Returns the register allocator for \p F as described by `CodegenOptions`
+static RegisterAllocator selectRegisterAllocator(
+    mir::Function& F, CodegenOptions const& options) {
+    if (options.registerAllocator) {
+        return *options.registerAllocator;
+    }
+    if (!options.optimize) {
+        return RegisterAllocator::LinearScan;
+    }
+    auto numInstructions = ranges::distance(F.instructions());
+    return static_cast<size_t>(numInstructions) > options.linearScanThreshold ?
+               RegisterAllocator::LinearScan :
+               RegisterAllocator::Graph;
+}
+
+static void runRegisterAllocator(mir::Context& ctx, mir::Function& F,
+                                 CodegenOptions const& options) {
+    cg::allocateRegisters(ctx, F, selectRegisterAllocator(F, options));
+}
 
-    forEach(ctx, mod, cg::destroySSA);
-    logger.log("MIR module after SSA destruction", mod);
+static constexpr Stage Pipeline[] = {
+    { "instsimplify", "MIR module after simplification",
+      runPass<cg::instSimplify> },
+    { "cse", "MIR module after CSE",
+      runPass<cg::commonSubexpressionElimination> },
+    { "dce", "MIR module after DCE", runPass<cg::deadCodeElim> },
+    /// We compute live sets just before we leave SSA form
+    { "livesets", "MIR module after life set computation",
+      runPass<cg::computeLiveSets> },
+    { "destroyssa", "MIR module after SSA destruction",
+      runPass<cg::destroySSA> },
+    { "coalesce", "MIR module after copy coalescing",
+      runPass<cg::coalesceCopies> },
+    { "regalloc", "MIR module after register allocation",
+      runRegisterAllocator },
+    { "elidejumps", "MIR module after jump elision", runPass<cg::elideJumps> },
+};
 
-    forEach(ctx, mod, cg::coalesceCopies);
-    logger.log("MIR module after copy coalescing", mod);
+static void runStage(Stage const& stage, mir::Context& ctx, mir::Function& F,
+                     CodegenOptions const& options) {
+    TraceScope trace(stage.name, "codegen");
+    trace.setFunction(F.name());
+    stage.transform(ctx, F, options);
+}
 
-    forEach(ctx, mod, cg::allocateRegisters);
-    logger.log("MIR module after register allocation", mod);
+static mir::Module tracedLowerToMIR(mir::Context& ctx,
+                                    ir::Module const& irMod) {
+    TraceScope trace("lowertomir", "codegen");
+    return cg::lowerToMIR(ctx, irMod);
+}
 
-    forEach(ctx, mod, cg::elideJumps);
-    logger.log("MIR module after jump elision", mod);
+static Asm::AssemblyStream tracedLowerToASM(mir::Module const& mod) {
+    TraceScope trace("lowertoasm", "codegen");
     return cg::lowerToASM(mod);
 }
+
+static void collectStats(std::span<mir::Function* const> functions,
+                         CodegenStats& stats) {
+    stats = {};
+    for (auto* F: functions) {
+        size_t numRegs = F->hardwareRegisters().size();
+        ++stats.numFunctions;
+        stats.totalRegisters += numRegs;
+        stats.maxRegisters = std::max(stats.maxRegisters, numRegs);
+    }
+}
+
+Asm::AssemblyStream cg::codegen(ir::Module const& irMod, cg::Logger& logger,
+                                CodegenOptions const& options) {
+    mir::Context ctx;
+    auto mod = tracedLowerToMIR(ctx, irMod);
+    logger.log("Initial MIR module", mod);
+    /// The passes only touch the function they are run on, so functions are
+    /// compiled concurrently
+    auto functions = mod | ranges::views::transform([](auto& F) {
+        return &F;
+    }) | ranges::to<std::vector>;
+    auto& pool = ThreadPool::global();
+    if (logger.isEnabled()) {
+        /// To log the whole module between stages we synchronize after every
+        /// stage
+        for (auto& stage: Pipeline) {
+            pool.parallelFor(functions.size(), [&](size_t index) {
+                runStage(stage, ctx, *functions[index], options);
+            });
+            logger.log(stage.logTitle, mod);
+        }
+    }
+    else {
+        pool.parallelFor(functions.size(), [&](size_t index) {
+            for (auto& stage: Pipeline) {
+                runStage(stage, ctx, *functions[index], options);
+            }
+        });
+    }
+    if (options.stats) {
+        collectStats(functions, *options.stats);
+    }
+    /// Assembly is emitted serially in module order, so the result does not
+    /// depend on thread scheduling
+    return tracedLowerToASM(mod);
+}
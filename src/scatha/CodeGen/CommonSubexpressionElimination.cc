@@ -76,6 +76,15 @@ public:
                 return TEST_EQ(LHS) && TEST_EQ(RHS) &&
                        TEST_EQ(operation) && TEST_EQ(bytewidth);
             },
+            [](VectorArithmeticInst const& A, VectorArithmeticInst const& B) {
+                return TEST_EQ(LHS) && TEST_EQ(RHS) &&
+                       TEST_EQ(operation) && TEST_EQ(laneWidth);
+            },
+            [](VectorCompareInst const& A, VectorCompareInst const& B) {
+                return TEST_EQ(LHS) && TEST_EQ(RHS) && TEST_EQ(mode) &&
+                       TEST_EQ(operation) && TEST_EQ(select) &&
+                       TEST_EQ(laneWidth);
+            },
             [](ConversionInst const& A, ConversionInst const& B) {
                 return TEST_EQ(operand) && TEST_EQ(conversion) &&
                        TEST_EQ(fromBits) && TEST_EQ(toBits) &&
@@ -128,6 +137,14 @@ public:
             [](LoadArithmeticInst const& inst) {
                 return utl::hash_combine(inst.LHS(), inst.RHS(), inst.operation());
             },
+            [](VectorArithmeticInst const& inst) {
+                return utl::hash_combine(inst.LHS(), inst.RHS(),
+                                         inst.operation(), inst.laneWidth());
+            },
+            [](VectorCompareInst const& inst) {
+                return utl::hash_combine(inst.LHS(), inst.RHS(),
+                                         inst.operation(), inst.laneWidth());
+            },
             [](ConversionInst const& inst) {
                 return utl::hash_combine(inst.operand(), inst.conversion(),
                                          inst.fromBits(), inst.toBits());
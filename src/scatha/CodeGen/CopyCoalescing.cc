@@ -90,7 +90,8 @@ static void coalesce(BasicBlock& BB, Register* survive,
 
 void CCContext::visitInst(Instruction& inst) {
     if (!isa<CopyInst>(inst) && !isa<ArithmeticInst>(inst) &&
-        !isa<UnaryArithmeticInst>(inst) && !isa<ConversionInst>(inst))
+        !isa<VectorCompareInst>(inst) && !isa<UnaryArithmeticInst>(inst) &&
+        !isa<ConversionInst>(inst))
     {
         return;
     }
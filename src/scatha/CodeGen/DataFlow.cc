@@ -18,13 +18,6 @@ using namespace scatha;
 using namespace cg;
 using namespace mir;
 
-template <typename T>
-static void merge(utl::hashset<T>& dest, auto const& source) {
-    for (auto* value: source) {
-        dest.insert(value);
-    }
-}
-
 namespace {
 
 struct LivenessContext {
@@ -36,8 +29,8 @@ struct LivenessContext {
 
     void loopTree(ir::LNFNode const* node);
 
-    utl::hashset<Register*> phiUses(BasicBlock* BB);
-    utl::hashset<Register*> phiUses(ranges::range auto&& params);
+    LiveSet phiUses(BasicBlock* BB);
+    LiveSet phiUses(ranges::range auto&& regs);
 
     Function& F;
     /// Need two sets because we use `visited` like a stack to detect back
@@ -78,9 +71,9 @@ void LivenessContext::dag(BasicBlock* BB) {
     }
     /// _Live out_ are all registers defined in this block that are used by phi
     /// instructions
-    utl::hashset<Register*> live = phiUses(BB);
+    LiveSet live = phiUses(BB);
     if (BB->isEntry()) {
-        merge(live, phiUses(F.ssaArgumentRegisters()));
+        live |= phiUses(F.ssaArgumentRegisters());
     }
     /// Also any registers that are _live in_ in our successors are _live out_
     /// in this block unless they are defined by phi instructions in the
@@ -106,7 +99,7 @@ void LivenessContext::dag(BasicBlock* BB) {
                 liveInSucc.erase(phi.dest());
             }
         }
-        merge(live, liveInSucc);
+        live |= liveInSucc;
     }
     /// If we return from this block, the return values are live out
     if (auto* ret = dyncast<ReturnInst*>(&BB->back())) {
@@ -161,16 +154,12 @@ void LivenessContext::loopTree(ir::LNFNode const* node) {
     }
     /// We also need to merge our own live-out values with the other loop-live
     /// values.
-    for (auto* r: liveLoop) {
-        header->addLiveIn(r);
-        header->addLiveOut(r);
-    }
+    header->addLiveIn(liveLoop);
+    header->addLiveOut(liveLoop);
     for (auto* child: node->children()) {
         BasicBlock* loopBlock = bbMap[child->basicBlock()];
-        for (auto* r: liveLoop) {
-            loopBlock->addLiveIn(r);
-            loopBlock->addLiveOut(r);
-        }
+        loopBlock->addLiveIn(liveLoop);
+        loopBlock->addLiveOut(liveLoop);
         loopTree(child);
     }
 }
@@ -188,10 +177,14 @@ static constexpr auto Dests =
 
 /// Returns all registers defined by instructions in \p BB that are used by phi
 /// instructions
-utl::hashset<Register*> LivenessContext::phiUses(BasicBlock* BB) {
-    return *BB | Dests | PhiUseFilter | ranges::to<utl::hashset<Register*>>;
+LiveSet LivenessContext::phiUses(BasicBlock* BB) {
+    return phiUses(*BB | Dests);
 }
 
-utl::hashset<Register*> LivenessContext::phiUses(ranges::range auto&& params) {
-    return params | PhiUseFilter | ranges::to<utl::hashset<Register*>>;
+LiveSet LivenessContext::phiUses(ranges::range auto&& regs) {
+    LiveSet result;
+    for (auto* reg: regs | PhiUseFilter) {
+        result.insert(reg);
+    }
+    return result;
 }
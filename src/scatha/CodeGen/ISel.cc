@@ -1,5 +1,7 @@
 #include "CodeGen/ISel.h"
 
+#include <optional>
+
 #include <range/v3/algorithm.hpp>
 #include <range/v3/view.hpp>
 #include <termfmt/termfmt.h>
@@ -45,10 +47,12 @@ struct Matcher<ir::Load>: MatcherBase {
         auto* dest = resolve(load);
         size_t numBytes = load.type()->size();
         size_t numWords = ::numWords(load);
+        /// Vectors may only be aligned to their element type
+        bool unaligned = isa<ir::VectorType>(load.type());
         for (size_t i = 0; i < numWords; ++i, dest = dest->next()) {
             auto* inst = new mir::LoadInst(dest, addrCallback(i),
                                            sliceWidth(numBytes, i, numWords),
-                                           load.metadata());
+                                           load.metadata(), unaligned);
             emit(inst);
         }
     }
@@ -84,10 +88,12 @@ struct Matcher<ir::Store>: MatcherBase {
         /// instructions, so we must take the constant -> register -> memory
         /// detour
         auto* value = resolveToRegister(*store.value(), store.metadata());
+        /// Vectors may only be aligned to their element type
+        bool unaligned = isa<ir::VectorType>(store.value()->type());
         for (size_t i = 0; i < numWords; ++i, value = value->next()) {
             auto* inst = new mir::StoreInst(addrCallback(i), value,
                                             sliceWidth(numBytes, i, numWords),
-                                            store.metadata());
+                                            store.metadata(), unaligned);
             emit(inst);
         }
     }
@@ -184,6 +190,28 @@ struct Matcher<ir::ConversionInst>: MatcherBase {
 
 template <>
 struct Matcher<ir::CompareInst>: MatcherBase {
+    // Vector comparison
+    // This must be the first case because the other case assumes scalar
+    // operands
+    SD_MATCH_CASE(ir::CompareInst const& cmp, SelectionNode&) {
+        auto* type = dyncast<ir::VectorType const*>(cmp.lhs()->type());
+        if (!type) return false;
+        auto* LHS = resolveToRegister(*cmp.lhs(), cmp.metadata());
+        auto* RHS = resolveToRegister(*cmp.rhs(), cmp.metadata());
+        auto* dest = resolve(cmp);
+        for (size_t i = 0; i < type->numRegisters(); ++i) {
+            emit(new mir::VectorCompareInst(dest, LHS, RHS,
+                                            type->elementType()->size(),
+                                            cmp.mode(), cmp.operation(),
+                                            /* select = */ false,
+                                            cmp.metadata()));
+            dest = dest->next();
+            LHS = LHS->next();
+            RHS = RHS->next();
+        }
+        return true;
+    }
+
     SD_MATCH_CASE(ir::CompareInst const& cmp, SelectionNode&) {
         auto* LHS = resolveToRegister(*cmp.lhs(), cmp.metadata());
         auto* RHS = resolve(*cmp.rhs());
@@ -223,6 +251,30 @@ struct Matcher<ir::ArithmeticInst>: MatcherBase {
         emit(new InstType(resolve(inst), LHS, RHS, size, op, inst.metadata()));
     }
 
+    // Vector arithmetic
+    // This must be the first case because the other cases assume scalar
+    // operands. Lanes never straddle registers, so vectors held in a pair of
+    // registers are computed one register at a time
+    SD_MATCH_CASE(ir::ArithmeticInst const& inst, SelectionNode&) {
+        auto* type = dyncast<ir::VectorType const*>(inst.type());
+        if (!type) return false;
+        SC_ASSERT(ir::hasVectorForm(inst.operation()),
+                  "The validator rejects other vector operations");
+        auto* LHS = resolveToRegister(*inst.lhs(), inst.metadata());
+        auto* RHS = resolveToRegister(*inst.rhs(), inst.metadata());
+        auto* dest = resolve(inst);
+        for (size_t i = 0; i < type->numRegisters(); ++i) {
+            emit(new mir::VectorArithmeticInst(dest, LHS, RHS,
+                                               inst.scalarType()->size(),
+                                               inst.operation(),
+                                               inst.metadata()));
+            dest = dest->next();
+            LHS = LHS->next();
+            RHS = RHS->next();
+        }
+        return true;
+    }
+
     // Arithmetic -> Load -> GEP
     SD_MATCH_CASE(ir::ArithmeticInst const& inst, SelectionNode& node) {
         auto* load = dyncast<ir::Load const*>(inst.rhs());
@@ -681,6 +733,107 @@ struct Matcher<ir::Select>: MatcherBase {
         }
     }
 
+    /// \Returns the operation of the vector minimum or maximum that computes
+    /// \p select with the condition \p cmp, or `std::nullopt` if there is none.
+    /// Float lanes only match the exact semantics of the VM instructions, i.e.
+    /// `select(a < b, a, b)` and `select(a > b, a, b)`
+    static std::optional<mir::CompareOperation> minMaxOperation(
+        ir::Select const& select, ir::CompareInst const& cmp) {
+        using enum mir::CompareOperation;
+        bool direct = select.thenValue() == cmp.lhs() &&
+                      select.elseValue() == cmp.rhs();
+        bool swapped = select.thenValue() == cmp.rhs() &&
+                       select.elseValue() == cmp.lhs();
+        if (cmp.mode() == ir::CompareMode::Float) {
+            if (!direct) {
+                return std::nullopt;
+            }
+            switch (cmp.operation()) {
+            case Less:
+            case Greater:
+                return cmp.operation();
+            default:
+                return std::nullopt;
+            }
+        }
+        if (!direct && !swapped) {
+            return std::nullopt;
+        }
+        switch (cmp.operation()) {
+        case Less:
+        case LessEq:
+            return direct ? Less : Greater;
+        case Greater:
+        case GreaterEq:
+            return direct ? Greater : Less;
+        default:
+            return std::nullopt;
+        }
+    }
+
+    // Vector select -> Compare
+    // Selecting between the operands of the comparison computes the lane wise
+    // minimum or maximum
+    SD_MATCH_CASE(ir::Select const& select, SelectionNode& node) {
+        auto* type = dyncast<ir::VectorType const*>(select.type());
+        if (!type) return false;
+        auto* cmp = dyncast<ir::CompareInst const*>(select.condition());
+        if (!cmp) return false;
+        auto op = minMaxOperation(select, *cmp);
+        if (!op) return false;
+        auto* cmpNode = DAG(cmp);
+        if (!cmpNode) return false;
+        node.merge(*cmpNode);
+        auto* LHS = resolveToRegister(*cmp->lhs(), cmp->metadata());
+        auto* RHS = resolveToRegister(*cmp->rhs(), cmp->metadata());
+        auto* dest = resolve(select);
+        for (size_t i = 0; i < type->numRegisters(); ++i) {
+            emit(new mir::VectorCompareInst(dest, LHS, RHS,
+                                            type->elementType()->size(),
+                                            cmp->mode(), *op,
+                                            /* select = */ true,
+                                            select.metadata()));
+            dest = dest->next();
+            LHS = LHS->next();
+            RHS = RHS->next();
+        }
+        return true;
+    }
+
+    // Vector select (base case)
+    // The condition is a lane mask `m`, so we compute `b ^ ((a ^ b) & m)`
+    SD_MATCH_CASE(ir::Select const& select, SelectionNode&) {
+        auto* type = dyncast<ir::VectorType const*>(select.condition()->type());
+        if (!type) return false;
+        auto* mask = resolveToRegister(*select.condition(), select.metadata());
+        auto* thenVal =
+            resolveToRegister(*select.thenValue(), select.metadata());
+        auto* elseVal =
+            resolveToRegister(*select.elseValue(), select.metadata());
+        auto* dest = resolve(select);
+        size_t laneWidth = type->elementType()->size();
+        for (size_t i = 0; i < type->numRegisters(); ++i) {
+            auto* diff = nextRegister();
+            emit(new mir::VectorArithmeticInst(diff, thenVal, elseVal,
+                                               laneWidth,
+                                               mir::ArithmeticOperation::XOr,
+                                               select.metadata()));
+            auto* masked = nextRegister();
+            emit(new mir::VectorArithmeticInst(masked, diff, mask, laneWidth,
+                                               mir::ArithmeticOperation::And,
+                                               select.metadata()));
+            emit(new mir::VectorArithmeticInst(dest, masked, elseVal,
+                                               laneWidth,
+                                               mir::ArithmeticOperation::XOr,
+                                               select.metadata()));
+            dest = dest->next();
+            mask = mask->next();
+            thenVal = thenVal->next();
+            elseVal = elseVal->next();
+        }
+        return true;
+    }
+
     // Select -> Compare
     SD_MATCH_CASE(ir::Select const& select, SelectionNode& node) {
         auto* cmp = dyncast<ir::CompareInst const*>(select.condition());
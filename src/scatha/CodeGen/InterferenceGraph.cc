@@ -74,6 +74,8 @@ void InterferenceGraph::colorize() {
 
 void InterferenceGraph::computeImpl(Function& F) {
     this->F = &F;
+    virtNodes.resize(F.virtualRegisters().size());
+    calleeNodes.resize(F.calleeRegisters().size());
     for (auto& reg: F.virtualRegisters()) {
         addRegister(&reg);
     }
@@ -109,7 +111,12 @@ void InterferenceGraph::addRegister(Register* reg) {
     auto nodeOwner = std::make_unique<Node>(reg);
     auto* node = nodeOwner.get();
     nodes.push_back(std::move(nodeOwner));
-    regMap.insert({ reg, node });
+    if (isa<CalleeRegister>(reg)) {
+        calleeNodes[reg->index()] = node;
+    }
+    else {
+        virtNodes[reg->index()] = node;
+    }
 }
 
 void InterferenceGraph::addEdges(mir::Register* reg, auto&& listOfRegs) {
@@ -125,9 +132,12 @@ void InterferenceGraph::addEdges(mir::Register* reg, auto&& listOfRegs) {
 }
 
 InterferenceGraph::Node* InterferenceGraph::find(mir::Register* reg) {
-    auto itr = regMap.find(reg);
-    SC_ASSERT(itr != regMap.end(), "Not found");
-    return itr->second;
+    auto& regNodes = isa<CalleeRegister>(reg) ? calleeNodes : virtNodes;
+    SC_ASSERT(isa<VirtualRegister>(reg) || isa<CalleeRegister>(reg),
+              "Not found");
+    SC_ASSERT(reg->index() < regNodes.size() && regNodes[reg->index()],
+              "Not found");
+    return regNodes[reg->index()];
 }
 
 static std::string toRegLetter(Register const* reg) {
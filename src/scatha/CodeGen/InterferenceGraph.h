@@ -73,7 +73,8 @@ private:
     Node* find(mir::Register*);
 
     mir::Function* F = nullptr;
-    utl::hashmap<mir::Register*, Node*> regMap;
+    /// Nodes of the virtual and callee registers, indexed by register index
+    utl::vector<Node*> virtNodes, calleeNodes;
     utl::vector<std::unique_ptr<Node>> nodes;
     size_t numCols = 0;
 };
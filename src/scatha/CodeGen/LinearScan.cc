@@ -0,0 +1,183 @@
+#include "CodeGen/LinearScan.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include <range/v3/algorithm.hpp>
+#include <utl/vector.hpp>
+
+#include "MIR/CFG.h"
+#include "MIR/Instructions.h"
+#include "MIR/LiveInterval.h"
+#include "MIR/Register.h"
+
+using namespace scatha;
+using namespace cg;
+using namespace mir;
+
+namespace {
+
+struct LSContext {
+    Function& F;
+    size_t numRegs;
+    RegisterAssignment result;
+
+    /// Smallest intervals that cover the live ranges of the unfixed registers,
+    /// indexed by register index
+    utl::vector<LiveInterval> hulls;
+
+    /// One hull per basic block for the fixed registers, indexed by register
+    /// index. The hulls of one register are sorted and disjoint because blocks
+    /// occupy disjoint ranges of program points
+    utl::vector<utl::small_vector<LiveInterval, 2>> fixedHulls;
+
+    /// For every hardware register the end of the hull of the unfixed register
+    /// that was assigned to it last
+    utl::vector<int> busyUntil;
+
+    explicit LSContext(Function& F):
+        F(F), numRegs(F.virtualRegisters().size()) {}
+
+    void run();
+
+    void computeHulls();
+
+    void assign();
+
+    bool isFree(size_t color, LiveInterval hull) const;
+
+    bool overlapsFixed(size_t color, LiveInterval hull) const;
+};
+
+} // namespace
+
+/// \Returns `true` if \p I covers no program point. Intervals that no point
+/// has been added to yet have no register
+static bool isEmpty(LiveInterval I) { return !I.reg || I.begin >= I.end; }
+
+/// Extends \p I to cover `[begin, end)` of register \p reg
+static void extend(LiveInterval& I, Register* reg, int begin, int end) {
+    LiveInterval J = { begin, end, reg };
+    I = I.reg ? merge(I, J) : J;
+}
+
+RegisterAssignment cg::linearScan(Function& F) {
+    LSContext ctx(F);
+    ctx.run();
+    return std::move(ctx.result);
+}
+
+void LSContext::run() {
+    /// Register allocation inserts instructions before it runs the allocator,
+    /// so we renumber the program points
+    F.linearize();
+    computeHulls();
+    assign();
+}
+
+void LSContext::computeHulls() {
+    hulls.resize(numRegs, LiveInterval{ 0, 0 });
+    fixedHulls.resize(numRegs);
+    /// Hulls of the registers within the current block
+    utl::vector<LiveInterval> local(numRegs, LiveInterval{ 0, 0 });
+    utl::small_vector<VirtualRegister*> touched;
+    auto extendLocal = [&](Register* reg, int begin, int end) {
+        auto* vreg = dyncast<VirtualRegister*>(reg);
+        if (!vreg) {
+            return;
+        }
+        auto& hull = local[vreg->index()];
+        if (!hull.reg) {
+            touched.push_back(vreg);
+        }
+        extend(hull, vreg, begin, end);
+    };
+    for (auto& BB: F) {
+        int blockBegin = BB.index();
+        int blockEnd = BB.empty() ? blockBegin + 1 : BB.back().index() + 1;
+        for (auto* reg: BB.liveIn()) {
+            extendLocal(reg, blockBegin, blockBegin);
+        }
+        for (auto* reg: BB.liveOut()) {
+            extendLocal(reg, blockEnd, blockEnd);
+        }
+        /// A use ends the interval before the instruction, so the operand and
+        /// the destination of a copy can share a register. A definition
+        /// occupies at least the defining instruction, even if the register is
+        /// never read, because it clobbers the register there
+        for (auto& inst: BB) {
+            int index = inst.index();
+            for (auto* reg: inst.operands() | Filter<Register>) {
+                extendLocal(reg, index, index);
+            }
+            for (auto* reg: inst.destRegisters()) {
+                extendLocal(reg, index, index + 1);
+            }
+        }
+        for (auto* vreg: touched) {
+            auto& hull = local[vreg->index()];
+            if (vreg->fixed()) {
+                if (!isEmpty(hull)) {
+                    fixedHulls[vreg->index()].push_back(hull);
+                }
+            }
+            else {
+                extend(hulls[vreg->index()], vreg, hull.begin, hull.end);
+            }
+            hull = { 0, 0 };
+        }
+        touched.clear();
+    }
+}
+
+void LSContext::assign() {
+    result.colors.resize(numRegs, 0);
+    /// Unused registers are mapped to register zero, so it must exist
+    result.numColors = numRegs > 0 ? 1 : 0;
+    utl::vector<LiveInterval> worklist;
+    for (auto& reg: F.virtualRegisters()) {
+        size_t index = reg.index();
+        if (reg.fixed()) {
+            result.colors[index] = utl::narrow_cast<uint32_t>(index);
+            result.numColors = std::max(result.numColors, index + 1);
+        }
+        else if (!isEmpty(hulls[index])) {
+            worklist.push_back(hulls[index]);
+        }
+    }
+    ranges::sort(worklist, [](LiveInterval I, LiveInterval J) {
+        return std::pair(I.begin, I.reg->index()) <
+               std::pair(J.begin, J.reg->index());
+    });
+    for (auto hull: worklist) {
+        size_t color = 0;
+        while (!isFree(color, hull)) {
+            ++color;
+        }
+        if (color >= busyUntil.size()) {
+            busyUntil.resize(color + 1, std::numeric_limits<int>::min());
+        }
+        busyUntil[color] = hull.end;
+        result.colors[hull.reg->index()] = utl::narrow_cast<uint32_t>(color);
+        result.numColors = std::max(result.numColors, color + 1);
+    }
+}
+
+bool LSContext::isFree(size_t color, LiveInterval hull) const {
+    if (color < busyUntil.size() && busyUntil[color] > hull.begin) {
+        return false;
+    }
+    return !overlapsFixed(color, hull);
+}
+
+bool LSContext::overlapsFixed(size_t color, LiveInterval hull) const {
+    if (color >= fixedHulls.size()) {
+        return false;
+    }
+    auto& blockHulls = fixedHulls[color];
+    /// First block hull that ends after our hull begins
+    auto itr = ranges::upper_bound(blockHulls, hull.begin, ranges::less{},
+                                   &LiveInterval::end);
+    return itr != blockHulls.end() && overlaps(*itr, hull);
+}
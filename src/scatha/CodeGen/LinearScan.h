@@ -0,0 +1,43 @@
+#ifndef SCATHA_CODEGEN_LINEARSCAN_H_
+#define SCATHA_CODEGEN_LINEARSCAN_H_
+
+#include <cstdint>
+
+#include <utl/vector.hpp>
+
+#include "Common/Base.h"
+#include "MIR/Fwd.h"
+
+namespace scatha::cg {
+
+/// Assignment of hardware register indices to the virtual registers of a
+/// function
+struct RegisterAssignment {
+    /// The hardware register index of every virtual register, indexed by the
+    /// index of the virtual register
+    utl::vector<uint32_t> colors;
+
+    /// The number of hardware registers used by the assignment
+    size_t numColors = 0;
+};
+
+/// Assigns hardware registers to the virtual registers of \p F with a linear
+/// scan over their live intervals.
+///
+/// Every virtual register is approximated by a single interval that covers all
+/// program points where it is live. The intervals are visited in order of
+/// their start and each one is assigned the lowest register that is not
+/// occupied by an overlapping interval. Fixed registers keep their index. They
+/// are compared block by block, so a fixed argument register that is only live
+/// in the entry block does not block its index for the rest of the function.
+///
+/// This runs in time linear in the size of the function (times the number of
+/// registers in use) but may use more registers than coloring the interference
+/// graph.
+///
+/// \pre Requires \p F to be in virtual register form with computed live sets
+SCTEST_API RegisterAssignment linearScan(mir::Function& F);
+
+} // namespace scatha::cg
+
+#endif // SCATHA_CODEGEN_LINEARSCAN_H_
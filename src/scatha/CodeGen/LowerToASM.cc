@@ -40,6 +40,8 @@ struct CGContext {
     void genInstImpl(mir::UnaryArithmeticInst const&);
     void genInstImpl(mir::ValueArithmeticInst const&);
     void genInstImpl(mir::LoadArithmeticInst const&);
+    void genInstImpl(mir::VectorArithmeticInst const&);
+    void genInstImpl(mir::VectorCompareInst const&);
     void genInstImpl(mir::ConversionInst const&);
     void genInstImpl(mir::JumpInst const&);
     void genInstImpl(mir::CondJumpInst const&);
@@ -121,6 +123,11 @@ Asm::AssemblyStream cg::lowerToASM(mir::Module const& mod) {
 }
 
 void CGContext::run(mir::Module const& mod) {
+    /// Functions are labeled in module order up front, so label IDs do not
+    /// depend on the order in which functions reference each other
+    for (auto& F: mod) {
+        getLabelID(F);
+    }
     for (auto& F: mod) {
         genFunction(F);
     }
@@ -181,14 +188,24 @@ void CGContext::genInstImpl(mir::StoreInst const& inst) {
     auto dest = convertAddress(inst.address());
     /// We cast to register because we can only move to memory from a register
     auto source = toRegIdx(inst.source());
-    currentBlock->insertBack(MoveInst(dest, source, inst.bytewidth()));
+    if (inst.isUnaligned()) {
+        currentBlock->insertBack(VectorMoveInst(dest, source));
+    }
+    else {
+        currentBlock->insertBack(MoveInst(dest, source, inst.bytewidth()));
+    }
     addMetadata(inst);
 }
 
 void CGContext::genInstImpl(mir::LoadInst const& inst) {
     auto dest = toRegIdx(inst.dest());
     auto source = convertAddress(inst.address());
-    currentBlock->insertBack(MoveInst(dest, source, inst.bytewidth()));
+    if (inst.isUnaligned()) {
+        currentBlock->insertBack(VectorMoveInst(dest, source));
+    }
+    else {
+        currentBlock->insertBack(MoveInst(dest, source, inst.bytewidth()));
+    }
     addMetadata(inst);
 }
 
@@ -311,6 +328,37 @@ void CGContext::genInstImpl(mir::LoadArithmeticInst const& inst) {
     addMetadata(inst);
 }
 
+void CGContext::genInstImpl(mir::VectorArithmeticInst const& inst) {
+    SC_ASSERT(inst.dest() == inst.LHS(), "Illegal instruction");
+    auto const laneType = [&] {
+        using enum mir::ArithmeticOperation;
+        switch (inst.operation()) {
+        case FAdd:
+        case FSub:
+        case FMul:
+        case FDiv:
+            return Asm::Type::Float;
+        case UDiv:
+            return Asm::Type::Unsigned;
+        default:
+            return Asm::Type::Signed;
+        }
+    }();
+    currentBlock->insertBack(Asm::VectorArithmeticInst(
+        mapArithmetic(inst.operation()), laneType, inst.laneWidth(),
+        toRegIdx(inst.LHS()), toRegIdx(inst.RHS())));
+    addMetadata(inst);
+}
+
+void CGContext::genInstImpl(mir::VectorCompareInst const& inst) {
+    SC_ASSERT(inst.dest() == inst.LHS(), "Illegal instruction");
+    currentBlock->insertBack(Asm::VectorCompareInst(
+        mapCompareOperation(inst.operation()), mapCompareMode(inst.mode()),
+        inst.laneWidth(), inst.select(), toRegIdx(inst.LHS()),
+        toRegIdx(inst.RHS())));
+    addMetadata(inst);
+}
+
 void CGContext::genInstImpl(mir::ConversionInst const& inst) {
     SC_ASSERT(inst.dest() == inst.operand(), "Illegal instruction");
     auto operand = toRegIdx(inst.operand());
@@ -1,6 +1,7 @@
 #include "CodeGen/Passes.h"
 
 #include "CodeGen/InterferenceGraph.h"
+#include "CodeGen/LinearScan.h"
 #include "CodeGen/TargetInfo.h"
 #include "CodeGen/Utility.h"
 #include "MIR/CFG.h"
@@ -18,18 +19,20 @@ using namespace ranges::views;
 static void convertToTwoAddressMode(Function& F) {
     auto instructions =
         F.instructions() |
-        Filter<UnaryArithmeticInst, ArithmeticInst, ConversionInst>;
+        Filter<UnaryArithmeticInst, ArithmeticInst, VectorCompareInst,
+               ConversionInst>;
     for (auto& inst: instructions) {
         auto* dest = inst.dest();
         auto* operand = inst.operandAt(0);
         if (dest == operand) {
             continue;
         }
-        if (auto* arithmetic = dyncast<ValueArithmeticInst*>(&inst);
-            arithmetic && arithmetic->RHS() == dest)
+        if (auto* arithmetic = dyncast<ArithmeticInst*>(&inst);
+            arithmetic && !isa<LoadArithmeticInst>(arithmetic) &&
+            arithmetic->operandAt(1) == dest)
         {
             if (isCommutative(arithmetic->operation())) {
-                inst.setOperandAt(0, arithmetic->RHS());
+                inst.setOperandAt(0, arithmetic->operandAt(1));
                 inst.setOperandAt(1, operand);
                 continue;
             }
@@ -41,6 +44,16 @@ static void convertToTwoAddressMode(Function& F) {
             inst.parent()->insert(&inst, copy);
             inst.setOperandAt(1, tmp);
         }
+        /// Vector comparisons don't commute in general, so we save the RHS
+        /// before it is clobbered
+        if (isa<VectorCompareInst>(inst) && inst.operandAt(1) == dest) {
+            auto* tmp = new VirtualRegister();
+            F.virtualRegisters().add(tmp);
+            auto* copy =
+                new CopyInst(tmp, dest, inst.bytewidth(), inst.metadata());
+            inst.parent()->insert(&inst, copy);
+            inst.setOperandAt(1, tmp);
+        }
         SC_ASSERT(
             !ranges::contains(inst.operands() | drop(1), dest),
             "The other operands must not contain dest because we clobber dest with a copy before execution the instruction");
@@ -59,33 +72,50 @@ static void allocateHardwareRegisters(Function& F, size_t numRegs) {
         F.hardwareRegisters().add(new HardwareRegister());
 }
 
-/// Replace all virtual registers with the newly allocated hardware registers
-static void replaceVirtRegsWithHardwareRegs(Function& F,
-                                            InterferenceGraph const& graph) {
-    utl::hashmap<VirtualRegister*, HardwareRegister*> registerMap;
+/// Colors the interference graph of \p F
+static RegisterAssignment colorInterferenceGraph(Function& F) {
+    auto graph = InterferenceGraph::compute(F);
+    graph.colorize();
+    RegisterAssignment result;
+    result.colors.resize(F.virtualRegisters().size(), 0);
     for (auto* node: graph) {
-        auto* vreg = dyncast<VirtualRegister*>(node->reg());
-        if (!vreg) {
-            continue;
+        if (auto* vreg = dyncast<VirtualRegister const*>(node->reg())) {
+            result.colors[vreg->index()] =
+                utl::narrow_cast<uint32_t>(node->color());
+        }
+    }
+    result.numColors = graph.numColors();
+    return result;
+}
+
+/// \Returns the live set \p live with all virtual registers replaced by the
+/// hardware registers they are assigned to
+static LiveSet mapLiveSet(Function& F, LiveSet const& live,
+                          RegisterAssignment const& assignment) {
+    LiveSet result;
+    for (auto* reg: live) {
+        if (isa<VirtualRegister>(reg)) {
+            result.insert(
+                F.hardwareRegisters().at(assignment.colors[reg->index()]));
+        }
+        else {
+            result.insert(reg);
         }
-        auto* hreg = F.hardwareRegisters().at(node->color());
-        vreg->replaceWith(hreg);
-        registerMap[vreg] = hreg;
+    }
+    return result;
+}
+
+/// Replace all virtual registers with the newly allocated hardware registers
+static void replaceVirtRegsWithHardwareRegs(
+    Function& F, RegisterAssignment const& assignment) {
+    for (auto& vreg: F.virtualRegisters()) {
+        auto* hreg = F.hardwareRegisters().at(assignment.colors[vreg.index()]);
+        vreg.replaceWith(hreg);
     }
     /// Update live sets with new registers
-    /// \Note this code is copied from `mapSSAToVirtualRegisters()`, we could
-    /// abstract this
     for (auto& BB: F) {
-        for (auto [vreg, hreg]: registerMap) {
-            if (BB.isLiveIn(vreg)) {
-                BB.addLiveIn(hreg);
-            }
-            BB.removeLiveIn(vreg);
-            if (BB.isLiveOut(vreg)) {
-                BB.addLiveOut(hreg);
-            }
-            BB.removeLiveOut(vreg);
-        }
+        BB.setLiveIn(mapLiveSet(F, BB.liveIn(), assignment));
+        BB.setLiveOut(mapLiveSet(F, BB.liveOut(), assignment));
     }
 }
 
@@ -174,16 +204,24 @@ static void allocateCalleeRegisters(Function& F) {
     }
 }
 
-void cg::allocateRegisters(Context&, Function& F) {
+void cg::allocateRegisters(Context&, Function& F,
+                           RegisterAllocator allocator) {
     convertToTwoAddressMode(F);
-    /// Now we color the interference graph and replace registers
+    /// Now we assign hardware registers and replace registers
     /// This is were the actual work happens, everything is this file is mostly
     /// auxiliary
-    auto graph = InterferenceGraph::compute(F);
-    graph.colorize();
-    size_t numCols = graph.numColors();
+    auto assignment = [&] {
+        switch (allocator) {
+        case RegisterAllocator::Graph:
+            return colorInterferenceGraph(F);
+        case RegisterAllocator::LinearScan:
+            return linearScan(F);
+        }
+        SC_UNREACHABLE();
+    }();
+    size_t numCols = assignment.numColors;
     allocateHardwareRegisters(F, numCols);
-    replaceVirtRegsWithHardwareRegs(F, graph);
+    replaceVirtRegsWithHardwareRegs(F, assignment);
     /// Then we try to evict some copy instructions.
     evictCopyInstructions(F);
     evictUnusedInstructions(F);
@@ -1,6 +1,9 @@
 #include "Common/Allocator.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdlib>
+#include <new>
 
 #include <utl/utility.hpp>
 
@@ -8,6 +11,61 @@
 
 namespace scatha {
 
+/// Relaxed atomics are enough because we only read the statistics between
+/// compiler stages
+static std::atomic<size_t> gLiveBytes = 0;
+static std::atomic<size_t> gPeakBytes = 0;
+
+size_t AllocationStats::liveBytes() {
+    return gLiveBytes.load(std::memory_order_relaxed);
+}
+
+size_t AllocationStats::peakBytes() {
+    return gPeakBytes.load(std::memory_order_relaxed);
+}
+
+void AllocationStats::resetPeakBytes() {
+    gPeakBytes.store(liveBytes(), std::memory_order_relaxed);
+}
+
+void AllocationStats::add(size_t size) {
+    size_t live = gLiveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = gPeakBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !gPeakBytes.compare_exchange_weak(peak, live,
+                                             std::memory_order_relaxed))
+        ;
+}
+
+void AllocationStats::remove(size_t size) {
+    gLiveBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+namespace {
+
+/// Precedes every allocation made by `allocateTracked()`
+struct alignas(std::max_align_t) TrackedHeader {
+    size_t size;
+};
+
+} // namespace
+
+void* internal::allocateTracked(size_t size) {
+    void* memory = ::operator new(sizeof(TrackedHeader) + size);
+    auto* header = ::new (memory) TrackedHeader{ size };
+    AllocationStats::add(size);
+    return header + 1;
+}
+
+void internal::deallocateTracked(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<TrackedHeader*>(ptr) - 1;
+    AllocationStats::remove(header->size);
+    ::operator delete(header);
+}
+
 u8* internal::alignPointer(u8* ptr, size_t alignment) {
     static_assert(sizeof(size_t) == sizeof(ptr));
     size_t const r =
@@ -66,7 +124,7 @@ void MonotonicBufferAllocator::release() {
         size_t const size = buf->size;
         InternalBufferHeader* const prev = buf->prev;
         std::free(buf);
-        (void)size;
+        AllocationStats::remove(size);
         buf = prev;
     }
     buffer = nullptr;
@@ -79,6 +137,7 @@ void MonotonicBufferAllocator::addChunk(size_t size) {
         std::malloc(size + sizeof(InternalBufferHeader)));
     newBuffer->prev = buffer;
     newBuffer->size = size;
+    AllocationStats::add(size);
 
     buffer = newBuffer;
     current = reinterpret_cast<u8*>(newBuffer) + sizeof(InternalBufferHeader);
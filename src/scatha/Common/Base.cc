@@ -1,5 +1,6 @@
 #include "Common/Base.h"
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -60,16 +61,29 @@ void internal::assertionFailure(char const* file, int line,
     });
 }
 
-void internal::relfail() { std::abort(); }
+void internal::relfail() {
+    if (getAssertFailureHandler() == AssertFailureHandler::Throw) {
+        throw AssertionFailure("Fatal error");
+    }
+    std::abort();
+}
 
 void internal::doAbort() { std::abort(); }
 
+/// Handler set by `setAssertFailureHandler()` or `-1` if the environment
+/// decides
+static std::atomic<int> handlerOverride = -1;
+
 static std::string_view getHandlerName() {
     auto* name = std::getenv("SC_ASSERTION_HANDLER");
     return name ? std::string_view(name) : std::string_view();
 }
 
 internal::AssertFailureHandler internal::getAssertFailureHandler() {
+    int overridden = handlerOverride.load(std::memory_order_relaxed);
+    if (overridden >= 0) {
+        return static_cast<AssertFailureHandler>(overridden);
+    }
     auto handler = getHandlerName();
     using enum internal::AssertFailureHandler;
     if (handler == "BREAK") {
@@ -83,3 +97,7 @@ internal::AssertFailureHandler internal::getAssertFailureHandler() {
     }
     return Abort;
 }
+
+void internal::setAssertFailureHandler(AssertFailureHandler handler) {
+    handlerOverride.store(static_cast<int>(handler), std::memory_order_relaxed);
+}
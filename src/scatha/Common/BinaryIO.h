@@ -0,0 +1,171 @@
+#ifndef SCATHA_COMMON_BINARYIO_H_
+#define SCATHA_COMMON_BINARYIO_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace scatha {
+
+/// Thrown by `ByteReader` when the input is malformed or truncated
+struct BinaryFormatError {};
+
+/// Appends integers and strings to a byte buffer. Integers are encoded as
+/// LEB128 variable length integers unless stated otherwise
+class ByteWriter {
+public:
+    ///
+    void u8(uint8_t value) { buffer.push_back(static_cast<char>(value)); }
+
+    ///
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            u8(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        u8(static_cast<uint8_t>(value));
+    }
+
+    /// Zig-zag encoded so small negative values stay small
+    void svarint(int64_t value) {
+        varint((static_cast<uint64_t>(value) << 1) ^
+               static_cast<uint64_t>(value >> 63));
+    }
+
+    /// Writes the low \p size bytes of \p value in little endian order
+    void fixed(uint64_t value, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            u8(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /// Writes \p text without length prefix
+    void bytes(std::string_view text) { buffer += text; }
+
+    ///
+    template <typename E>
+    void enumValue(E value) {
+        varint(static_cast<uint64_t>(value));
+    }
+
+    /// \Returns the bytes written so far
+    std::string const& data() const { return buffer; }
+
+    /// \Returns the number of bytes written so far
+    size_t size() const { return buffer.size(); }
+
+private:
+    std::string buffer;
+};
+
+/// Reads values written by `ByteWriter`. All reads are bounds checked and
+/// throw `BinaryFormatError` on failure
+class ByteReader {
+public:
+    explicit ByteReader(std::span<unsigned char const> data): data(data) {}
+
+    ///
+    uint8_t u8() {
+        if (pos >= data.size()) {
+            throw BinaryFormatError{};
+        }
+        return data[pos++];
+    }
+
+    ///
+    uint64_t varint() {
+        uint64_t result = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = u8();
+            result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        throw BinaryFormatError{};
+    }
+
+    ///
+    int64_t svarint() {
+        uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1) ^
+               -static_cast<int64_t>(value & 1);
+    }
+
+    /// Reads \p size bytes in little endian order
+    uint64_t fixed(size_t size) {
+        uint64_t result = 0;
+        for (size_t i = 0; i < size; ++i) {
+            result |= static_cast<uint64_t>(u8()) << (8 * i);
+        }
+        return result;
+    }
+
+    /// \Returns a view of the next \p size bytes
+    std::string_view bytes(size_t size) {
+        if (size > data.size() - pos) {
+            throw BinaryFormatError{};
+        }
+        std::string_view result(reinterpret_cast<char const*>(&data[pos]),
+                                size);
+        pos += size;
+        return result;
+    }
+
+    /// Reads an element count. Every element occupies at least one byte, so
+    /// counts that exceed the remaining input are rejected before anything is
+    /// allocated
+    size_t count() {
+        uint64_t value = varint();
+        if (value > remaining()) {
+            throw BinaryFormatError{};
+        }
+        return static_cast<size_t>(value);
+    }
+
+    /// Reads an index into a table of size \p size
+    size_t index(size_t size) {
+        uint64_t value = varint();
+        if (value >= size) {
+            throw BinaryFormatError{};
+        }
+        return static_cast<size_t>(value);
+    }
+
+    /// Reads an enum value. If \p numEnumerators is not zero, values that are
+    /// not less than \p numEnumerators are rejected
+    template <typename E>
+    E enumValue(size_t numEnumerators = 0) {
+        uint64_t value = varint();
+        if (numEnumerators > 0 && value >= numEnumerators) {
+            throw BinaryFormatError{};
+        }
+        return static_cast<E>(value);
+    }
+
+    /// \Returns the current read position
+    size_t position() const { return pos; }
+
+    /// Sets the read position to \p position
+    void seek(size_t position) {
+        if (position > data.size()) {
+            throw BinaryFormatError{};
+        }
+        pos = position;
+    }
+
+    /// \Returns the number of bytes that have not been read yet
+    size_t remaining() const { return data.size() - pos; }
+
+    /// \Returns `true` if all bytes have been read
+    bool atEnd() const { return pos == data.size(); }
+
+private:
+    std::span<unsigned char const> data;
+    size_t pos = 0;
+};
+
+} // namespace scatha
+
+#endif // SCATHA_COMMON_BINARYIO_H_
@@ -0,0 +1,141 @@
+#include "Common/InternedString.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "Common/Allocator.h"
+
+using namespace scatha;
+
+namespace {
+
+/// Text of an interned string together with its hash, so the text is hashed
+/// only once per lookup and never again when the table rehashes
+struct Entry {
+    std::string_view text;
+    size_t hash;
+};
+
+struct EntryHash {
+    size_t operator()(Entry const& entry) const { return entry.hash; }
+};
+
+struct EntryEqual {
+    bool operator()(Entry const& a, Entry const& b) const {
+        return a.hash == b.hash && a.text == b.text;
+    }
+};
+
+/// The table is split into shards with separate locks so threads that intern
+/// different names rarely contend
+struct Shard {
+    std::shared_mutex mutex;
+    /// Elements of node based sets have stable addresses, interned strings
+    /// point to them
+    std::unordered_set<Entry, EntryHash, EntryEqual> entries;
+    /// Owns the text of the permanent entries
+    MonotonicBufferAllocator text;
+    /// Entries that were added while an `InternedStringScope` was alive
+    std::vector<Entry> scopedEntries;
+    /// Owns the text of the scoped entries
+    MonotonicBufferAllocator scopedText;
+};
+
+struct InternTable {
+    static constexpr size_t NumShards = 64;
+
+    Shard& shard(size_t hash) { return shards[hash % NumShards]; }
+
+    std::array<Shard, NumShards> shards;
+
+    /// Number of alive `InternedStringScope`s
+    std::atomic<size_t> numScopes = 0;
+
+    /// Serializes the creation and destruction of scopes
+    std::mutex scopeMutex;
+};
+
+} // namespace
+
+static InternTable& table() {
+    static InternTable* table = new InternTable();
+    return *table;
+}
+
+InternedString::InternedString(std::string_view text) {
+    if (text.empty()) {
+        return;
+    }
+    auto& tab = table();
+    Entry key{ text, std::hash<std::string_view>{}(text) };
+    auto& shard = tab.shard(key.hash);
+    {
+        std::shared_lock lock(shard.mutex);
+        auto itr = shard.entries.find(key);
+        if (itr != shard.entries.end()) {
+            entry = &itr->text;
+            return;
+        }
+    }
+    std::unique_lock lock(shard.mutex);
+    auto itr = shard.entries.find(key);
+    if (itr == shard.entries.end()) {
+        bool scoped = tab.numScopes.load(std::memory_order_relaxed) > 0;
+        auto& alloc = scoped ? shard.scopedText : shard.text;
+        auto* data = static_cast<char*>(alloc.allocate(text.size(), 1));
+        std::copy(text.begin(), text.end(), data);
+        key.text = std::string_view(data, text.size());
+        itr = shard.entries.insert(key).first;
+        if (scoped) {
+            shard.scopedEntries.push_back(key);
+        }
+    }
+    entry = &itr->text;
+}
+
+std::optional<InternedString> InternedString::find(std::string_view text) {
+    if (text.empty()) {
+        return InternedString();
+    }
+    Entry key{ text, std::hash<std::string_view>{}(text) };
+    auto& shard = table().shard(key.hash);
+    std::shared_lock lock(shard.mutex);
+    auto itr = shard.entries.find(key);
+    if (itr == shard.entries.end()) {
+        return std::nullopt;
+    }
+    return InternedString(&itr->text);
+}
+
+InternedStringScope::InternedStringScope() {
+    auto& tab = table();
+    std::lock_guard lock(tab.scopeMutex);
+    tab.numScopes.fetch_add(1, std::memory_order_relaxed);
+}
+
+InternedStringScope::~InternedStringScope() {
+    auto& tab = table();
+    std::lock_guard lock(tab.scopeMutex);
+    if (tab.numScopes.fetch_sub(1, std::memory_order_relaxed) > 1) {
+        return;
+    }
+    for (auto& shard: tab.shards) {
+        std::unique_lock shardLock(shard.mutex);
+        for (auto& entry: shard.scopedEntries) {
+            shard.entries.erase(entry);
+        }
+        shard.scopedEntries.clear();
+        shard.scopedText.release();
+    }
+}
+
+std::ostream& scatha::operator<<(std::ostream& ostream,
+                                 InternedString str) {
+    return ostream << str.str();
+}
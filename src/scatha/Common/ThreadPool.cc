@@ -0,0 +1,156 @@
+#include "Common/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+using namespace scatha;
+
+ThreadPool::ThreadPool(size_t numThreads) {
+    workers.reserve(numThreads);
+    for (size_t i = 0; i < numThreads; ++i) {
+        workers.emplace_back([this] { threadMain(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    cv.notify_all();
+    for (auto& worker: workers) {
+        worker.join();
+    }
+}
+
+namespace {
+
+struct GlobalPool {
+    std::mutex mutex;
+    std::unique_ptr<ThreadPool> pool;
+};
+
+} // namespace
+
+static GlobalPool& globalPool() {
+    static GlobalPool instance;
+    return instance;
+}
+
+static size_t defaultConcurrency() {
+    return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+ThreadPool& ThreadPool::global() {
+    auto& [mutex, pool] = globalPool();
+    std::lock_guard lock(mutex);
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(defaultConcurrency() - 1);
+    }
+    return *pool;
+}
+
+void ThreadPool::setGlobalConcurrency(size_t concurrency) {
+    if (concurrency == 0) {
+        concurrency = defaultConcurrency();
+    }
+    auto& [mutex, pool] = globalPool();
+    std::lock_guard lock(mutex);
+    if (pool && pool->numThreads() == concurrency - 1) {
+        return;
+    }
+    pool = std::make_unique<ThreadPool>(concurrency - 1);
+}
+
+void ThreadPool::threadMain() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(mutex);
+            cv.wait(lock, [&] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+    }
+}
+
+namespace {
+
+/// State of one `parallelFor()` invocation. Threads claim indices until all
+/// are taken, so a task that is dequeued after the job finished does nothing
+struct Job {
+    Job(utl::function_view<void(size_t)> fn, size_t count):
+        fn(fn), count(count), exceptions(count) {}
+
+    void work() {
+        size_t numRun = 0;
+        while (true) {
+            size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            if (index >= count) {
+                break;
+            }
+            try {
+                fn(index);
+            }
+            catch (...) {
+                exceptions[index] = std::current_exception();
+            }
+            ++numRun;
+        }
+        if (numRun == 0) {
+            return;
+        }
+        std::lock_guard lock(mutex);
+        numDone += numRun;
+        if (numDone == count) {
+            cv.notify_all();
+        }
+    }
+
+    void wait() {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return numDone == count; });
+    }
+
+    utl::function_view<void(size_t)> fn;
+    size_t count;
+    std::atomic<size_t> next = 0;
+    std::mutex mutex;
+    std::condition_variable cv;
+    size_t numDone = 0;
+    std::vector<std::exception_ptr> exceptions;
+};
+
+} // namespace
+
+void ThreadPool::parallelFor(size_t count,
+                             utl::function_view<void(size_t)> fn) {
+    if (count <= 1 || workers.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    auto job = std::make_shared<Job>(fn, count);
+    size_t numTasks = std::min(workers.size(), count - 1);
+    {
+        std::lock_guard lock(mutex);
+        for (size_t i = 0; i < numTasks; ++i) {
+            tasks.push_back([job] { job->work(); });
+        }
+    }
+    cv.notify_all();
+    job->work();
+    job->wait();
+    for (auto& exception: job->exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
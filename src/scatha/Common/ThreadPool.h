@@ -0,0 +1,64 @@
+#ifndef SCATHA_COMMON_THREADPOOL_H_
+#define SCATHA_COMMON_THREADPOOL_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <utl/function_view.hpp>
+
+#include "Common/Base.h"
+
+namespace scatha {
+
+/// Fixed size pool of worker threads used to run independent compilation
+/// steps like parsing multiple source files in parallel
+class SCTEST_API ThreadPool {
+public:
+    /// Creates a pool with \p numThreads worker threads. With zero worker
+    /// threads all work is done on the calling thread
+    explicit ThreadPool(size_t numThreads);
+
+    ThreadPool(ThreadPool const&) = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    /// Waits for all pending tasks and joins the worker threads
+    ~ThreadPool();
+
+    /// \Returns the process wide thread pool. Its size is the number of
+    /// hardware threads minus one, because the thread calling `parallelFor()`
+    /// also participates in the work
+    static ThreadPool& global();
+
+    /// Replaces the process wide thread pool by a pool that runs work on
+    /// \p concurrency threads including the calling thread. A value of zero
+    /// restores the default size.
+    /// Must not be called while the global pool is in use
+    static void setGlobalConcurrency(size_t concurrency);
+
+    /// \Returns the number of worker threads
+    size_t numThreads() const { return workers.size(); }
+
+    /// Invokes \p fn with every index in `[0, count)` and blocks until all
+    /// invocations have returned. The order and the threads on which the
+    /// invocations run are unspecified. If invocations throw, the exception
+    /// of the invocation with the lowest index is rethrown.
+    /// This function may be called recursively from within \p fn
+    void parallelFor(size_t count, utl::function_view<void(size_t)> fn);
+
+private:
+    void threadMain();
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::function<void()>> tasks;
+    bool stopping = false;
+};
+
+} // namespace scatha
+
+#endif // SCATHA_COMMON_THREADPOOL_H_
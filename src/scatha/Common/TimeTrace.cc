@@ -0,0 +1,229 @@
+#include "Common/TimeTrace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <ostream>
+#include <span>
+
+#include <nlohmann/json.hpp>
+#include <utl/hashtable.hpp>
+
+#include "Common/Allocator.h"
+
+using namespace scatha;
+using nlohmann::json;
+
+static std::atomic<TimeTrace*> gActiveTrace = nullptr;
+
+TimeTrace::TimeTrace(): start(std::chrono::steady_clock::now()) {}
+
+TimeTrace* TimeTrace::active() {
+    return gActiveTrace.load(std::memory_order_relaxed);
+}
+
+TimeTrace::Activation::Activation(TimeTrace* trace):
+    prev(gActiveTrace.exchange(trace)) {}
+
+TimeTrace::Activation::~Activation() { gActiveTrace.store(prev); }
+
+int64_t TimeTrace::now() const {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now() - start).count();
+}
+
+void TimeTrace::record(TraceEvent event) {
+    std::lock_guard lock(mutex);
+    auto id = std::this_thread::get_id();
+    auto itr = std::find(threads.begin(), threads.end(), id);
+    event.thread = static_cast<size_t>(itr - threads.begin());
+    if (itr == threads.end()) {
+        threads.push_back(id);
+    }
+    _events.push_back(std::move(event));
+}
+
+std::vector<TraceEvent> TimeTrace::events() const {
+    std::lock_guard lock(mutex);
+    return _events;
+}
+
+namespace {
+
+/// Accumulated events of one stage or pass
+struct Summary {
+    std::string category;
+    std::string name;
+    size_t calls = 0;
+    int64_t duration = 0;
+    int64_t instDelta = 0;
+    bool haveInstCounts = false;
+    std::optional<size_t> peakBytes;
+};
+
+} // namespace
+
+static double toMs(int64_t microseconds) {
+    return static_cast<double>(microseconds) / 1000.0;
+}
+
+void TimeTrace::printReport(std::ostream& str) const {
+    auto events = this->events();
+    /// Events are recorded on completion, so we sort by begin time to list
+    /// stages and passes in the order they start
+    std::stable_sort(events.begin(), events.end(),
+                     [](auto& a, auto& b) { return a.begin < b.begin; });
+    std::vector<Summary> summaries;
+    utl::hashmap<std::string, size_t> indices;
+    int64_t stageTime = 0;
+    for (auto& event: events) {
+        auto key = event.category + '\0' + event.name;
+        auto [itr, inserted] = indices.insert({ key, summaries.size() });
+        if (inserted) {
+            summaries.push_back({ .category = event.category,
+                                  .name = event.name });
+        }
+        auto& summary = summaries[itr->second];
+        ++summary.calls;
+        summary.duration += event.duration;
+        if (event.instCountBefore && event.instCountAfter) {
+            summary.haveInstCounts = true;
+            summary.instDelta += static_cast<int64_t>(*event.instCountAfter) -
+                                 static_cast<int64_t>(*event.instCountBefore);
+        }
+        if (event.peakBytes) {
+            summary.peakBytes =
+                std::max(summary.peakBytes.value_or(0), *event.peakBytes);
+        }
+        if (event.category == "stage") {
+            stageTime += event.duration;
+        }
+    }
+    auto flags = str.flags();
+    str << "Time report (" << std::fixed << std::setprecision(3)
+        << toMs(stageTime) << " ms)\n";
+    str << "  " << std::left << std::setw(10) << "Category" << std::setw(28)
+        << "Name" << std::right << std::setw(8) << "Calls" << std::setw(12)
+        << "Time (ms)" << std::setw(8) << "%" << std::setw(14) << "Inst delta"
+        << std::setw(16) << "Peak mem (B)" << "\n";
+    for (auto& summary: summaries) {
+        double percent =
+            stageTime > 0 ? 100.0 * static_cast<double>(summary.duration) /
+                                static_cast<double>(stageTime) :
+                            0.0;
+        str << "  " << std::left << std::setw(10) << summary.category
+            << std::setw(28) << summary.name << std::right << std::setw(8)
+            << summary.calls << std::setw(12) << std::setprecision(3)
+            << toMs(summary.duration) << std::setw(8) << std::setprecision(1)
+            << percent << std::setw(14);
+        if (summary.haveInstCounts) {
+            str << summary.instDelta;
+        }
+        else {
+            str << "-";
+        }
+        str << std::setw(16);
+        if (summary.peakBytes) {
+            str << *summary.peakBytes;
+        }
+        else {
+            str << "-";
+        }
+        str << "\n";
+    }
+    /// Per function events let us find single pathological functions
+    std::vector<TraceEvent const*> functionEvents;
+    for (auto& event: events) {
+        if (!event.function.empty()) {
+            functionEvents.push_back(&event);
+        }
+    }
+    size_t const numSlowest = std::min<size_t>(10, functionEvents.size());
+    std::partial_sort(functionEvents.begin(),
+                      functionEvents.begin() +
+                          static_cast<ptrdiff_t>(numSlowest),
+                      functionEvents.end(), [](auto* a, auto* b) {
+        return a->duration > b->duration;
+    });
+    if (numSlowest > 0) {
+        str << "Slowest function passes:\n";
+    }
+    for (auto* event: std::span(functionEvents).first(numSlowest)) {
+        str << "  " << std::left << std::setw(20) << event->name << std::right
+            << std::setw(12) << std::setprecision(3) << toMs(event->duration)
+            << " ms  " << event->function << "\n";
+    }
+    str.flags(flags);
+}
+
+void TimeTrace::writeChromeTrace(std::ostream& str) const {
+    json traceEvents = json::array();
+    for (auto& event: events()) {
+        json args = json::object();
+        if (!event.function.empty()) {
+            args["function"] = event.function;
+        }
+        if (event.instCountBefore) {
+            args["instsBefore"] = *event.instCountBefore;
+        }
+        if (event.instCountAfter) {
+            args["instsAfter"] = *event.instCountAfter;
+        }
+        if (event.peakBytes) {
+            args["peakBytes"] = *event.peakBytes;
+        }
+        traceEvents.push_back({ { "name", event.name },
+                                { "cat", event.category },
+                                { "ph", "X" },
+                                { "ts", event.begin },
+                                { "dur", event.duration },
+                                { "pid", 1 },
+                                { "tid", event.thread },
+                                { "args", std::move(args) } });
+    }
+    json j = { { "traceEvents", std::move(traceEvents) },
+               { "displayTimeUnit", "ms" } };
+    str << j << std::endl;
+}
+
+TraceScope::TraceScope(std::string_view name, std::string_view category):
+    trace(TimeTrace::active()) {
+    if (!trace) {
+        return;
+    }
+    event.name = std::string(name);
+    event.category = std::string(category);
+    event.begin = trace->now();
+}
+
+TraceScope::~TraceScope() {
+    if (!trace) {
+        return;
+    }
+    event.duration = trace->now() - event.begin;
+    if (trackPeak) {
+        event.peakBytes = AllocationStats::peakBytes();
+    }
+    trace->record(std::move(event));
+}
+
+void TraceScope::setFunction(std::string_view name) {
+    if (trace) {
+        event.function = std::string(name);
+    }
+}
+
+void TraceScope::setInstCountBefore(size_t count) {
+    event.instCountBefore = count;
+}
+
+void TraceScope::setInstCountAfter(size_t count) {
+    event.instCountAfter = count;
+}
+
+void TraceScope::trackPeakBytes() {
+    if (trace) {
+        AllocationStats::resetPeakBytes();
+        trackPeak = true;
+    }
+}
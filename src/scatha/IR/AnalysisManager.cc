@@ -0,0 +1,171 @@
+#include "IR/AnalysisManager.h"
+
+#include <array>
+#include <atomic>
+
+#include <range/v3/algorithm.hpp>
+
+#include "IR/CFG/Function.h"
+#include "IR/Dominance.h"
+#include "IR/Loop.h"
+
+using namespace scatha;
+using namespace ir;
+
+std::string_view ir::toString(Analysis analysis) {
+    switch (analysis) {
+    case Analysis::DomInfo:
+        return "DomInfo";
+    case Analysis::PostDomInfo:
+        return "PostDomInfo";
+    case Analysis::LoopNestingForest:
+        return "LoopNestingForest";
+    }
+    SC_UNREACHABLE();
+}
+
+namespace {
+
+/// Statistics are updated from all threads that optimize functions, so the
+/// counters are atomic
+struct AtomicStats {
+    std::atomic<size_t> hits = 0;
+    std::atomic<size_t> misses = 0;
+    std::atomic<size_t> invalidations = 0;
+};
+
+} // namespace
+
+static std::array<AtomicStats, NumAnalyses> gStats;
+
+static AtomicStats& getStats(Analysis analysis) {
+    return gStats[size_t(analysis)];
+}
+
+static void increment(std::atomic<size_t>& counter) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Returns \p result and records a hit if it is non-null. Otherwise invokes
+/// \p compute, caches and returns its result and records a miss
+template <typename T>
+static T& getOrCompute(Analysis analysis, std::unique_ptr<T>& result,
+                       auto compute) {
+    if (result) {
+        increment(getStats(analysis).hits);
+    }
+    else {
+        increment(getStats(analysis).misses);
+        result = compute();
+    }
+    return *result;
+}
+
+AnalysisManager::AnalysisManager(Function& function): function(function) {}
+
+AnalysisManager::~AnalysisManager() = default;
+
+DominanceInfo& AnalysisManager::domInfo() {
+    return getOrCompute(Analysis::DomInfo, _domInfo,
+                        [&] { return DominanceInfo::compute(function); });
+}
+
+DominanceInfo& AnalysisManager::postDomInfo() {
+    return getOrCompute(Analysis::PostDomInfo, _postDomInfo,
+                        [&] { return DominanceInfo::computePost(function); });
+}
+
+LoopNestingForest& AnalysisManager::LNF() {
+    return getOrCompute(Analysis::LoopNestingForest, _LNF, [&] {
+        return LoopNestingForest::compute(function, domInfo().domTree());
+    });
+}
+
+bool AnalysisManager::isCached(Analysis analysis) const {
+    switch (analysis) {
+    case Analysis::DomInfo:
+        return _domInfo != nullptr;
+    case Analysis::PostDomInfo:
+        return _postDomInfo != nullptr;
+    case Analysis::LoopNestingForest:
+        return _LNF != nullptr;
+    }
+    SC_UNREACHABLE();
+}
+
+void AnalysisManager::invalidate(Analysis analysis) {
+    drop(analysis);
+    for (size_t i = 0; i < NumAnalyses; ++i) {
+        auto dependent = Analysis(i);
+        if (ranges::contains(dependencies(dependent), analysis)) {
+            invalidate(dependent);
+        }
+    }
+}
+
+void AnalysisManager::invalidate(PreservedAnalyses preserved) {
+    for (size_t i = 0; i < NumAnalyses; ++i) {
+        auto analysis = Analysis(i);
+        if (!preserved.preserves(analysis)) {
+            invalidate(analysis);
+        }
+    }
+    /// Passes that preserve the CFG may still have rewritten instructions. The
+    /// loop infos reference instructions like the induction variables, so we
+    /// recompute them lazily
+    if (_LNF && !preserved.preservesAll()) {
+        _LNF->postorderDFS([](LNFNode* node) { node->invalidateLoopInfo(); });
+    }
+}
+
+void AnalysisManager::invalidateNonTransitive(Analysis analysis) {
+    drop(analysis);
+}
+
+std::span<Analysis const> AnalysisManager::dependencies(Analysis analysis) {
+    static constexpr Analysis LNFDeps[] = { Analysis::DomInfo };
+    switch (analysis) {
+    case Analysis::DomInfo:
+        return {};
+    case Analysis::PostDomInfo:
+        return {};
+    case Analysis::LoopNestingForest:
+        return LNFDeps;
+    }
+    SC_UNREACHABLE();
+}
+
+AnalysisStats AnalysisManager::stats(Analysis analysis) {
+    auto& stats = getStats(analysis);
+    return {
+        .hits = stats.hits.load(std::memory_order_relaxed),
+        .misses = stats.misses.load(std::memory_order_relaxed),
+        .invalidations = stats.invalidations.load(std::memory_order_relaxed),
+    };
+}
+
+void AnalysisManager::resetStats() {
+    for (auto& stats: gStats) {
+        stats.hits.store(0, std::memory_order_relaxed);
+        stats.misses.store(0, std::memory_order_relaxed);
+        stats.invalidations.store(0, std::memory_order_relaxed);
+    }
+}
+
+void AnalysisManager::drop(Analysis analysis) {
+    if (!isCached(analysis)) {
+        return;
+    }
+    increment(getStats(analysis).invalidations);
+    switch (analysis) {
+    case Analysis::DomInfo:
+        _domInfo = nullptr;
+        break;
+    case Analysis::PostDomInfo:
+        _postDomInfo = nullptr;
+        break;
+    case Analysis::LoopNestingForest:
+        _LNF = nullptr;
+        break;
+    }
+}
@@ -1,14 +1,1360 @@
 #include "IR/BinSerialize.h"
 
+#include <array>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <range/v3/algorithm.hpp>
+#include <range/v3/view.hpp>
+#include <utl/hashtable.hpp>
+#include <utl/vector.hpp>
+
+#include "Common/APFloat.h"
+#include "Common/APInt.h"
 #include "Common/Base.h"
+#include "Common/BinaryIO.h"
+#include "Common/Ranges.h"
+#include "IR/Attributes.h"
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/InvariantSetup.h"
+#include "IR/Module.h"
+#include "IR/PointerInfo.h"
+#include "IR/Type.h"
+#include "IR/Validate.h"
 
 using namespace scatha;
 using namespace ir;
 
-void ir::serializeBinary(ir::Module const&, std::ostream&) {
-    SC_UNIMPLEMENTED();
+/// # Format
+///
+/// All integers are LEB128 encoded unless stated otherwise. A module is encoded
+/// as
+///
+///     Magic "SCIR", FormatVersion
+///     Strings:     count, { length, bytes }
+///     Types:       count, { category, payload }
+///     Decls:       count, { node type, name, visibility, payload }
+///     Constants:   count, { node type, payload }
+///     Offsets:     { offset } for every declaration
+///     Definitions: { payload } for every declaration
+///
+/// The offsets of the definitions are relative to the start of the definition
+/// section, so definitions can be decoded out of order.
+/// Entries only reference entries of earlier sections or earlier entries of
+/// the same section. Only local values in function bodies may be referenced
+/// before they are defined. Values are referenced by indices tagged with a
+/// `RefKind`.
+
+namespace {
+
+constexpr std::array<char, 4> Magic = { 'S', 'C', 'I', 'R' };
+
+/// Must be incremented whenever the encoding changes
+constexpr uint64_t FormatVersion = 2;
+
+/// Kind of a value reference. Stored in the low bits of the encoded index
+enum class RefKind : uint8_t { Null, Local, Global, Constant };
+
+constexpr uint64_t RefKindBits = 2;
+
+/// Upper bound of the size of decoded types in bytes. Array counts and
+/// structure members are checked against it, so the size computations of
+/// the type classes cannot overflow
+constexpr size_t MaxTypeSize = size_t(1) << 48;
+
+/// Bits of the pointer info flag byte
+enum PtrInfoFlags : uint8_t {
+    HasPtrInfo = 1 << 0,
+    HasValidSize = 1 << 1,
+    HasProvOffset = 1 << 2,
+    StaticProv = 1 << 3,
+    NonNull = 1 << 4,
+    NonEscaping = 1 << 5,
+};
+
+/// Number of enumerators of the enums listed in `Lists.def.h`. Used to
+/// validate decoded enum values
+template <typename E>
+constexpr size_t EnumSize = 0;
+
+template <>
+constexpr size_t EnumSize<Conversion> = 0
+#define SC_CONVERSION_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+template <>
+constexpr size_t EnumSize<CompareMode> = 0
+#define SC_COMPARE_MODE_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+template <>
+constexpr size_t EnumSize<CompareOperation> = 0
+#define SC_COMPARE_OPERATION_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+template <>
+constexpr size_t EnumSize<UnaryArithmeticOperation> = 0
+#define SC_UNARY_ARITHMETIC_OPERATION_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+template <>
+constexpr size_t EnumSize<ArithmeticOperation> = 0
+#define SC_ARITHMETIC_OPERATION_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+template <>
+constexpr size_t EnumSize<Visibility> = 0
+#define SC_VISKIND_DEF(...) +1
+#include "IR/Lists.def.h"
+    ;
+
+struct Serializer {
+    explicit Serializer(Module const& mod): mod(mod) {
+        /// The empty string always has index zero
+        string({});
+    }
+
+    void run(std::ostream& out);
+
+    size_t string(std::string_view text);
+    size_t type(Type const* type);
+    size_t constant(Constant const* constant);
+    void valueRef(ByteWriter& out, Value const* value);
+
+    void declare(Global const& global);
+    void declareCallable(Callable const& callable);
+    void define(Global const& global);
+    void defineBody(Function const& function);
+    void instruction(Instruction const& inst);
+    void metadata(ByteWriter& out, Value const& value);
+
+    Module const& mod;
+    ByteWriter strings, types, decls, constants, defs;
+    size_t numStrings = 0;
+    utl::hashmap<std::string_view, size_t> stringIndices;
+    utl::hashmap<Type const*, size_t> typeIndices;
+    utl::hashmap<Global const*, size_t> globalIndices;
+    utl::hashmap<Constant const*, size_t> constantIndices;
+    utl::hashmap<Value const*, size_t> localIndices;
+};
+
+} // namespace
+
+void ir::serializeBinary(ir::Module const& mod, std::ostream& out) {
+    Serializer(mod).run(out);
+}
+
+void Serializer::run(std::ostream& out) {
+    auto globals = mod.globals() | TakeAddress | ToSmallVector<>;
+    for (auto& F: mod) {
+        globals.push_back(&F);
+    }
+    for (auto [index, global]: globals | ranges::views::enumerate) {
+        globalIndices.insert({ global, index });
+    }
+    /// Named structs are registered first to preserve their order
+    for (auto* structType: mod.structTypes()) {
+        type(structType);
+    }
+    decls.varint(globals.size());
+    for (auto* global: globals) {
+        declare(*global);
+    }
+    ByteWriter defOffsets;
+    for (auto* global: globals) {
+        defOffsets.varint(defs.size());
+        define(*global);
+    }
+    ByteWriter header;
+    header.bytes(std::string_view(Magic.data(), Magic.size()));
+    header.varint(FormatVersion);
+    header.varint(numStrings);
+    ByteWriter typeCount;
+    typeCount.varint(typeIndices.size());
+    ByteWriter constantCount;
+    constantCount.varint(constantIndices.size());
+    for (auto* section: { &header, &strings, &typeCount, &types, &decls,
+                          &constantCount, &constants, &defOffsets, &defs })
+    {
+        out.write(section->data().data(),
+                  static_cast<std::streamsize>(section->size()));
+    }
+}
+
+size_t Serializer::string(std::string_view text) {
+    auto [itr, success] = stringIndices.insert({ text, numStrings });
+    if (success) {
+        ++numStrings;
+        strings.varint(text.size());
+        strings.bytes(text);
+    }
+    return itr->second;
+}
+
+size_t Serializer::type(Type const* type) {
+    SC_EXPECT(type);
+    if (auto itr = typeIndices.find(type); itr != typeIndices.end()) {
+        return itr->second;
+    }
+    /// Element types are written first so entries only reference earlier
+    /// entries
+    utl::small_vector<size_t> elems;
+    if (auto* structType = dyncast<StructType const*>(type)) {
+        for (auto member: structType->members()) {
+            elems.push_back(this->type(member.type));
+        }
+    }
+    else if (auto* arrayType = dyncast<ArrayType const*>(type)) {
+        elems.push_back(this->type(arrayType->elementType()));
+    }
+    types.enumValue(type->category());
+    // clang-format off
+    SC_MATCH (*type) {
+        [&](VoidType const&) {},
+        [&](PointerType const&) {},
+        [&](ArithmeticType const& type) { types.varint(type.bitwidth()); },
+        [&](ArrayType const& type) {
+            types.varint(elems.front());
+            types.varint(type.count());
+        },
+        [&](StructType const& type) {
+            types.u8(type.isAnonymous());
+            if (!type.isAnonymous()) {
+                types.varint(string(type.name()));
+            }
+            types.varint(elems.size());
+            for (size_t index: elems) {
+                types.varint(index);
+            }
+        },
+        [&](FunctionType const&) {
+            SC_UNREACHABLE("Function types are not used by values");
+        },
+    }; // clang-format on
+    size_t index = typeIndices.size();
+    typeIndices.insert({ type, index });
+    return index;
+}
+
+size_t Serializer::constant(Constant const* constant) {
+    SC_EXPECT(!isa<Global>(constant));
+    if (auto itr = constantIndices.find(constant);
+        itr != constantIndices.end())
+    {
+        return itr->second;
+    }
+    /// Like types, record elements are written before the record
+    ByteWriter elems;
+    if (auto* record = dyncast<RecordConstant const*>(constant)) {
+        for (auto* elem: record->elements()) {
+            valueRef(elems, elem);
+        }
+    }
+    constants.enumValue(constant->nodeType());
+    // clang-format off
+    SC_MATCH (*constant) {
+        [&](IntegralConstant const& constant) {
+            SC_ASSERT(constant.type()->bitwidth() <= 64,
+                      "Can't handle extended width integers");
+            constants.varint(type(constant.type()));
+            constants.varint(constant.value().to<uint64_t>());
+        },
+        [&](FloatingPointConstant const& constant) {
+            constants.varint(type(constant.type()));
+            if (constant.value().precision() == APFloatPrec::Single()) {
+                constants.fixed(std::bit_cast<uint32_t>(
+                                    constant.value().to<float>()), 4);
+            }
+            else {
+                constants.fixed(std::bit_cast<uint64_t>(
+                                    constant.value().to<double>()), 8);
+            }
+        },
+        [&](NullPointerConstant const&) {},
+        [&](UndefValue const& constant) {
+            constants.varint(type(constant.type()));
+        },
+        [&](RecordConstant const& constant) {
+            constants.varint(type(constant.type()));
+            constants.bytes(elems.data());
+        },
+        [&](Constant const&) { SC_UNREACHABLE(); }
+    }; // clang-format on
+    size_t index = constantIndices.size();
+    constantIndices.insert({ constant, index });
+    return index;
+}
+
+static uint64_t encodeRef(RefKind kind, size_t index) {
+    return (static_cast<uint64_t>(index) << RefKindBits) |
+           static_cast<uint64_t>(kind);
+}
+
+void Serializer::valueRef(ByteWriter& out, Value const* value) {
+    if (!value) {
+        out.varint(encodeRef(RefKind::Null, 0));
+        return;
+    }
+    if (auto* global = dyncast<Global const*>(value)) {
+        auto itr = globalIndices.find(global);
+        SC_ASSERT(itr != globalIndices.end(), "Global is not in this module");
+        out.varint(encodeRef(RefKind::Global, itr->second));
+        return;
+    }
+    if (auto* constant = dyncast<Constant const*>(value)) {
+        /// Must be evaluated before writing to `out` because registering a new
+        /// record constant may write to the constant section
+        size_t index = this->constant(constant);
+        out.varint(encodeRef(RefKind::Constant, index));
+        return;
+    }
+    auto itr = localIndices.find(value);
+    SC_ASSERT(itr != localIndices.end(), "Value is not local to this function");
+    out.varint(encodeRef(RefKind::Local, itr->second));
+}
+
+void Serializer::declare(Global const& global) {
+    decls.enumValue(global.nodeType());
+    decls.varint(string(global.name()));
+    decls.enumValue(global.visibility());
+    // clang-format off
+    SC_MATCH (global) {
+        [&](GlobalVariable const& var) { decls.enumValue(var.mutability()); },
+        [&](Callable const& callable) { declareCallable(callable); },
+        [&](Global const&) { SC_UNREACHABLE(); }
+    }; // clang-format on
+}
+
+void Serializer::declareCallable(Callable const& callable) {
+    decls.varint(type(callable.returnType()));
+    decls.enumValue(callable.attributes());
+    decls.varint(callable.parameters().size());
+    for (auto& param: callable.parameters()) {
+        decls.varint(type(param.type()));
+        decls.varint(string(param.name()));
+        auto attribs = param.attributes() | ToSmallVector<>;
+        decls.varint(attribs.size());
+        for (auto* attrib: attribs) {
+            decls.enumValue(attrib->type());
+            // clang-format off
+            SC_MATCH (*attrib) {
+                [&](ByValAttribute const& attrib) {
+                    decls.varint(type(attrib.type()));
+                },
+                [&](ValRetAttribute const& attrib) {
+                    decls.varint(type(attrib.type()));
+                }
+            }; // clang-format on
+        }
+    }
+}
+
+void Serializer::define(Global const& global) {
+    // clang-format off
+    SC_MATCH (global) {
+        [&](GlobalVariable const& var) {
+            valueRef(defs, var.initializer());
+            metadata(defs, var);
+        },
+        [&](Callable const& callable) {
+            localIndices.clear();
+            for (auto& param: callable.parameters()) {
+                localIndices.insert({ &param, localIndices.size() });
+            }
+            auto* function = dyncast<Function const*>(&callable);
+            /// Local indices are assigned up front so parameters and
+            /// instructions can reference values that are defined later
+            if (function) {
+                for (auto& BB: *function) {
+                    localIndices.insert({ &BB, localIndices.size() });
+                }
+                for (auto& inst: function->instructions()) {
+                    localIndices.insert({ &inst, localIndices.size() });
+                }
+            }
+            for (auto& param: callable.parameters()) {
+                metadata(defs, param);
+            }
+            if (function) {
+                defineBody(*function);
+            }
+        },
+        [&](Global const&) { SC_UNREACHABLE(); }
+    }; // clang-format on
+}
+
+void Serializer::defineBody(Function const& function) {
+    defs.varint(ranges::distance(function));
+    for (auto& BB: function) {
+        defs.varint(string(BB.name()));
+        defs.varint(ranges::distance(BB));
+    }
+    for (auto& inst: function.instructions()) {
+        instruction(inst);
+    }
+}
+
+void Serializer::instruction(Instruction const& inst) {
+    defs.enumValue(inst.nodeType());
+    defs.varint(string(inst.name()));
+    defs.varint(string(inst.comment()));
+    defs.varint(type(inst.type()));
+    defs.varint(inst.typeOperands().size());
+    for (auto* typeOp: inst.typeOperands()) {
+        defs.varint(type(typeOp));
+    }
+    defs.varint(inst.numOperands());
+    // clang-format off
+    SC_MATCH (inst) {
+        [&](ConversionInst const& inst) { defs.enumValue(inst.conversion()); },
+        [&](CompareInst const& inst) {
+            defs.enumValue(inst.mode());
+            defs.enumValue(inst.operation());
+        },
+        [&](UnaryArithmeticInst const& inst) {
+            defs.enumValue(inst.operation());
+        },
+        [&](ArithmeticInst const& inst) { defs.enumValue(inst.operation()); },
+        [&](AccessValueInst const& inst) {
+            defs.varint(inst.memberIndices().size());
+            for (size_t index: inst.memberIndices()) {
+                defs.varint(index);
+            }
+        },
+        [&](Phi const& phi) {
+            for (auto* pred: phi.incomingEdges()) {
+                valueRef(defs, pred);
+            }
+        },
+        [&](Instruction const&) {}
+    }; // clang-format on
+    for (auto* operand: inst.operands()) {
+        valueRef(defs, operand);
+    }
+    metadata(defs, inst);
+}
+
+void Serializer::metadata(ByteWriter& out, Value const& value) {
+    auto* info = value.pointerInfo();
+    if (!info) {
+        out.u8(0);
+        return;
+    }
+    auto desc = info->getDesc();
+    uint8_t flags = HasPtrInfo;
+    flags |= desc.validSize ? HasValidSize : 0;
+    flags |= desc.staticProvenanceOffset ? HasProvOffset : 0;
+    flags |= desc.provenance.isStatic() ? StaticProv : 0;
+    flags |= desc.guaranteedNotNull ? NonNull : 0;
+    flags |= desc.nonEscaping ? NonEscaping : 0;
+    out.u8(flags);
+    out.svarint(desc.align);
+    if (desc.validSize) {
+        out.svarint(*desc.validSize);
+    }
+    if (desc.staticProvenanceOffset) {
+        out.svarint(*desc.staticProvenanceOffset);
+    }
+    valueRef(out, desc.provenance.value());
+}
+
+namespace {
+
+struct Deserializer {
+    Deserializer(Context& ctx, Module& mod,
+                 std::span<unsigned char const> data,
+                 ParseOptions const& options):
+        ctx(ctx), mod(mod), in(data), options(options) {}
+
+    void run();
+    void readDeclarations();
+
+    std::string_view string() { return strings[in.index(strings.size())]; }
+
+    template <typename E>
+    E readEnum() {
+        return in.enumValue<E>(EnumSize<E>);
+    }
+    Type const* type() { return types[in.index(types.size())]; }
+
+    template <typename T>
+    T const* type() {
+        auto* result = dyncast<T const*>(type());
+        if (!result) {
+            throw BinaryFormatError{};
+        }
+        return result;
+    }
+
+    void readStrings();
+    void readType();
+    Type const* readStructType();
+    void readDecl();
+    UniquePtr<Global> readCallableDecl(NodeType nodeType, std::string name);
+    void readConstant();
+    void readDefinition(Global& global);
+    void readBody(Function& function);
+    void checkBody(Function const& function,
+                   std::span<UniquePtr<BasicBlock> const> blocks);
+    void checkOperands(Function const& function, Instruction const& inst);
+    UniquePtr<Instruction> readInstruction();
+    void readMetadata(Value& value);
+
+    /// Reads a value reference and invokes \p assign with the referenced
+    /// value. References to local values that have not been decoded yet are
+    /// deferred until the function body has been decoded
+    template <typename F>
+    void readValueRef(F&& assign) {
+        uint64_t ref = in.varint();
+        auto kind = static_cast<RefKind>(ref & ((1 << RefKindBits) - 1));
+        uint64_t index = ref >> RefKindBits;
+        switch (kind) {
+        case RefKind::Null:
+            assign(nullptr);
+            return;
+        case RefKind::Local:
+            if (index < locals.size()) {
+                assign(locals[index]);
+            }
+            else {
+                pendingUpdates.push_back({ index, std::forward<F>(assign) });
+            }
+            return;
+        case RefKind::Global:
+            if (index >= globals.size()) {
+                throw BinaryFormatError{};
+            }
+            assign(globals[index]);
+            return;
+        case RefKind::Constant:
+            if (index >= constants.size()) {
+                throw BinaryFormatError{};
+            }
+            assign(constants[index]);
+            return;
+        }
+        throw BinaryFormatError{};
+    }
+
+    /// Reads a value reference that must not be deferred
+    Value* readValueRef() {
+        Value* result = nullptr;
+        bool assigned = false;
+        readValueRef([&](Value* value) {
+            result = value;
+            assigned = true;
+        });
+        if (!assigned) {
+            throw BinaryFormatError{};
+        }
+        return result;
+    }
+
+    void executePendingUpdates();
+
+    struct PendingUpdate {
+        uint64_t index;
+        std::function<void(Value*)> assign;
+    };
+
+    Context& ctx;
+    Module& mod;
+    ByteReader in;
+    ParseOptions options;
+    std::vector<std::string_view> strings;
+    std::vector<Type const*> types;
+    std::vector<Global*> globals;
+    std::vector<Constant*> constants;
+    std::vector<Value*> locals;
+    std::vector<PendingUpdate> pendingUpdates;
+    std::vector<size_t> defOffsets;
+    size_t defsBegin = 0;
+};
+
+} // namespace
+
+bool ir::deserializeBinary(ir::Context& ctx, ir::Module& mod, std::istream& in,
+                           ParseOptions const& options) {
+    std::vector<unsigned char> data(std::istreambuf_iterator<char>(in), {});
+    return deserializeBinary(ctx, mod, data, options);
+}
+
+bool ir::deserializeBinary(ir::Context& ctx, ir::Module& mod,
+                           std::span<unsigned char const> data,
+                           ParseOptions const& options) {
+    try {
+        Deserializer(ctx, mod, data, options).run();
+    }
+    catch (BinaryFormatError const&) {
+        return false;
+    }
+    if (options.assertInvariants) {
+        try {
+            assertInvariants(ctx, mod);
+        }
+        catch (InvariantException const&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void Deserializer::run() {
+    readDeclarations();
+    for (auto [global, offset]: ranges::views::zip(globals, defOffsets)) {
+        if (in.position() - defsBegin != offset) {
+            throw BinaryFormatError{};
+        }
+        readDefinition(*global);
+    }
+    if (!in.atEnd()) {
+        throw BinaryFormatError{};
+    }
+}
+
+void Deserializer::readDeclarations() {
+    if (in.bytes(Magic.size()) != std::string_view(Magic.data(), Magic.size()))
+    {
+        throw BinaryFormatError{};
+    }
+    if (in.varint() != FormatVersion) {
+        throw BinaryFormatError{};
+    }
+    readStrings();
+    size_t numTypes = in.count();
+    types.reserve(numTypes);
+    for (size_t i = 0; i < numTypes; ++i) {
+        readType();
+    }
+    size_t numGlobals = in.count();
+    globals.reserve(numGlobals);
+    for (size_t i = 0; i < numGlobals; ++i) {
+        readDecl();
+    }
+    size_t numConstants = in.count();
+    constants.reserve(numConstants);
+    for (size_t i = 0; i < numConstants; ++i) {
+        readConstant();
+    }
+    defOffsets.reserve(globals.size());
+    for (size_t i = 0; i < globals.size(); ++i) {
+        defOffsets.push_back(in.varint());
+    }
+    defsBegin = in.position();
+}
+
+void Deserializer::readStrings() {
+    size_t count = in.count();
+    strings.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        strings.push_back(in.bytes(in.varint()));
+    }
+}
+
+void Deserializer::readType() {
+    auto category = readEnum<TypeCategory>();
+    Type const* result = [&]() -> Type const* {
+        switch (category) {
+        case TypeCategory::VoidType:
+            return ctx.voidType();
+        case TypeCategory::PointerType:
+            return ctx.ptrType();
+        case TypeCategory::IntegralType: {
+            size_t bitwidth = in.varint();
+            if (bitwidth == 0 || bitwidth > 64) {
+                throw BinaryFormatError{};
+            }
+            return ctx.intType(bitwidth);
+        }
+        case TypeCategory::FloatType: {
+            size_t bitwidth = in.varint();
+            if (bitwidth != 32 && bitwidth != 64) {
+                throw BinaryFormatError{};
+            }
+            return ctx.floatType(bitwidth);
+        }
+        case TypeCategory::ArrayType: {
+            auto* elemType = type();
+            uint64_t count = in.varint();
+            if (isa<VoidType>(elemType) ||
+                (elemType->size() > 0 &&
+                 count > MaxTypeSize / elemType->size()))
+            {
+                throw BinaryFormatError{};
+            }
+            return ctx.arrayType(elemType, count);
+        }
+        case TypeCategory::VectorType: {
+            auto* elemType = type<ArithmeticType>();
+            uint64_t count = in.varint();
+            if (!VectorType::isValid(elemType, count)) {
+                throw BinaryFormatError{};
+            }
+            return ctx.vectorType(elemType, count);
+        }
+        case TypeCategory::StructType:
+            return readStructType();
+        default:
+            throw BinaryFormatError{};
+        }
+    }();
+    types.push_back(result);
+}
+
+Type const* Deserializer::readStructType() {
+    bool isAnonymous = in.u8();
+    std::string_view name = isAnonymous ? std::string_view{} : string();
+    size_t numMembers = in.count();
+    utl::small_vector<Type const*> members;
+    members.reserve(numMembers);
+    size_t size = 0;
+    for (size_t i = 0; i < numMembers; ++i) {
+        auto* member = type();
+        /// Padding adds at most the alignment of the member
+        size += member->size() + member->align();
+        if (isa<VoidType>(member) || size > MaxTypeSize) {
+            throw BinaryFormatError{};
+        }
+        members.push_back(member);
+    }
+    if (isAnonymous) {
+        return ctx.anonymousStruct(members);
+    }
+    auto structType = allocate<StructType>(std::string(name), members);
+    DeclToken declToken;
+    if (options.typeParseCallback) {
+        options.typeParseCallback(*structType, declToken);
+    }
+    if (!declToken.shallIgnore()) {
+        return mod.addStructure(std::move(structType));
+    }
+    /// Like the text parser we resolve ignored declarations to the existing
+    /// structure of the same name
+    auto structures = mod.structTypes();
+    auto itr = ranges::find_if(structures,
+                               [&](auto* type) { return type->name() == name; });
+    if (itr == ranges::end(structures)) {
+        throw BinaryFormatError{};
+    }
+    return *itr;
+}
+
+void Deserializer::readDecl() {
+    auto nodeType = readEnum<NodeType>();
+    auto name = std::string(string());
+    auto vis = readEnum<Visibility>();
+    UniquePtr<Global> global;
+    switch (nodeType) {
+    case NodeType::GlobalVariable: {
+        auto mut = readEnum<GlobalVariable::Mutability>();
+        if (mut != GlobalVariable::Mutable && mut != GlobalVariable::Const) {
+            throw BinaryFormatError{};
+        }
+        global = allocate<GlobalVariable>(ctx, mut, nullptr, std::move(name));
+        break;
+    }
+    case NodeType::Function:
+        [[fallthrough]];
+    case NodeType::ForeignFunction:
+        global = readCallableDecl(nodeType, std::move(name));
+        break;
+    default:
+        throw BinaryFormatError{};
+    }
+    global->setVisibility(vis);
+    globals.push_back(global.get());
+    DeclToken declToken;
+    if (options.objectParseCallback) {
+        options.objectParseCallback(*global, declToken);
+    }
+    SC_ASSERT(!declToken.shallIgnore(),
+              "Globals may be referenced and can't be ignored");
+    mod.addGlobal(std::move(global));
+}
+
+UniquePtr<Global> Deserializer::readCallableDecl(NodeType nodeType,
+                                                 std::string name) {
+    auto* returnType = type();
+    auto attribs = readEnum<FunctionAttribute>();
+    size_t numParams = in.count();
+    List<Parameter> params;
+    for (size_t index = 0; index < numParams; ++index) {
+        auto* paramType = type();
+        auto paramName = std::string(string());
+        auto param = allocate<Parameter>(paramType, index, std::move(paramName),
+                                         nullptr);
+        size_t numAttribs = in.count();
+        for (size_t i = 0; i < numAttribs; ++i) {
+            switch (readEnum<AttributeType>()) {
+            case AttributeType::ByValAttribute:
+                param->addAttribute(allocate<ByValAttribute>(type()));
+                break;
+            case AttributeType::ValRetAttribute:
+                param->addAttribute(allocate<ValRetAttribute>(type()));
+                break;
+            default:
+                throw BinaryFormatError{};
+            }
+        }
+        params.push_back(param.release());
+    }
+    if (nodeType == NodeType::ForeignFunction) {
+        return allocate<ForeignFunction>(ctx, returnType, std::move(params),
+                                         std::move(name), attribs);
+    }
+    return allocate<Function>(ctx, returnType, std::move(params),
+                              std::move(name), attribs);
+}
+
+void Deserializer::readConstant() {
+    auto nodeType = readEnum<NodeType>();
+    Constant* result = [&]() -> Constant* {
+        switch (nodeType) {
+        case NodeType::IntegralConstant: {
+            auto* intType = type<IntegralType>();
+            return ctx.intConstant(in.varint(), intType->bitwidth());
+        }
+        case NodeType::FloatingPointConstant: {
+            auto* floatType = type<FloatType>();
+            if (floatType->bitwidth() == 32) {
+                auto value = std::bit_cast<float>(
+                    static_cast<uint32_t>(in.fixed(4)));
+                return ctx.floatConstant(value, 32);
+            }
+            return ctx.floatConstant(std::bit_cast<double>(in.fixed(8)), 64);
+        }
+        case NodeType::NullPointerConstant:
+            return ctx.nullpointer();
+        case NodeType::UndefValue:
+            return ctx.undef(type());
+        case NodeType::StructConstant:
+            [[fallthrough]];
+        case NodeType::ArrayConstant: {
+            auto* recordType = type<RecordType>();
+            /// Every element reference occupies at least one byte
+            if (recordType->numElements() > in.remaining()) {
+                throw BinaryFormatError{};
+            }
+            utl::small_vector<Constant*> elems;
+            elems.reserve(recordType->numElements());
+            for (size_t i = 0; i < recordType->numElements(); ++i) {
+                auto* elem = dyncast<Constant*>(readValueRef());
+                if (!elem || elem->type() != recordType->elementAt(i)) {
+                    throw BinaryFormatError{};
+                }
+                elems.push_back(elem);
+            }
+            return ctx.recordConstant(elems, recordType);
+        }
+        default:
+            throw BinaryFormatError{};
+        }
+    }();
+    constants.push_back(result);
+}
+
+void Deserializer::readDefinition(Global& global) {
+    if (auto* var = dyncast<GlobalVariable*>(&global)) {
+        locals.clear();
+        auto* init = dyncast<Constant*>(readValueRef());
+        if (!init) {
+            throw BinaryFormatError{};
+        }
+        var->setInitializer(init);
+        readMetadata(*var);
+        return;
+    }
+    auto& callable = cast<Callable&>(global);
+    locals.clear();
+    for (auto& param: callable.parameters()) {
+        locals.push_back(&param);
+    }
+    for (auto& param: callable.parameters()) {
+        readMetadata(param);
+    }
+    if (auto* function = dyncast<Function*>(&callable)) {
+        readBody(*function);
+    }
+    else {
+        executePendingUpdates();
+    }
+}
+
+void Deserializer::readBody(Function& function) {
+    /// Bodies are also read lazily while another function is being processed
+    NodeAllocatorScope allocScope(function);
+    size_t numBlocks = in.count();
+    utl::small_vector<UniquePtr<BasicBlock>> blocks;
+    utl::small_vector<size_t> blockSizes;
+    blocks.reserve(numBlocks);
+    for (size_t i = 0; i < numBlocks; ++i) {
+        blocks.push_back(allocate<BasicBlock>(ctx, std::string(string())));
+        blockSizes.push_back(in.count());
+        locals.push_back(blocks.back().get());
+    }
+    for (auto [BB, size]: ranges::views::zip(blocks, blockSizes)) {
+        for (size_t i = 0; i < size; ++i) {
+            auto inst = readInstruction();
+            locals.push_back(inst.get());
+            BB->pushBack(std::move(inst));
+        }
+    }
+    executePendingUpdates();
+    checkBody(function, blocks);
+    for (auto& BB: blocks) {
+        function.pushBack(std::move(BB));
+    }
+    setupInvariants(ctx, function);
+    /// Phi arguments must be in the order of the predecessors which are
+    /// recomputed by `setupInvariants()`
+    for (auto& BB: function) {
+        for (auto& phi: BB.phiNodes()) {
+            /// `operandOf()` requires every predecessor to be listed
+            for (auto* pred: BB.predecessors()) {
+                if (!ranges::contains(phi.incomingEdges(), pred)) {
+                    throw BinaryFormatError{};
+                }
+            }
+            auto sortedArgs = BB.predecessors() |
+                              ranges::views::transform([&](BasicBlock* pred) {
+                return PhiMapping{ pred, phi.operandOf(pred) };
+            }) | ToSmallVector<>;
+            phi.setArguments(sortedArgs);
+        }
+    }
+}
+
+/// Rejects bodies that are well formed on the byte level but not valid IR.
+/// `setupInvariants()` and the passes that run on imported code assume
+/// terminated blocks, leading phi nodes and well typed operands.
+/// `assertInvariants()` does not check all of this and is not run on lazily
+/// imported functions
+void Deserializer::checkBody(Function const& function,
+                             std::span<UniquePtr<BasicBlock> const> blocks) {
+    for (auto& BB: blocks) {
+        if (BB->empty() || !isa<TerminatorInst>(BB->back())) {
+            throw BinaryFormatError{};
+        }
+        bool phiAllowed = true;
+        for (auto& inst: *BB) {
+            if (isa<TerminatorInst>(inst) && &inst != &BB->back()) {
+                throw BinaryFormatError{};
+            }
+            if (isa<Phi>(inst) && !phiAllowed) {
+                throw BinaryFormatError{};
+            }
+            phiAllowed &= isa<Phi>(inst);
+            checkOperands(function, inst);
+        }
+    }
+}
+
+/// \Returns the type of the member of \p type at \p indices or null if the
+/// indices are invalid
+static Type const* memberType(Type const* type,
+                              std::span<size_t const> indices) {
+    for (size_t index: indices) {
+        auto* record = dyncast<RecordType const*>(type);
+        if (!record || index >= record->numElements()) {
+            return nullptr;
+        }
+        type = record->elementAt(index);
+    }
+    return type;
+}
+
+static bool isScalarOrVector(Type const* type) {
+    return isa<ArithmeticType>(type) || isa<VectorType>(type);
+}
+
+void Deserializer::checkOperands(Function const& function,
+                                 Instruction const& inst) {
+    auto require = [](bool condition) {
+        if (!condition) {
+            throw BinaryFormatError{};
+        }
+    };
+    /// Only the targets of gotos and branches may be blocks. The targets are
+    /// checked below
+    for (auto [index, operand]: inst.operands() | ranges::views::enumerate) {
+        require(operand != nullptr);
+        require(!isa<BasicBlock>(operand) || isa<Goto>(inst) ||
+                (isa<Branch>(inst) && index > 0));
+    }
+    auto* ptr = ctx.ptrType();
+    auto* i1 = ctx.intType(1);
+    // clang-format off
+    SC_MATCH (inst) {
+        [&](Alloca const& alloc) {
+            require(isa<IntegralType>(alloc.count()->type()));
+        },
+        [&](Load const& load) {
+            require(load.address()->type() == ptr);
+            require(!isa<VoidType>(load.type()));
+        },
+        [&](Store const& store) {
+            require(store.address()->type() == ptr);
+            require(!isa<VoidType>(store.value()->type()));
+        },
+        [&](ConversionInst const& conv) {
+            auto* from = conv.operand()->type();
+            require(isScalarOrVector(from) || from == ptr);
+            require(isScalarOrVector(conv.type()) || conv.type() == ptr);
+        },
+        [&](CompareInst const& cmp) {
+            auto* type = cmp.lhs()->type();
+            require(type == cmp.rhs()->type());
+            if (auto* vecType = dyncast<VectorType const*>(type)) {
+                require(cmp.type() == ctx.maskType(vecType));
+                return;
+            }
+            require(isa<ArithmeticType>(type) || type == ptr);
+            require(cmp.type() == i1);
+        },
+        [&](UnaryArithmeticInst const& unary) {
+            require(isScalarOrVector(unary.operand()->type()));
+            if (unary.operation() == UnaryArithmeticOperation::LogicalNot) {
+                require(unary.type() == i1);
+            }
+            else {
+                require(unary.type() == unary.operand()->type());
+            }
+        },
+        [&](ArithmeticInst const& arith) {
+            auto* type = arith.lhs()->type();
+            require(isScalarOrVector(type) && arith.type() == type);
+            if (isShift(arith.operation())) {
+                require(isScalarOrVector(arith.rhs()->type()));
+            }
+            else {
+                require(arith.rhs()->type() == type);
+            }
+            if (isa<VectorType>(type)) {
+                require(hasVectorForm(arith.operation()));
+            }
+        },
+        [&](Goto const& gotoInst) {
+            require(isa<BasicBlock>(gotoInst.operandAt(0)));
+        },
+        [&](Branch const& branch) {
+            require(branch.condition()->type() == i1);
+            require(isa<BasicBlock>(branch.operandAt(1)));
+            require(isa<BasicBlock>(branch.operandAt(2)));
+        },
+        [&](Return const& ret) {
+            require(ret.value()->type() == function.returnType());
+        },
+        [&](Call const& call) {
+            auto* callee = dyncast<Callable const*>(call.function());
+            if (!callee) {
+                require(call.function()->type() == ptr);
+                return;
+            }
+            require(call.type() == callee->returnType());
+            require(ranges::distance(callee->parameters()) ==
+                    ranges::distance(call.arguments()));
+            for (auto [param, arg]:
+                 ranges::views::zip(callee->parameters(), call.arguments()))
+            {
+                require(param.type() == arg->type());
+            }
+        },
+        [&](Phi const& phi) {
+            for (auto* arg: phi.operands()) {
+                require(arg->type() == phi.type());
+            }
+        },
+        [&](Select const& select) {
+            auto* condType = select.condition()->type();
+            auto* vecType = dyncast<VectorType const*>(select.type());
+            require(condType == i1 ||
+                    (vecType && condType == ctx.maskType(vecType)));
+            require(select.thenValue()->type() == select.type());
+            require(select.elseValue()->type() == select.type());
+        },
+        [&](GetElementPointer const& gep) {
+            require(gep.basePointer()->type() == ptr);
+            require(isa<IntegralType>(gep.arrayIndex()->type()));
+            require(memberType(gep.inboundsType(), gep.memberIndices()));
+            require(gep.type() == ptr);
+        },
+        [&](ExtractValue const& extract) {
+            require(memberType(extract.baseValue()->type(),
+                               extract.memberIndices()) == extract.type());
+        },
+        [&](InsertValue const& insert) {
+            require(insert.baseValue()->type() == insert.type());
+            require(memberType(insert.type(), insert.memberIndices()) ==
+                    insert.insertedValue()->type());
+        },
+        [](Instruction const&) {}
+    }; // clang-format on
+}
+
+UniquePtr<Instruction> Deserializer::readInstruction() {
+    auto nodeType = readEnum<NodeType>();
+    auto name = std::string(string());
+    auto comment = string();
+    auto* instType = type();
+    size_t numTypeOps = in.count();
+    utl::small_vector<Type const*> typeOps;
+    for (size_t i = 0; i < numTypeOps; ++i) {
+        typeOps.push_back(type());
+    }
+    auto typeOpAt = [&](size_t index) {
+        if (index >= typeOps.size()) {
+            throw BinaryFormatError{};
+        }
+        return typeOps[index];
+    };
+    size_t numOperands = in.count();
+    auto readIndices = [&] {
+        size_t count = in.count();
+        utl::small_vector<size_t> indices;
+        for (size_t i = 0; i < count; ++i) {
+            indices.push_back(in.varint());
+        }
+        return indices;
+    };
+    UniquePtr<Instruction> inst;
+    switch (nodeType) {
+    case NodeType::Alloca:
+        inst = allocate<Alloca>(ctx, typeOpAt(0), std::move(name));
+        break;
+    case NodeType::Load:
+        inst = allocate<Load>(nullptr, instType, std::move(name));
+        break;
+    case NodeType::Store:
+        inst = allocate<Store>(ctx, nullptr, nullptr);
+        break;
+    case NodeType::ConversionInst: {
+        auto conv = readEnum<Conversion>();
+        inst = allocate<ConversionInst>(nullptr, instType, conv,
+                                        std::move(name));
+        break;
+    }
+    case NodeType::CompareInst: {
+        auto mode = readEnum<CompareMode>();
+        auto op = readEnum<CompareOperation>();
+        inst = allocate<CompareInst>(ctx, nullptr, nullptr, mode, op,
+                                     std::move(name));
+        break;
+    }
+    case NodeType::UnaryArithmeticInst: {
+        auto op = readEnum<UnaryArithmeticOperation>();
+        inst = allocate<UnaryArithmeticInst>(ctx, nullptr, op, std::move(name));
+        break;
+    }
+    case NodeType::ArithmeticInst: {
+        auto op = readEnum<ArithmeticOperation>();
+        inst = allocate<ArithmeticInst>(nullptr, nullptr, op, std::move(name));
+        break;
+    }
+    case NodeType::Goto:
+        inst = allocate<Goto>(ctx, nullptr);
+        break;
+    case NodeType::Branch:
+        inst = allocate<Branch>(ctx, nullptr, nullptr, nullptr);
+        break;
+    case NodeType::Return:
+        inst = allocate<Return>(ctx, nullptr);
+        break;
+    case NodeType::Call: {
+        if (numOperands == 0) {
+            throw BinaryFormatError{};
+        }
+        utl::small_vector<Value*> nullArgs(numOperands - 1);
+        inst = allocate<Call>(instType, nullptr, nullArgs, std::move(name));
+        break;
+    }
+    case NodeType::Phi: {
+        auto phi = allocate<Phi>(instType, numOperands, std::move(name));
+        for (size_t index = 0; index < numOperands; ++index) {
+            auto* pred = dyncast<BasicBlock*>(readValueRef());
+            if (!pred) {
+                throw BinaryFormatError{};
+            }
+            phi->setPredecessor(index, pred);
+        }
+        inst = std::move(phi);
+        break;
+    }
+    case NodeType::Select:
+        inst = allocate<Select>(nullptr, nullptr, nullptr, std::move(name));
+        break;
+    case NodeType::GetElementPointer: {
+        auto indices = readIndices();
+        inst = allocate<GetElementPointer>(ctx, typeOpAt(0), nullptr, nullptr,
+                                           indices, std::move(name));
+        break;
+    }
+    case NodeType::ExtractValue: {
+        auto indices = readIndices();
+        inst = allocate<ExtractValue>(nullptr, indices, std::move(name));
+        break;
+    }
+    case NodeType::InsertValue: {
+        auto indices = readIndices();
+        inst = allocate<InsertValue>(nullptr, nullptr, indices,
+                                     std::move(name));
+        break;
+    }
+    default:
+        throw BinaryFormatError{};
+    }
+    if (inst->numOperands() != numOperands ||
+        inst->typeOperands().size() != typeOps.size())
+    {
+        throw BinaryFormatError{};
+    }
+    inst->setType(instType);
+    inst->setComment(std::string(comment));
+    User* user = inst.get();
+    for (size_t index = 0; index < numOperands; ++index) {
+        readValueRef([=](Value* value) { user->setOperand(index, value); });
+    }
+    readMetadata(*inst);
+    return inst;
+}
+
+void Deserializer::readMetadata(Value& value) {
+    uint8_t flags = in.u8();
+    if (!(flags & HasPtrInfo)) {
+        return;
+    }
+    ssize_t align = in.svarint();
+    std::optional<ssize_t> validSize;
+    if (flags & HasValidSize) {
+        validSize = in.svarint();
+    }
+    std::optional<ssize_t> provOffset;
+    if (flags & HasProvOffset) {
+        provOffset = in.svarint();
+    }
+    readValueRef([=, value = &value](Value* prov) {
+        value->setPointerInfo({ .align = align,
+                                .validSize = validSize,
+                                .provenance = PointerProvenance(
+                                    prov, flags & StaticProv),
+                                .staticProvenanceOffset = provOffset,
+                                .guaranteedNotNull = bool(flags & NonNull),
+                                .nonEscaping = bool(flags & NonEscaping) });
+    });
+}
+
+void Deserializer::executePendingUpdates() {
+    for (auto& [index, assign]: pendingUpdates) {
+        if (index >= locals.size()) {
+            throw BinaryFormatError{};
+        }
+        assign(locals[index]);
+    }
+    pendingUpdates.clear();
+}
+
+struct LazyModuleImport::Impl {
+    Impl(Context& ctx, Module& mod,
+         std::shared_ptr<std::vector<unsigned char> const> data,
+         ParseOptions const& options):
+        data(std::move(data)), deserializer(ctx, mod, *this->data, options) {}
+
+    std::shared_ptr<std::vector<unsigned char> const> data;
+    Deserializer deserializer;
+    /// Indices of the globals declared by this import
+    utl::hashmap<Global const*, size_t> indices;
+    utl::hashset<Function const*> pending;
+};
+
+LazyModuleImport::LazyModuleImport(std::unique_ptr<Impl> impl):
+    impl(std::move(impl)) {}
+
+LazyModuleImport::~LazyModuleImport() = default;
+
+std::unique_ptr<LazyModuleImport> LazyModuleImport::Open(
+    ir::Context& ctx, ir::Module& mod, std::vector<unsigned char> data,
+    ParseOptions const& options) {
+    return Open(ctx, mod,
+                std::make_shared<std::vector<unsigned char> const>(
+                    std::move(data)),
+                options);
+}
+
+std::unique_ptr<LazyModuleImport> LazyModuleImport::Open(
+    ir::Context& ctx, ir::Module& mod,
+    std::shared_ptr<std::vector<unsigned char> const> data,
+    ParseOptions const& options) {
+    SC_EXPECT(data);
+    auto impl = std::make_unique<Impl>(ctx, mod, std::move(data), options);
+    auto& deserializer = impl->deserializer;
+    try {
+        deserializer.readDeclarations();
+        auto& globals = deserializer.globals;
+        for (auto [index, global]: globals | ranges::views::enumerate) {
+            impl->indices.insert({ global, index });
+            if (auto* function = dyncast<Function*>(global)) {
+                impl->pending.insert(function);
+                continue;
+            }
+            deserializer.in.seek(deserializer.defsBegin +
+                                 deserializer.defOffsets[index]);
+            deserializer.readDefinition(*global);
+        }
+    }
+    catch (BinaryFormatError const&) {
+        return nullptr;
+    }
+    /// The callbacks may not outlive this call
+    deserializer.options = {};
+    return std::unique_ptr<LazyModuleImport>(
+        new LazyModuleImport(std::move(impl)));
+}
+
+bool LazyModuleImport::isImported(ir::Global const& global) const {
+    return impl->indices.contains(&global);
+}
+
+bool LazyModuleImport::isPending(ir::Function const& function) const {
+    return impl->pending.contains(&function);
+}
+
+bool LazyModuleImport::materialize(ir::Function& function) {
+    SC_EXPECT(isPending(function));
+    impl->pending.erase(&function);
+    auto& deserializer = impl->deserializer;
+    size_t index = impl->indices[&function];
+    try {
+        deserializer.in.seek(deserializer.defsBegin +
+                             deserializer.defOffsets[index]);
+        deserializer.readDefinition(function);
+    }
+    catch (BinaryFormatError const&) {
+        deserializer.pendingUpdates.clear();
+        return false;
+    }
+    return true;
 }
 
-bool ir::deserializeBinary(ir::Context&, ir::Module&, std::istream&) {
-    SC_UNIMPLEMENTED();
+void LazyModuleImport::replaceGlobal(ir::Global const& global,
+                                     ir::Global& replacement) {
+    auto itr = impl->indices.find(&global);
+    if (itr == impl->indices.end()) {
+        return;
+    }
+    impl->deserializer.globals[itr->second] = &replacement;
+    if (auto* function = dyncast<Function const*>(&global)) {
+        impl->pending.erase(function);
+    }
+    impl->indices.erase(itr);
 }
@@ -4,6 +4,7 @@
 
 #include <range/v3/view.hpp>
 
+#include "IR/AnalysisManager.h"
 #include "IR/Attributes.h"
 #include "IR/Context.h"
 #include "IR/Dominance.h"
@@ -48,12 +49,6 @@ Callable::Callable(NodeType nodeType, Context& ctx, Type const* returnType,
                      .guaranteedNotNull = true });
 }
 
-struct Function::AnalysisData {
-    std::unique_ptr<DominanceInfo> domInfo;
-    std::unique_ptr<DominanceInfo> postDomInfo;
-    std::unique_ptr<LoopNestingForest> LNF;
-};
-
 static void uniqueParams(auto&& params, auto&& nameFac) {
     for (auto& param: params) {
         bool const nameUnique = nameFac.tryRegister(param.name());
@@ -67,49 +62,36 @@ Function::Function(Context& ctx, Type const* returnType,
     Callable(NodeType::Function, ctx, returnType, std::move(parameters),
              std::move(name), attr, vis),
     nameFac(),
-    analysisData(std::make_unique<AnalysisData>()) {
+    _analysisManager(std::make_unique<AnalysisManager>(*this)),
+    _nodeAllocator(NodeAllocator::create()) {
     uniqueParams(this->parameters(), nameFac);
 }
 
-Function::~Function() = default;
+Function::~Function() { _nodeAllocator->release(); }
 
 DomTree const& Function::getOrComputeDomTree() const {
     return getOrComputeDomInfo().domTree();
 }
 
 DominanceInfo const& Function::getOrComputeDomInfo() const {
-    if (!analysisData->domInfo) {
-        analysisData->domInfo =
-            DominanceInfo::compute(const_cast<Function&>(*this));
-    }
-    return *analysisData->domInfo;
+    return _analysisManager->domInfo();
 }
 
 DominanceInfo const& Function::getOrComputePostDomInfo() const {
-    if (!analysisData->postDomInfo) {
-        analysisData->postDomInfo =
-            DominanceInfo::computePost(const_cast<Function&>(*this));
-    }
-    return *analysisData->postDomInfo;
+    return _analysisManager->postDomInfo();
 }
 
 LoopNestingForest const& Function::getOrComputeLNF() const {
-    if (!analysisData->LNF) {
-        analysisData->LNF =
-            LoopNestingForest::compute(const_cast<Function&>(*this),
-                                       getOrComputeDomTree());
-    }
-    return *analysisData->LNF;
+    return _analysisManager->LNF();
 }
 
 void Function::invalidateDomInfo() {
-    analysisData->domInfo = nullptr;
-    analysisData->postDomInfo = nullptr;
+    _analysisManager->invalidateNonTransitive(Analysis::DomInfo);
+    _analysisManager->invalidateNonTransitive(Analysis::PostDomInfo);
 }
 
 void Function::invalidateCFGInfo() {
-    invalidateDomInfo();
-    analysisData->LNF = nullptr;
+    _analysisManager->invalidate(PreservedAnalyses::None());
 }
 
 void Function::insertCallback(BasicBlock& bb) {
@@ -21,5 +21,8 @@ Function const* Instruction::parentFunction() const {
 }
 
 void BinaryInstruction::swapOperands() {
-    std::swap(_operands[0], _operands[1]);
+    auto* lhs = operandAt(0);
+    auto* rhs = operandAt(1);
+    setOperand(0, rhs);
+    setOperand(1, lhs);
 }
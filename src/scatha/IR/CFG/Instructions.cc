@@ -46,11 +46,20 @@ void Store::setAddress(Value* address) { setOperand(0, address); }
 
 void Store::setValue(Value* value) { setOperand(1, value); }
 
+static Type const* computeCompareType(Context& context, Value const* operand) {
+    if (operand) {
+        if (auto* vecType = dyncast<VectorType const*>(operand->type())) {
+            return context.maskType(vecType);
+        }
+    }
+    return context.intType(1);
+}
+
 CompareInst::CompareInst(Context& context, Value* lhs, Value* rhs,
                          CompareMode mode, CompareOperation op,
                          std::string name):
-    BinaryInstruction(NodeType::CompareInst, lhs, rhs, context.intType(1),
-                      std::move(name)),
+    BinaryInstruction(NodeType::CompareInst, lhs, rhs,
+                      computeCompareType(context, lhs), std::move(name)),
     _mode(mode),
     _op(op) {}
 
@@ -83,11 +92,14 @@ ArithmeticInst::ArithmeticInst(Value* lhs, Value* rhs, ArithmeticOperation op,
                       lhs ? lhs->type() : nullptr, std::move(name)),
     _op(op) {}
 
-ArithmeticType const* ArithmeticInst::type() const {
-    auto* t = Value::type();
+ArithmeticType const* ArithmeticInst::scalarType() const {
+    auto* t = type();
     if (!t) {
         return nullptr;
     }
+    if (auto* vecType = dyncast<VectorType const*>(t)) {
+        return vecType->elementType();
+    }
     return cast<ArithmeticType const*>(t);
 }
 
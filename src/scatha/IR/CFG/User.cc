@@ -1,6 +1,9 @@
 #include "IR/CFG/User.h"
 
+#include <algorithm>
+
 #include <range/v3/algorithm.hpp>
+#include <utl/hashtable.hpp>
 #include <utl/utility.hpp>
 
 using namespace scatha;
@@ -25,63 +28,200 @@ std::optional<size_t> User::indexOf(Value const* operand) const {
 void User::setOperand(size_t index, Value* operand) {
     SC_ASSERT(index < _operands.size(),
               "`index` not valid for this instruction");
-    if (auto* op = _operands[index]) {
-        op->removeUserWeak(this);
+    if (_operands[index] == operand) {
+        return;
     }
-    if (operand) {
-        operand->addUserWeak(this);
+    if (_operands[index]) {
+        unlinkUse(index, findOtherUse(index));
     }
     _operands[index] = operand;
+    if (operand) {
+        linkUse(index, !findOtherUse(index));
+    }
 }
 
 void User::setOperands(std::span<Value* const> ops) {
     clearOperands();
-    _operands.assign(ops.begin(), ops.end());
-    for (auto* op: _operands) {
+    resizeOperands(0);
+    resizeOperands(ops.size());
+    /// Most users have few operands, so we compare them directly. Phis and
+    /// calls can have many operands, for these we find repeated operands with
+    /// a hash set so setting the operands stays linear
+    if (ops.size() <= 64) {
+        for (auto [index, op]: ops | ranges::views::enumerate) {
+            setOperand(index, op);
+        }
+        return;
+    }
+    utl::hashset<Value const*> distinct;
+    for (auto [index, op]: ops | ranges::views::enumerate) {
         if (op) {
-            op->addUserWeak(this);
+            _operands[index] = op;
+            linkUse(index, distinct.insert(op).second);
         }
     }
 }
 
+void User::setOperandCount(size_t count) {
+    for (size_t index = count; index < _operands.size(); ++index) {
+        setOperand(index, nullptr);
+    }
+    resizeOperands(count);
+}
+
 void User::updateOperand(Value const* oldOperand, Value* newOperand) {
     [[maybe_unused]] bool result = tryUpdateOperand(oldOperand, newOperand);
     SC_ASSERT(result, "Not found");
 }
 
 bool User::tryUpdateOperand(Value const* oldOperand, Value* newOperand) {
+    if (oldOperand == newOperand) {
+        return directlyUses(oldOperand);
+    }
+    /// All uses of `oldOperand` are removed, so none of them has to pass on
+    /// counting this user. Only the first new use of `newOperand` counts this
+    /// user, if no other slot already does
+    bool countUser = newOperand && !directlyUses(newOperand);
     bool result = false;
-    for (auto&& [index, op]: _operands | ranges::views::enumerate) {
-        if (op == oldOperand) {
-            setOperand(index, newOperand);
-            result = true;
+    for (size_t index = 0; index < _operands.size(); ++index) {
+        if (_operands[index] != oldOperand) {
+            continue;
         }
+        if (oldOperand) {
+            unlinkUse(index, nullptr);
+        }
+        _operands[index] = newOperand;
+        if (newOperand) {
+            linkUse(index, countUser);
+            countUser = false;
+        }
+        result = true;
     }
     return result;
 }
 
 void User::addOperand(Value* op) {
-    _operands.push_back(op);
-    op->addUserWeak(this);
+    size_t index = _operands.size();
+    resizeOperands(index + 1);
+    setOperand(index, op);
 }
 
 void User::removeOperand(size_t index) {
-    auto const itr = _operands.begin() + index;
-    if (auto* op = *itr) {
-        op->removeUserWeak(this);
+    setOperand(index, nullptr);
+    /// The uses behind `index` move down by one slot, so we unlink them before
+    /// erasing and link them again afterwards. The set of users of each
+    /// operand does not change
+    for (size_t i = index + 1; i < _operands.size(); ++i) {
+        if (_operands[i]) {
+            unlinkUse(i, /* heir = */ &_uses[i]);
+        }
+    }
+    _operands.erase(_operands.begin() + index);
+    _uses.erase(_uses.begin() + index);
+    for (size_t i = index; i < _operands.size(); ++i) {
+        if (_operands[i]) {
+            linkUse(i, /* countUser = */ false);
+        }
     }
-    _operands.erase(itr);
 }
 
 void User::clearOperands() {
-    for (auto& op: _operands) {
-        if (op) {
-            op->removeUserWeak(this);
+    /// Every operand counts this user by exactly one use. We remove all uses,
+    /// so none of them has to pass on counting this user
+    for (size_t index = 0; index < _operands.size(); ++index) {
+        if (_operands[index]) {
+            unlinkUse(index, nullptr);
+            _operands[index] = nullptr;
         }
-        op = nullptr;
     }
 }
 
 bool User::directlyUses(Value const* value) const {
     return ranges::find(_operands, value) != ranges::end(_operands);
 }
+
+void User::linkUse(size_t index, bool countUser) {
+    auto* value = _operands[index];
+    auto& use = _uses[index];
+    SC_ASSERT(!use.isLinked(), "Use is already linked");
+    auto lock = value->lockUseLists();
+    use._user = this;
+    use._next = value->_uses;
+    if (use._next) {
+        use._next->_prev = &use._next;
+    }
+    use._prev = &value->_uses;
+    value->_uses = &use;
+    if (countUser) {
+        use._countsUser = true;
+        ++value->_numUsers;
+    }
+}
+
+void User::unlinkUse(size_t index, Use* heir) {
+    auto* value = _operands[index];
+    auto& use = _uses[index];
+    SC_ASSERT(use.isLinked(), "Use is not linked");
+    auto lock = value->lockUseLists();
+    *use._prev = use._next;
+    if (use._next) {
+        use._next->_prev = use._prev;
+    }
+    use._next = nullptr;
+    use._prev = nullptr;
+    if (!use._countsUser) {
+        return;
+    }
+    use._countsUser = false;
+    if (heir) {
+        heir->_countsUser = true;
+    }
+    else {
+        SC_ASSERT(value->_numUsers > 0, "User count underflow");
+        --value->_numUsers;
+    }
+}
+
+Use* User::findOtherUse(size_t index) {
+    auto* value = _operands[index];
+    for (size_t i = 0; i < _operands.size(); ++i) {
+        if (i != index && _operands[i] == value) {
+            return &_uses[i];
+        }
+    }
+    return nullptr;
+}
+
+void User::resizeOperands(size_t count) {
+    SC_ASSERT(count >= _operands.size() ||
+                  ranges::all_of(_operands | ranges::views::drop(count),
+                                 [](Value* op) { return op == nullptr; }),
+              "Removed operands must be cleared first");
+    /// Growing beyond the capacity moves the uses to new storage. The uses
+    /// are linked by address, so we take them out of their lists and link
+    /// them again after the move
+    bool relink = count > _uses.capacity();
+    if (relink) {
+        for (size_t index = 0; index < _operands.size(); ++index) {
+            if (_operands[index]) {
+                unlinkUse(index, /* heir = */ &_uses[index]);
+            }
+        }
+    }
+    size_t oldCount = _operands.size();
+    _operands.resize(count, nullptr);
+    _uses.resize(count);
+    if (relink) {
+        for (size_t index = 0; index < std::min(oldCount, count); ++index) {
+            if (_operands[index]) {
+                linkUse(index, /* countUser = */ false);
+            }
+        }
+    }
+}
+
+size_t Use::operandIndex() const {
+    return utl::narrow_cast<size_t>(this - _user->_uses.data());
+}
+
+Value* Use::value() const { return _user->operandAt(operandIndex()); }
@@ -1,5 +1,7 @@
 #include "IR/CFG/Value.h"
 
+#include <array>
+
 #include "Common/Ranges.h"
 #include "IR/Attributes.h"
 #include "IR/CFG.h"
@@ -24,7 +26,7 @@ void Value::removeAllUses() {
     for (auto* user: users() | ToSmallVector<>) {
         user->updateOperand(this, nullptr);
     }
-    SC_ASSERT(_users.empty(),
+    SC_ASSERT(!_uses && _numUsers == 0,
               "The calls to updateOperand() should have cleared this");
 }
 
@@ -41,23 +43,37 @@ void Value::replaceAllUsesWith(Value* newValue) {
 }
 
 void Value::clearAllReferences() {
-    for (auto* ref: _references) {
+    auto lock = lockUseLists();
+    if (!_sideTable) {
+        return;
+    }
+    for (auto* ref: _sideTable->references) {
         ref->_value = nullptr;
     }
-    _references.clear();
+    _sideTable->references.clear();
 }
 
-void Value::addUserWeak(User* user) {
-    auto const [itr, success] = _users.insert({ user, 0 });
-    ++itr->second;
+Value::SideTable& Value::sideTable() {
+    if (!_sideTable) {
+        _sideTable = std::make_unique<SideTable>();
+    }
+    return *_sideTable;
 }
 
-void Value::removeUserWeak(User* user) {
-    auto itr = _users.find(user);
-    SC_ASSERT(itr != _users.end(), "`user` is not a user of this value.");
-    if (--itr->second == 0) {
-        _users.erase(itr);
+Value::AttributeMap const& Value::attributeMap() const {
+    static AttributeMap const empty;
+    return _sideTable ? _sideTable->attribs : empty;
+}
+
+std::unique_lock<std::mutex> Value::lockUseLists() const {
+    if (!isa<Constant>(this)) {
+        return {};
     }
+    /// Striped locks keyed by address. One mutex per constant would bloat
+    /// every value and a single mutex would serialize all users
+    static std::array<std::mutex, 64> mutexes;
+    size_t index = (reinterpret_cast<uintptr_t>(this) >> 4) % mutexes.size();
+    return std::unique_lock(mutexes[index]);
 }
 
 void Value::setName(std::string name) {
@@ -107,18 +123,22 @@ void Value::amendPointerInfo(PointerInfoDesc const& desc) {
 }
 
 Attribute const* Value::addAttribute(UniquePtr<Attribute> attrib) {
-    auto [itr, success] = _attribs.emplace(attrib->type(), std::move(attrib));
+    auto [itr, success] =
+        sideTable().attribs.emplace(attrib->type(), std::move(attrib));
     SC_ASSERT(success, "Attribute already present");
     return itr->second.get();
 }
 
 void Value::removeAttribute(AttributeType attribType) {
-    _attribs.erase(attribType);
+    if (_sideTable) {
+        _sideTable->attribs.erase(attribType);
+    }
 }
 
 Attribute const* Value::get(AttributeType attrib) const {
-    auto itr = _attribs.find(attrib);
-    if (itr != _attribs.end()) {
+    auto& attribs = attributeMap();
+    auto itr = attribs.find(attrib);
+    if (itr != attribs.end()) {
         return itr->second.get();
     }
     return nullptr;
@@ -181,6 +181,7 @@ UniquePtr<Function> ir::clone(Context& context, Function* function) {
                                      clone(context, function->parameters()),
                                      std::string(function->name()),
                                      function->attributes());
+    NodeAllocatorScope allocScope(*result);
     CloneValueMap valueMap;
     for (auto& bb: *function) {
         auto* cloned = ::cloneRaw(context, &bb, valueMap);
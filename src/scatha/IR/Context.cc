@@ -1,9 +1,12 @@
 #include "IR/Context.h"
 
+#include <array>
+#include <mutex>
 #include <sstream>
 
 #include <range/v3/view.hpp>
 #include <utl/graph.hpp>
+#include <utl/hash.hpp>
 #include <utl/hashmap.hpp>
 #include <utl/hashset.hpp>
 #include <utl/strcat.hpp>
@@ -49,21 +52,50 @@ struct RecordConstantMap {
         map;
 };
 
+/// Hash map of uniqued constants that is split into independently locked
+/// shards. Arithmetic constants are requested very frequently during parallel
+/// function generation, so a single lock would be highly contended
+template <typename Key, typename T, size_t NumShards = 32>
+struct ShardedConstantMap {
+    /// \Returns the constant stored under \p key or inserts the result of
+    /// \p make if there is none. \p hash selects the shard
+    T* get(size_t hash, Key const& key, std::invocable auto make) {
+        auto& shard = shards[hash % NumShards];
+        std::lock_guard lock(shard.mutex);
+        auto itr = shard.map.find(key);
+        if (itr == shard.map.end()) {
+            itr = shard.map.insert({ key, make() }).first;
+        }
+        return itr->second.get();
+    }
+
+    struct Shard {
+        std::mutex mutex;
+        utl::hashmap<Key, UniquePtr<T>> map;
+    };
+
+    std::array<Shard, NumShards> shards;
+};
+
 } // namespace
 
 struct Context::Impl {
     /// ## Constants
     /// ** Bitwidth must appear before the value, because comparison of values
     /// of different widths may not be possible. **
-    utl::hashmap<std::pair<size_t, APInt>, UniquePtr<IntegralConstant>>
+    ShardedConstantMap<std::pair<size_t, APInt>, IntegralConstant>
         _integralConstants;
-    utl::hashmap<std::pair<size_t, APFloat>, UniquePtr<FloatingPointConstant>>
+    ShardedConstantMap<std::pair<size_t, APFloat>, FloatingPointConstant>
         _floatConstants;
+    /// Guards `_undefConstants` and `recordConstants`
+    std::mutex constantMutex;
     utl::hashmap<Type const*, UniquePtr<UndefValue>> _undefConstants;
     utl::hashmap<RecordType const*, RecordConstantMap> recordConstants;
     UniquePtr<NullPointerConstant> nullptrConstant;
 
     /// ## Types
+    /// Guards all type maps
+    std::mutex typeMutex;
     utl::vector<UniquePtr<Type>> _types;
     VoidType const* _voidType;
     PointerType const* _ptrType;
@@ -72,6 +104,7 @@ struct Context::Impl {
     utl::hashmap<StructKey, StructType const*, StructHash, StructEqual>
         _anonymousStructs;
     utl::hashmap<ArrayKey, ArrayType const*> _arrayTypes;
+    utl::hashmap<ArrayKey, VectorType const*> _vectorTypes;
 };
 
 Context::Context(): impl(std::make_unique<Impl>()) {
@@ -100,7 +133,9 @@ VoidType const* Context::voidType() { return impl->_voidType; }
 PointerType const* Context::ptrType() { return impl->_ptrType; }
 
 template <typename A>
-static auto* getArithmeticType(size_t bitwidth, auto& types, auto& map) {
+static auto* getArithmeticType(size_t bitwidth, auto& types, auto& map,
+                               std::mutex& mutex) {
+    std::lock_guard lock(mutex);
     auto itr = map.find(bitwidth);
     if (itr != map.end()) {
         return itr->second;
@@ -113,7 +148,7 @@ static auto* getArithmeticType(size_t bitwidth, auto& types, auto& map) {
 
 IntegralType const* Context::intType(size_t bitwidth) {
     return getArithmeticType<IntegralType>(bitwidth, impl->_types,
-                                           impl->_intTypes);
+                                           impl->_intTypes, impl->typeMutex);
 }
 
 IntegralType const* Context::boolType() { return intType(1); }
@@ -121,7 +156,7 @@ IntegralType const* Context::boolType() { return intType(1); }
 FloatType const* Context::floatType(size_t bitwidth) {
     SC_ASSERT(bitwidth == 32 || bitwidth == 64, "Other sizes not supported");
     return getArithmeticType<FloatType>(bitwidth, impl->_types,
-                                        impl->_floatTypes);
+                                        impl->_floatTypes, impl->typeMutex);
 }
 
 FloatType const* Context::floatType(APFloatPrec precision) {
@@ -145,6 +180,7 @@ static std::string makeAnonStructName(std::span<Type const* const> members) {
 StructType const* Context::anonymousStruct(
     std::span<Type const* const> members) {
     SC_EXPECT(ranges::all_of(members, [](auto* ty) { return !!ty; }));
+    std::lock_guard lock(impl->typeMutex);
     auto itr = impl->_anonymousStructs.find(members);
     if (itr != impl->_anonymousStructs.end()) {
         return itr->second;
@@ -162,6 +198,7 @@ StructType const* Context::anonymousStruct(
 
 ArrayType const* Context::arrayType(Type const* elementType, size_t count) {
     ArrayKey key = { elementType, count };
+    std::lock_guard lock(impl->typeMutex);
     auto itr = impl->_arrayTypes.find(key);
     if (itr != impl->_arrayTypes.end()) {
         return itr->second;
@@ -176,16 +213,36 @@ ArrayType const* Context::byteArrayType(size_t count) {
     return arrayType(intType(8), count);
 }
 
+VectorType const* Context::vectorType(ArithmeticType const* elementType,
+                                      size_t count) {
+    ArrayKey key = { elementType, count };
+    std::lock_guard lock(impl->typeMutex);
+    auto itr = impl->_vectorTypes.find(key);
+    if (itr != impl->_vectorTypes.end()) {
+        return itr->second;
+    }
+    auto type = allocate<VectorType>(elementType, count);
+    itr = impl->_vectorTypes.insert({ key, type.get() }).first;
+    impl->_types.push_back(std::move(type));
+    return itr->second;
+}
+
+VectorType const* Context::vectorType(ArithmeticType const* elementType) {
+    return vectorType(elementType,
+                      VectorType::MaxByteSize / elementType->size());
+}
+
+VectorType const* Context::maskType(VectorType const* type) {
+    return vectorType(intType(type->elementType()->bitwidth()), type->count());
+}
+
 IntegralConstant* Context::intConstant(APInt value) {
     size_t const bitwidth = value.bitwidth();
-    auto itr = impl->_integralConstants.find({ bitwidth, value });
-    if (itr == impl->_integralConstants.end()) {
-        std::tie(itr, std::ignore) = impl->_integralConstants.insert(
-            { std::pair{ bitwidth, value },
-              allocate<IntegralConstant>(*this, value) });
-    }
-    SC_ASSERT(ucmp(itr->second->value(), value) == 0, "Value mismatch");
-    return itr->second.get();
+    auto* result = impl->_integralConstants.get(
+        utl::hash_combine(bitwidth, value), { bitwidth, value },
+        [&] { return allocate<IntegralConstant>(*this, value); });
+    SC_ASSERT(ucmp(result->value(), value) == 0, "Value mismatch");
+    return result;
 }
 
 IntegralConstant* Context::intConstant(u64 value, size_t bitwidth) {
@@ -198,14 +255,11 @@ IntegralConstant* Context::boolConstant(bool value) {
 
 FloatingPointConstant* Context::floatConstant(APFloat value) {
     size_t const bitwidth = value.precision().totalBitwidth();
-    auto itr = impl->_floatConstants.find({ bitwidth, value });
-    if (itr == impl->_floatConstants.end()) {
-        std::tie(itr, std::ignore) = impl->_floatConstants.insert(
-            { std::pair{ bitwidth, value },
-              allocate<FloatingPointConstant>(*this, value) });
-    }
-    SC_ASSERT(itr->second->value() == value, "Value mismatch");
-    return itr->second.get();
+    auto* result = impl->_floatConstants.get(
+        utl::hash_combine(bitwidth, value), { bitwidth, value },
+        [&] { return allocate<FloatingPointConstant>(*this, value); });
+    SC_ASSERT(result->value() == value, "Value mismatch");
+    return result;
 }
 
 FloatingPointConstant* Context::floatConstant(double value, size_t bitwidth) {
@@ -258,6 +312,7 @@ RecordConstant* Context::addRecordConstant(UniquePtr<RecordConstant> constant) {
     if (!constant->type()) {
         return nullptr;
     }
+    std::lock_guard lock(impl->constantMutex);
     auto& map = impl->recordConstants[constant->type()].map;
     auto key = constant->elements() | ToSmallVector<>;
     auto itr = map.find(key);
@@ -274,15 +329,17 @@ RecordConstant* Context::addRecordConstant(UniquePtr<RecordConstant> constant) {
 }
 
 template <typename ConstType, typename IRType>
-static ConstType* recordConstantImpl(auto& constantMap, IRType const* type,
+static ConstType* recordConstantImpl(auto& constantMap, std::mutex& mutex,
+                                     IRType const* type,
                                      std::span<Constant* const> elems) {
+    std::lock_guard lock(mutex);
     return constantMap[type].template get<ConstType>(type, elems);
 }
 
 StructConstant* Context::structConstant(std::span<Constant* const> elems,
                                         StructType const* type) {
-    return recordConstantImpl<StructConstant>(impl->recordConstants, type,
-                                              elems);
+    return recordConstantImpl<StructConstant>(impl->recordConstants,
+                                              impl->constantMutex, type, elems);
 }
 
 StructConstant* Context::anonymousStructConstant(
@@ -294,8 +351,8 @@ StructConstant* Context::anonymousStructConstant(
 
 ArrayConstant* Context::arrayConstant(std::span<Constant* const> elems,
                                       ArrayType const* type) {
-    return recordConstantImpl<ArrayConstant>(impl->recordConstants, type,
-                                             elems);
+    return recordConstantImpl<ArrayConstant>(impl->recordConstants,
+                                             impl->constantMutex, type, elems);
 }
 
 ArrayConstant* Context::stringLiteral(std::string_view text) {
@@ -333,6 +390,7 @@ Constant* Context::nullConstant(Type const* type) {
 }
 
 UndefValue* Context::undef(Type const* type) {
+    std::lock_guard lock(impl->constantMutex);
     auto itr = impl->_undefConstants.find(type);
     if (itr == impl->_undefConstants.end()) {
         bool success = false;
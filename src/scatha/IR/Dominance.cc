@@ -1,9 +1,10 @@
 #include "IR/Dominance.h"
 
-#include <array>
+#include <algorithm>
 #include <iostream>
+#include <queue>
 
-#include <range/v3/numeric.hpp>
+#include <range/v3/algorithm.hpp>
 #include <range/v3/to_container.hpp>
 #include <range/v3/view.hpp>
 #include <utl/hashtable.hpp>
@@ -19,37 +20,6 @@ using namespace ir;
 
 using DomFrontMap = DominanceInfo::DomFrontMap;
 
-static void merge(utl::hashset<BasicBlock*>& dest,
-                  utl::hashset<BasicBlock*> const& source) {
-    for (auto* BB: source) {
-        dest.insert(BB);
-    }
-}
-
-static utl::hashset<BasicBlock*> intersect(
-    utl::hashset<BasicBlock*> lhs, utl::hashset<BasicBlock*> const& rhs) {
-    for (auto itr = lhs.begin(); itr != lhs.end();) {
-        if (rhs.contains(*itr)) {
-            ++itr;
-        }
-        else {
-            itr = lhs.erase(itr);
-        }
-    }
-    return lhs;
-}
-
-static utl::hashset<BasicBlock*> intersect(auto&& range) {
-    if (range.empty()) {
-        return {};
-    }
-    return ranges::accumulate(std::next(ranges::begin(range)),
-                              ranges::end(range), *range.begin(),
-                              [](auto& a, auto const& b) {
-        return intersect(std::move(a), b);
-    });
-}
-
 static utl::small_vector<BasicBlock*> exitNodes(Function& function) {
     return function | ranges::views::filter([](auto& BB) {
         return isa<Return>(BB.terminator());
@@ -88,29 +58,457 @@ void PrintCtx::print(DomTree::Node const& node) {
     indent.decrease();
 }
 
+/// Implements construction and incremental updates of dominator trees
+///
+/// Trees are built with the Semi-NCA algorithm [1]. Incremental edge insertion
+/// follows the depth based search of [2]. After deleting an edge the subtree
+/// of the nearest common dominator of the endpoints is rebuilt with Semi-NCA.
+///
+/// [1] Georgiadis, L. (2005). Linear-Time Algorithms for Dominators and
+///     Related Problems
+/// [2] Georgiadis, L. et al. (2016). An Experimental Study of Dynamic
+///     Dominators
+struct ir::DomTreeBuilder {
+    using Node = DomTree::Node;
+
+    /// Per node state of the Semi-NCA algorithm. Indexed by DFS preorder
+    /// number
+    struct NodeInfo {
+        Node* node;
+        /// The DFS tree parent
+        uint32_t parent;
+        /// Path compressed ancestor in the link-eval forest
+        uint32_t ancestor;
+        uint32_t semi;
+        uint32_t label;
+        uint32_t idom;
+    };
+
+    DomTree& tree;
+
+    /// `true` if `tree` is a post-dominator tree. Then all CFG edges are
+    /// traversed in reverse direction
+    bool post = false;
+
+    /// The successors of the virtual root of post-dominator trees
+    utl::small_vector<BasicBlock*> exits;
+
+    utl::vector<NodeInfo> infos;
+    utl::hashmap<Node const*, uint32_t> numbers;
+    utl::small_vector<uint32_t> evalStack;
+
+    explicit DomTreeBuilder(DomTree& tree, bool post = false):
+        tree(tree), post(post) {}
+
+    /// Invokes \p fn for every successor of \p BB in the direction of the tree
+    void forEachSucc(BasicBlock* BB, auto fn) {
+        if (!BB) {
+            for (auto* exit: exits) {
+                fn(exit);
+            }
+        }
+        else if (post) {
+            for (auto* pred: BB->predecessors()) {
+                fn(pred);
+            }
+        }
+        else {
+            for (auto* succ: BB->successors()) {
+                fn(succ);
+            }
+        }
+    }
+
+    /// Invokes \p fn for every predecessor of \p BB in the direction of the
+    /// tree. The virtual root of post-dominator trees is never passed to \p fn
+    void forEachPred(BasicBlock* BB, auto fn) {
+        if (!BB) {
+            return;
+        }
+        if (post) {
+            for (auto* succ: BB->successors()) {
+                fn(succ);
+            }
+        }
+        else {
+            for (auto* pred: BB->predecessors()) {
+                fn(pred);
+            }
+        }
+    }
+
+    Node* node(BasicBlock const* BB) { return tree.findMut(BB); }
+
+    /// \Returns the node of \p BB or `nullptr` if the tree does not know
+    /// \p BB
+    Node* tryNode(BasicBlock const* BB) {
+        auto itr = tree._index.find(BB);
+        return itr != tree._index.end() ? itr->second : nullptr;
+    }
+
+    Node* addNode(BasicBlock* BB) {
+        auto& node = tree._nodes.emplace_back(std::make_unique<Node>(BB));
+        tree._index[BB] = node.get();
+        return node.get();
+    }
+
+    static Node* nca(Node* a, Node* b) {
+        while (a != b) {
+            if (a->_level < b->_level) {
+                std::swap(a, b);
+            }
+            a = a->parent();
+        }
+        return a;
+    }
+
+    void build(Function& function, BasicBlock* root);
+    void runDFS(Node* root, auto filter);
+    uint32_t eval(uint32_t v, uint32_t lastLinked);
+    void runSemiNCA();
+    void attach();
+    void computeDFSNumbers();
+
+    bool insertEdge(BasicBlock* from, BasicBlock* to);
+    bool deleteEdge(BasicBlock* from, BasicBlock* to);
+    bool insertJoiningBlock(BasicBlock* joiner, BasicBlock* BB);
+};
+
+void DomTreeBuilder::build(Function& function, BasicBlock* root) {
+    tree = DomTree();
+    for (auto& BB: function) {
+        addNode(&BB);
+    }
+    tree._root = root ? node(root) : addNode(nullptr);
+    runDFS(tree._root, [](Node const*) { return true; });
+    runSemiNCA();
+    tree._root->_level = 0;
+    attach();
+    computeDFSNumbers();
+}
+
+void DomTreeBuilder::runDFS(Node* root, auto filter) {
+    infos.clear();
+    numbers.clear();
+    utl::small_vector<std::pair<Node*, uint32_t>> stack = { { root, 0 } };
+    while (!stack.empty()) {
+        auto [node, parent] = stack.back();
+        stack.pop_back();
+        uint32_t num = utl::narrow_cast<uint32_t>(infos.size());
+        if (!numbers.insert({ node, num }).second) {
+            continue;
+        }
+        infos.push_back({ node, parent, parent, num, num, parent });
+        size_t begin = stack.size();
+        forEachSucc(node->basicBlock(), [&](BasicBlock* succ) {
+            auto* succNode = this->node(succ);
+            if (!numbers.contains(succNode) && filter(succNode)) {
+                stack.push_back({ succNode, num });
+            }
+        });
+        /// Visit the successors in CFG order
+        std::reverse(stack.begin() + utl::narrow_cast<ssize_t>(begin),
+                     stack.end());
+    }
+}
+
+uint32_t DomTreeBuilder::eval(uint32_t v, uint32_t lastLinked) {
+    if (infos[v].ancestor < lastLinked) {
+        return infos[v].label;
+    }
+    /// Gather the path to the first ancestor that is not linked yet
+    do {
+        evalStack.push_back(v);
+        v = infos[v].ancestor;
+    } while (infos[v].ancestor >= lastLinked);
+    /// Compress the path and propagate the labels with minimal semidominators
+    uint32_t p = v;
+    uint32_t pLabel = infos[p].label;
+    do {
+        v = evalStack.back();
+        evalStack.pop_back();
+        infos[v].ancestor = infos[p].ancestor;
+        uint32_t vLabel = infos[v].label;
+        if (infos[pLabel].semi < infos[vLabel].semi) {
+            infos[v].label = pLabel;
+        }
+        else {
+            pLabel = vLabel;
+        }
+        p = v;
+    } while (!evalStack.empty());
+    return infos[v].label;
+}
+
+void DomTreeBuilder::runSemiNCA() {
+    uint32_t const count = utl::narrow_cast<uint32_t>(infos.size());
+    /// Compute the semidominators in reverse preorder
+    for (uint32_t w = count; w-- > 1;) {
+        auto& info = infos[w];
+        info.semi = info.parent;
+        forEachPred(info.node->basicBlock(), [&](BasicBlock* pred) {
+            auto itr = numbers.find(node(pred));
+            if (itr == numbers.end()) {
+                return;
+            }
+            uint32_t u = eval(itr->second, w + 1);
+            infos[w].semi = std::min(infos[w].semi, infos[u].semi);
+        });
+    }
+    /// The immediate dominator of every node is the nearest common ancestor
+    /// of its DFS parent and its semidominator in the dominator tree
+    for (uint32_t w = 1; w < count; ++w) {
+        uint32_t idom = infos[w].idom;
+        while (idom > infos[w].semi) {
+            idom = infos[idom].idom;
+        }
+        infos[w].idom = idom;
+    }
+}
+
+/// Links the nodes numbered by the last DFS below their immediate dominators.
+/// The root of the DFS must already be linked
+void DomTreeBuilder::attach() {
+    for (auto& info: infos | ranges::views::drop(1)) {
+        auto* parent = infos[info.idom].node;
+        parent->addChild(info.node);
+        info.node->_level = parent->_level + 1;
+    }
+}
+
+void DomTreeBuilder::computeDFSNumbers() {
+    uint32_t counter = 0;
+    utl::small_vector<std::pair<Node*, size_t>> stack = { { tree._root, 0 } };
+    tree._root->_dfsIn = counter++;
+    while (!stack.empty()) {
+        auto& [node, index] = stack.back();
+        if (index == node->children().size()) {
+            node->_dfsOut = counter++;
+            stack.pop_back();
+            continue;
+        }
+        auto* child = node->children()[index++];
+        child->_dfsIn = counter++;
+        stack.push_back({ child, 0 });
+    }
+}
+
+bool DomTreeBuilder::insertEdge(BasicBlock* from, BasicBlock* to) {
+    auto* fromNode = tryNode(from);
+    auto* toNode = tryNode(to);
+    if (!fromNode || !toNode) {
+        return false;
+    }
+    if (!fromNode->isReachable()) {
+        return true;
+    }
+    /// Nodes that become reachable are not handled incrementally
+    if (!toNode->isReachable()) {
+        return false;
+    }
+    auto* ncd = nca(fromNode, toNode);
+    if (ncd == toNode || ncd == toNode->parent()) {
+        return true;
+    }
+    /// Affected are all nodes `v` with `level(v) > level(ncd) + 1` that are
+    /// reachable from `to` by a path whose nodes are all at least as deep as
+    /// `v`. We visit candidates from the deepest level upwards.
+    uint32_t const ncdLevel = ncd->_level;
+    auto shallower = [](Node const* a, Node const* b) {
+        return std::pair(a->_level, a->_dfsIn) <
+               std::pair(b->_level, b->_dfsIn);
+    };
+    std::priority_queue<Node*, utl::vector<Node*>, decltype(shallower)> bucket(
+        shallower);
+    utl::hashset<Node*> visited = { toNode };
+    utl::small_vector<Node*> affected;
+    utl::small_vector<Node*> unaffectedOnCurrentLevel;
+    bucket.push(toNode);
+    while (!bucket.empty()) {
+        auto* current = bucket.top();
+        bucket.pop();
+        affected.push_back(current);
+        uint32_t const currentLevel = current->_level;
+        while (true) {
+            for (auto* succ: current->basicBlock()->successors()) {
+                auto* succNode = tryNode(succ);
+                if (!succNode) {
+                    return false;
+                }
+                uint32_t const succLevel = succNode->_level;
+                if (succLevel <= ncdLevel + 1 ||
+                    !visited.insert(succNode).second)
+                {
+                    continue;
+                }
+                if (succLevel > currentLevel) {
+                    unaffectedOnCurrentLevel.push_back(succNode);
+                }
+                else {
+                    bucket.push(succNode);
+                }
+            }
+            if (unaffectedOnCurrentLevel.empty()) {
+                break;
+            }
+            current = unaffectedOnCurrentLevel.back();
+            unaffectedOnCurrentLevel.pop_back();
+        }
+    }
+    for (auto* node: affected) {
+        node->parent()->removeChild(node);
+        ncd->addChild(node);
+    }
+    for (auto* node: affected) {
+        node->preorderDFS([](Node* node) {
+            node->_level = node->parent()->_level + 1;
+        });
+    }
+    computeDFSNumbers();
+    return true;
+}
+
+bool DomTreeBuilder::deleteEdge(BasicBlock* from, BasicBlock* to) {
+    auto* fromNode = tryNode(from);
+    auto* toNode = tryNode(to);
+    if (!fromNode || !toNode) {
+        return false;
+    }
+    if (!fromNode->isReachable() || !toNode->isReachable() ||
+        ranges::contains(to->predecessors(), from))
+    {
+        return true;
+    }
+    auto* ncd = nca(fromNode, toNode);
+    /// If `to` dominates `from` the edge is a back edge which does not
+    /// contribute to dominance
+    if (ncd == toNode) {
+        return true;
+    }
+    /// `to` stays reachable if it has a reachable predecessor that it does not
+    /// dominate. Otherwise nodes become unreachable and we recompute.
+    bool hasSupport = ranges::any_of(to->predecessors(), [&](auto* pred) {
+        auto* predNode = tryNode(pred);
+        return predNode && predNode->isReachable() &&
+               nca(toNode, predNode) != toNode;
+    });
+    if (!hasSupport || ncd == tree._root) {
+        return false;
+    }
+    /// Only the subtree of `ncd` is affected. Paths from `ncd` to nodes in its
+    /// subtree never leave the subtree, so we rebuild it in isolation.
+    utl::hashset<Node*> subtree;
+    ncd->preorderDFS([&](Node* node) { subtree.insert(node); });
+    runDFS(ncd, [&](Node* node) { return subtree.contains(node); });
+    if (infos.size() != subtree.size()) {
+        return false;
+    }
+    runSemiNCA();
+    for (auto& info: infos | ranges::views::drop(1)) {
+        info.node->parent()->removeChild(info.node);
+    }
+    attach();
+    computeDFSNumbers();
+    return true;
+}
+
+bool DomTreeBuilder::insertJoiningBlock(BasicBlock* joiner, BasicBlock* BB) {
+    auto* BBNode = tryNode(BB);
+    if (tryNode(joiner) || !BBNode) {
+        return false;
+    }
+    auto* joinerNode = addNode(joiner);
+    Node* idom = nullptr;
+    for (auto* pred: joiner->predecessors()) {
+        auto* predNode = tryNode(pred);
+        if (!predNode) {
+            return false;
+        }
+        if (predNode->isReachable()) {
+            idom = idom ? nca(idom, predNode) : predNode;
+        }
+    }
+    /// If no predecessor is reachable, neither is `joiner`
+    if (!idom) {
+        return true;
+    }
+    if (!BBNode->isReachable()) {
+        return false;
+    }
+    /// `joiner` dominates `BB` if all other paths to `BB` pass through `BB`
+    /// itself
+    bool dominatesBB = ranges::none_of(BB->predecessors(), [&](auto* pred) {
+        if (pred == joiner) {
+            return false;
+        }
+        auto* predNode = tryNode(pred);
+        return predNode && predNode->isReachable() &&
+               nca(BBNode, predNode) != BBNode;
+    });
+    if (!dominatesBB) {
+        idom->addChild(joinerNode);
+        joinerNode->_level = idom->_level + 1;
+    }
+    else {
+        auto* parent = BBNode->parent();
+        if (!parent) {
+            return false;
+        }
+        parent->removeChild(BBNode);
+        parent->addChild(joinerNode);
+        joinerNode->_level = parent->_level + 1;
+        joinerNode->addChild(BBNode);
+        BBNode->preorderDFS([](Node* node) {
+            node->_level = node->parent()->_level + 1;
+        });
+    }
+    computeDFSNumbers();
+    return true;
+}
+
+bool DomTree::dominates(BasicBlock const* dom, BasicBlock const* sub) const {
+    if (empty()) {
+        return true;
+    }
+    auto* subNode = (*this)[sub];
+    if (!subNode->isReachable()) {
+        return true;
+    }
+    auto* domNode = (*this)[dom];
+    if (!domNode->isReachable()) {
+        return false;
+    }
+    return domNode->_dfsIn <= subNode->_dfsIn &&
+           subNode->_dfsOut <= domNode->_dfsOut;
+}
+
+BasicBlock* DomTree::nearestCommonDominator(BasicBlock const* a,
+                                            BasicBlock const* b) const {
+    auto* aNode = const_cast<Node*>((*this)[a]);
+    auto* bNode = const_cast<Node*>((*this)[b]);
+    if (!aNode->isReachable() || !bNode->isReachable()) {
+        return nullptr;
+    }
+    return DomTreeBuilder::nca(aNode, bNode)->basicBlock();
+}
+
 std::unique_ptr<DominanceInfo> DominanceInfo::compute(Function& function) {
     auto result = std::make_unique<DominanceInfo>();
-    result->_dominatorMap = computeDominatorSets(function);
-    result->_domTree = computeDomTree(function, result->_dominatorMap);
+    result->_function = &function;
+    result->_domTree = computeDomTree(function);
     result->_domFront = computeDomFronts(function, result->_domTree);
     return result;
 }
 
 std::unique_ptr<DominanceInfo> DominanceInfo::computePost(Function& function) {
     auto result = std::make_unique<DominanceInfo>();
-    result->_dominatorMap = computePostDomSets(function);
-    result->_domTree = computePostDomTree(function, result->_dominatorMap);
+    result->_function = &function;
+    result->_isPostDom = true;
+    result->_domTree = computePostDomTree(function);
     result->_domFront = computePostDomFronts(function, result->_domTree);
     return result;
 }
 
-utl::hashset<BasicBlock*> const& DominanceInfo::dominatorSet(
-    ir::BasicBlock const* basicBlock) const {
-    auto itr = _dominatorMap.find(basicBlock);
-    SC_ASSERT(itr != _dominatorMap.end(), "Basic block not found");
-    return itr->second;
-}
-
 std::span<BasicBlock* const> DominanceInfo::domFront(
     ir::BasicBlock const* basicBlock) const {
     auto itr = _domFront.find(basicBlock);
@@ -121,200 +519,103 @@ std::span<BasicBlock* const> DominanceInfo::domFront(
     return {};
 }
 
-DominanceInfo::DomMap DominanceInfo::computeDomSetsImpl(
-    Function& function, std::span<BasicBlock* const> entries, auto predecessors,
-    auto successors) {
-    /// https://pages.cs.wisc.edu/~fischer/cs701.f07/lectures/Lecture20.pdf
-    auto const nodeSet = [&] {
-        utl::hashset<BasicBlock*> res;
-        for (auto& BB: function) {
-            res.insert(&BB);
-        }
-        return res;
-    }();
-    DomMap domSets = [&] {
-        DomMap res;
-        for (auto& BB: function) {
-            res.insert({ &BB, nodeSet });
-        }
-        return res;
-    }();
-    SC_ASSERT(!entries.empty(), "Handle post-dom case without exit notes "
-                                "outside of this function");
-    auto worklist = entries | ranges::to<utl::hashset<BasicBlock*>>;
-    while (!worklist.empty()) {
-        auto* BB = *worklist.begin();
-        worklist.erase(worklist.begin());
-        utl::hashset<BasicBlock*> newDomSet = { BB };
-        auto predDomSets =
-            predecessors(BB) |
-            ranges::views::transform(
-                [&](auto* pred) -> auto const& { return domSets[pred]; });
-        merge(newDomSet, intersect(predDomSets));
-        auto& oldDomSet = domSets[BB];
-        if (newDomSet != oldDomSet) {
-            oldDomSet = newDomSet;
-            for (auto* succ: successors(BB)) {
-                worklist.insert(succ);
-            }
-        }
-    }
-    return domSets;
-}
-
-DominanceInfo::DomMap DominanceInfo::computeDominatorSets(Function& function) {
-    return computeDomSetsImpl(function, std::array{ &function.entry() },
-                              [](BasicBlock* BB) { return BB->predecessors(); },
-                              [](BasicBlock* BB) { return BB->successors(); });
+DomTree DominanceInfo::computeDomTree(Function& function) {
+    DomTree result;
+    DomTreeBuilder(result).build(function, &function.entry());
+    return result;
 }
 
-DominanceInfo::DomMap DominanceInfo::computePostDomSets(Function& function) {
-    /// Same as `computeDominatorSets` but with reversed edges.
+DomTree DominanceInfo::computePostDomTree(Function& function) {
     auto exits = ::exitNodes(function);
+    /// Can't compute post-dominator tree for function without an exit node.
     if (exits.empty()) {
         return {};
     }
-    return computeDomSetsImpl(function, exits, [](BasicBlock* BB) {
-        return BB->successors();
-    }, [](BasicBlock* BB) { return BB->predecessors(); });
+    DomTree result;
+    DomTreeBuilder builder(result, /* post = */ true);
+    auto* root = exits.size() == 1 ? exits.front() : nullptr;
+    builder.exits = std::move(exits);
+    builder.build(function, root);
+    return result;
 }
 
-DomTree DominanceInfo::computeDomTreeImpl(ir::Function& function,
-                                          DomMap const& domSets,
-                                          BasicBlock* entry,
-                                          std::span<BasicBlock* const> exits,
-                                          auto predecessors) {
-    DomTree result;
-    auto const nodeSet = function | TakeAddress |
-                         ranges::to<utl::hashset<BasicBlock*>>;
-    result._nodes = nodeSet | ranges::views::transform([](BasicBlock* BB) {
-        return DomTree::Node{ BB };
-    }) | ranges::to<DomTree::NodeSet>;
-    if (entry) {
-        result._root = result.findMut(entry);
+/// Computes the dominance frontiers from the dominator tree. For every block
+/// `B` we walk up the tree from each predecessor of `B` until we reach the
+/// immediate dominator of `B`. `B` is in the frontier of every node we pass.
+static DomFrontMap computeDomFrontsImpl(DomTree const& domTree, bool post) {
+    DomFrontMap result;
+    if (domTree.empty()) {
+        return result;
     }
-    else {
-        auto& constRoot = *result._nodes.insert(DomTree::Node(nullptr)).first;
-        result._root = const_cast<DomTree::Node*>(&constRoot);
-        for (auto* exit: exits) {
-            result._root->addChild(result.findMut(exit));
+    for (auto& node: domTree.nodes()) {
+        if (node.isReachable()) {
+            result[node.basicBlock()];
         }
     }
-    for (auto& start: result._nodes) {
-        if (!start.basicBlock()) {
+    for (auto& node: domTree.nodes()) {
+        auto* BB = node.basicBlock();
+        if (!BB || !node.isReachable()) {
             continue;
         }
-        auto const& dominatorSet = domSets.find(start.basicBlock())->second;
-        utl::hashset<DomTree::Node*> visited = { const_cast<DomTree::Node*>(
-            &start) };
-        auto findParent = [&](DomTree::Node* node,
-                              auto& findParent) -> DomTree::Node* {
-            if (visited.contains(node)) {
-                return nullptr;
-            }
-            visited.insert(node);
-            if (dominatorSet.contains(node->basicBlock())) {
-                return node;
+        auto visitPred = [&](BasicBlock const* pred) {
+            auto* runner = domTree[pred];
+            if (!runner->isReachable()) {
+                return;
             }
-            for (auto* pred: predecessors(node->basicBlock())) {
-                auto* predNode = result.findMut(pred);
-                if (auto res = findParent(predNode, findParent)) {
-                    return res;
+            while (runner && runner != node.parent()) {
+                auto& front = result[runner->basicBlock()];
+                if (front.empty() || front.back() != BB) {
+                    front.push_back(BB);
                 }
+                runner = runner->parent();
             }
-            return nullptr;
         };
-        for (auto* pred: predecessors(start.basicBlock())) {
-            auto* predNode = result.findMut(pred);
-            auto* res = findParent(predNode, findParent);
-            if (!res) {
-                continue;
+        if (post) {
+            for (auto* succ: BB->successors()) {
+                visitPred(succ);
+            }
+        }
+        else {
+            for (auto* pred: BB->predecessors()) {
+                visitPred(pred);
             }
-            auto* mutStart = const_cast<DomTree::Node*>(&start);
-            res->addChild(mutStart);
-            break;
         }
     }
     return result;
 }
 
-DomTree DominanceInfo::computeDomTree(Function& function,
-                                      DomMap const& domSets) {
-    return computeDomTreeImpl(function, domSets, &function.entry(), {},
-                              [](BasicBlock* BB) {
-        return BB->predecessors();
-    });
+DomFrontMap DominanceInfo::computeDomFronts(Function&,
+                                            DomTree const& domTree) {
+    return computeDomFrontsImpl(domTree, /* post = */ false);
 }
 
-DomTree DominanceInfo::computePostDomTree(Function& function,
-                                          DomMap const& postDomSets) {
-    auto exits = ::exitNodes(function);
-    /// Can't compute post-dominator tree for function without an exit node.
-    if (exits.empty()) {
-        return {};
-    }
-    auto* exitNode = exits.size() == 1 ? exits.front() : nullptr;
-    return computeDomTreeImpl(function, postDomSets, exitNode, exits,
-                              [](BasicBlock* BB) { return BB->successors(); });
+DomFrontMap DominanceInfo::computePostDomFronts(Function&,
+                                                DomTree const& postDomTree) {
+    return computeDomFrontsImpl(postDomTree, /* post = */ true);
 }
 
-DomFrontMap DominanceInfo::computeDomFrontsImpl(ir::Function& function,
-                                                DomTree const& domTree,
-                                                auto successors) {
-    if (domTree.empty()) {
-        return {};
+void DominanceInfo::insertEdge(BasicBlock* from, BasicBlock* to) {
+    SC_EXPECT(!_isPostDom);
+    if (!DomTreeBuilder(_domTree).insertEdge(from, to)) {
+        _domTree = computeDomTree(*_function);
     }
-    struct DFContext {
-        DFContext(Function& function, DomTree const& domTree, DomFrontMap& df,
-                  decltype(successors) succ):
-            function(function), domTree(domTree), df(df), succ(succ) {}
-
-        void compute(DomTree::Node const* uNode) {
-            for (auto* n: uNode->children()) {
-                compute(n);
-            }
-            auto* u = uNode->basicBlock();
-            auto& dfU = df[u];
-            // DF_local
-            for (BasicBlock* v: succ(u)) {
-                if (domTree.idom(v) != u) {
-                    dfU.push_back(v);
-                }
-            }
-            // DF_up
-            for (auto* wNode: uNode->children()) {
-                for (auto* v: df[wNode->basicBlock()]) {
-                    if (domTree.idom(v) != u) {
-                        dfU.push_back(v);
-                    }
-                }
-            }
-        }
-
-        Function& function;
-        DomTree const& domTree;
-        DomFrontMap& df;
-        decltype(successors) succ;
-    };
-    DomFrontMap result;
-    DFContext ctx(function, domTree, result, successors);
-    ctx.compute(domTree.root());
-    return result;
+    _domFront = computeDomFronts(*_function, _domTree);
 }
 
-DomFrontMap DominanceInfo::computeDomFronts(Function& function,
-                                            DomTree const& domTree) {
-    return computeDomFrontsImpl(function, domTree, [](BasicBlock* BB) {
-        return BB->successors();
-    });
+void DominanceInfo::deleteEdge(BasicBlock* from, BasicBlock* to) {
+    SC_EXPECT(!_isPostDom);
+    if (!DomTreeBuilder(_domTree).deleteEdge(from, to)) {
+        _domTree = computeDomTree(*_function);
+    }
+    _domFront = computeDomFronts(*_function, _domTree);
 }
 
-DomFrontMap DominanceInfo::computePostDomFronts(Function& function,
-                                                DomTree const& postDomTree) {
-    auto exits = exitNodes(function);
-    return computeDomFrontsImpl(function, postDomTree, [&](BasicBlock* BB) {
-        return BB ? BB->predecessors() : std::span<BasicBlock* const>(exits);
-    });
+void DominanceInfo::insertJoiningBlock(BasicBlock* joiner, BasicBlock* BB) {
+    SC_EXPECT(!_isPostDom);
+    if (!DomTreeBuilder(_domTree).insertJoiningBlock(joiner, BB)) {
+        _domTree = computeDomTree(*_function);
+    }
+    _domFront = computeDomFronts(*_function, _domTree);
 }
 
 utl::hashset<BasicBlock*> unionDF(BasicBlock* X,
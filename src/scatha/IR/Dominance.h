@@ -1,7 +1,10 @@
 #ifndef SCATHA_IR_DOMINANCE_H_
 #define SCATHA_IR_DOMINANCE_H_
 
+#include <cstdint>
 #include <iosfwd>
+#include <limits>
+#include <memory>
 #include <span>
 
 #include <range/v3/view.hpp>
@@ -15,8 +18,13 @@
 namespace scatha::ir {
 
 class DomTree;
+struct DomTreeBuilder;
 
 /// Dominator tree of a function
+///
+/// The tree has one node for every basic block of the function. Nodes of
+/// basic blocks that are unreachable from the root are not linked into the
+/// tree, i.e. they have no parent and are not the child of any node.
 class SCTEST_API DomTree {
 public:
     class Node: public TreeNode<ir::BasicBlock*, Node> {
@@ -27,19 +35,38 @@ public:
 
         ir::BasicBlock* basicBlock() const { return payload(); }
 
+        /// \Returns the depth of this node in the tree. The root has level 0
+        size_t level() const { return _level; }
+
+        /// \Returns `true` if this node is linked into the tree
+        bool isReachable() const { return _level != Unreachable; }
+
     private:
-        friend class DominanceInfo;
+        friend class DomTree;
+        friend struct DomTreeBuilder;
+
+        static constexpr uint32_t Unreachable =
+            std::numeric_limits<uint32_t>::max();
+
+        uint32_t _level = Unreachable;
+        /// Preorder and postorder indices of this node in a DFS of the tree.
+        /// Used to answer dominance queries in constant time
+        uint32_t _dfsIn = 0;
+        uint32_t _dfsOut = 0;
     };
 
 public:
     /// \Returns Flat array of nodes in the dominator tree.
-    auto nodes() const { return _nodes | Opaque; }
+    auto nodes() const {
+        return _nodes | ranges::views::transform(
+                            [](auto& node) -> Node const& { return *node; });
+    }
 
     /// \Returns The tree node corresponding to basic block \p BB
     Node const* operator[](ir::BasicBlock const* BB) const {
-        auto itr = _nodes.find(BB);
-        SC_ASSERT(itr != _nodes.end(), "Not found");
-        return &*itr;
+        auto itr = _index.find(BB);
+        SC_ASSERT(itr != _index.end(), "Not found");
+        return itr->second;
     }
 
     /// \Returns root of the tree.
@@ -56,22 +83,38 @@ public:
         return parent ? parent->basicBlock() : nullptr;
     }
 
+    /// \Returns `true` if \p dom dominates \p sub. Every block dominates
+    /// itself. Blocks that are unreachable from the root are dominated by all
+    /// blocks, and unreachable blocks dominate no reachable block.
+    bool dominates(ir::BasicBlock const* dom, ir::BasicBlock const* sub) const;
+
+    /// \Returns the nearest common dominator of \p a and \p b or `nullptr` if
+    /// one of them is unreachable
+    ir::BasicBlock* nearestCommonDominator(ir::BasicBlock const* a,
+                                           ir::BasicBlock const* b) const;
+
+    /// \Returns `true` if \p BB is reachable from the root of the tree
+    bool isReachable(ir::BasicBlock const* BB) const {
+        return (*this)[BB]->isReachable();
+    }
+
     /// \Returns `true` if the tree is empty.
     bool empty() const { return _nodes.empty(); }
 
 private:
     friend class DominanceInfo;
+    friend struct DomTreeBuilder;
 
     Node* findMut(ir::BasicBlock const* bb) {
         return const_cast<Node*>(
             static_cast<DomTree const*>(this)->operator[](bb));
     }
 
-private:
-    using NodeSet =
-        utl::hashset<Node, Node::PayloadHash<>, Node::PayloadEqual<>>;
-    NodeSet _nodes;
-    Node* _root;
+    /// Nodes are allocated individually so node pointers stay valid when
+    /// blocks are added by incremental updates
+    utl::vector<std::unique_ptr<Node>> _nodes;
+    utl::hashmap<ir::BasicBlock const*, Node*> _index;
+    Node* _root = nullptr;
 };
 
 SCTEST_API void print(DomTree const& domTree);
@@ -80,23 +123,19 @@ SCTEST_API void print(DomTree const& domTree, std::ostream& ostream);
 
 /// Groups dominance information of a function.
 /// Specifically, once computed, it contains:
-/// - Dominator sets for each basic block
 /// - A dominator tree
 /// - Dominance frontiers for each basic block
+///
+/// Dominator trees are computed with the Semi-NCA algorithm over a dense DFS
+/// numbering of the basic blocks. Dominance queries are answered in constant
+/// time by the DFS intervals of the tree nodes.
 class SCTEST_API DominanceInfo {
 public:
-    using DomMap = utl::hashmap<ir::BasicBlock*, utl::hashset<ir::BasicBlock*>>;
-
     using DomFrontMap =
         utl::hashmap<ir::BasicBlock*, utl::small_vector<ir::BasicBlock*>>;
 
-    /// Compute the dominator sets of the basic blocks in \p function
-    /// I.e. for each basic block `B` the set of basic blocks that dominate `B`.
-    static DomMap computeDominatorSets(ir::Function& function);
-
     /// Compute the dominator tree of \p function
-    static DomTree computeDomTree(ir::Function& function,
-                                  DomMap const& domSets);
+    static DomTree computeDomTree(ir::Function& function);
 
     /// Compute the dominance frontiers of the basic blocks in \p function
     static DomFrontMap computeDomFronts(ir::Function& function,
@@ -106,36 +145,30 @@ public:
     static DomFrontMap computeIterDomFronts(DomFrontMap const& domFronts);
 
     /// Compute dominance information of \p function
-    /// Computes dominance sets, dominator tree and dominance frontiers.
+    /// Computes dominator tree and dominance frontiers.
     static std::unique_ptr<DominanceInfo> compute(ir::Function& function);
 
-    /// Compute the post-dominator sets of the basic blocks in \p function
-    /// I.e. for each basic block `B` the set of basic blocks that are dominated
-    /// by `B`.
-    static DomMap computePostDomSets(ir::Function& function);
-
     /// Compute the post-dominator tree of \p function
     ///
     /// If \p function has no exit nodes, than the post-dominator tree will be
     /// empty. If \p function has more than one exit node, than the root of the
     /// post-dominator tree will not correspond to a basic block,  but instead
     /// be a 'virtual' root node that has the exit nodes as its children.
-    static DomTree computePostDomTree(ir::Function& function,
-                                      DomMap const& postDomSets);
+    static DomTree computePostDomTree(ir::Function& function);
 
     /// Compute the post-dominance frontiers of the basic blocks in \p function
     static DomFrontMap computePostDomFronts(ir::Function& function,
                                             DomTree const& postDomTree);
 
     /// Compute post-dominance information of \p function
-    /// Computes post-dominance sets, post-dominator tree and post-dominance
-    /// frontiers.
+    /// Computes post-dominator tree and post-dominance frontiers.
     static std::unique_ptr<DominanceInfo> computePost(ir::Function& function);
 
-    /// \returns the dominator set of \p BB i.e. the set of basic blocks that
-    /// dominate (or post-dominate) \p BB
-    utl::hashset<ir::BasicBlock*> const& dominatorSet(
-        ir::BasicBlock const* BB) const;
+    /// \Returns `true` if \p dom dominates (or post-dominates) \p sub
+    /// See `DomTree::dominates()`
+    bool dominates(ir::BasicBlock const* dom, ir::BasicBlock const* sub) const {
+        return _domTree.dominates(dom, sub);
+    }
 
     /// \returns the dominator (or post-dominator) tree.
     DomTree const& domTree() const { return _domTree; }
@@ -147,23 +180,31 @@ public:
 
     DomFrontMap const& domFronts() const { return _domFront; }
 
-private:
-    friend struct DFContext;
-
-    static DomMap computeDomSetsImpl(
-        ir::Function& function,
-        /// Shall only have more than one element when used to compute post-dom
-        /// sets for function with multiple exits
-        std::span<BasicBlock* const> entries, auto preds, auto succs);
-    static DomTree computeDomTreeImpl(
-        ir::Function& function, DomMap const& domMap, BasicBlock* entry,
-        /// Only used to compute post-dom tree for function with multiple exits
-        std::span<BasicBlock* const> exits, auto preds);
-    static DomFrontMap computeDomFrontsImpl(ir::Function& function,
-                                            DomTree const& domTree, auto succs);
+    /// Updates the dominator tree and the dominance frontiers after the edge
+    /// \p from → \p to has been added to the CFG. The CFG must already
+    /// contain the edge. The tree is updated incrementally if both blocks are
+    /// already known and recomputed otherwise.
+    /// \pre Must only be used for dominance, not for post-dominance info
+    void insertEdge(ir::BasicBlock* from, ir::BasicBlock* to);
+
+    /// Updates the dominator tree and the dominance frontiers after the edge
+    /// \p from → \p to has been removed from the CFG. The CFG must no longer
+    /// contain the edge. The tree is updated incrementally if \p to remains
+    /// reachable and recomputed otherwise.
+    /// \pre Must only be used for dominance, not for post-dominance info
+    void deleteEdge(ir::BasicBlock* from, ir::BasicBlock* to);
+
+    /// Updates the dominator tree and the dominance frontiers after the new
+    /// block \p joiner has been inserted in front of \p BB. I.e. some
+    /// predecessors of \p BB now branch to \p joiner, which in turn jumps to
+    /// \p BB. This is the CFG edit performed by `opt::splitEdge()` and
+    /// `opt::addJoiningPredecessor()`.
+    /// \pre Must only be used for dominance, not for post-dominance info
+    void insertJoiningBlock(ir::BasicBlock* joiner, ir::BasicBlock* BB);
 
 private:
-    DomMap _dominatorMap;
+    ir::Function* _function = nullptr;
+    bool _isPostDom = false;
     DomTree _domTree;
     DomFrontMap _domFront;
 };
@@ -142,3 +142,24 @@ bool ir::isCommutative(ArithmeticOperation op) {
     }
     SC_UNREACHABLE();
 }
+
+bool ir::hasVectorForm(ArithmeticOperation op) {
+    using enum ArithmeticOperation;
+    switch (op) {
+    case Add:
+    case Sub:
+    case Mul:
+    case SDiv:
+    case UDiv:
+    case And:
+    case Or:
+    case XOr:
+    case FAdd:
+    case FSub:
+    case FMul:
+    case FDiv:
+        return true;
+    default:
+        return false;
+    }
+}
@@ -56,8 +56,7 @@ static bool isInductionVar(Instruction const* inst, LoopInfo const& loop,
         return true;
     }
     if (!loop.isExiting(loop.header())) {
-        return postDomInfo.dominatorSet(loop.header())
-            .contains(indVar->parent());
+        return postDomInfo.dominates(indVar->parent(), loop.header());
     }
     SC_ASSERT(loop.header()->numSuccessors() <= 2,
               "This won't work with more than two successors");
@@ -67,7 +66,7 @@ static bool isInductionVar(Instruction const* inst, LoopInfo const& loop,
     });
     SC_ASSERT(nextItr != headerSuccs.end(),
               "Loop header must have at one successor in the loop");
-    return postDomInfo.dominatorSet(*nextItr).contains(indVar->parent());
+    return postDomInfo.dominates(indVar->parent(), *nextItr);
 }
 
 LoopInfo LoopInfo::Compute(LNFNode const& header) {
@@ -218,8 +217,9 @@ bool ir::makeLCSSA(Function& function) {
 
 static bool makeLCSSAPass(Context&, Function& F) { return makeLCSSA(F); }
 
-SC_REGISTER_FUNCTION_PASS(makeLCSSAPass, "lcssa",
-                          PassCategory::Canonicalization, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(makeLCSSAPass, "lcssa",
+                                     PassCategory::Canonicalization,
+                                     PreservedAnalyses::CFG(), {});
 
 static BasicBlock* getIdom(BasicBlock* dominator, BasicBlock* BB,
                            auto condition) {
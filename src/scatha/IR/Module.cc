@@ -56,6 +56,35 @@ GlobalVariable* Module::makeGlobalConstant(Context& ctx, Constant* value,
     return global;
 }
 
+void Module::moveToBack(std::span<Global* const> globals) {
+    bool movedForeignFunction = false;
+    for (auto* global: globals) {
+        SC_ASSERT(global->parent() == this, "Global is not in this module");
+        // clang-format off
+        SC_MATCH (*global) {
+            [&](Function& function) {
+                funcs.push_back(
+                    funcs.extract(List<Function>::const_iterator(&function)));
+            },
+            [&](Global& global) {
+                movedForeignFunction |= isa<ForeignFunction>(global);
+                _globals.push_back(
+                    _globals.extract(List<Global>::const_iterator(&global)));
+            },
+        }; // clang-format on
+    }
+    /// The foreign function set is ordered by insertion, so we rebuild it to
+    /// match the new order of the globals
+    if (movedForeignFunction) {
+        _extFunctions.clear();
+        for (auto& global: _globals) {
+            if (auto* function = dyncast<ForeignFunction*>(&global)) {
+                _extFunctions.insert(function);
+            }
+        }
+    }
+}
+
 void Module::erase(Global* global) {
     // clang-format off
     SC_MATCH (*global) {
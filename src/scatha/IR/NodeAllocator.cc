@@ -0,0 +1,153 @@
+#include "IR/NodeAllocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "Common/Allocator.h"
+#include "IR/CFG/Function.h"
+
+using namespace scatha;
+using namespace ir;
+
+namespace {
+
+/// Precedes every allocation made by `allocateNodeMemory()`
+struct alignas(std::max_align_t) NodeMemoryHeader {
+    /// The allocator the node lives in or null if it lives on the heap
+    NodeAllocator* allocator;
+    uint32_t sizeClass;
+};
+
+} // namespace
+
+struct NodeAllocator::SlabHeader {
+    SlabHeader* prev;
+    size_t size;
+};
+
+struct NodeAllocator::FreeBlock {
+    FreeBlock* next;
+};
+
+static_assert(sizeof(NodeMemoryHeader) % NodeAllocator::SizeClassGranularity ==
+              0);
+static_assert(alignof(std::max_align_t) <=
+              NodeAllocator::SizeClassGranularity);
+
+static size_t blockSize(size_t sizeClass) {
+    return (sizeClass + 1) * NodeAllocator::SizeClassGranularity;
+}
+
+NodeAllocator* NodeAllocator::create() { return new NodeAllocator(); }
+
+NodeAllocator::~NodeAllocator() {
+    SlabHeader* slab = slabs;
+    while (slab) {
+        SlabHeader* prev = slab->prev;
+        AllocationStats::remove(slab->size);
+        std::free(slab);
+        slab = prev;
+    }
+}
+
+void NodeAllocator::release() {
+    if (--refCount == 0) {
+        delete this;
+    }
+}
+
+void* NodeAllocator::allocate(size_t sizeClass) {
+    SC_EXPECT(sizeClass < NumSizeClasses);
+    retain();
+    ++numLiveNodes;
+    if (auto* block = freeLists[sizeClass]) {
+        freeLists[sizeClass] = block->next;
+        return block;
+    }
+    size_t size = blockSize(sizeClass);
+    if (static_cast<size_t>(end - current) < size) {
+        addSlab(size);
+    }
+    void* result = current;
+    current += size;
+    return result;
+}
+
+void NodeAllocator::deallocate(void* block, size_t sizeClass) {
+    SC_EXPECT(sizeClass < NumSizeClasses);
+    SC_EXPECT(numLiveNodes > 0);
+    auto* freeBlock = ::new (block) FreeBlock{ freeLists[sizeClass] };
+    freeLists[sizeClass] = freeBlock;
+    --numLiveNodes;
+    release();
+}
+
+void NodeAllocator::addSlab(size_t minSize) {
+    /// The remainder of the current slab is too small for the requested size
+    /// class, so we hand it out to the free lists of the smaller classes
+    while (static_cast<size_t>(end - current) >= SizeClassGranularity) {
+        size_t sizeClass =
+            std::min<size_t>(NumSizeClasses,
+                             static_cast<size_t>(end - current) /
+                                 SizeClassGranularity) -
+            1;
+        freeLists[sizeClass] =
+            ::new (current) FreeBlock{ freeLists[sizeClass] };
+        current += blockSize(sizeClass);
+    }
+    size_t size = slabs ? std::min(slabs->size * 2, MaxSlabSize) :
+                          InitialSlabSize;
+    size = std::max(size, minSize);
+    auto* slab =
+        static_cast<SlabHeader*>(std::malloc(sizeof(SlabHeader) + size));
+    if (!slab) {
+        throw std::bad_alloc();
+    }
+    slab->prev = slabs;
+    slab->size = size;
+    slabs = slab;
+    numSlabBytes += size;
+    AllocationStats::add(size);
+    current = reinterpret_cast<char*>(slab) + sizeof(SlabHeader);
+    end = current + size;
+}
+
+static thread_local NodeAllocator* currentAllocator = nullptr;
+
+NodeAllocatorScope::NodeAllocatorScope(Function& function):
+    prev(currentAllocator) {
+    currentAllocator = &function.nodeAllocator();
+}
+
+NodeAllocatorScope::~NodeAllocatorScope() { currentAllocator = prev; }
+
+void* ir::internal::allocateNodeMemory(size_t size) {
+    size_t const totalSize = sizeof(NodeMemoryHeader) + size;
+    size_t const sizeClass =
+        (totalSize + NodeAllocator::SizeClassGranularity - 1) /
+            NodeAllocator::SizeClassGranularity -
+        1;
+    NodeAllocator* allocator =
+        sizeClass < NodeAllocator::NumSizeClasses ? currentAllocator : nullptr;
+    void* memory = allocator ? allocator->allocate(sizeClass) :
+                               ::operator new(totalSize);
+    auto* header = ::new (memory) NodeMemoryHeader{
+        allocator, static_cast<uint32_t>(sizeClass)
+    };
+    return header + 1;
+}
+
+void ir::internal::deallocateNodeMemory(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto* header = static_cast<NodeMemoryHeader*>(ptr) - 1;
+    if (auto* allocator = header->allocator) {
+        allocator->deallocate(header, header->sizeClass);
+    }
+    else {
+        ::operator delete(header);
+    }
+}
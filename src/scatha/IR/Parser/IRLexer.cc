@@ -1,5 +1,6 @@
 #include "IR/Parser/IRLexer.h"
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <optional>
@@ -225,6 +226,19 @@ Expected<Token, LexicalIssue> Lexer::next() {
                                               TokenKind::FloatType;
             return Token(id, beginSL, kind, utl::narrow_cast<unsigned>(width));
         }
+        /// Vector types like `v2i32` or `v8i8`
+        if (*first == 'v') {
+            auto* elem = std::find_if_not(first + 1, i, isdigit);
+            bool const isVector = elem != first + 1 && elem != i &&
+                                  (*elem == 'i' || *elem == 'f') &&
+                                  elem + 1 != i &&
+                                  ranges::all_of(elem + 1, i, isdigit);
+            if (isVector) {
+                long const width = std::strtol(elem + 1, nullptr, 10);
+                return Token(id, beginSL, TokenKind::VectorType,
+                             utl::narrow_cast<unsigned>(width));
+            }
+        }
         return Token(id, beginSL, TokenKind::OtherID);
     }
     return LexicalIssue(loc);
@@ -547,6 +547,7 @@ UniquePtr<Callable> IRParser::parseCallable() {
                            Visibility::External); // FIXME: Parse
                                                   // function visibility
     registerValue(name, function.get());
+    NodeAllocatorScope allocScope(*function);
     expect(eatToken(), TokenKind::OpenBrace);
     /// Parse the body of the function.
     while (true) {
@@ -871,6 +872,9 @@ UniquePtr<Instruction> IRParser::parseInstruction() {
         auto rhs = parseValue(rhsType);
         auto result =
             allocate<CompareInst>(ctx, nullptr, nullptr, mode, op, name());
+        if (auto* vecType = dyncast<VectorType const*>(lhsType)) {
+            result->setType(ctx.maskType(vecType));
+        }
         addValueLink(result.get(), lhsType, lhs, &CompareInst::setLHS);
         addValueLink(result.get(), rhsType, rhs, &CompareInst::setRHS);
         return result;
@@ -925,7 +929,11 @@ UniquePtr<Instruction> IRParser::parseInstruction() {
         [[fallthrough]];
     case TokenKind::XOr: {
         auto op = toArithmeticOp(eatToken());
+        auto lhsTypeName = peekToken();
         auto* lhsType = parseType();
+        if (isa<VectorType>(lhsType) && !hasVectorForm(op)) {
+            reportSemaIssue(lhsTypeName, SemanticIssue::InvalidType);
+        }
         auto lhs = parseValue(lhsType);
         expect(eatToken(), TokenKind::Comma);
         auto* rhsType = parseType();
@@ -986,12 +994,16 @@ UniquePtr<Instruction> IRParser::parseInstruction() {
         eatToken();
         auto condTypeName = peekToken();
         auto* condType = parseType();
-        if (condType != ctx.intType(1)) {
-            reportSemaIssue(condTypeName, SemanticIssue::InvalidType);
-        }
         auto cond = parseValue(condType);
         expectNext(TokenKind::Comma);
         auto* thenType = parseType();
+        /// Vectors may also select lane wise with a mask
+        auto* vecType = dyncast<VectorType const*>(thenType);
+        if (condType != ctx.intType(1) &&
+            (!vecType || condType != ctx.maskType(vecType)))
+        {
+            reportSemaIssue(condTypeName, SemanticIssue::InvalidType);
+        }
         auto thenVal = parseValue(thenType);
         expectNext(TokenKind::Comma);
         auto* elseType = parseType();
@@ -1071,6 +1083,24 @@ Type const* IRParser::tryParseType() {
     case TokenKind::FloatType:
         eatToken();
         return ctx.floatType(token.width());
+    case TokenKind::VectorType: {
+        eatToken();
+        /// The lexer guarantees the form `v<count><i|f><width>`
+        auto id = token.id();
+        auto elemPos = id.find_first_of("if");
+        size_t const count = std::stoul(std::string(id.substr(1, elemPos - 1)));
+        ArithmeticType const* elemType = nullptr;
+        if (id[elemPos] == 'i') {
+            elemType = ctx.intType(token.width());
+        }
+        else {
+            elemType = ctx.floatType(token.width());
+        }
+        if (!VectorType::isValid(elemType, count)) {
+            reportSemaIssue(token, SemanticIssue::InvalidType);
+        }
+        return ctx.vectorType(elemType, count);
+    }
     case TokenKind::OpenBrace: {
         eatToken();
         utl::small_vector<Type const*> members;
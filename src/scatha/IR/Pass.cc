@@ -6,6 +6,11 @@
 #include <range/v3/algorithm.hpp>
 #include <range/v3/view.hpp>
 
+#include "Common/TimeTrace.h"
+#include "IR/AnalysisManager.h"
+#include "IR/CFG/Function.h"
+#include "IR/Module.h"
+
 using namespace scatha;
 using namespace ir;
 using namespace ranges::views;
@@ -72,3 +77,59 @@ ArgumentMatchResult PassArgumentMap::match(std::string_view key,
     }
     return Success;
 }
+
+/// Passes without name are wrappers created by the pipeline or converted from
+/// plain functions. Their work is recorded by the named passes they run
+static bool isTraced(PassBase const& pass) {
+    return pass.name() != "anonymous" && TimeTrace::active();
+}
+
+static size_t countInstructions(Function const& function) {
+    return static_cast<size_t>(ranges::distance(function.instructions()));
+}
+
+static size_t countInstructions(Module const& mod) {
+    size_t count = 0;
+    for (auto& function: mod) {
+        count += countInstructions(function);
+    }
+    return count;
+}
+
+bool FunctionPass::operator()(Context& ctx, Function& function,
+                              LoopPass const& loopPass) const {
+    if (!p) {
+        return false;
+    }
+    NodeAllocatorScope allocScope(function);
+    bool result = false;
+    if (!isTraced(*this)) {
+        result = p(ctx, function, loopPass, arguments());
+    }
+    else {
+        TraceScope trace(name(), "pass");
+        trace.setFunction(function.name());
+        trace.setInstCountBefore(countInstructions(function));
+        result = p(ctx, function, loopPass, arguments());
+        trace.setInstCountAfter(countInstructions(function));
+    }
+    if (result) {
+        function.analysisManager().invalidate(preservedAnalyses());
+    }
+    return result;
+}
+
+bool ModulePass::operator()(Context& ctx, Module& mod,
+                            FunctionPass const& functionPass) const {
+    if (!p) {
+        return false;
+    }
+    if (!isTraced(*this)) {
+        return p(ctx, mod, functionPass, arguments());
+    }
+    TraceScope trace(name(), "pass");
+    trace.setInstCountBefore(countInstructions(mod));
+    bool result = p(ctx, mod, functionPass, arguments());
+    trace.setInstCountAfter(countInstructions(mod));
+    return result;
+}
@@ -4,25 +4,37 @@
 #include "Common/Base.h"
 #include "IR/Pass.h"
 
-#define _SC_REGISTER_PASS_IMPL(impl, function, name, category, ...)            \
+#define _SC_REGISTER_PASS_IMPL(impl, function, name, category, preserved,      \
+                               ...)                                            \
     static int SC_CONCAT(__Pass_, __COUNTER__) = [] {                          \
         using namespace ::scatha::ir::passParameterTypes;                      \
         ::scatha::ir::internal::impl(                                          \
             { function, ::scatha::ir::PassArgumentMap __VA_ARGS__, name,       \
-              category });                                                     \
+              category, preserved });                                          \
         return 0;                                                              \
     }()
 
 /// Register a loop pass
 #define SC_REGISTER_LOOP_PASS(function, name, category, ...)                   \
     _SC_REGISTER_PASS_IMPL(registerLoopPass, function, name, category,         \
+                           ::scatha::ir::PreservedAnalyses::None(),            \
                            __VA_ARGS__)
 
-/// Register a function pass
+/// Register a function pass. All analyses of a function are invalidated when
+/// the pass modifies it
 #define SC_REGISTER_FUNCTION_PASS(function, name, category, ...)               \
     _SC_REGISTER_PASS_IMPL(registerFunctionPass, function, name, category,     \
+                           ::scatha::ir::PreservedAnalyses::None(),            \
                            __VA_ARGS__)
 
+/// Register a function pass that keeps the analyses \p preserved valid when it
+/// modifies a function. \p preserved is one of
+/// `::scatha::ir::PreservedAnalyses::{ None(), CFG(), All() }`
+#define SC_REGISTER_FUNCTION_PASS_PRESERVING(function, name, category,         \
+                                             preserved, ...)                   \
+    _SC_REGISTER_PASS_IMPL(registerFunctionPass, function, name, category,     \
+                           preserved, __VA_ARGS__)
+
 /// Register a global pass. Same as `SC_REGISTER_FUNCTION_PASS` except that \p
 /// function is cast to module pass signature
 #define SC_REGISTER_MODULE_PASS(function, name, category, ...)                 \
@@ -31,7 +43,7 @@
         static_cast<bool (*)(::scatha::ir::Context&, ::scatha::ir::Module&,    \
                              ::scatha::ir::FunctionPass const&,                \
                              ::scatha::ir::PassArgumentMap const&)>(function), \
-        name, category, __VA_ARGS__)
+        name, category, ::scatha::ir::PreservedAnalyses::None(), __VA_ARGS__)
 
 namespace scatha::ir::internal {
 
@@ -39,13 +39,16 @@ bool PipelineModuleNode::execute(ir::Context& ctx, ir::Module& mod) const {
         if (children.empty()) {
             return {};
         }
-        return FunctionPass([this](ir::Context& ctx, ir::Function& F) {
+        auto runChildren = [this](ir::Context& ctx, ir::Function& F) {
             bool result = false;
             for (auto& child: children) {
                 result |= child->execute(ctx, F);
             }
             return result;
-        });
+        };
+        /// The child passes invalidate the analyses they don't preserve
+        return FunctionPass(runChildren, {}, {}, PassCategory::Schedule,
+                            PreservedAnalyses::All());
     }();
     return pass(ctx, mod, fnPass);
 }
@@ -149,6 +149,9 @@ static utl::vstreammanip<> formatType(ir::Type const* type) {
                 }
                 str << tfmt::format(None, " }");
             },
+            [&](VectorType const& type) {
+                str << tfmt::format(BrightBlue, type.name());
+            },
             [&](ArrayType const& type) {
                 str << tfmt::format(None, "[") << formatType(type.elementType()) << ", "
                     << formatNumLiteral(type.count()) << tfmt::format(None, "]");
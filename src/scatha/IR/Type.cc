@@ -57,8 +57,28 @@ void StructType::computeSizeAndAlign() {
 }
 
 ArrayType::ArrayType(Type const* elementType, size_t count):
-    RecordType(utl::strcat("[", elementType->name(), ",", count, "]"),
-               TypeCategory::ArrayType, count * elementType->size(),
+    ArrayType(utl::strcat("[", elementType->name(), ",", count, "]"),
+              TypeCategory::ArrayType, elementType, count) {}
+
+ArrayType::ArrayType(std::string name, TypeCategory category,
+                     Type const* elementType, size_t count):
+    RecordType(std::move(name), category, count * elementType->size(),
                elementType->align()),
     _elemType(elementType),
     _count(count) {}
+
+bool VectorType::isValid(ArithmeticType const* elementType, size_t count) {
+    if (count < 2 || elementType->bitwidth() % 8 != 0) {
+        return false;
+    }
+    size_t size = elementType->size() * count;
+    return size == RegisterSize || size == MaxByteSize;
+}
+
+VectorType::VectorType(ArithmeticType const* elementType, size_t count):
+    ArrayType(utl::strcat("v", count, elementType->name()),
+              TypeCategory::VectorType, elementType, count) {
+    SC_ASSERT(isValid(elementType, count),
+              "Vectors must have at least two lanes and fill one or two "
+              "registers");
+}
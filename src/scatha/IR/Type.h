@@ -197,6 +197,11 @@ class SCTEST_API ArrayType: public RecordType {
 public:
     explicit ArrayType(Type const* elementType, size_t count);
 
+protected:
+    explicit ArrayType(std::string name, TypeCategory category,
+                       Type const* elementType, size_t count);
+
+public:
     /// Element type
     Type const* elementType() const { return _elemType; }
 
@@ -221,6 +226,34 @@ private:
     size_t _count = 0;
 };
 
+/// Represents a packed vector of arithmetic elements like `v2i32` or `v2f64`.
+/// Vectors are arrays with the additional guarantee that they fill one or two
+/// registers of the VM, so arithmetic instructions can operate on them lane
+/// wise. Vectors that fill two registers are held in a pair of registers.
+class SCTEST_API VectorType: public ArrayType {
+public:
+    /// Size of one VM register in bytes
+    static constexpr size_t RegisterSize = 8;
+
+    /// Size of the largest vector types in bytes
+    static constexpr size_t MaxByteSize = 2 * RegisterSize;
+
+    /// \Returns `true` if \p count lanes of type \p elementType form a valid
+    /// vector, i.e. if there are at least two lanes of whole bytes and they
+    /// fill one or two registers
+    static bool isValid(ArithmeticType const* elementType, size_t count);
+
+    explicit VectorType(ArithmeticType const* elementType, size_t count);
+
+    /// Number of registers that hold a vector of this type
+    size_t numRegisters() const { return size() / RegisterSize; }
+
+    /// Element type
+    ArithmeticType const* elementType() const {
+        return cast<ArithmeticType const*>(ArrayType::elementType());
+    }
+};
+
 /// Represents a function type.
 class FunctionType: public Type {
 public:
@@ -42,7 +42,7 @@ struct AssertFnCtx {
     Function const& function;
     BasicBlock const* currentBB = nullptr;
     utl::hashmap<std::string, Value const*> nameValueMap;
-    DominanceInfo::DomMap domMap;
+    DomTree domTree;
 
     AssertFnCtx(Context& ctx, Function const& F): ctx(ctx), function(F) {}
 
@@ -55,7 +55,9 @@ struct AssertFnCtx {
     void assertInvariantsImpl(Branch const&);
     void assertInvariantsImpl(Load const&);
     void assertInvariantsImpl(Store const&);
+    void assertInvariantsImpl(ArithmeticInst const&);
     void assertInvariantsImpl(CompareInst const&);
+    void assertInvariantsImpl(Select const&);
     void assertInvariantsImpl(GetElementPointer const&);
 
     void checkUseDefDom(Instruction const& def, Instruction const& use);
@@ -126,8 +128,7 @@ void AssertFnCtx::run() {
     check(!function.empty(), function, "Empty functions are invalid");
     /// Annoying that we have to `const_cast` here, but `DominanceInfo` exposes
     /// all references as mutable so we have no choice.
-    domMap =
-        DominanceInfo::computeDominatorSets(const_cast<Function&>(function));
+    domTree = DominanceInfo::computeDomTree(const_cast<Function&>(function));
     for (auto& BB: function) {
         check(BB.parent() == &function, BB,
               "Parent pointers must be setup correctly");
@@ -217,10 +218,8 @@ void AssertFnCtx::checkUseDefDom(Instruction const& def,
               "Defs must dominate uses");
     }
     else {
-        auto itr = domMap.find(use.parent());
-        SC_ASSERT(itr != domMap.end(), "");
-        auto& domSet = itr->second;
-        check(domSet.contains(def.parent()), use, "Defs must dominate uses");
+        check(domTree.dominates(def.parent(), use.parent()), use,
+              "Defs must dominate uses");
     }
 }
 
@@ -232,7 +231,8 @@ void AssertFnCtx::assertInvariants(Instruction const& inst) {
     }
     for (auto [index, operand]: inst.operands() | enumerate) {
         check(operand != nullptr, inst, "Operands can't be null");
-        check(operand->countedUsers().contains(&inst), inst,
+        auto& use = inst.useAt(index);
+        check(use.isLinked() && use.user() == &inst, inst,
               "Our operands must have listed us as their user");
         if (auto* def = dyncast<Instruction const*>(operand)) {
             check(
@@ -247,9 +247,8 @@ void AssertFnCtx::assertInvariants(Instruction const& inst) {
             }
         }
     }
-    for (auto* user: inst.users()) {
-        check(ranges::contains(user->operands(), &inst), inst,
-              "Our users must actually use us");
+    for (auto* use = inst.firstUse(); use; use = use->next()) {
+        check(use->value() == &inst, inst, "Our users must actually use us");
     }
     visit(inst, [this](auto& inst) { assertInvariantsImpl(inst); });
 }
@@ -314,10 +313,27 @@ void AssertFnCtx::assertInvariantsImpl(Store const& store) {
     }
 }
 
+void AssertFnCtx::assertInvariantsImpl(ArithmeticInst const& inst) {
+    if (isa<VectorType>(inst.type())) {
+        check(hasVectorForm(inst.operation()), inst,
+              "Operation is not defined for vector operands");
+    }
+}
+
 void AssertFnCtx::assertInvariantsImpl(CompareInst const& cmp) {
     check(cmp.lhs()->type() == cmp.rhs()->type(), cmp,
           "Compare operands must have the same type");
     auto* type = cmp.lhs()->type();
+    /// Vectors are compared lane wise
+    if (auto* vecType = dyncast<VectorType const*>(type)) {
+        check(cmp.type() == ctx.maskType(vecType), cmp,
+              "Vector comparisons must produce a lane mask");
+        type = vecType->elementType();
+    }
+    else {
+        check(cmp.type() == ctx.intType(1), cmp,
+              "Scalar comparisons must produce an i1");
+    }
     switch (cmp.mode()) {
     case CompareMode::Signed:
     case CompareMode::Unsigned:
@@ -330,6 +346,19 @@ void AssertFnCtx::assertInvariantsImpl(CompareInst const& cmp) {
     }
 }
 
+void AssertFnCtx::assertInvariantsImpl(Select const& select) {
+    check(select.thenValue()->type() == select.type() &&
+              select.elseValue()->type() == select.type(),
+          select, "Selected values must have the type of the select");
+    auto* condType = select.condition()->type();
+    if (condType == ctx.intType(1)) {
+        return;
+    }
+    auto* vecType = dyncast<VectorType const*>(select.type());
+    check(vecType && condType == ctx.maskType(vecType), select,
+          "Condition must be i1 or a lane mask of the selected vectors");
+}
+
 void AssertFnCtx::assertInvariantsImpl(GetElementPointer const& gep) {
     check(gep.basePointer()->type() == ctx.ptrType(), gep,
           "Base pointer must be of pointer type");
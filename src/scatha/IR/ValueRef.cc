@@ -6,7 +6,8 @@ using namespace scatha;
 using namespace ir;
 
 ValueRef::ValueRef(Value* value): _value(value) {
-    value->_references.insert(this);
+    auto lock = value->lockUseLists();
+    value->sideTable().references.insert(this);
 }
 
 ValueRef::ValueRef(ValueRef const& rhs): ValueRef(rhs.value()) {}
@@ -17,7 +18,8 @@ ValueRef& ValueRef::operator=(ValueRef const& rhs) {
     }
     reset();
     _value = rhs.value();
-    _value->_references.insert(this);
+    auto lock = _value->lockUseLists();
+    _value->sideTable().references.insert(this);
     return *this;
 }
 
@@ -25,6 +27,7 @@ ValueRef::~ValueRef() { reset(); }
 
 void ValueRef::reset() {
     if (_value) {
-        _value->_references.erase(this);
+        auto lock = _value->lockUseLists();
+        _value->sideTable().references.erase(this);
     }
 }
@@ -5,8 +5,10 @@
 #include "AST/AST.h"
 #include "IR/CFG/Constants.h"
 #include "IR/CFG/Function.h"
+#include "IR/CFG/GlobalVariable.h"
 #include "IR/CFG/Instructions.h"
 #include "IR/Context.h"
+#include "IR/Module.h"
 #include "IR/Type.h"
 #include "IR/Validate.h"
 #include "IRGen/GlobalDecls.h"
@@ -42,6 +44,19 @@ ir::Callable* FuncGenContextBase::getFunction(
     return irgen::getFunction(*semaFunction, lctx);
 }
 
+ir::GlobalVariable* FuncGenContextBase::makeGlobalConstant(ir::Constant* value,
+                                                          std::string name) {
+    std::lock_guard lock(lctx.mutex);
+    auto* global = mod.makeGlobalConstant(ctx, value, name);
+    /// Which function creates a shared constant first depends on thread
+    /// scheduling, so we name it after the smallest name any user asks for
+    if (name < global->name()) {
+        global->setName(std::move(name));
+    }
+    lctx.noteUse(global);
+    return global;
+}
+
 CallingConvention FuncGenContextBase::getCC(sema::Function const* function) {
     return globalMap(function).CC;
 }
@@ -44,6 +44,13 @@ struct FuncGenContextBase: ir::FunctionBuilder {
     /// declared it will be declared.
     ir::Callable* getFunction(sema::Function const* semaFn);
 
+    /// Creates a global constant with value \p value or returns an existing
+    /// one. Unlike `ir::Module::makeGlobalConstant()` this may be called while
+    /// other functions are generated concurrently. If several functions use
+    /// the same constant, it gets the smallest of the requested names
+    ir::GlobalVariable* makeGlobalConstant(ir::Constant* value,
+                                           std::string name);
+
     /// Get the calling convention of \p function
     CallingConvention getCC(sema::Function const* function);
 
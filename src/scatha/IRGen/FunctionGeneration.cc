@@ -236,6 +236,7 @@ struct FuncGenContext: FuncGenContextBase {
 
 void irgen::generateFunction(sema::Function const* semaFn, ir::Function& irFn,
                              LoweringContext& loweringContext) {
+    ir::NodeAllocatorScope allocScope(irFn);
     using enum sema::FunctionKind;
     switch (semaFn->kind()) {
     case Native:
@@ -312,6 +313,9 @@ GlobalVarMetadata irgen::generateGlobalVariable(sema::Variable const& semaVar,
     /// We insert the metadata into the map before generating the initializer to
     /// avoid infinite recursion with cyclic references between global variables
     lctx.globalMap.insert(&semaVar, metadata);
+    /// We may be called while generating another function, whose allocator
+    /// must not own the nodes of the getter
+    ir::NodeAllocatorScope allocScope(*getter);
     FuncGenContext builder(nullptr, *getter, lctx);
     builder.generateGlobalVarGetter(metadata, varDecl);
     return metadata;
@@ -751,7 +755,7 @@ Value FuncGenContext::getValueImpl(ast::Literal const& lit) {
         auto const& text = lit.value<std::string>();
         auto name = nameFromSourceLoc("string", lit.sourceLocation());
         auto* data = ctx.stringLiteral(text);
-        auto* global = mod.makeGlobalConstant(ctx, data, name);
+        auto* global = makeGlobalConstant(data, name);
         return Value::Unpacked(name, lit.type(),
                                { Atom::Register(global),
                                  Atom::Register(
@@ -1373,7 +1377,7 @@ bool FuncGenContext::genStaticListData(ast::ListExpression const& list,
     auto* irType = ctx.arrayType(typeMap.packed(elemType), type->count());
     auto* value = ctx.arrayConstant(elems, irType);
     auto name = nameFromSourceLoc("listexpr", list.sourceLocation());
-    auto* global = mod.makeGlobalConstant(ctx, value, std::move(name));
+    auto* global = makeGlobalConstant(value, std::move(name));
     callMemcpy(dest, global, irType->size());
     return true;
 }
@@ -2206,10 +2210,15 @@ void FuncGenContext::generateGlobalVarGetter(
 
 ir::Function* FuncGenContext::getGlobalVarGetter(
     sema::Variable const& semaVar) {
-    if (auto md = globalMap.tryGet(&semaVar)) {
-        return md->getter;
-    }
-    return makeGlobalVariable(semaVar).getter;
+    std::lock_guard lock(lctx.mutex);
+    auto md = globalMap.tryGet(&semaVar);
+    if (!md) {
+        md = makeGlobalVariable(semaVar);
+    }
+    lctx.noteUse(md->var);
+    lctx.noteUse(md->varInit);
+    lctx.noteUse(md->getter);
+    return md->getter;
 }
 
 void FuncGenContext::assignValue(Value dest, Value source) {
@@ -53,6 +53,7 @@ static ir::Function* generateThunk(ir::Function* target,
                                         std::move(name), target->attributes(),
                                         vis);
     auto* thunk = lctx.mod.addGlobal(std::move(owner));
+    ir::NodeAllocatorScope allocScope(*thunk);
     ir::FunctionBuilder builder(ctx, thunk);
     builder.addNewBlock("entry");
     SC_ASSERT(ranges::distance(thunk->parameters()) >= 2,
@@ -474,8 +475,9 @@ ir::Callable* irgen::declareFunction(sema::Function const& semaFn,
     }
 }
 
-ir::Callable* irgen::getFunction(sema::Function const& semaFn,
-                                 LoweringContext& lctx, bool pushToDeclQueue) {
+static ir::Callable* getFunctionImpl(sema::Function const& semaFn,
+                                     LoweringContext& lctx,
+                                     bool pushToDeclQueue) {
     if (auto md = lctx.globalMap.tryGet(&semaFn)) {
         return md->function;
     }
@@ -487,3 +489,11 @@ ir::Callable* irgen::getFunction(sema::Function const& semaFn,
     }
     return declareFunction(semaFn, lctx);
 }
+
+ir::Callable* irgen::getFunction(sema::Function const& semaFn,
+                                 LoweringContext& lctx, bool pushToDeclQueue) {
+    std::lock_guard lock(lctx.mutex);
+    auto* function = getFunctionImpl(semaFn, lctx, pushToDeclQueue);
+    lctx.noteUse(function);
+    return function;
+}
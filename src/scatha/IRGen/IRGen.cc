@@ -2,15 +2,18 @@
 
 #include <fstream>
 #include <queue>
+#include <span>
 #include <vector>
 
 #include <range/v3/algorithm.hpp>
 #include <range/v3/view.hpp>
 #include <utl/hashtable.hpp>
+#include <utl/scope_guard.hpp>
 #include <utl/strcat.hpp>
 
 #include "AST/AST.h"
 #include "Common/DebugInfo.h"
+#include "Common/ThreadPool.h"
 #include "IR/CFG/Function.h"
 #include "IR/CFG/GlobalVariable.h"
 #include "IR/Context.h"
@@ -74,6 +77,59 @@ static void declareInitialFunctions(sema::AnalysisResult const& analysisResult,
     }
 }
 
+/// Generates the bodies of all functions in \p batch in parallel.
+/// Functions and globals that are declared while generating the bodies are
+/// added to the module in unspecified order. Afterwards we move them into the
+/// order in which they are first used by the functions of the batch and queue
+/// the newly declared functions in the same order, so the resulting module
+/// does not depend on thread scheduling
+static void generateFunctions(std::span<sema::Function const* const> batch,
+                              LoweringContext& lctx) {
+    auto& mod = lctx.mod;
+    ir::Global const* lastFunction = mod.empty() ? nullptr : &mod.back();
+    ir::Global const* lastGlobal =
+        mod.globals().empty() ? nullptr : &mod.globals().back();
+    std::vector<std::vector<ir::Global*>> useLogs(batch.size());
+    ThreadPool::global().parallelFor(batch.size(), [&](size_t index) {
+        auto* semaFn = batch[index];
+        auto* native = dyncast<ir::Function*>(lctx.globalMap(semaFn).function);
+        if (!native) {
+            return;
+        }
+        LoweringContext::useLog = &useLogs[index];
+        utl::scope_guard resetLog = [] { LoweringContext::useLog = nullptr; };
+        generateFunction(semaFn, *native, lctx);
+    });
+    /// Collect the globals that have been added by this batch
+    utl::hashset<ir::Global*> added;
+    for (auto& F: mod.functions() | reverse) {
+        if (&F == lastFunction) break;
+        added.insert(&F);
+    }
+    for (auto& global: mod.globals() | reverse) {
+        if (&global == lastGlobal) break;
+        added.insert(&global);
+    }
+    if (added.empty()) {
+        return;
+    }
+    std::vector<ir::Global*> order;
+    utl::hashmap<ir::Global const*, size_t> position;
+    for (auto* global: useLogs | join) {
+        if (added.contains(global) && position.insert({ global, order.size() })
+                                          .second)
+        {
+            order.push_back(global);
+        }
+    }
+    SC_ASSERT(order.size() == added.size(),
+              "Every new global must have been used by a function");
+    mod.moveToBack(order);
+    ranges::sort(lctx.declQueue, ranges::less{}, [&](auto* semaFn) {
+        return position[lctx.globalMap(semaFn).function];
+    });
+}
+
 void irgen::generateIR(ir::Context& ctx, ir::Module& mod, ast::ASTNode const&,
                        sema::SymbolTable const& sym,
                        sema::AnalysisResult const& analysisResult,
@@ -96,14 +152,15 @@ void irgen::generateIR(ir::Context& ctx, ir::Module& mod, ast::ASTNode const&,
     for (auto* var: globalVariables) {
         generateGlobalVariable(*var, lctx);
     }
+    /// We generate the functions in the decl queue in batches. Every batch
+    /// queues the functions it calls that have not been declared yet
     while (!lctx.declQueue.empty()) {
-        auto* semaFn = lctx.declQueue.front();
-        lctx.declQueue.pop_front();
-        auto* irFn = lctx.globalMap(semaFn).function;
-        auto* native = dyncast<ir::Function*>(irFn);
-        if (!native) continue;
-        generateFunction(semaFn, *native, lctx);
+        std::vector<sema::Function const*> batch(lctx.declQueue.begin(),
+                                                 lctx.declQueue.end());
+        lctx.declQueue.clear();
+        generateFunctions(batch, lctx);
     }
+    materializeLibraryCode(lctx);
     ir::assertInvariants(ctx, mod);
     if (config.generateDebugSymbols) {
         mod.setMetadata(config.sourceFiles | transform(&SourceFile::path) |
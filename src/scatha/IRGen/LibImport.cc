@@ -3,19 +3,23 @@
 #include <iostream>
 #include <span>
 
+#include <range/v3/algorithm.hpp>
 #include <svm/Builtin.h>
 #include <utl/graph.hpp>
+#include <utl/hashtable.hpp>
 #include <utl/vector.hpp>
 
-#include "Common/FileHandling.h"
 #include "Common/Ranges.h"
+#include "IR/BinSerialize.h"
 #include "IR/CFG.h"
+#include "IR/Context.h"
 #include "IR/IRParser.h"
 #include "IR/Module.h"
+#include "IR/PointerInfo.h"
 #include "IR/Type.h"
 #include "IRGen/GlobalDecls.h"
 #include "IRGen/LoweringContext.h"
-#include "Invocation/TargetNames.h"
+#include "Invocation/LibraryCache.h"
 #include "Sema/Entity.h"
 #include "Sema/SymbolTable.h"
 
@@ -109,10 +113,8 @@ static void checkParserIssues(std::span<ir::ParseIssue const> issues,
 
 static void importLibrary(sema::NativeLibrary const& lib, ImportMap& importMap,
                           LoweringContext& lctx) {
-    auto archive = Archive::Open(lib.path());
-    SC_RELASSERT(archive, "Failed to open library file");
-    auto code = archive->openTextFile(TargetNames::ObjectCodeName);
-    SC_RELASSERT(code, "Failed to open object code file");
+    auto files = LibraryCache::load(lib.path());
+    SC_RELASSERT(files, "Failed to open library file");
     auto typeCallback = [&](ir::StructType& type, ir::DeclToken& declToken) {
         if (!importMap.insert(&type)) {
             declToken.ignore();
@@ -124,11 +126,26 @@ static void importLibrary(sema::NativeLibrary const& lib, ImportMap& importMap,
         }
         importMap.insert(&object);
     };
-    auto parseIssues = ir::parseTo(*code, lctx.ctx, lctx.mod,
-                                   { .typeParseCallback = typeCallback,
-                                     .objectParseCallback = objCallback,
-                                     .assertInvariants = false });
-    checkParserIssues(parseIssues, lib.path().string());
+    ir::ParseOptions options = { .typeParseCallback = typeCallback,
+                                 .objectParseCallback = objCallback,
+                                 .assertInvariants = false };
+    if (auto& code = files->objectCode) {
+        auto import =
+            ir::LazyModuleImport::Open(lctx.ctx, lctx.mod, code, options);
+        if (!import) {
+            std::cerr << "Failed to read object code of library \""
+                      << lib.path().string() << "\"\n";
+            SC_ABORT();
+        }
+        lctx.libraryImports.push_back(std::move(import));
+    }
+    else {
+        /// Libraries built before the binary format store textual IR
+        auto& text = files->textObjectCode;
+        SC_RELASSERT(text, "Failed to open object code file");
+        auto parseIssues = ir::parseTo(*text, lctx.ctx, lctx.mod, options);
+        checkParserIssues(parseIssues, lib.path().string());
+    }
     MapCtx mapCtx(importMap, lctx);
     mapCtx.mapScope(lib);
     /// We defer generation of type metadata because to generate vtables all
@@ -185,6 +202,9 @@ static void uniqueGlobals(LoweringContext& lctx) {
         auto* existing = itr->second;
         SC_RELASSERT(existing->nodeType() == global.nodeType(), "");
         global.replaceAllUsesWith(existing);
+        for (auto& import: lctx.libraryImports) {
+            import->replaceGlobal(global, *existing);
+        }
         toErase.push_back(&global);
     };
     for (auto& global: lctx.mod.globals()) {
@@ -210,3 +230,137 @@ void irgen::importLibraries(sema::SymbolTable const& sym,
     }
     uniqueGlobals(lctx);
 }
+
+namespace {
+
+/// Finds the library code that is reachable from the rest of the module and
+/// decodes the bodies of the reachable library functions
+struct MaterializeCtx {
+    explicit MaterializeCtx(LoweringContext& lctx): lctx(lctx) {}
+
+    LoweringContext& lctx;
+    utl::hashset<ir::Value const*> visited;
+    utl::small_vector<ir::Value*> worklist;
+
+    void run();
+    bool isImported(ir::Global const& global) const;
+    ir::LazyModuleImport* pendingImport(ir::Function const& function) const;
+    void visit(ir::Value* value);
+    void visitPtrInfo(ir::Value const& value);
+    void eraseUnreached();
+};
+
+} // namespace
+
+void irgen::materializeLibraryCode(LoweringContext& lctx) {
+    if (lctx.libraryImports.empty()) {
+        return;
+    }
+    MaterializeCtx(lctx).run();
+    lctx.libraryImports.clear();
+}
+
+void MaterializeCtx::run() {
+    /// Library globals are only roots if they are visible outside of the
+    /// module. Library functions are always imported with internal visibility
+    for (auto& global: lctx.mod.globals()) {
+        if (!isImported(global) ||
+            global.visibility() == ir::Visibility::External)
+        {
+            visit(&global);
+        }
+    }
+    for (auto& F: lctx.mod) {
+        if (!isImported(F)) {
+            visit(&F);
+        }
+    }
+    while (!worklist.empty()) {
+        auto* value = worklist.back();
+        worklist.pop_back();
+        if (auto* F = dyncast<ir::Function*>(value)) {
+            if (auto* import = pendingImport(*F)) {
+                SC_RELASSERT(import->materialize(*F),
+                             "Failed to read library function");
+            }
+            for (auto& param: F->parameters()) {
+                visitPtrInfo(param);
+            }
+            for (auto& inst: F->instructions()) {
+                for (auto* operand: inst.operands()) {
+                    visit(operand);
+                }
+                visitPtrInfo(inst);
+            }
+        }
+        else if (auto* user = dyncast<ir::User*>(value)) {
+            /// Global variables and record constants
+            for (auto* operand: user->operands()) {
+                visit(operand);
+            }
+            visitPtrInfo(*user);
+        }
+    }
+    eraseUnreached();
+}
+
+bool MaterializeCtx::isImported(ir::Global const& global) const {
+    return ranges::any_of(lctx.libraryImports, [&](auto& import) {
+        return import->isImported(global);
+    });
+}
+
+ir::LazyModuleImport* MaterializeCtx::pendingImport(
+    ir::Function const& function) const {
+    for (auto& import: lctx.libraryImports) {
+        if (import->isPending(function)) {
+            return import.get();
+        }
+    }
+    return nullptr;
+}
+
+void MaterializeCtx::visit(ir::Value* value) {
+    /// Only constants can reference globals. Local values are visited through
+    /// their functions
+    if (!value || !isa<ir::Constant>(value) || !visited.insert(value).second) {
+        return;
+    }
+    worklist.push_back(value);
+}
+
+void MaterializeCtx::visitPtrInfo(ir::Value const& value) {
+    if (auto* info = value.pointerInfo()) {
+        visit(info->provenance().value());
+    }
+}
+
+void MaterializeCtx::eraseUnreached() {
+    /// Unreached library globals can only be referenced by other unreached
+    /// values. We first drop the references of the unreached variables so the
+    /// constants they use become unused, then erase everything that is unused
+    utl::small_vector<ir::Global*> unreached;
+    auto collect = [&](ir::Global& global) {
+        if (isImported(global) && !visited.contains(&global)) {
+            unreached.push_back(&global);
+        }
+    };
+    for (auto& global: lctx.mod.globals()) {
+        collect(global);
+    }
+    for (auto& F: lctx.mod) {
+        collect(F);
+    }
+    for (auto* var: unreached | Filter<ir::GlobalVariable>) {
+        var->clearOperands();
+    }
+    lctx.ctx.cleanConstants();
+    for (auto* global: unreached) {
+        if (isa<ir::ForeignFunction>(global)) {
+            continue;
+        }
+        SC_ASSERT(global->unused(),
+                  "Unreached globals can only be used by unreached values");
+        lctx.mod.erase(global);
+    }
+}
@@ -12,6 +12,12 @@ struct LoweringContext;
 void importLibraries(sema::SymbolTable const& symbolTable,
                      LoweringContext& lctx);
 
+/// Library functions are imported without body. This function decodes the
+/// bodies of all library functions that are transitively referenced by the
+/// rest of the module and erases the library functions and global variables
+/// that are not referenced. Must be called after all code has been generated
+void materializeLibraryCode(LoweringContext& lctx);
+
 } // namespace scatha::irgen
 
 #endif // SCATHA_IRGEN_LIBIMPORT_H_
@@ -2,12 +2,16 @@
 #define SCATHA_IRGEN_LOWERINGCONTEXT_H_
 
 #include <deque>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <utl/hashtable.hpp>
 #include <utl/strcat.hpp>
 
 #include "AST/Fwd.h"
+#include "IR/BinSerialize.h"
 #include "IR/Fwd.h"
 #include "IRGen/IRGen.h"
 #include "IRGen/Maps.h"
@@ -60,6 +64,27 @@ struct LoweringContext {
     utl::hashset<sema::Function const*> lowered;
     /// To avoid generating the same thunk twice we cache them here
     utl::hashmap<ThunkKey, ir::Function*> thunkMap;
+    /// Object code of imported libraries whose function bodies have not been
+    /// decoded yet. See `materializeLibraryCode()`
+    std::vector<std::unique_ptr<ir::LazyModuleImport>> libraryImports;
+    /// Guards the module, the decl queue and the declaration of globals while
+    /// function bodies are generated in parallel. Recursive because declaring
+    /// a global variable generates its getter function
+    std::recursive_mutex mutex;
+
+    /// Records that the function generated on the calling thread uses
+    /// \p global. Concurrently generated functions add globals to the module
+    /// in unspecified order, so the recorded uses are used to reorder the
+    /// module afterwards
+    static void noteUse(ir::Global* global) {
+        if (useLog && global) {
+            useLog->push_back(global);
+        }
+    }
+
+    /// Globals used by the function that is generated on this thread, or null
+    /// if functions are generated sequentially
+    static inline thread_local std::vector<ir::Global*>* useLog = nullptr;
 };
 
 } // namespace scatha::irgen
@@ -81,6 +81,7 @@ void irgen::print(ValueMap const& valueMap) { print(valueMap, std::cout); }
 
 void GlobalMap::insert(sema::Function const* semaFn,
                        FunctionMetadata metadata) {
+    std::unique_lock lock(mutex);
     [[maybe_unused]] bool success =
         functions.insert({ semaFn, std::move(metadata) }).second;
     SC_ASSERT(success, "Redeclaration");
@@ -88,6 +89,7 @@ void GlobalMap::insert(sema::Function const* semaFn,
 
 void GlobalMap::insert(sema::Variable const* semaVar,
                        GlobalVarMetadata metadata) {
+    std::unique_lock lock(mutex);
     [[maybe_unused]] bool success =
         vars.insert({ semaVar, std::move(metadata) }).second;
     SC_ASSERT(success, "Redeclaration");
@@ -101,6 +103,7 @@ FunctionMetadata GlobalMap::operator()(sema::Function const* F) const {
 
 std::optional<FunctionMetadata> GlobalMap::tryGet(
     sema::Function const* F) const {
+    std::shared_lock lock(mutex);
     auto itr = functions.find(F);
     if (itr != functions.end()) {
         return itr->second;
@@ -116,6 +119,7 @@ GlobalVarMetadata GlobalMap::operator()(sema::Variable const* V) const {
 
 std::optional<GlobalVarMetadata> GlobalMap::tryGet(
     sema::Variable const* V) const {
+    std::shared_lock lock(mutex);
     auto itr = vars.find(V);
     if (itr != vars.end()) {
         return itr->second;
@@ -134,6 +138,7 @@ static void insertImpl(Map& map, typename Map::key_type key,
 }
 
 void TypeMap::insert(sema::RecordType const* key, ir::StructType const* value) {
+    std::lock_guard lock(cacheMutex);
     insertImpl(packedMap, key, value);
     insertImpl(unpackedMap, key, { value });
 }
@@ -204,7 +209,9 @@ auto TypeMap::compute(sema::Type const* type) const {
     }
 }
 
-static auto mapChached(auto& cache, sema::Type const* key, auto compute) {
+static auto mapChached(auto& cache, std::recursive_mutex& mutex,
+                       sema::Type const* key, auto compute) {
+    std::lock_guard lock(mutex);
     auto itr = cache.find(key);
     if (itr != cache.end()) {
         return itr->second;
@@ -215,13 +222,13 @@ static auto mapChached(auto& cache, sema::Type const* key, auto compute) {
 }
 
 ir::Type const* TypeMap::packed(sema::Type const* type) const {
-    return mapChached(packedMap, type,
+    return mapChached(packedMap, cacheMutex, type,
                       std::bind_front(&TypeMap::compute<Packed>, this));
 }
 
 utl::small_vector<ir::Type const*, 2> TypeMap::unpacked(
     sema::Type const* type) const {
-    return mapChached(unpackedMap, type,
+    return mapChached(unpackedMap, cacheMutex, type,
                       std::bind_front(&TypeMap::compute<Unpacked>, this));
 }
 
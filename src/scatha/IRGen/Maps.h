@@ -4,7 +4,9 @@
 #include <concepts>
 #include <functional>
 #include <iosfwd>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <span>
 #include <string>
 
@@ -60,6 +62,7 @@ void print(ValueMap const& valueMap, std::ostream& ostream);
 void print(ValueMap const& valueMap);
 
 /// Maps global sema objects to IR objects
+/// All member functions are thread safe
 class GlobalMap {
 public:
     /// Associate \p semaFn with \p irFn and \p metadata
@@ -82,11 +85,14 @@ public:
     std::optional<GlobalVarMetadata> tryGet(sema::Variable const* var) const;
 
 private:
+    mutable std::shared_mutex mutex;
     utl::hashmap<sema::Function const*, FunctionMetadata> functions;
     utl::hashmap<sema::Variable const*, GlobalVarMetadata> vars;
 };
 
 /// Maps sema types to IR types
+/// Type translation is thread safe. Insertion is not and must happen before
+/// functions are generated concurrently
 class TypeMap {
 public:
     explicit TypeMap(ir::Context& ctx): ctx(&ctx) {}
@@ -123,6 +129,9 @@ private:
     auto compute(sema::Type const* type) const;
 
     ir::Context* ctx;
+    /// Guards the caches. Recursive because computing the type of an array
+    /// translates the element type
+    mutable std::recursive_mutex cacheMutex;
     /// Mutable to cache results in const getter functions
     mutable utl::hashmap<sema::Type const*, ir::Type const*> packedMap;
     mutable utl::hashmap<sema::Type const*,
@@ -0,0 +1,72 @@
+#include "Invocation/BuildId.h"
+
+#include <filesystem>
+#include <optional>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#include <utl/strcat.hpp>
+
+using namespace scatha;
+
+#ifndef SCATHA_BUILD_ID
+#define SCATHA_BUILD_ID "unknown"
+#endif
+
+/// \Returns the path of the executable or shared library that contains this
+/// function
+static std::optional<std::filesystem::path> compilerBinaryPath() {
+    auto* address = reinterpret_cast<void const*>(&compilerBinaryPath);
+#if defined(_WIN32)
+    HMODULE module = nullptr;
+    if (!GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                                GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                            reinterpret_cast<LPCWSTR>(address),
+                            &module))
+    {
+        return std::nullopt;
+    }
+    wchar_t buffer[MAX_PATH];
+    DWORD size = GetModuleFileNameW(module, buffer, MAX_PATH);
+    if (size == 0 || size == MAX_PATH) {
+        return std::nullopt;
+    }
+    return std::filesystem::path(buffer, buffer + size);
+#else
+    Dl_info info;
+    if (!dladdr(address, &info) || !info.dli_fname) {
+        return std::nullopt;
+    }
+    return std::filesystem::path(info.dli_fname);
+#endif
+}
+
+static std::string computeBuildId() {
+    auto path = compilerBinaryPath();
+    if (!path) {
+        return SCATHA_BUILD_ID;
+    }
+    std::error_code ec;
+    auto absPath = std::filesystem::canonical(*path, ec);
+    auto size = std::filesystem::file_size(absPath, ec);
+    if (ec) {
+        return SCATHA_BUILD_ID;
+    }
+    auto time = std::filesystem::last_write_time(absPath, ec);
+    if (ec) {
+        return SCATHA_BUILD_ID;
+    }
+    return utl::strcat(SCATHA_BUILD_ID, ";", absPath.string(), ";", size, ";",
+                       time.time_since_epoch().count());
+}
+
+std::string const& scatha::compilerBuildId() {
+    static std::string const id = computeBuildId();
+    return id;
+}
@@ -0,0 +1,19 @@
+#ifndef SCATHA_INVOCATION_BUILDID_H_
+#define SCATHA_INVOCATION_BUILDID_H_
+
+#include <string>
+
+namespace scatha {
+
+/// \Returns a string that identifies this build of the compiler. Cache keys
+/// include it so entries written by other builds are never reused.
+/// The identifier combines the build id injected by CMake with the path, size
+/// and modification time of the binary that contains the compiler, so it also
+/// changes on rebuilds of an uncommitted tree. Like ccache's default compiler
+/// check, we don't hash the contents of the binary, because that would cost
+/// more than a cache hit saves
+std::string const& compilerBuildId();
+
+} // namespace scatha
+
+#endif // SCATHA_INVOCATION_BUILDID_H_
@@ -0,0 +1,240 @@
+#include "Invocation/CompilationCache.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <utl/strcat.hpp>
+#include <utl/vector.hpp>
+
+#include "Common/BinaryIO.h"
+#include "Invocation/ContentHash.h"
+
+using namespace scatha;
+
+/// # Entry format
+///
+///     Magic "SCCE", EntryFormatVersion
+///     Checksum: hex digest of the payload
+///     Payload:  size, bytes
+///
+/// The checksum detects entries that have been truncated or otherwise
+/// corrupted. Such entries are treated as misses and removed.
+
+static constexpr std::string_view EntryMagic = "SCCE";
+
+static constexpr uint64_t EntryFormatVersion = 1;
+
+static constexpr std::string_view EntryExt = ".sccache";
+
+static std::string checksum(std::span<unsigned char const> data) {
+    ContentHasher hasher;
+    hasher.add(data);
+    return hasher.hexDigest();
+}
+
+/// \Returns the payload of the entry \p data or `std::nullopt` if the entry is
+/// invalid
+static std::optional<std::vector<unsigned char>> decodeEntry(
+    std::span<unsigned char const> data) {
+    try {
+        ByteReader in(data);
+        if (in.bytes(EntryMagic.size()) != EntryMagic ||
+            in.varint() != EntryFormatVersion)
+        {
+            return std::nullopt;
+        }
+        auto sum = in.bytes(in.count());
+        auto payloadView = in.bytes(in.count());
+        std::span payload(
+            reinterpret_cast<unsigned char const*>(payloadView.data()),
+            payloadView.size());
+        if (!in.atEnd() || sum != checksum(payload)) {
+            return std::nullopt;
+        }
+        return std::vector<unsigned char>(payload.begin(), payload.end());
+    }
+    catch (BinaryFormatError const&) {
+        return std::nullopt;
+    }
+}
+
+static std::string encodeEntry(std::span<unsigned char const> payload) {
+    ByteWriter out;
+    out.bytes(EntryMagic);
+    out.varint(EntryFormatVersion);
+    auto sum = checksum(payload);
+    out.varint(sum.size());
+    out.bytes(sum);
+    out.varint(payload.size());
+    out.bytes(std::string_view(reinterpret_cast<char const*>(payload.data()),
+                               payload.size()));
+    return out.data();
+}
+
+namespace {
+
+struct EntryInfo {
+    std::filesystem::path path;
+    size_t size;
+    std::filesystem::file_time_type time;
+};
+
+} // namespace
+
+static utl::vector<EntryInfo> listEntries(std::filesystem::path const& dir) {
+    utl::vector<EntryInfo> entries;
+    std::error_code ec;
+    for (auto& file: std::filesystem::directory_iterator(dir, ec)) {
+        if (file.path().extension() != EntryExt) {
+            continue;
+        }
+        auto size = file.file_size(ec);
+        if (ec) continue;
+        auto time = file.last_write_time(ec);
+        if (ec) continue;
+        entries.push_back({ file.path(), static_cast<size_t>(size), time });
+    }
+    return entries;
+}
+
+CompilationCache::CompilationCache(std::filesystem::path directory,
+                                   size_t maxSize):
+    dir(std::move(directory)), _maxSize(maxSize) {
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec);
+    for (auto& entry: listEntries(dir)) {
+        estimatedSize += entry.size;
+    }
+}
+
+std::filesystem::path CompilationCache::entryPath(std::string_view key) const {
+    return dir / utl::strcat(key, EntryExt);
+}
+
+std::optional<std::vector<unsigned char>> CompilationCache::lookup(
+    std::string_view key) {
+    std::lock_guard lock(mutex);
+    auto path = entryPath(key);
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    std::vector<unsigned char> data(std::istreambuf_iterator<char>(file), {});
+    file.close();
+    auto payload = decodeEntry(data);
+    std::error_code ec;
+    if (!payload) {
+        if (std::filesystem::remove(path, ec)) {
+            estimatedSize -= std::min(estimatedSize, data.size());
+        }
+        ++_stats.misses;
+        return std::nullopt;
+    }
+    /// Eviction removes the entries with the oldest modification time first,
+    /// so we update it on every hit
+    std::filesystem::last_write_time(path,
+                                     std::filesystem::file_time_type::clock::
+                                         now(),
+                                     ec);
+    ++_stats.hits;
+    return payload;
+}
+
+void CompilationCache::store(std::string_view key,
+                             std::span<unsigned char const> data) {
+    std::lock_guard lock(mutex);
+    auto entry = encodeEntry(data);
+    if (entry.size() > _maxSize) {
+        return;
+    }
+    auto path = entryPath(key);
+    /// We write to a uniquely named temporary file and rename it, so
+    /// concurrent readers never see partially written entries
+    std::random_device rng;
+    auto tmpPath = path;
+    tmpPath += utl::strcat(".", rng(), rng(), ".tmp");
+    std::error_code ec;
+    auto replacedSize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        replacedSize = 0;
+    }
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(entry.data(), static_cast<std::streamsize>(entry.size()));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(tmpPath, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmpPath, ec);
+        return;
+    }
+    estimatedSize -= std::min<size_t>(estimatedSize, replacedSize);
+    estimatedSize += entry.size();
+    /// Listing the directory is expensive for large caches, so we only do it
+    /// when our own bookkeeping says that the limit is exceeded
+    if (estimatedSize > _maxSize) {
+        evict(path);
+    }
+}
+
+/// Removes the least recently used entries until the cache fits its size
+/// limit. The entry at \p keep has just been written and is never removed, even
+/// if the file system time resolution makes it look as old as other entries
+void CompilationCache::evict(std::filesystem::path const& keep) {
+    auto entries = listEntries(dir);
+    size_t total = 0;
+    for (auto& entry: entries) {
+        total += entry.size;
+    }
+    if (total <= _maxSize) {
+        estimatedSize = total;
+        return;
+    }
+    std::sort(entries.begin(), entries.end(),
+              [](auto& a, auto& b) { return a.time < b.time; });
+    for (auto& entry: entries) {
+        if (total <= _maxSize) {
+            break;
+        }
+        if (entry.path == keep) {
+            continue;
+        }
+        std::error_code ec;
+        if (std::filesystem::remove(entry.path, ec)) {
+            total -= entry.size;
+            ++_stats.evictions;
+        }
+    }
+    estimatedSize = total;
+}
+
+void CompilationCache::clear() {
+    std::lock_guard lock(mutex);
+    for (auto& entry: listEntries(dir)) {
+        std::error_code ec;
+        std::filesystem::remove(entry.path, ec);
+    }
+    estimatedSize = 0;
+}
+
+CompilationCacheStats CompilationCache::stats() const {
+    std::lock_guard lock(mutex);
+    return _stats;
+}
+
+size_t CompilationCache::size() const {
+    std::lock_guard lock(mutex);
+    size_t total = 0;
+    for (auto& entry: listEntries(dir)) {
+        total += entry.size;
+    }
+    return total;
+}
@@ -1,7 +1,10 @@
 #include "Invocation/CompilerInvocation.h"
 
 #include <filesystem>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <optional>
 #include <sstream>
 
@@ -14,15 +17,23 @@
 #include "Assembly/Assembler.h"
 #include "Assembly/AssemblyStream.h"
 #include "CodeGen/CodeGen.h"
+#include "Common/BinaryIO.h"
 #include "Common/FileHandling.h"
 #include "Common/SourceFile.h"
+#include "Common/ThreadPool.h"
+#include "Common/TimeTrace.h"
 #include "Common/UniquePtr.h"
+#include "IR/BinSerialize.h"
+#include "IR/CFG/Function.h"
 #include "IR/Context.h"
 #include "IR/IRParser.h"
 #include "IR/Module.h"
 #include "IR/PassManager.h"
 #include "IR/Print.h"
 #include "IRGen/IRGen.h"
+#include "Invocation/BuildId.h"
+#include "Invocation/CompilationCache.h"
+#include "Invocation/ContentHash.h"
 #include "Issue/IssueHandler.h"
 #include "Opt/Passes.h"
 #include "Parser/Parser.h"
@@ -118,7 +129,288 @@ static void populateSymbolTableWithBinaryInfo(
     populateScopeWithBinaryInfo(sym.globalScope(), asmRes);
 }
 
+/// MARK: - Compilation cache
+///
+/// The cache holds three kinds of entries:
+/// - Manifests list the native libraries imported by a set of sources. They
+///   are keyed by the frontend key, which hashes everything the compilation
+///   depends on except the contents of imported libraries, because we only
+///   know which libraries are imported after semantic analysis.
+/// - Modules hold the symbol table and the IR module after IR generation.
+/// - Targets hold the compiled target.
+///
+/// Modules and targets are keyed by the inputs key, which is the frontend key
+/// combined with the contents of all libraries listed in the manifest. Target
+/// keys additionally hash the options of the later stages.
+
+/// Must be incremented whenever the layout of cache entries changes or cache
+/// keys depend on additional inputs
+static constexpr uint64_t CacheFormatVersion = 2;
+
+static std::span<unsigned char const> asBytes(std::string_view data) {
+    return { reinterpret_cast<unsigned char const*>(data.data()),
+             data.size() };
+}
+
+static std::optional<std::string> readFile(std::filesystem::path const& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+    return std::string(std::istreambuf_iterator<char>(file), {});
+}
+
+static void writeString(ByteWriter& out, std::string_view text) {
+    out.varint(text.size());
+    out.bytes(text);
+}
+
+static std::string readString(ByteReader& in) {
+    return std::string(in.bytes(in.count()));
+}
+
+static std::string serializeToJSON(sema::SymbolTable const& sym) {
+    std::stringstream sstr;
+    sema::serialize(sym, sstr);
+    return std::move(sstr).str();
+}
+
+/// \Returns the resolved paths of all native libraries imported by \p sym
+static std::vector<std::string> nativeLibraryPaths(
+    sema::SymbolTable const& sym) {
+    std::vector<std::string> result;
+    for (auto* lib: sym.importedLibs()) {
+        if (auto* native = dyncast<sema::NativeLibrary const*>(lib)) {
+            result.push_back(native->path().string());
+        }
+    }
+    return result;
+}
+
+/// \Returns the key of the entries that depend on the inputs identified by \p
+/// frontendKey and the libraries \p libPaths, or `std::nullopt` if a library
+/// cannot be read
+static std::optional<std::string> computeInputsKey(
+    std::string const& frontendKey, std::span<std::string const> libPaths) {
+    ContentHasher hasher;
+    hasher.add(frontendKey);
+    for (auto& path: libPaths) {
+        auto data = readFile(path);
+        if (!data) {
+            return std::nullopt;
+        }
+        hasher.add(path);
+        hasher.add(*data);
+    }
+    return hasher.hexDigest();
+}
+
+static std::string manifestKey(std::string const& frontendKey) {
+    ContentHasher hasher;
+    hasher.add(frontendKey);
+    hasher.add("manifest");
+    return hasher.hexDigest();
+}
+
+static std::string moduleKey(std::string const& inputsKey) {
+    ContentHasher hasher;
+    hasher.add(inputsKey);
+    hasher.add("module");
+    return hasher.hexDigest();
+}
+
+std::string CompilerInvocation::frontendKey() const {
+    ContentHasher hasher;
+    hasher.add(CacheFormatVersion);
+    hasher.add(compilerBuildId());
+    hasher.add(static_cast<uint64_t>(frontend));
+    hasher.add(static_cast<uint64_t>(targetType));
+    hasher.add(name);
+    hasher.add(static_cast<uint64_t>(genDebugInfo));
+    hasher.add(static_cast<uint64_t>(libSearchPaths.size()));
+    for (auto& path: libSearchPaths) {
+        hasher.add(path.string());
+    }
+    hasher.add(static_cast<uint64_t>(sources.size()));
+    for (auto& source: sources) {
+        hasher.add(source.path().string());
+        hasher.add(source.text());
+    }
+    return hasher.hexDigest();
+}
+
+std::string CompilerInvocation::targetKey(std::string const& inputsKey) const {
+    ContentHasher hasher;
+    hasher.add(inputsKey);
+    hasher.add("target");
+    hasher.add(static_cast<uint64_t>(optLevel));
+    hasher.add(optPipeline);
+    hasher.add(registerAllocator ?
+                   static_cast<uint64_t>(*registerAllocator) + 1 :
+                   uint64_t{ 0 });
+    hasher.add(static_cast<uint64_t>(linkerOptions.searchHost));
+    return hasher.hexDigest();
+}
+
+std::optional<std::string> CompilerInvocation::lookupInputsKey(
+    std::string const& frontendKey) {
+    if (frontend == FrontendType::IR) {
+        return computeInputsKey(frontendKey, {});
+    }
+    auto data = cache->lookup(manifestKey(frontendKey));
+    if (!data) {
+        return std::nullopt;
+    }
+    try {
+        ByteReader in(*data);
+        std::vector<std::string> libPaths(in.count());
+        for (auto& path: libPaths) {
+            path = readString(in);
+        }
+        if (!in.atEnd()) {
+            return std::nullopt;
+        }
+        return computeInputsKey(frontendKey, libPaths);
+    }
+    catch (BinaryFormatError const&) {
+        return std::nullopt;
+    }
+}
+
+void CompilerInvocation::storeManifest(std::string const& frontendKey,
+                                       std::span<std::string const> libPaths) {
+    ByteWriter out;
+    out.varint(libPaths.size());
+    for (auto& path: libPaths) {
+        writeString(out, path);
+    }
+    cache->store(manifestKey(frontendKey), asBytes(out.data()));
+}
+
+std::optional<Target> CompilerInvocation::lookupTarget(std::string const& key) {
+    auto data = cache->lookup(key);
+    if (!data) {
+        return std::nullopt;
+    }
+    try {
+        ByteReader in(*data);
+        auto type = in.enumValue<TargetType>(3);
+        auto targetName = readString(in);
+        auto symText = readString(in);
+        auto binary = in.bytes(in.count());
+        auto debugInfo = readString(in);
+        auto libSymbolTable = readString(in);
+        auto libObjectCode = readString(in);
+        if (!in.atEnd()) {
+            return std::nullopt;
+        }
+        auto sym = std::make_unique<sema::SymbolTable>();
+        sym->setLibrarySearchPaths(libSearchPaths);
+        if (!sema::deserialize(*sym, symText)) {
+            return std::nullopt;
+        }
+        if (type == TargetType::StaticLibrary) {
+            return Target(type, std::move(targetName), std::move(sym),
+                          Target::StaticLib{ std::move(libSymbolTable),
+                                             std::move(libObjectCode) });
+        }
+        return Target(type, std::move(targetName), std::move(sym),
+                      std::vector<uint8_t>(binary.begin(), binary.end()),
+                      std::move(debugInfo));
+    }
+    catch (BinaryFormatError const&) {
+        return std::nullopt;
+    }
+}
+
+void CompilerInvocation::storeTarget(std::string const& key,
+                                     Target const& target) {
+    ByteWriter out;
+    out.u8(static_cast<uint8_t>(target.type()));
+    writeString(out, target.name());
+    writeString(out, serializeToJSON(target.symbolTable()));
+    auto binary = target.binary();
+    writeString(out, std::string_view(reinterpret_cast<char const*>(
+                                          binary.data()),
+                                      binary.size()));
+    writeString(out, target.debugInfo());
+    writeString(out, target.staticLib().symbolTable);
+    writeString(out, target.staticLib().objectCode);
+    cache->store(key, asBytes(out.data()));
+}
+
+bool CompilerInvocation::lookupModule(std::string const& key,
+                                      sema::SymbolTable& sym, ir::Context& ctx,
+                                      ir::Module& mod) {
+    auto data = cache->lookup(key);
+    if (!data) {
+        return false;
+    }
+    try {
+        ByteReader in(*data);
+        auto symText = readString(in);
+        auto irData = in.bytes(in.count());
+        if (!in.atEnd()) {
+            return false;
+        }
+        /// We decode into temporaries so a corrupted entry leaves the outputs
+        /// untouched and we can compile normally
+        sema::SymbolTable tmpSym;
+        tmpSym.setLibrarySearchPaths(libSearchPaths);
+        if (!sema::deserialize(tmpSym, symText)) {
+            return false;
+        }
+        ir::Module tmpMod;
+        if (!ir::deserializeBinary(ctx, tmpMod, asBytes(irData))) {
+            return false;
+        }
+        sym = std::move(tmpSym);
+        mod = std::move(tmpMod);
+        return true;
+    }
+    catch (BinaryFormatError const&) {
+        return false;
+    }
+}
+
+void CompilerInvocation::storeModule(std::string const& key,
+                                     sema::SymbolTable const& sym,
+                                     std::string_view irData) {
+    ByteWriter out;
+    writeString(out, serializeToJSON(sym));
+    writeString(out, irData);
+    cache->store(key, asBytes(out.data()));
+}
+
+/// MARK: - run()
+
+/// \Returns the number of instructions in \p mod
+static size_t countInstructions(ir::Module const& mod) {
+    size_t count = 0;
+    for (auto& function: mod) {
+        auto insts = function.instructions();
+        count += static_cast<size_t>(ranges::distance(insts));
+    }
+    return count;
+}
+
+/// Invokes \p fn in a trace event of the compiler stage \p name
+template <typename F>
+static decltype(auto) traceStage(std::string_view name, F&& fn) {
+    TraceScope scope(name, "stage");
+    scope.trackPeakBytes();
+    return std::invoke(fn);
+}
+
 std::optional<Target> CompilerInvocation::run() {
+    std::optional<TimeTrace::Activation> activation;
+    if (timeTrace) {
+        activation.emplace(timeTrace);
+    }
+    return runImpl();
+}
+
+std::optional<Target> CompilerInvocation::runImpl() {
     using enum TargetType;
     /// Mode validation
     if (frontend == FrontendType::IR) {
@@ -134,14 +426,43 @@ std::optional<Target> CompilerInvocation::run() {
         handleError();
         return std::nullopt;
     }
+    if (numThreads > 0) {
+        ThreadPool::setGlobalConcurrency(numThreads);
+    }
+    std::string feKey;
+    std::optional<std::string> inputsKey;
+    if (cache) {
+        feKey = frontendKey();
+        inputsKey = lookupInputsKey(feKey);
+        if (inputsKey) {
+            if (auto target = lookupTarget(targetKey(*inputsKey))) {
+                return target;
+            }
+        }
+    }
+    /// Debug info is attached to the IR as metadata which the binary IR format
+    /// does not preserve, so we only cache modules without debug info. Cached
+    /// modules restore the symbol table from its JSON form, which only
+    /// contains what binary targets export
+    bool const cacheModule = cache && !genDebugInfo &&
+                             targetType != TargetType::StaticLibrary;
     /// Now we compile the program
     sema::SymbolTable semaSym;
     ir::Context irContext;
     ir::Module irModule;
     switch (frontend) {
     case FrontendType::Scatha: {
+        if (cacheModule && inputsKey &&
+            lookupModule(moduleKey(*inputsKey), semaSym, irContext, irModule))
+        {
+            tryInvoke(callbacks.irgenCallback, irContext, irModule);
+            if (!continueCompilation) return std::nullopt;
+            break;
+        }
         IssueHandler issueHandler;
-        auto ast = parser::parse(sources, issueHandler);
+        auto ast = traceStage("parse", [&] {
+            return parser::parse(sources, issueHandler);
+        });
         bool haveErrors = false;
         if (!issueHandler.empty()) {
             haveErrors |= issueHandler.haveErrors();
@@ -152,9 +473,10 @@ std::optional<Target> CompilerInvocation::run() {
             handleError();
             return std::nullopt;
         }
-        auto analysisResult =
-            sema::analyze(*ast, semaSym, issueHandler,
-                          { .librarySearchPaths = libSearchPaths });
+        auto analysisResult = traceStage("sema", [&] {
+            return sema::analyze(*ast, semaSym, issueHandler,
+                                 { .librarySearchPaths = libSearchPaths });
+        });
         if (!issueHandler.empty()) {
             haveErrors |= issueHandler.haveErrors();
             issueHandler.print(sources, err());
@@ -171,12 +493,33 @@ std::optional<Target> CompilerInvocation::run() {
             irgenConfig.nameMangler =
                 sema::NameMangler({ .globalPrefix = name });
         }
-        irgen::generateIR(irContext, irModule, *ast, semaSym, analysisResult,
-                          std::move(irgenConfig));
-        opt::globalDCE(irContext, irModule, {});
+        {
+            TraceScope scope("irgen", "stage");
+            scope.trackPeakBytes();
+            irgen::generateIR(irContext, irModule, *ast, semaSym,
+                              analysisResult, std::move(irgenConfig));
+            opt::globalDCE(irContext, irModule, {});
+            if (scope.isActive()) {
+                scope.setInstCountAfter(countInstructions(irModule));
+            }
+        }
+        std::string irData;
+        if (cacheModule) {
+            std::stringstream sstr;
+            ir::serializeBinary(irModule, sstr);
+            irData = std::move(sstr).str();
+        }
         tryInvoke(callbacks.irgenCallback, irContext, irModule);
         semaSym.prepareExport();
         if (!continueCompilation) return std::nullopt;
+        if (cache) {
+            auto libPaths = nativeLibraryPaths(semaSym);
+            storeManifest(feKey, libPaths);
+            inputsKey = computeInputsKey(feKey, libPaths);
+            if (cacheModule && inputsKey) {
+                storeModule(moduleKey(*inputsKey), semaSym, irData);
+            }
+        }
         break;
     }
     case FrontendType::IR: {
@@ -185,8 +528,9 @@ std::optional<Target> CompilerInvocation::run() {
             handleError();
             return std::nullopt;
         }
-        auto parseIssues =
-            ir::parseTo(sources.front().text(), irContext, irModule);
+        auto parseIssues = traceStage("irparse", [&] {
+            return ir::parseTo(sources.front().text(), irContext, irModule);
+        });
         if (!parseIssues.empty()) {
             err() << Error;
             for (auto& issue: parseIssues) {
@@ -199,30 +543,59 @@ std::optional<Target> CompilerInvocation::run() {
         break;
     }
     }
-    if (optLevel > 0) {
-        opt::optimize(irContext, irModule, {});
-    }
-    else if (!optPipeline.empty()) {
-        auto pipeline = ir::PassManager::makePipeline(optPipeline);
-        pipeline(irContext, irModule);
+    if (optLevel > 0 || !optPipeline.empty()) {
+        TraceScope scope("optimize", "stage");
+        scope.trackPeakBytes();
+        if (scope.isActive()) {
+            scope.setInstCountBefore(countInstructions(irModule));
+        }
+        if (optLevel > 0) {
+            opt::optimize(irContext, irModule, {});
+        }
+        else {
+            auto pipeline = ir::PassManager::makePipeline(optPipeline);
+            pipeline(irContext, irModule);
+        }
+        if (scope.isActive()) {
+            scope.setInstCountAfter(countInstructions(irModule));
+        }
     }
     tryInvoke(callbacks.optCallback, irContext, irModule);
     if (!continueCompilation) return std::nullopt;
+    auto target = emitTarget(semaSym, irContext, irModule);
+    if (target && cache && inputsKey) {
+        storeTarget(targetKey(*inputsKey), *target);
+    }
+    return target;
+}
+
+std::optional<Target> CompilerInvocation::emitTarget(sema::SymbolTable& semaSym,
+                                                     ir::Context& irContext,
+                                                     ir::Module& irModule) {
     switch (targetType) {
     case TargetType::Executable:
         [[fallthrough]];
     case TargetType::BinaryOnly: {
         cg::NullLogger nullLogger;
         auto* logger = codegenLogger ? codegenLogger : &nullLogger;
-        auto asmStream = cg::codegen(irModule, *logger);
+        cg::CodegenOptions codegenOptions{
+            .registerAllocator = registerAllocator,
+            .optimize = optLevel > 0 || !optPipeline.empty(),
+        };
+        auto asmStream = traceStage("codegen", [&] {
+            return cg::codegen(irModule, *logger, codegenOptions);
+        });
         tryInvoke(callbacks.codegenCallback, asmStream);
         if (!continueCompilation) return std::nullopt;
-        auto asmRes = Asm::assemble(asmStream);
+        auto asmRes =
+            traceStage("assemble", [&] { return Asm::assemble(asmStream); });
         tryInvoke(callbacks.asmCallback, asmRes);
         if (!continueCompilation) return std::nullopt;
         auto& [program, symbolTable, unresolved] = asmRes;
-        auto linkRes = Asm::link(linkerOptions, program,
-                                 semaSym.foreignLibraries(), unresolved);
+        auto linkRes = traceStage("link", [&] {
+            return Asm::link(linkerOptions, program,
+                             semaSym.foreignLibraries(), unresolved);
+        });
         if (!linkRes) {
             printLinkerError(linkRes.error(), err());
             handleError();
@@ -238,11 +611,13 @@ std::optional<Target> CompilerInvocation::run() {
                       std::move(program), std::move(dsym));
     }
     case TargetType::StaticLibrary: {
+        TraceScope scope("serialize", "stage");
+        scope.trackPeakBytes();
         std::stringstream symstr;
-        sema::serialize(semaSym, symstr);
+        sema::serializeBinary(semaSym, symstr);
         opt::globalDCE(irContext, irModule, {});
         std::stringstream objstr;
-        ir::print(irModule, objstr);
+        ir::serializeBinary(irModule, objstr);
         return Target(TargetType::StaticLibrary, name,
                       std::make_unique<sema::SymbolTable>(std::move(semaSym)),
                       Target::StaticLib{ std::move(symstr).str(),
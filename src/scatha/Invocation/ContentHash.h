@@ -0,0 +1,73 @@
+#ifndef SCATHA_INVOCATION_CONTENTHASH_H_
+#define SCATHA_INVOCATION_CONTENTHASH_H_
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace scatha {
+
+/// Computes a 128 bit hash of a sequence of values. Used to name the entries
+/// of the compilation cache. The hash is not cryptographic, it only needs to
+/// make accidental collisions unlikely
+class ContentHasher {
+public:
+    /// Adds \p data to the hash. Data is length prefixed, so the hash depends
+    /// on how a sequence of strings is split
+    void add(std::string_view data) {
+        add(static_cast<uint64_t>(data.size()));
+        addBytes(reinterpret_cast<unsigned char const*>(data.data()),
+                 data.size());
+    }
+
+    /// \overload
+    void add(std::span<unsigned char const> data) {
+        add(static_cast<uint64_t>(data.size()));
+        addBytes(data.data(), data.size());
+    }
+
+    /// \overload
+    void add(uint64_t value) {
+        unsigned char bytes[8];
+        for (size_t i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+        addBytes(bytes, 8);
+    }
+
+    /// \Returns the hash as a string of 32 hex digits
+    std::string hexDigest() const {
+        static constexpr char Digits[] = "0123456789abcdef";
+        std::string result;
+        for (uint64_t word: { mix(lo ^ hi), mix(hi + lo) }) {
+            for (int shift = 60; shift >= 0; shift -= 4) {
+                result.push_back(Digits[(word >> shift) & 0xF]);
+            }
+        }
+        return result;
+    }
+
+private:
+    /// Two FNV-1a style lanes with different multipliers
+    void addBytes(unsigned char const* data, size_t size) {
+        for (size_t i = 0; i < size; ++i) {
+            lo = (lo ^ data[i]) * 0x100000001b3;
+            hi = (hi ^ data[i]) * 0x9e3779b97f4a7c15;
+        }
+    }
+
+    /// Final mixing step of splitmix64
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t lo = 0xcbf29ce484222325;
+    uint64_t hi = 0x84222325cbf29ce4;
+};
+
+} // namespace scatha
+
+#endif // SCATHA_INVOCATION_CONTENTHASH_H_
@@ -0,0 +1,126 @@
+#include "Invocation/LibraryCache.h"
+
+#include <atomic>
+#include <mutex>
+
+#include <utl/hashtable.hpp>
+
+#include "Common/FileHandling.h"
+#include "Invocation/TargetNames.h"
+
+using namespace scatha;
+
+namespace {
+
+/// Identifies the version of a library file on disk
+struct FileStamp {
+    std::filesystem::file_time_type time;
+    uintmax_t size;
+
+    bool operator==(FileStamp const&) const = default;
+};
+
+struct CacheEntry {
+    FileStamp stamp;
+    std::shared_ptr<LibraryFiles const> files;
+};
+
+struct CacheState {
+    std::atomic_bool enabled = false;
+    std::mutex mutex;
+    utl::hashmap<std::string, CacheEntry> entries;
+};
+
+} // namespace
+
+static CacheState& state() {
+    static CacheState s;
+    return s;
+}
+
+static std::optional<FileStamp> getStamp(std::filesystem::path const& path) {
+    std::error_code ec;
+    auto time = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return FileStamp{ time, size };
+}
+
+static std::shared_ptr<std::vector<unsigned char> const> readShared(
+    Archive& archive, std::string_view name) {
+    auto data = archive.openBinaryFile(name);
+    if (!data) {
+        return nullptr;
+    }
+    return std::make_shared<std::vector<unsigned char> const>(
+        std::move(*data));
+}
+
+static std::shared_ptr<LibraryFiles const> readLibrary(
+    std::filesystem::path const& path) {
+    auto archive = Archive::Open(path);
+    if (!archive) {
+        return nullptr;
+    }
+    auto files = std::make_shared<LibraryFiles>();
+    files->binarySymbolTable =
+        readShared(*archive, TargetNames::BinarySymbolTableName);
+    if (files->binarySymbolTable) {
+        files->symbolTableIndex =
+            sema::LazySymbolTable::ReadIndex(files->binarySymbolTable);
+    }
+    files->symbolTable = archive->openTextFile(TargetNames::SymbolTableName);
+    files->objectCode = readShared(*archive, TargetNames::ObjectCodeName);
+    files->textObjectCode =
+        archive->openTextFile(TargetNames::TextObjectCodeName);
+    return files;
+}
+
+void LibraryCache::setEnabled(bool enabled) {
+    state().enabled = enabled;
+    if (!enabled) {
+        clear();
+    }
+}
+
+bool LibraryCache::isEnabled() { return state().enabled; }
+
+void LibraryCache::clear() {
+    auto& s = state();
+    std::lock_guard lock(s.mutex);
+    s.entries.clear();
+}
+
+std::shared_ptr<LibraryFiles const> LibraryCache::load(
+    std::filesystem::path const& path) {
+    auto& s = state();
+    if (!s.enabled) {
+        return readLibrary(path);
+    }
+    auto stamp = getStamp(path);
+    if (!stamp) {
+        return nullptr;
+    }
+    auto key = std::filesystem::absolute(path).lexically_normal().string();
+    {
+        std::lock_guard lock(s.mutex);
+        auto itr = s.entries.find(key);
+        if (itr != s.entries.end() && itr->second.stamp == *stamp) {
+            return itr->second.files;
+        }
+    }
+    /// We read outside of the lock, so imports of different libraries don't
+    /// wait for each other
+    auto files = readLibrary(path);
+    if (!files) {
+        return nullptr;
+    }
+    std::lock_guard lock(s.mutex);
+    s.entries[key] = { *stamp, files };
+    return files;
+}
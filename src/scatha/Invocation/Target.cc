@@ -87,10 +87,16 @@ void Target::writeToDisk(std::filesystem::path const& dir) const {
             Archive::Create(appendExt(outFile, TargetNames::LibraryExt));
         /// TODO: Implement proper error handling here
         SC_RELASSERT(archive, "Failed to create archive");
-        archive->addTextFile(TargetNames::SymbolTableName,
-                             staticLib().symbolTable);
-        archive->addTextFile(TargetNames::ObjectCodeName,
-                             staticLib().objectCode);
+        auto& symbols = staticLib().symbolTable;
+        archive->addBinaryFile(TargetNames::BinarySymbolTableName,
+                               { reinterpret_cast<unsigned char const*>(
+                                     symbols.data()),
+                                 symbols.size() });
+        auto& code = staticLib().objectCode;
+        archive->addBinaryFile(TargetNames::ObjectCodeName,
+                               { reinterpret_cast<unsigned char const*>(
+                                     code.data()),
+                                 code.size() });
         break;
     }
     }
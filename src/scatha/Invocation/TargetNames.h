@@ -10,8 +10,12 @@ struct TargetNames {
     static constexpr std::string_view LibraryExt = "sclib";
     static constexpr std::string_view ExecutableName = "executable";
     static constexpr std::string_view SymbolTableName = "sym.txt";
+    /// Binary symbol table of static libraries
+    static constexpr std::string_view BinarySymbolTableName = "sym.scbsym";
     static constexpr std::string_view DebugInfoName = "dbgsym.txt";
-    static constexpr std::string_view ObjectCodeName = "code.scir";
+    static constexpr std::string_view ObjectCodeName = "code.scbir";
+    /// Textual IR object code of libraries built before the binary format
+    static constexpr std::string_view TextObjectCodeName = "code.scir";
 };
 
 } // namespace scatha
@@ -1,6 +1,8 @@
 #include "Issue/IssueHandler.h"
 
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 #include <range/v3/algorithm.hpp>
 #include <utl/hashtable.hpp>
@@ -13,6 +15,18 @@ bool IssueHandler::haveErrors() const {
     return ranges::any_of(*this, [](auto* issue) { return issue->isError(); });
 }
 
+void IssueHandler::sortBySourceLocation(size_t begin) {
+    SC_EXPECT(begin <= _issues.size());
+    auto key = [](std::unique_ptr<Issue> const& issue) {
+        auto loc = issue->sourceLocation();
+        return std::pair{ static_cast<size_t>(loc.fileIndex), loc.index };
+    };
+    std::stable_sort(_issues.begin() + static_cast<ssize_t>(begin),
+                     _issues.end(), [&](auto const& lhs, auto const& rhs) {
+        return key(lhs) < key(rhs);
+    });
+}
+
 void IssueHandler::print(std::span<SourceFile const> files,
                          std::ostream& str) const {
     SourceStructureMap structureMap(files);
@@ -27,20 +27,15 @@ void BasicBlock::eraseCallback(Instruction const& inst) {
     mutInst.setDest(nullptr);
 }
 
-void BasicBlock::addLiveImpl(utl::hashset<Register*>& set, Register* reg,
-                             size_t count) {
+void BasicBlock::addLiveImpl(LiveSet& set, Register* reg, size_t count) {
     for (size_t i = 0; i < count; ++i, reg = reg->next()) {
         set.insert(reg);
     }
 }
 
-void BasicBlock::removeLiveImpl(utl::hashset<Register*>& set, Register* reg,
-                                size_t count) {
+void BasicBlock::removeLiveImpl(LiveSet& set, Register* reg, size_t count) {
     for (size_t i = 0; i < count; ++i, reg = reg->next()) {
-        auto itr = set.find(reg);
-        if (itr != set.end()) {
-            set.erase(itr);
-        }
+        set.erase(reg);
     }
 }
 
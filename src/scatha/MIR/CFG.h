@@ -16,6 +16,7 @@
 #include "Common/UniquePtr.h"
 #include "MIR/Fwd.h"
 #include "MIR/Instruction.h"
+#include "MIR/LiveSet.h"
 #include "MIR/RegisterSet.h"
 #include "MIR/Value.h"
 
@@ -91,6 +92,12 @@ public:
         removeLiveImpl(_liveOut, reg, count);
     }
 
+    /// Mark all registers in \p regs as live-in
+    void addLiveIn(LiveSet const& regs) { _liveIn |= regs; }
+
+    /// Mark all registers in \p regs as live-out
+    void addLiveOut(LiveSet const& regs) { _liveOut |= regs; }
+
     /// \Returns `true` if register \p reg is live-in to this block
     bool isLiveIn(Register const* reg) const { return _liveIn.contains(reg); }
 
@@ -98,20 +105,16 @@ public:
     bool isLiveOut(Register const* reg) const { return _liveOut.contains(reg); }
 
     /// \Returns The set of live-in registers
-    utl::hashset<Register*> const& liveIn() const { return _liveIn; }
+    LiveSet const& liveIn() const { return _liveIn; }
 
     /// Set the live-in registers
-    void setLiveIn(utl::hashset<Register*> liveIn) {
-        _liveIn = std::move(liveIn);
-    }
+    void setLiveIn(LiveSet liveIn) { _liveIn = std::move(liveIn); }
 
     /// \Returns The set of live-out registers
-    utl::hashset<Register*> const& liveOut() const { return _liveOut; }
+    LiveSet const& liveOut() const { return _liveOut; }
 
     /// Set the live-out registers
-    void setLiveOut(utl::hashset<Register*> liveOut) {
-        _liveOut = std::move(liveOut);
-    }
+    void setLiveOut(LiveSet liveOut) { _liveOut = std::move(liveOut); }
 
     /// \Returns `true` if this is the entry basic block
     bool isEntry() const;
@@ -149,12 +152,11 @@ private:
     void insertCallback(Instruction& inst);
     void eraseCallback(Instruction const& inst);
 
-    void addLiveImpl(utl::hashset<Register*>& set, Register* reg, size_t count);
-    void removeLiveImpl(utl::hashset<Register*>& set, Register* reg,
-                        size_t count);
+    void addLiveImpl(LiveSet& set, Register* reg, size_t count);
+    void removeLiveImpl(LiveSet& set, Register* reg, size_t count);
 
     std::string _name;
-    utl::hashset<Register*> _liveIn, _liveOut;
+    LiveSet _liveIn, _liveOut;
     ir::BasicBlock const* irBB = nullptr;
 };
 
@@ -7,12 +7,12 @@ using namespace mir;
 
 static StoreInst* doClone(StoreInst& inst) {
     return new StoreInst(inst.address(), inst.source(), inst.bytewidth(),
-                         inst.metadata());
+                         inst.metadata(), inst.isUnaligned());
 }
 
 static LoadInst* doClone(LoadInst& inst) {
     return new LoadInst(inst.dest(), inst.address(), inst.bytewidth(),
-                        inst.metadata());
+                        inst.metadata(), inst.isUnaligned());
 }
 
 static CopyInst* doClone(CopyInst& inst) {
@@ -77,6 +77,19 @@ static LoadArithmeticInst* doClone(LoadArithmeticInst& inst) {
                                   inst.metadata());
 }
 
+static VectorArithmeticInst* doClone(VectorArithmeticInst& inst) {
+    return new VectorArithmeticInst(inst.dest(), inst.LHS(), inst.RHS(),
+                                    inst.laneWidth(), inst.operation(),
+                                    inst.metadata());
+}
+
+static VectorCompareInst* doClone(VectorCompareInst& inst) {
+    return new VectorCompareInst(inst.dest(), inst.LHS(), inst.RHS(),
+                                 inst.laneWidth(), inst.mode(),
+                                 inst.operation(), inst.select(),
+                                 inst.metadata());
+}
+
 static ConversionInst* doClone(ConversionInst& inst) {
     return new ConversionInst(inst.dest(), inst.operand(), inst.conversion(),
                               inst.fromBits(), inst.toBits(), inst.metadata());
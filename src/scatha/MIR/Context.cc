@@ -8,7 +8,9 @@
 using namespace scatha;
 using namespace mir;
 
-Context::Context(): _undef(std::make_unique<UndefValue>()) {
+Context::Context():
+    constantMutex(std::make_unique<std::mutex>()),
+    _undef(std::make_unique<UndefValue>()) {
     _undef->set_next(undef());
     _undef->set_prev(undef());
 }
@@ -20,6 +22,7 @@ Context& Context::operator=(Context&&) noexcept = default;
 Context::~Context() = default;
 
 Constant* Context::constant(uint64_t value, size_t bytewidth) {
+    std::lock_guard lock(*constantMutex);
     auto [itr, success] = constants.insert(
         std::pair{ std::pair{ value, bytewidth },
                    std::make_unique<Constant>(value, bytewidth) });
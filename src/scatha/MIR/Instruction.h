@@ -5,6 +5,7 @@
 
 #include <utl/vector.hpp>
 
+#include "Common/Allocator.h"
 #include "Common/Metadata.h"
 #include "Common/Ranges.h"
 #include "Common/UniquePtr.h"
@@ -28,6 +29,10 @@ class Instruction:
     }
 
 public:
+    /// Allocated with `internal::allocateTracked()`, so MIR nodes are counted
+    /// in `AllocationStats`
+    SC_TRACKED_HEAP_ALLOCATION()
+
     /// Instructions are polymorphic and not copyable
     Instruction(Instruction const&) = delete;
 
@@ -26,11 +26,12 @@ protected:
 class StoreInst: public Instruction, public MemoryInst<StoreInst, 0, 1> {
 public:
     explicit StoreInst(MemoryAddress address, Value* source, size_t byteWidth,
-                       Metadata metadata):
+                       Metadata metadata, bool unaligned = false):
         Instruction(InstType::StoreInst, nullptr, 0,
                     { address.baseAddress(), address.dynOffset(), source },
                     byteWidth, std::move(metadata)),
-        MemoryInst(address.constantData()) {}
+        MemoryInst(address.constantData()),
+        _unaligned(unaligned) {}
 
     /// The address that is stored to
     using MemoryInst::address;
@@ -40,20 +41,36 @@ public:
 
     /// \overload
     Value const* source() const { return operandAt(2); }
+
+    /// \Returns `true` if the address may not be aligned to the byte width.
+    /// This is the case for vector stores, because vectors only need to be
+    /// aligned to their element type
+    bool isUnaligned() const { return _unaligned; }
+
+private:
+    bool _unaligned;
 };
 
 /// Concrete load instruction
 class LoadInst: public Instruction, public MemoryInst<StoreInst, 0, 1> {
 public:
     explicit LoadInst(Register* dest, MemoryAddress source, size_t byteWidth,
-                      Metadata metadata):
+                      Metadata metadata, bool unaligned = false):
         Instruction(InstType::LoadInst, dest, 1,
                     { source.baseAddress(), source.dynOffset() }, byteWidth,
                     std::move(metadata)),
-        MemoryInst(source.constantData()) {}
+        MemoryInst(source.constantData()),
+        _unaligned(unaligned) {}
 
     /// The address that is loaded from
     using MemoryInst::address;
+
+    /// \Returns `true` if the address may not be aligned to the byte width.
+    /// See `StoreInst::isUnaligned()`
+    bool isUnaligned() const { return _unaligned; }
+
+private:
+    bool _unaligned;
 };
 
 /// Abstract base class of `CopyInst` and `CondCopyInst`
@@ -271,7 +288,8 @@ private:
     UnaryArithmeticOperation op;
 };
 
-/// Abstract base class of `ValueArithmeticInst` and `LoadArithmeticInst`
+/// Abstract base class of `ValueArithmeticInst`, `LoadArithmeticInst` and
+/// `VectorArithmeticInst`
 class ArithmeticInst: public Instruction {
 public:
     ///
@@ -334,6 +352,83 @@ public:
     ConstMemoryAddress RHS() const { return address(); }
 };
 
+/// Concrete lane wise arithmetic instruction on packed vectors. Vectors that
+/// fill a pair of registers are computed by one instruction per register, so
+/// the byte width of this instruction is always 8
+class VectorArithmeticInst: public ArithmeticInst {
+public:
+    explicit VectorArithmeticInst(Register* dest, Value* LHS, Value* RHS,
+                                  size_t laneWidth,
+                                  ArithmeticOperation operation,
+                                  Metadata metadata):
+        ArithmeticInst(InstType::VectorArithmeticInst, dest, { LHS, RHS }, 8,
+                       operation, std::move(metadata)),
+        _laneWidth(laneWidth) {}
+
+    /// Right hand side operand
+    Value* RHS() { return operandAt(1); }
+
+    /// \overload
+    Value const* RHS() const { return operandAt(1); }
+
+    /// Size of one lane in bytes
+    size_t laneWidth() const { return _laneWidth; }
+
+private:
+    size_t _laneWidth;
+};
+
+/// Concrete lane wise comparison of packed vectors. Lanes where the comparison
+/// holds are set to all ones and the other lanes are cleared. If `select()` is
+/// true, each lane is instead taken from the LHS if the comparison holds and
+/// from the RHS otherwise. This computes the lane wise minimum for `Less` and
+/// the maximum for `Greater`, the only operations that may select. Like
+/// `VectorArithmeticInst` this instruction operates on one register
+class VectorCompareInst: public Instruction {
+public:
+    explicit VectorCompareInst(Register* dest, Value* LHS, Value* RHS,
+                               size_t laneWidth, CompareMode mode,
+                               CompareOperation operation, bool select,
+                               Metadata metadata):
+        Instruction(InstType::VectorCompareInst, dest, 1, { LHS, RHS }, 8,
+                    std::move(metadata)),
+        _laneWidth(laneWidth),
+        _mode(mode),
+        _op(operation),
+        _select(select) {}
+
+    /// Left hand side operand
+    Value* LHS() { return operandAt(0); }
+
+    /// \overload
+    Value const* LHS() const { return operandAt(0); }
+
+    /// Right hand side operand
+    Value* RHS() { return operandAt(1); }
+
+    /// \overload
+    Value const* RHS() const { return operandAt(1); }
+
+    /// Size of one lane in bytes
+    size_t laneWidth() const { return _laneWidth; }
+
+    /// The compare mode, i.e. signed, unsigned or float
+    CompareMode mode() const { return _mode; }
+
+    /// The comparison to perform
+    CompareOperation operation() const { return _op; }
+
+    /// \Returns `true` if this instruction selects lanes instead of computing
+    /// a mask
+    bool select() const { return _select; }
+
+private:
+    size_t _laneWidth;
+    CompareMode _mode;
+    CompareOperation _op;
+    bool _select;
+};
+
 ///
 class ConversionInst: public UnaryInstruction {
 public:
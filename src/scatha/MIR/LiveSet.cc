@@ -0,0 +1,181 @@
+#include "MIR/LiveSet.h"
+
+#include <algorithm>
+#include <bit>
+
+#include "MIR/CFG.h"
+#include "MIR/Register.h"
+
+using namespace scatha;
+using namespace mir;
+
+void LiveSet::Iterator::settle() {
+    while (kind < NumKinds) {
+        auto& kindWords = set->words[kind];
+        size_t wordIndex = bitIndex / WordBits;
+        if (wordIndex >= kindWords.size()) {
+            ++kind;
+            bitIndex = 0;
+            continue;
+        }
+        Word word = kindWords[wordIndex] & (~Word(0) << bitIndex % WordBits);
+        if (!word) {
+            bitIndex = (wordIndex + 1) * WordBits;
+            continue;
+        }
+        bitIndex = wordIndex * WordBits +
+                   static_cast<size_t>(std::countr_zero(word));
+        reg = set->registerAt(kind, bitIndex);
+        if (reg) {
+            return;
+        }
+        ++bitIndex;
+    }
+    bitIndex = 0;
+    reg = nullptr;
+}
+
+size_t LiveSet::kindIndex(Register const* reg) {
+    switch (reg->nodeType()) {
+    case NodeType::SSARegister:
+        return 0;
+    case NodeType::VirtualRegister:
+        return 1;
+    case NodeType::CalleeRegister:
+        return 2;
+    case NodeType::HardwareRegister:
+        return 3;
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
+Register* LiveSet::registerAt(size_t kind, size_t index) const {
+    auto get = [&](auto& regs) -> Register* {
+        return index < regs.size() ? regs.at(index) : nullptr;
+    };
+    switch (kind) {
+    case 0:
+        return get(F->ssaRegisters());
+    case 1:
+        return get(F->virtualRegisters());
+    case 2:
+        return get(F->calleeRegisters());
+    case 3:
+        return get(F->hardwareRegisters());
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
+bool LiveSet::contains(Register const* reg) const {
+    if (!reg) {
+        return false;
+    }
+    auto& kindWords = words[kindIndex(reg)];
+    size_t index = reg->index();
+    size_t wordIndex = index / WordBits;
+    return wordIndex < kindWords.size() &&
+           (kindWords[wordIndex] >> index % WordBits & 1) != 0;
+}
+
+bool LiveSet::insert(Register* reg) {
+    SC_EXPECT(reg->parent());
+    SC_EXPECT(!F || F == reg->parent());
+    F = reg->parent();
+    auto& kindWords = words[kindIndex(reg)];
+    size_t index = reg->index();
+    size_t wordIndex = index / WordBits;
+    if (wordIndex >= kindWords.size()) {
+        kindWords.resize(wordIndex + 1, 0);
+    }
+    Word bit = Word(1) << index % WordBits;
+    bool inserted = (kindWords[wordIndex] & bit) == 0;
+    kindWords[wordIndex] |= bit;
+    return inserted;
+}
+
+bool LiveSet::erase(Register const* reg) {
+    if (!reg) {
+        return false;
+    }
+    auto& kindWords = words[kindIndex(reg)];
+    size_t index = reg->index();
+    size_t wordIndex = index / WordBits;
+    if (wordIndex >= kindWords.size()) {
+        return false;
+    }
+    Word bit = Word(1) << index % WordBits;
+    bool erased = (kindWords[wordIndex] & bit) != 0;
+    kindWords[wordIndex] &= ~bit;
+    return erased;
+}
+
+void LiveSet::clear() {
+    for (auto& kindWords: words) {
+        kindWords.clear();
+    }
+}
+
+bool LiveSet::empty() const {
+    return std::all_of(words.begin(), words.end(), [](auto& kindWords) {
+        return std::all_of(kindWords.begin(), kindWords.end(),
+                           [](Word word) { return word == 0; });
+    });
+}
+
+size_t LiveSet::size() const {
+    size_t result = 0;
+    for (auto& kindWords: words) {
+        for (Word word: kindWords) {
+            result += static_cast<size_t>(std::popcount(word));
+        }
+    }
+    return result;
+}
+
+LiveSet& LiveSet::operator|=(LiveSet const& rhs) {
+    SC_EXPECT(!F || !rhs.F || F == rhs.F);
+    if (!F) {
+        F = rhs.F;
+    }
+    for (size_t kind = 0; kind < NumKinds; ++kind) {
+        auto& lhsWords = words[kind];
+        auto& rhsWords = rhs.words[kind];
+        if (lhsWords.size() < rhsWords.size()) {
+            lhsWords.resize(rhsWords.size(), 0);
+        }
+        for (size_t i = 0; i < rhsWords.size(); ++i) {
+            lhsWords[i] |= rhsWords[i];
+        }
+    }
+    return *this;
+}
+
+LiveSet& LiveSet::operator-=(LiveSet const& rhs) {
+    for (size_t kind = 0; kind < NumKinds; ++kind) {
+        auto& lhsWords = words[kind];
+        auto& rhsWords = rhs.words[kind];
+        size_t count = std::min(lhsWords.size(), rhsWords.size());
+        for (size_t i = 0; i < count; ++i) {
+            lhsWords[i] &= ~rhsWords[i];
+        }
+    }
+    return *this;
+}
+
+bool LiveSet::operator==(LiveSet const& rhs) const {
+    for (size_t kind = 0; kind < NumKinds; ++kind) {
+        auto& lhsWords = words[kind];
+        auto& rhsWords = rhs.words[kind];
+        size_t size = std::max(lhsWords.size(), rhsWords.size());
+        for (size_t i = 0; i < size; ++i) {
+            Word lhsWord = i < lhsWords.size() ? lhsWords[i] : 0;
+            Word rhsWord = i < rhsWords.size() ? rhsWords[i] : 0;
+            if (lhsWord != rhsWord) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
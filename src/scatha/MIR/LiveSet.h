@@ -0,0 +1,127 @@
+#ifndef SCATHA_MIR_LIVESET_H_
+#define SCATHA_MIR_LIVESET_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+#include <utl/vector.hpp>
+
+#include "Common/Base.h"
+#include "MIR/Fwd.h"
+
+namespace scatha::mir {
+
+/// Set of registers of one function. Used for the live-in and live-out sets of
+/// basic blocks.
+///
+/// Registers are identified by their kind and their index in the register set
+/// of their kind. These indices are dense, so the set is stored as one bit
+/// vector per register kind and union and difference are computed a word at a
+/// time.
+///
+/// Iterating the set yields the registers in order of kind and index.
+/// Registers that have been cleared from their function are skipped.
+class SCATHA_API LiveSet {
+public:
+    /// Forward iterator over the registers in the set
+    class SCATHA_API Iterator {
+    public:
+        using value_type = Register*;
+        using reference = Register*;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        Iterator() = default;
+
+        Register* operator*() const { return reg; }
+
+        Iterator& operator++() {
+            ++bitIndex;
+            settle();
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        bool operator==(Iterator const& rhs) const {
+            return kind == rhs.kind && bitIndex == rhs.bitIndex;
+        }
+
+    private:
+        friend class LiveSet;
+
+        Iterator(LiveSet const* set, size_t kind): set(set), kind(kind) {
+            settle();
+        }
+
+        /// Moves to the first register at or after the current position
+        void settle();
+
+        LiveSet const* set = nullptr;
+        size_t kind = NumKinds;
+        size_t bitIndex = 0;
+        Register* reg = nullptr;
+    };
+
+    /// \Returns `true` if \p reg is in the set. \p reg may be null
+    bool contains(Register const* reg) const;
+
+    /// Adds \p reg to the set
+    /// \Returns `true` if \p reg was not in the set before
+    bool insert(Register* reg);
+
+    /// Removes \p reg from the set. \p reg may be null
+    /// \Returns `true` if \p reg was in the set before
+    bool erase(Register const* reg);
+
+    /// Removes all registers from the set
+    void clear();
+
+    /// \Returns `true` if the set contains no registers
+    bool empty() const;
+
+    /// \Returns the number of registers in the set
+    size_t size() const;
+
+    /// Adds all registers in \p rhs to this set
+    LiveSet& operator|=(LiveSet const& rhs);
+
+    /// Removes all registers in \p rhs from this set
+    LiveSet& operator-=(LiveSet const& rhs);
+
+    /// Two sets are equal if they contain the same registers
+    bool operator==(LiveSet const& rhs) const;
+
+    /// Range accessors @{
+    Iterator begin() const { return Iterator(this, 0); }
+    Iterator end() const { return Iterator(this, NumKinds); }
+    /// @}
+
+private:
+    /// SSA, virtual, callee and hardware registers
+    static constexpr size_t NumKinds = 4;
+
+    using Word = uint64_t;
+
+    static constexpr size_t WordBits = 64;
+
+    static size_t kindIndex(Register const* reg);
+
+    /// \Returns the register of kind \p kind with index \p index or null if it
+    /// does not exist
+    Register* registerAt(size_t kind, size_t index) const;
+
+    Function* F = nullptr;
+    std::array<utl::vector<Word>, NumKinds> words;
+};
+
+} // namespace scatha::mir
+
+#endif // SCATHA_MIR_LIVESET_H_
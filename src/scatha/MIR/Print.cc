@@ -143,6 +143,19 @@ static auto formatInstName(mir::Instruction const& inst) {
             return utl::strcat(inst.operation(),
                                inst.bitwidth());
         },
+        [](VectorArithmeticInst const& inst) {
+            return utl::strcat("v", inst.operation(),
+                               8 * inst.laneWidth());
+        },
+        [](VectorCompareInst const& inst) {
+            if (inst.select()) {
+                bool min = inst.operation() == CompareOperation::Less;
+                return utl::strcat("v", min ? "min" : "max",
+                                   8 * inst.laneWidth());
+            }
+            return utl::strcat("v", inst.mode(), inst.operation(),
+                               8 * inst.laneWidth());
+        },
         [](ConversionInst const& inst) {
             return utl::strcat(inst.conversion());
         },
@@ -251,7 +264,7 @@ struct PrintContext {
     }
 
     utl::vstreammanip<> formatLiveList(std::string_view name,
-                                       utl::hashset<Register*> const& regs) {
+                                       LiveSet const& regs) {
         return [name, &regs](std::ostream& str) {
             str << light(name, ": [");
             bool first = true;
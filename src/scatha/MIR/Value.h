@@ -1,6 +1,7 @@
 #ifndef SCATHA_MIR_VALUE_H_
 #define SCATHA_MIR_VALUE_H_
 
+#include "Common/Allocator.h"
 #include "Common/List.h"
 #include "MIR/Fwd.h"
 
@@ -9,6 +10,10 @@ namespace scatha::mir {
 /// Abstract base class of all values in the MIR
 class Value: public ListNode<Value, /* AllowSetSiblings = */ true> {
 public:
+    /// Allocated with `internal::allocateTracked()`, so MIR nodes are counted
+    /// in `AllocationStats`
+    SC_TRACKED_HEAP_ALLOCATION()
+
     /// \Returns The most derived run time type of this value
     NodeType nodeType() const { return _nodeType; }
 
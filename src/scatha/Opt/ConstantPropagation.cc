@@ -28,8 +28,11 @@ using namespace ir;
 /// Implemented with help from:
 /// https://www.cs.utexas.edu/users/lin/cs380c/wegman.pdf
 
-SC_REGISTER_FUNCTION_PASS(opt::propagateConstants, "propagateconst",
-                          PassCategory::Simplification, {});
+/// Branches on constant conditions are folded by SimplifyCFG, so this pass
+/// does not change the CFG
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::propagateConstants, "propagateconst",
+                                     PassCategory::Simplification,
+                                     PreservedAnalyses::CFG(), {});
 
 namespace {
 
@@ -298,7 +301,11 @@ void SCCPContext::visitExpression(Instruction& inst) {
                                       inst.type(),
                                       formalValue(inst.operand()));
         },
-        [&](ArithmeticInst& inst) {
+        [&](ArithmeticInst& inst) -> FormalValue {
+            /// We don't track the lanes of vector values
+            if (isa<VectorType>(inst.type())) {
+                return Inevaluable{};
+            }
             return evaluateArithmetic(inst.operation(),
                                       formalValue(inst.lhs()),
                                       formalValue(inst.rhs()));
@@ -307,7 +314,10 @@ void SCCPContext::visitExpression(Instruction& inst) {
             return evaluateUnaryArithmetic(inst.operation(),
                                            formalValue(inst.operand()));
         },
-        [&](CompareInst& inst) {
+        [&](CompareInst& inst) -> FormalValue {
+            if (isa<VectorType>(inst.type())) {
+                return Inevaluable{};
+            }
             return evaluateComparison(inst.operation(),
                                       formalValue(inst.lhs()),
                                       formalValue(inst.rhs()));
@@ -111,6 +111,13 @@ bool DCEContext::run() {
             return false;
         }
     }
+    /// Blocks that cannot reach an exit have no post-dominator that their
+    /// branches could be redirected to, so we keep them
+    for (auto& BB: function) {
+        if (!postDomInfo.domTree().isReachable(&BB)) {
+            mark(BB.terminator());
+        }
+    }
     /// Mark phase
     while (!worklist.empty()) {
         auto* inst = *worklist.begin();
@@ -1,5 +1,7 @@
 #include "Opt/Passes.h"
 
+#include "IR/CFG/Function.h"
+#include "IR/PassManager.h"
 #include "IR/PassRegistry.h"
 
 using namespace scatha;
@@ -9,8 +11,11 @@ using namespace ir;
 SC_REGISTER_FUNCTION_PASS(opt::canonicalize, "canonicalize",
                           PassCategory::Canonicalization, {});
 
-SC_REGISTER_FUNCTION_PASS(opt::defaultPass, "default",
-                          PassCategory::Simplification, {});
+/// The passes of the default pass are run through the pass manager and
+/// invalidate the analyses they don't preserve themselves
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::defaultPass, "default",
+                                     PassCategory::Simplification,
+                                     PreservedAnalyses::All(), {});
 
 bool opt::canonicalize(Context& ctx, Function& function) {
     bool modified = false;
@@ -19,16 +24,37 @@ bool opt::canonicalize(Context& ctx, Function& function) {
     return modified;
 }
 
+/// Runs the registered pass \p pass on \p function. Running the passes
+/// through their `FunctionPass` objects records them in the active time trace
+/// and invalidates only the analyses they don't preserve, so analyses computed
+/// by one pass are reused by the following ones
+static bool run(FunctionPass const& pass, Context& ctx, Function& function) {
+    SC_ASSERT(pass, "Pass is not registered");
+    return pass(ctx, function);
+}
+
 bool opt::defaultPass(Context& ctx, Function& function) {
+    static FunctionPass const sroaPass = PassManager::getFunctionPass("sroa");
+    static FunctionPass const ptrAnalysisPass =
+        PassManager::getFunctionPass("ptranalysis");
+    static FunctionPass const instCombinePass =
+        PassManager::getFunctionPass("instcombine");
+    static FunctionPass const propConstPass =
+        PassManager::getFunctionPass("propagateconst");
+    static FunctionPass const dcePass = PassManager::getFunctionPass("dce");
+    static FunctionPass const simplifyCFGPass =
+        PassManager::getFunctionPass("simplifycfg");
+    static FunctionPass const gvnPass = PassManager::getFunctionPass("gvn");
+    static FunctionPass const trePass = PassManager::getFunctionPass("tre");
     bool modified = false;
-    modified |= sroa(ctx, function);
-    modified |= pointerAnalysis(ctx, function);
-    modified |= instCombine(ctx, function);
-    modified |= propagateConstants(ctx, function);
-    modified |= dce(ctx, function);
-    modified |= simplifyCFG(ctx, function);
-    modified |= globalValueNumbering(ctx, function);
-    modified |= tailRecElim(ctx, function);
+    modified |= run(sroaPass, ctx, function);
+    modified |= run(ptrAnalysisPass, ctx, function);
+    modified |= run(instCombinePass, ctx, function);
+    modified |= run(propConstPass, ctx, function);
+    modified |= run(dcePass, ctx, function);
+    modified |= run(simplifyCFGPass, ctx, function);
+    modified |= run(gvnPass, ctx, function);
+    modified |= run(trePass, ctx, function);
     if (std::getenv("TEST_LOOP_SCHEDULE")) {
         loopSchedule(ctx, function, {});
     }
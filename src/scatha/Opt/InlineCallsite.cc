@@ -17,6 +17,8 @@ using namespace opt;
 
 void opt::inlineCallsite(ir::Context& ctx, Call* call) {
     auto* callee = cast<Function*>(call->function());
+    /// The cloned nodes end up in the caller, so we allocate them there
+    NodeAllocatorScope allocScope(*call->parentFunction());
     inlineCallsite(ctx, call, ir::clone(ctx, callee));
 }
 
@@ -24,6 +26,7 @@ void opt::inlineCallsite(ir::Context& ctx, ir::Call* call,
                          UniquePtr<ir::Function> calleeClone) {
     auto* callerBB = call->parent();
     auto* caller = callerBB->parent();
+    NodeAllocatorScope allocScope(*caller);
     auto* newGoto = new Goto(ctx, &calleeClone->entry());
     calleeClone->entry().setPredecessors(std::array{ callerBB });
     callerBB->insert(call, newGoto);
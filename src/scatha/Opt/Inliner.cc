@@ -1,6 +1,7 @@
 #include "Opt/Passes.h"
 
 #include <iostream>
+#include <mutex>
 #include <optional>
 
 #include <range/v3/algorithm.hpp>
@@ -10,9 +11,11 @@
 
 #include "Common/Logging.h"
 #include "Common/Ranges.h"
+#include "Common/ThreadPool.h"
 #include "IR/CFG.h"
 #include "IR/Clone.h"
 #include "IR/Module.h"
+#include "IR/PassManager.h"
 #include "IR/PassRegistry.h"
 #include "IR/Print.h"
 #include "IR/Validate.h"
@@ -53,6 +56,32 @@ using SCC = SCCCallGraph::SCCNode;
 using FunctionNode = SCCCallGraph::FunctionNode;
 using Modification = SCCCallGraph::Modification;
 
+namespace {
+
+/// Effects of visiting one SCC on the shared state of the inliner. The SCCs of
+/// one round are visited concurrently, so these are collected per SCC and
+/// applied in a deterministic order after the round
+struct VisitResult {
+    /// See `Inliner::visitSCC()`
+    std::optional<bool> modified;
+
+    /// SCCs that shall be inserted into the worklist
+    utl::small_vector<SCC*> newWork;
+
+    /// Functions found to be self recursive
+    utl::small_vector<Function const*> selfRecursive;
+
+    /// Functions that have been modified by inlining and must be validated
+    /// once no other SCC is visited
+    utl::small_vector<Function*> toValidate;
+
+    /// Set if the SCC has been left because its callees could not be
+    /// recomputed while other SCCs were visited concurrently
+    bool deferredRecompute = false;
+};
+
+} // namespace
+
 namespace scatha::opt {
 
 struct Inliner {
@@ -62,21 +91,36 @@ struct Inliner {
         mod(mod),
         functionPass(std::move(functionPass)),
         callGraph(SCCCallGraph::compute(mod)),
-        args(Arguments::Parse(map)) {}
+        args(Arguments::Parse(map)) {
+        /// We insert all functions here so these maps are not structurally
+        /// modified while SCCs are visited concurrently
+        size_t index = 0;
+        for (auto& function: mod) {
+            functionIndex[&function] = index++;
+            visitCount[&function] = 0;
+            incorporatedFunctions[&function];
+        }
+    }
 
     bool run();
 
+    /// Visits the SCCs in \p round. These must not depend on each other, so
+    /// they are visited concurrently
+    void visitRound(std::span<SCC* const> round,
+                    std::span<VisitResult> results);
+
     /// Called for every SCC whose successors have been fully optimized.
     /// \Returns
     /// - `true` if any function in the SCC has been modified
     /// - `false` if no functions have been modified
     /// - `std::nullopt` if structural changes have been made to the call graph
     /// and the SCC needs to be revisited later
-    std::optional<bool> visitSCC(SCC& scc);
+    std::optional<bool> visitSCC(SCC& scc, VisitResult& result);
 
     /// After analyzing an SCC, this function is called for every function of
     /// the SCC
-    void analyzeSelfRecursion(ir::Function* function);
+    /// \Returns `true` if \p function calls itself
+    bool isSelfRecursive(ir::Function* function) const;
 
     /// Called for every function in an SCC
     /// \Returns
@@ -84,22 +128,37 @@ struct Inliner {
     /// - `false` if the function has not been modified
     /// - `std::nullopt` if structural changes have been made to the call graph
     /// and the function needs to be revisited later
-    std::optional<bool> visitFunction(FunctionNode& node);
+    std::optional<bool> visitFunction(FunctionNode& node, VisitResult& result);
 
     /// Collects all sinks of the quotient call graph
     utl::small_vector<SCC*> gatherSinks();
 
+    /// \Returns the SCCs in the worklist whose successors have all been
+    /// analyzed ordered by the position of their functions in the module.
+    /// SCCs that have been emptied by splitting are erased from the worklist
+    utl::small_vector<SCC*> gatherReadySCCs();
+
     bool shouldInlineCallsite(Call const* call, int visitCount);
 
+    /// \Returns the number of users of \p function. During concurrent rounds
+    /// this is the number at the beginning of the round, so inlining
+    /// decisions don't depend on how the SCCs of the round are scheduled
+    size_t numUsers(Function const* function) const;
+
     bool allSuccessorsAnalyzed(SCC const& scc) const;
 
     /// Performs all local optimization passes on a function.
     bool optimize(Function& function) const;
 
-    /// Inserts all modified SCCs into the worklist
+    /// Recomputes the callees of \p node and inserts all modified SCCs into
+    /// the worklist
     /// \Returns `true` if the currently visited function or SCC must be left
     /// and revisited
-    bool handleCalleeRecompute(SCCCallGraph::RecomputeCalleesResult result);
+    bool recomputeCallees(FunctionNode& node, VisitResult& result);
+
+    /// \overload for multiple nodes
+    bool recomputeCallees(std::span<FunctionNode* const> nodes,
+                          VisitResult& result);
 
     /// Debug utilities
     void printWorklist() const;
@@ -114,6 +173,13 @@ struct Inliner {
     Module& mod;
     FunctionPass functionPass;
     SCCCallGraph callGraph;
+    /// Guards modifications of the call graph during concurrent rounds
+    std::mutex callGraphMutex;
+    /// Set while the SCCs of a round with more than one SCC are visited
+    bool concurrentRound = false;
+    /// User counts of all functions at the beginning of a concurrent round
+    utl::hashmap<Function const*, size_t> userCounts;
+    utl::hashmap<Function const*, size_t> functionIndex;
     utl::hashset<SCC*> worklist;
     utl::hashset<SCC const*> analyzed;
     utl::hashmap<Function const*, int> visitCount;
@@ -127,16 +193,23 @@ struct Inliner {
 
 bool opt::inlineFunctions(ir::Context& ctx, Module& mod,
                           PassArgumentMap const& args) {
-    return inlineFunctions(ctx, mod, opt::defaultPass, args);
+    return inlineFunctions(ctx, mod, PassManager::getFunctionPass("default"),
+                           args);
 }
 
 bool opt::inlineFunctions(ir::Context& ctx, ir::Module& mod,
                           FunctionPass const& argPass,
                           PassArgumentMap const& args) {
-    Inliner inl(ctx, mod, args, argPass ? argPass : defaultPass);
+    Inliner inl(ctx, mod, args,
+                argPass ? argPass : PassManager::getFunctionPass("default"));
     return inl.run();
 }
 
+/// The SCCs are visited in rounds. Every round visits all SCCs in the worklist
+/// whose successors have been analyzed. These are independent of each other, so
+/// we visit them concurrently. All effects on the worklist are applied after
+/// the round in the order of the SCCs, so the result does not depend on the
+/// number of threads
 bool Inliner::run() {
     if (args.printAny()) {
         logging::subHeader("Inliner");
@@ -144,34 +217,76 @@ bool Inliner::run() {
     bool modifiedAny = false;
     worklist = gatherSinks() | ranges::to<utl::hashset<SCC*>>;
     while (!worklist.empty()) {
-        auto itr = worklist.begin();
-        while (!allSuccessorsAnalyzed(**itr)) {
-            ++itr;
-            SC_ASSERT(
-                itr != worklist.end(),
-                "We have no component in the worklist that has all successors analyzed.");
+        auto round = gatherReadySCCs();
+        if (worklist.empty()) {
+            break;
         }
-        SCC& scc = **itr;
-        if (scc.nodes().empty()) {
-            worklist.erase(itr);
-            continue;
+        SC_ASSERT(
+            !round.empty(),
+            "We have no component in the worklist that has all successors analyzed.");
+        std::vector<VisitResult> results(round.size());
+        visitRound(round, results);
+        for (auto [scc, result]: zip(round, results)) {
+            if (result.deferredRecompute) {
+                /// We can safely modify the call graph now that no other SCC
+                /// is visited
+                (void)recomputeCallees(scc->nodes(), result);
+            }
+            worklist.insert(result.newWork.begin(), result.newWork.end());
+            selfRecursive.insert(result.selfRecursive.begin(),
+                                 result.selfRecursive.end());
+            if (!result.modified) {
+                modifiedAny = true;
+                continue;
+            }
+            worklist.erase(scc);
+            modifiedAny |= *result.modified;
+            analyzed.insert(scc);
+            for (auto* pred: scc->predecessors()) {
+                worklist.insert(pred);
+            }
         }
-        auto visRes = visitSCC(scc);
-        if (!visRes) {
-            modifiedAny = true;
-            continue;
+    }
+    return modifiedAny;
+}
+
+void Inliner::visitRound(std::span<SCC* const> round,
+                         std::span<VisitResult> results) {
+    concurrentRound = round.size() > 1;
+    if (!concurrentRound) {
+        results.front().modified = visitSCC(*round.front(), results.front());
+        return;
+    }
+    userCounts.clear();
+    for (auto& function: mod) {
+        userCounts[&function] = function.userCount();
+    }
+    callGraph.setValidateOnModify(false);
+    auto visit = [&](size_t index) {
+        results[index].modified = visitSCC(*round[index], results[index]);
+    };
+    /// We don't interleave debug output of concurrently visited SCCs
+    if (args.printAny()) {
+        for (size_t index = 0; index < round.size(); ++index) {
+            visit(index);
         }
-        worklist.erase(itr);
-        modifiedAny |= *visRes;
-        analyzed.insert(&scc);
-        for (auto* pred: scc.predecessors()) {
-            worklist.insert(pred);
+    }
+    else {
+        ThreadPool::global().parallelFor(round.size(), visit);
+    }
+    callGraph.setValidateOnModify(true);
+    callGraph.validate();
+    /// Validation reads the users of shared values like callees and
+    /// constants, so it cannot run while other SCCs are being modified
+    for (auto& result: results) {
+        for (auto* function: result.toValidate) {
+            ir::assertInvariants(ctx, *function);
         }
     }
-    return modifiedAny;
+    concurrentRound = false;
 }
 
-std::optional<bool> Inliner::visitSCC(SCC& scc) {
+std::optional<bool> Inliner::visitSCC(SCC& scc, VisitResult& visitResult) {
     bool modifiedAny = false;
     /// Perform one local optimization pass on every function before traversing
     /// the SCC. Otherwise, because we are in a cyclic component,  there will
@@ -179,15 +294,13 @@ std::optional<bool> Inliner::visitSCC(SCC& scc) {
     /// considered for inlining.
     /// This is the first time any optimization is run on the function so here
     /// we canonicalize
-    SCCCallGraph::RecomputeCalleesResult recomputeResult;
     for (auto* node: scc.nodes()) {
         modifiedAny |= canonicalize(ctx, *node->function());
         modifiedAny |= optimize(*node->function());
-        /// We recompute the call sites after local optimizations because they
-        /// could have been invalidated
-        recomputeResult.merge(callGraph.recomputeCallees(*node));
     }
-    if (handleCalleeRecompute(recomputeResult)) {
+    /// We recompute the call sites after local optimizations because they
+    /// could have been invalidated
+    if (recomputeCallees(scc.nodes(), visitResult)) {
         return std::nullopt;
     }
     utl::hashset<FunctionNode const*> visited;
@@ -199,7 +312,7 @@ std::optional<bool> Inliner::visitSCC(SCC& scc) {
         if (!visited.insert(node).second) {
             return true;
         }
-        auto result = visitFunction(*node);
+        auto result = visitFunction(*node, visitResult);
         if (!result) {
             return false;
         }
@@ -220,12 +333,15 @@ std::optional<bool> Inliner::visitSCC(SCC& scc) {
     /// Here we have fully optimized the SCC
     /// We will now try to inline self recursive functions
     for (auto& node: scc.nodes()) {
-        analyzeSelfRecursion(node->function());
+        if (isSelfRecursive(node->function())) {
+            visitResult.selfRecursive.push_back(node->function());
+        }
     }
     return modifiedAny;
 }
 
-std::optional<bool> Inliner::visitFunction(FunctionNode& node) {
+std::optional<bool> Inliner::visitFunction(FunctionNode& node,
+                                           VisitResult& visitResult) {
     printVisit(*node.function());
     auto& visitCount = this->visitCount[node.function()];
     utl::armed_scope_guard incGuard = [&] { ++visitCount; };
@@ -248,13 +364,17 @@ std::optional<bool> Inliner::visitFunction(FunctionNode& node) {
             inlineCallsite(ctx, callInst);
             inlined.push_back(callee->function());
             modifiedAny = true;
-            auto result = callGraph.removeCall(&node, callee, callInst);
+            auto result = [&] {
+                std::lock_guard lock(callGraphMutex);
+                return callGraph.removeCall(&node, callee, callInst);
+            }();
             /// If the SCC has been split, we immediately return.
             /// Both new SCCs will be pushed to the worklist, so no inlining
             /// opportunities are missed.
             if (result.type == Modification::SplitSCC) {
-                worklist.insert(result.modifiedSCCs.begin(),
-                                result.modifiedSCCs.end());
+                visitResult.newWork.insert(visitResult.newWork.end(),
+                                           result.modifiedSCCs.begin(),
+                                           result.modifiedSCCs.end());
                 incGuard.disarm();
                 return std::nullopt;
             }
@@ -268,8 +388,13 @@ std::optional<bool> Inliner::visitFunction(FunctionNode& node) {
         return false;
     }
     modifiedAny |= optimize(*node.function());
-    ir::assertInvariants(ctx, *node.function());
-    if (handleCalleeRecompute(callGraph.recomputeCallees(node))) {
+    if (concurrentRound) {
+        visitResult.toValidate.push_back(node.function());
+    }
+    else {
+        ir::assertInvariants(ctx, *node.function());
+    }
+    if (recomputeCallees(node, visitResult)) {
         return std::nullopt;
     }
     return modifiedAny;
@@ -284,10 +409,8 @@ static bool callsFunction(ir::Function* caller, ir::Function* callee) {
     return false;
 }
 
-void Inliner::analyzeSelfRecursion(ir::Function* function) {
-    if (callsFunction(function, function)) {
-        selfRecursive.insert(function);
-    }
+bool Inliner::isSelfRecursive(ir::Function* function) const {
+    return callsFunction(function, function);
 }
 
 utl::small_vector<SCC*> Inliner::gatherSinks() {
@@ -300,6 +423,30 @@ utl::small_vector<SCC*> Inliner::gatherSinks() {
     return result;
 }
 
+utl::small_vector<SCC*> Inliner::gatherReadySCCs() {
+    auto key = [&](SCC const* scc) {
+        return ranges::min(scc->nodes() | transform([&](auto* node) {
+            return functionIndex.find(node->function())->second;
+        }));
+    };
+    utl::small_vector<std::pair<size_t, SCC*>> ready;
+    utl::small_vector<SCC*> empty;
+    for (auto* scc: worklist) {
+        if (scc->nodes().empty()) {
+            empty.push_back(scc);
+        }
+        else if (allSuccessorsAnalyzed(*scc)) {
+            ready.push_back({ key(scc), scc });
+        }
+    }
+    for (auto* scc: empty) {
+        worklist.erase(scc);
+    }
+    /// SCCs are disjoint, so the keys are unique
+    ranges::sort(ready, ranges::less{}, [](auto& p) { return p.first; });
+    return ready | values | ToSmallVector<>;
+}
+
 bool Inliner::shouldInlineCallsite(Call const* call, int visitCount) {
     auto* caller = call->parentFunction();
     auto* callee = dyncast<Function const*>(call->function());
@@ -329,12 +476,19 @@ bool Inliner::shouldInlineCallsite(Call const* call, int visitCount) {
         }
     }
     /// Also always inline if we are the only user of this function.
-    if (callee->users().size() <= 1) {
+    if (numUsers(callee) <= 1) {
         return true;
     }
     return false;
 }
 
+size_t Inliner::numUsers(Function const* function) const {
+    if (concurrentRound) {
+        return userCounts.find(function)->second;
+    }
+    return function->userCount();
+}
+
 bool Inliner::allSuccessorsAnalyzed(SCC const& scc) const {
     for (auto* succ: scc.successors()) {
         if (!analyzed.contains(succ)) {
@@ -356,14 +510,36 @@ bool Inliner::optimize(Function& function) const {
     return modifiedAny;
 }
 
-bool Inliner::handleCalleeRecompute(
-    SCCCallGraph::RecomputeCalleesResult result) {
+bool Inliner::recomputeCallees(FunctionNode& node, VisitResult& visitResult) {
+    FunctionNode* nodes[] = { &node };
+    return recomputeCallees(nodes, visitResult);
+}
+
+bool Inliner::recomputeCallees(std::span<FunctionNode* const> nodes,
+                               VisitResult& visitResult) {
+    std::lock_guard lock(callGraphMutex);
+    /// New call edges can merge SCCs that are visited by other threads, so
+    /// during concurrent rounds we leave the SCC and recompute the callees
+    /// after the round
+    if (concurrentRound && ranges::any_of(nodes, [&](auto* node) {
+        return callGraph.hasNewCallees(*node);
+    })) {
+        visitResult.deferredRecompute = true;
+        return true;
+    }
+    SCCCallGraph::RecomputeCalleesResult result;
+    for (auto* node: nodes) {
+        result.merge(callGraph.recomputeCallees(*node));
+    }
     if (!result) {
         return false;
     }
-    worklist.insert(result.modifiedSCCs.begin(), result.modifiedSCCs.end());
-    auto newCalleeSSCs = result.newCallees | transform(&FunctionNode::scc);
-    worklist.insert(newCalleeSSCs.begin(), newCalleeSSCs.end());
+    visitResult.newWork.insert(visitResult.newWork.end(),
+                               result.modifiedSCCs.begin(),
+                               result.modifiedSCCs.end());
+    for (auto* callee: result.newCallees) {
+        visitResult.newWork.push_back(callee->scc());
+    }
     return true;
 }
 
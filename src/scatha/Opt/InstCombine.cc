@@ -26,8 +26,9 @@ using namespace ir;
 using namespace opt;
 using namespace ranges::views;
 
-SC_REGISTER_FUNCTION_PASS(opt::instCombine, "instcombine",
-                          PassCategory::Simplification, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::instCombine, "instcombine",
+                                     PassCategory::Simplification,
+                                     PreservedAnalyses::CFG(), {});
 
 namespace {
 
@@ -409,6 +410,10 @@ static bool isConstant(Value const* value, APInt const& constant) {
 }
 
 Value* InstCombineCtx::visitImpl(ArithmeticInst* inst) {
+    /// The folds below assume scalar operands
+    if (isa<VectorType>(inst->type())) {
+        return nullptr;
+    }
     auto* lhs = inst->lhs();
     auto* rhs = inst->rhs();
     /// If we have a constant operand put it on the RHS if possible.
@@ -1096,6 +1101,10 @@ static StaticCompareResult pointerStaticCompare(Value const* lhs,
 
 Value* InstCombineCtx::visitImpl(CompareInst* inst) {
     using enum CompareOperation;
+    /// The folds below produce `i1` constants
+    if (isa<VectorType>(inst->type())) {
+        return nullptr;
+    }
     auto* lhs = inst->lhs();
     auto* rhs = inst->rhs();
     /// If we have a constant operand put it on the RHS
@@ -1210,7 +1219,7 @@ Value* InstCombineCtx::extractPhiValue(ExtractValue* extractInst) {
     /// If we extract from a phi node and the phi node has no other users, we
     /// perform the extract in each of the predecessors and phi them together
     auto* phi = dyncast<Phi*>(extractInst->baseValue());
-    if (!phi || phi->users().size() > 1) {
+    if (!phi || phi->userCount() > 1) {
         return nullptr;
     }
     utl::small_vector<PhiMapping> newPhiArgs;
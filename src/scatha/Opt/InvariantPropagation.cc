@@ -381,7 +381,7 @@ void IPContext::replaceIfDominatedBy(Value* value, Constant* newValue,
                                      BasicBlock const* dom) const {
     auto users = value->users() | Filter<Instruction> | ToSmallVector<>;
     for (auto* user: users) {
-        if (domInfo.dominatorSet(user->parent()).contains(dom)) {
+        if (domInfo.dominates(dom, user->parent())) {
             user->updateOperand(value, newValue);
         }
     }
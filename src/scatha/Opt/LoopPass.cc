@@ -45,8 +45,7 @@ static void validateLNF(Function const& F) {
     // TODO: Only perform this check if F has an existing LNF
     auto& existing = F.getOrComputeLNF();
     auto& mutF = const_cast<Function&>(F);
-    auto domSets = DominanceInfo::computeDominatorSets(mutF);
-    auto domTree = DominanceInfo::computeDomTree(mutF, domSets);
+    auto domTree = DominanceInfo::computeDomTree(mutF);
     auto ref = LoopNestingForest::compute(mutF, domTree);
     auto diffCallback = [&](LNFNode const& A, LNFNode const& B) {
         std::cerr << "Invalid LNF in function " << format(F) << std::endl;
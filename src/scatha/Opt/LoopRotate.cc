@@ -132,7 +132,7 @@ struct LRContext {
     Context& ctx;
     Function& function;
     LoopNestingForest& LNF;
-    DominanceInfo const* domInfo;
+    DominanceInfo* domInfo;
 
     utl::small_vector<Phi*> addedPhis;
     utl::hashmap<Instruction*, Phi*> headerToSkipPhis;
@@ -141,8 +141,7 @@ struct LRContext {
     /// \Returns `true` if \p dom dominates \p sub
     /// Should only be used with `entry` and `skip` blocks
     bool dominates(BasicBlock const* dom, BasicBlock const* sub) const {
-        auto& dominatorSet = domInfo->dominatorSet(sub);
-        return dominatorSet.contains(dom);
+        return domInfo->dominates(dom, sub);
     }
 
     std::array<utl::small_vector<BasicBlock*>, 2> partitionLoopPreds(
@@ -158,7 +157,6 @@ struct LRContext {
 
     BasicBlock* addPreheader(BasicBlock* header,
                              std::span<BasicBlock* const> nonLoopPreds);
-    void recomputeDomInfo();
 
     PreprocessResult preprocess(BasicBlock* header);
     utl::hashmap<Instruction*, Phi*> mapInstructionsToPhis(BasicBlock* header,
@@ -292,12 +290,10 @@ void LRContext::rotate(BasicBlock* header) {
 
 BasicBlock* LRContext::addPreheader(BasicBlock* header,
                                     std::span<BasicBlock* const> nonLoopPreds) {
-    return addJoiningPredecessor(ctx, header, nonLoopPreds, "preheader");
-}
-
-void LRContext::recomputeDomInfo() {
-    function.invalidateDomInfo();
-    domInfo = &function.getOrComputeDomInfo();
+    auto* preheader =
+        addJoiningPredecessor(ctx, header, nonLoopPreds, "preheader");
+    domInfo->insertJoiningBlock(preheader, header);
+    return preheader;
 }
 
 PreprocessResult LRContext::preprocess(BasicBlock* header) {
@@ -322,20 +318,20 @@ PreprocessResult LRContext::preprocess(BasicBlock* header) {
         }
         return std::pair{ B, A };
     }();
-    bool domInfoInvalidated = false;
-    /// We add new nodes for `entry` and `skip` if necessary
+    /// We add new nodes for `entry` and `skip` if necessary. The dominator
+    /// tree is updated incrementally because we query it below and in the
+    /// rotation
     if (entry->numPredecessors() > 1) {
-        entry = splitEdge("loop.entry", ctx, header, entry);
-        domInfoInvalidated = true;
+        auto* split = splitEdge("loop.entry", ctx, header, entry);
+        domInfo->insertJoiningBlock(split, entry);
+        entry = split;
     }
     auto [skipLoopPreds, skipNonLoopPreds] = partitionLoopPreds(skip, header);
     if (!skipNonLoopPreds.empty()) {
         SC_ASSERT(!skipLoopPreds.empty(), "");
-        skip = addJoiningPredecessor(ctx, skip, skipLoopPreds, "skip");
-        domInfoInvalidated = true;
-    }
-    if (domInfoInvalidated) {
-        recomputeDomInfo();
+        auto* joiner = addJoiningPredecessor(ctx, skip, skipLoopPreds, "skip");
+        domInfo->insertJoiningBlock(joiner, skip);
+        skip = joiner;
     }
     return { entry, skip, loopPreds, nonLoopPreds };
 }
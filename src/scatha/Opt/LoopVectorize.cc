@@ -0,0 +1,597 @@
+#include <range/v3/algorithm.hpp>
+#include <utl/hashtable.hpp>
+#include <utl/strcat.hpp>
+#include <utl/vector.hpp>
+
+#include "IR/Builder.h"
+#include "IR/CFG.h"
+#include "IR/Clone.h"
+#include "IR/Context.h"
+#include "IR/Loop.h"
+#include "IR/PassRegistry.h"
+#include "IR/Type.h"
+#include "IR/Validate.h"
+#include "Opt/Passes.h"
+#include "Opt/ScalarEvolution.h"
+
+using namespace scatha;
+using namespace ir;
+using namespace opt;
+
+SC_REGISTER_FUNCTION_PASS(opt::loopVectorize, "loopvectorize",
+                          PassCategory::Optimization, {});
+
+/// Loops with more widened instructions than this are not interleaved
+static constexpr size_t MaxInterleaveBodySize = 16;
+
+/// Number of iterations of the interleaved loop body
+static constexpr size_t InterleaveFactor = 2;
+
+/// We don't emit more than this many runtime alias checks per loop
+static constexpr size_t MaxAliasChecks = 4;
+
+namespace {
+
+/// How the loop body is widened
+enum class WidenMode {
+    /// Every instruction is replaced by its lane wise vector counterpart
+    Vector,
+
+    /// The body is duplicated `InterleaveFactor` times in scalar order
+    Interleave
+};
+
+struct VectorizeContext {
+    Context& ctx;
+    Function& function;
+    LNFNode& node;
+    LoopInfo& loop = node.loopInfo();
+
+    BasicBlock* header = nullptr;
+    BasicBlock* preheader = nullptr;
+    BasicBlock* exit = nullptr;
+    Phi* inductionVar = nullptr;
+    ArithmeticInst* increment = nullptr;
+    CompareInst* exitCondition = nullptr;
+    Value* beginValue = nullptr;
+    Value* endValue = nullptr;
+    CompareOperation continueOperation = {};
+
+    /// All instructions of the header except the induction variable and the
+    /// loop control instructions
+    utl::small_vector<Instruction*> body;
+
+    /// Element type of all memory accesses and arithmetic in vector mode
+    ArithmeticType const* elemType = nullptr;
+
+    /// Pairs of base pointers that must not overlap in one vector iteration
+    utl::small_vector<std::pair<Value*, Value*>> aliasChecks;
+
+    VectorizeContext(Context& ctx, Function& function, LNFNode& node):
+        ctx(ctx), function(function), node(node) {}
+
+    /// Run the algorithm for this loop
+    bool run();
+
+    /// Assign the loop control variables above. \Returns `false` if the loop
+    /// is not a counted single block loop with unit stride
+    bool gatherVariables();
+
+    /// \Returns `true` if the body can be widened to vector instructions
+    bool isVectorizable();
+
+    /// \Returns `true` if the body can be interleaved
+    bool isInterleavable() const;
+
+    /// \Returns `false` if the trip count is known to be too small to profit
+    /// from running \p factor iterations at once
+    bool isProfitable(size_t factor) const;
+
+    /// Performs the CFG modifications and widens the body
+    void transform(WidenMode mode, size_t factor);
+
+    /// \Returns `true` if \p value is defined outside of the loop
+    bool isInvariant(Value const* value) const;
+
+    /// \Returns a boolean value that is true if the accesses through \p a and
+    /// \p b do not overlap within one vector iteration
+    Value* emitAliasCheck(BasicBlockBuilder& builder, Value* a, Value* b,
+                          size_t vectorSize) const;
+};
+
+} // namespace
+
+bool opt::loopVectorize(Context& ctx, Function& function) {
+    /// We only consider innermost loops that consist of a single block, so
+    /// transforming one loop does not change the structure of the others.
+    /// We gather the headers first because the loop nesting forest must be
+    /// recomputed after every transformation
+    utl::small_vector<BasicBlock*> headers;
+    for (auto& BB: function) {
+        if (BB.isPredecessor(&BB)) {
+            headers.push_back(&BB);
+        }
+    }
+    bool modified = false;
+    for (auto* header: headers) {
+        auto& LNF = function.getOrComputeLNF();
+        auto* node = LNF[header];
+        if (!node->isProperLoop() || !node->children().empty()) {
+            continue;
+        }
+        if (VectorizeContext(ctx, function, *node).run()) {
+            function.invalidateCFGInfo();
+            modified = true;
+        }
+    }
+    assertInvariants(ctx, function);
+    return modified;
+}
+
+bool VectorizeContext::run() {
+    if (!gatherVariables()) {
+        return false;
+    }
+    if (isVectorizable()) {
+        size_t factor = ctx.vectorType(elemType)->count();
+        if (!isProfitable(factor)) {
+            return false;
+        }
+        transform(WidenMode::Vector, factor);
+        return true;
+    }
+    /// `isVectorizable()` may have failed after it gathered some state.
+    /// Interleaving runs the iterations in scalar order, so it needs no alias
+    /// checks
+    elemType = nullptr;
+    aliasChecks.clear();
+    if (isInterleavable() && isProfitable(InterleaveFactor)) {
+        transform(WidenMode::Interleave, InterleaveFactor);
+        return true;
+    }
+    return false;
+}
+
+bool VectorizeContext::gatherVariables() {
+    header = node.basicBlock();
+    /* preheader */ {
+        if (header->numPredecessors() != 2) {
+            return false;
+        }
+        preheader = header->predecessor(0) == header ? header->predecessor(1) :
+                                                       header->predecessor(0);
+        if (preheader == header) {
+            return false;
+        }
+    }
+    /* exit */ {
+        auto* branch = dyncast<Branch*>(header->terminator());
+        if (!branch) {
+            return false;
+        }
+        exit = branch->thenTarget() == header ? branch->elseTarget() :
+                                                branch->thenTarget();
+        /// We add the vector loop as a predecessor to the exit, so it must not
+        /// have phi nodes
+        if (exit == header || !exit->phiNodes().empty()) {
+            return false;
+        }
+    }
+    /* inductionVar */ {
+        auto phis = header->phiNodes();
+        if (ranges::distance(phis) != 1) {
+            return false;
+        }
+        inductionVar = &*phis.begin();
+        if (!isa<IntegralType>(inductionVar->type())) {
+            return false;
+        }
+        /// SCEV must prove the induction variable to be `{begin,+,1}`
+        scev(ctx, node);
+        auto* expr = loop.getScevExpr(inductionVar);
+        auto* addExpr = expr ? dyncast<ScevAddExpr const*>(expr) : nullptr;
+        if (!addExpr) {
+            return false;
+        }
+        auto* stride = dyncast<ScevConstExpr const*>(addExpr->RHS());
+        if (!stride || stride->value().to<u64>() != 1) {
+            return false;
+        }
+        beginValue = inductionVar->operandOf(preheader);
+    }
+    /* increment */ {
+        increment =
+            dyncast<ArithmeticInst*>(inductionVar->operandOf(header));
+        if (!increment || increment->lhs() != inductionVar) {
+            return false;
+        }
+    }
+    /* exitCondition */ {
+        auto* branch = cast<Branch*>(header->terminator());
+        exitCondition = dyncast<CompareInst*>(branch->condition());
+        if (!exitCondition || exitCondition->lhs() != increment ||
+            exitCondition->mode() == CompareMode::Float ||
+            !isInvariant(exitCondition->rhs()))
+        {
+            return false;
+        }
+        endValue = exitCondition->rhs();
+        continueOperation = branch->thenTarget() == header ?
+                                exitCondition->operation() :
+                                inverse(exitCondition->operation());
+        using enum CompareOperation;
+        if (continueOperation != Less && continueOperation != NotEqual) {
+            return false;
+        }
+    }
+    /* body */ {
+        for (auto& inst: *header) {
+            /// No value computed in the loop may be used after the loop,
+            /// because the scalar epilogue is skipped when the vector loop
+            /// handles all iterations
+            for (auto* user: inst.users()) {
+                if (cast<Instruction const*>(user)->parent() != header) {
+                    return false;
+                }
+            }
+            if (&inst == inductionVar || &inst == increment ||
+                &inst == exitCondition || &inst == header->terminator())
+            {
+                continue;
+            }
+            body.push_back(&inst);
+        }
+        if (increment->userCount() != 2 || exitCondition->userCount() != 1) {
+            return false;
+        }
+    }
+    return !body.empty();
+}
+
+static bool isVectorizableOperation(ArithmeticOperation op) {
+    using enum ArithmeticOperation;
+    switch (op) {
+    case Add:
+    case Sub:
+    case Mul:
+    case FAdd:
+    case FSub:
+    case FMul:
+    case And:
+    case Or:
+    case XOr:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool VectorizeContext::isVectorizable() {
+    auto setElemType = [&](Type const* type) {
+        auto* arithType = dyncast<ArithmeticType const*>(type);
+        if (!arithType || arithType->bitwidth() % 8 != 0 ||
+            2 * arithType->size() > VectorType::MaxByteSize)
+        {
+            return false;
+        }
+        if (!elemType) {
+            elemType = arithType;
+        }
+        return elemType == arithType;
+    };
+    /// Addresses must be `gep T, ptr %base, %i` with loop invariant base
+    auto isUnitStrideAccess = [&](Value* address) {
+        auto* gep = dyncast<GetElementPointer*>(address);
+        return gep && gep->parent() == header;
+    };
+    utl::small_vector<Value*> storeBases;
+    utl::small_vector<Value*> accessBases;
+    size_t numWidened = 0;
+    for (auto* user: inductionVar->users()) {
+        if (user != increment && !isa<GetElementPointer>(user)) {
+            return false;
+        }
+    }
+    for (auto* inst: body) {
+        // clang-format off
+        bool legal = SC_MATCH (*inst) {
+            [&](GetElementPointer& gep) {
+                if (!gep.memberIndices().empty() ||
+                    gep.arrayIndex() != inductionVar ||
+                    !isInvariant(gep.basePointer()) ||
+                    !setElemType(gep.inboundsType()))
+                {
+                    return false;
+                }
+                return ranges::all_of(gep.users(), [&](auto* user) {
+                    if (isa<Load>(user)) {
+                        return true;
+                    }
+                    auto* store = dyncast<Store const*>(user);
+                    return store && store->value() != &gep;
+                });
+            },
+            [&](Load& load) {
+                if (!isUnitStrideAccess(load.address()) ||
+                    !setElemType(load.type()))
+                {
+                    return false;
+                }
+                auto* base = cast<GetElementPointer*>(load.address())
+                                 ->basePointer();
+                accessBases.push_back(base);
+                ++numWidened;
+                return true;
+            },
+            [&](Store& store) {
+                if (!isUnitStrideAccess(store.address()) ||
+                    !setElemType(store.value()->type()))
+                {
+                    return false;
+                }
+                auto* base = cast<GetElementPointer*>(store.address())
+                                 ->basePointer();
+                storeBases.push_back(base);
+                accessBases.push_back(base);
+                ++numWidened;
+                return true;
+            },
+            [&](ArithmeticInst& arith) {
+                if (!isVectorizableOperation(arith.operation()) ||
+                    !setElemType(arith.type()))
+                {
+                    return false;
+                }
+                ++numWidened;
+                return true;
+            },
+            [&](Instruction&) { return false; },
+        }; // clang-format on
+        if (!legal) {
+            return false;
+        }
+    }
+    if (storeBases.empty() || numWidened < 2) {
+        return false;
+    }
+    /// Distinct base pointers may still point into the same array, so every
+    /// store must be checked against every other access at runtime. Accesses
+    /// through the same base pointer always refer to the same element in one
+    /// iteration and need no check
+    for (auto* store: storeBases) {
+        for (auto* access: accessBases) {
+            if (store == access) {
+                continue;
+            }
+            bool known = ranges::any_of(aliasChecks, [&](auto& pair) {
+                return (pair.first == store && pair.second == access) ||
+                       (pair.first == access && pair.second == store);
+            });
+            if (!known) {
+                aliasChecks.push_back({ store, access });
+            }
+        }
+    }
+    return aliasChecks.size() <= MaxAliasChecks;
+}
+
+bool VectorizeContext::isInterleavable() const {
+    if (body.size() > MaxInterleaveBodySize) {
+        return false;
+    }
+    return ranges::none_of(body, [](Instruction const* inst) {
+        return isa<Alloca>(inst) || isa<VectorType>(inst->type());
+    });
+}
+
+bool VectorizeContext::isProfitable(size_t factor) const {
+    auto* begin = dyncast<IntegralConstant const*>(beginValue);
+    auto* end = dyncast<IntegralConstant const*>(endValue);
+    if (!begin || !end) {
+        return true;
+    }
+    if (continueOperation == CompareOperation::Less) {
+        int cmp = exitCondition->mode() == CompareMode::Signed ?
+                      scmp(begin->value(), end->value()) :
+                      ucmp(begin->value(), end->value());
+        if (cmp >= 0) {
+            return false;
+        }
+    }
+    /// We want the vector loop to run at least twice
+    auto tripCount = sub(end->value(), begin->value());
+    return tripCount.to<u64>() >= 2 * factor;
+}
+
+bool VectorizeContext::isInvariant(Value const* value) const {
+    auto* inst = dyncast<Instruction const*>(value);
+    return !inst || !loop.isInner(inst->parent());
+}
+
+Value* VectorizeContext::emitAliasCheck(BasicBlockBuilder& builder, Value* a,
+                                        Value* b, size_t vectorSize) const {
+    auto* i64 = ctx.intType(64);
+    auto* intA = builder.add<ConversionInst>(a, i64, Conversion::Bitcast,
+                                             "vec.addr");
+    auto* intB = builder.add<ConversionInst>(b, i64, Conversion::Bitcast,
+                                             "vec.addr");
+    /// The accesses are independent if the distance `d` between the base
+    /// pointers is zero or at least one vector. We test the latter as
+    /// `d + (size - 1) >= 2 * size - 1` in unsigned arithmetic
+    auto* dist = builder.add<ArithmeticInst>(intB, intA,
+                                             ArithmeticOperation::Sub,
+                                             "vec.alias.dist");
+    auto* biased = builder.add<ArithmeticInst>(
+        dist, ctx.intConstant(vectorSize - 1, 64), ArithmeticOperation::Add,
+        "vec.alias.biased");
+    auto* disjoint =
+        builder.add<CompareInst>(biased, ctx.intConstant(2 * vectorSize - 1, 64),
+                                 CompareMode::Unsigned,
+                                 CompareOperation::GreaterEq,
+                                 "vec.alias.disjoint");
+    auto* same =
+        builder.add<CompareInst>(dist, ctx.intConstant(0, 64),
+                                 CompareMode::Unsigned, CompareOperation::Equal,
+                                 "vec.alias.same");
+    return builder.add<ArithmeticInst>(disjoint, same, ArithmeticOperation::Or,
+                                       "vec.alias.ok");
+}
+
+/// The transformed CFG looks like this:
+///
+///     preheader -> vec.guard -> vec.body -> vec.middle -> header -> exit
+///                      |         ^    |          |          ^  |
+///                      |         +----+          +----------|--+--> exit
+///                      +------------------------------------+
+///
+/// `vec.guard` checks that the loop runs at least `factor` iterations and that
+/// no accesses alias. `vec.body` runs `factor` iterations at once while at
+/// least `factor` iterations remain. The original loop serves as the scalar
+/// epilogue and handles the remaining iterations
+void VectorizeContext::transform(WidenMode mode, size_t factor) {
+    auto* indexType = cast<IntegralType const*>(inductionVar->type());
+    size_t width = indexType->bitwidth();
+    auto* factorValue = ctx.intConstant(factor, width);
+    auto* guard = new BasicBlock(ctx, "vec.guard");
+    auto* vecBody = new BasicBlock(ctx, "vec.body");
+    auto* middle = new BasicBlock(ctx, "vec.middle");
+    function.insert(header, guard);
+    function.insert(header, vecBody);
+    function.insert(header, middle);
+    preheader->terminator()->updateTarget(header, guard);
+    header->updatePredecessor(preheader, guard);
+    guard->addPredecessor(preheader);
+    /* Guard */ {
+        BasicBlockBuilder builder(ctx, guard);
+        auto* dist =
+            builder.add<ArithmeticInst>(endValue, beginValue,
+                                        ArithmeticOperation::Sub, "vec.dist");
+        Value* cond = builder.add<CompareInst>(dist, factorValue,
+                                               CompareMode::Unsigned,
+                                               CompareOperation::GreaterEq,
+                                               "vec.enough");
+        auto conjoin = [&](Value* value) {
+            cond = builder.add<ArithmeticInst>(cond, value,
+                                               ArithmeticOperation::And,
+                                               "vec.cond");
+        };
+        /// With a `ls` exit test the loop runs once if `begin >= end`, so the
+        /// distance is only meaningful if `begin < end`
+        if (continueOperation == CompareOperation::Less) {
+            conjoin(builder.add<CompareInst>(beginValue, endValue,
+                                             exitCondition->mode(),
+                                             CompareOperation::Less,
+                                             "vec.inrange"));
+        }
+        if (mode == WidenMode::Vector) {
+            size_t vectorSize = ctx.vectorType(elemType)->size();
+            for (auto [a, b]: aliasChecks) {
+                conjoin(emitAliasCheck(builder, a, b, vectorSize));
+            }
+        }
+        builder.add<Branch>(cond, vecBody, header);
+    }
+    /* Vector body */ {
+        vecBody->addPredecessor(guard);
+        vecBody->addPredecessor(vecBody);
+        BasicBlockBuilder builder(ctx, vecBody);
+        auto* index = builder.add<Phi>(indexType, "vec.i");
+        switch (mode) {
+        case WidenMode::Vector: {
+            auto* vecType = ctx.vectorType(elemType);
+            utl::hashmap<Value*, Value*> widened;
+            utl::hashmap<Value*, Value*> splats;
+            /// Invariant operands are splatted in the guard block
+            BasicBlockBuilder guardBuilder(ctx, guard, guard->terminator());
+            auto widen = [&](Value* value) -> Value* {
+                if (auto itr = widened.find(value); itr != widened.end()) {
+                    return itr->second;
+                }
+                auto& splat = splats[value];
+                if (!splat) {
+                    splat = ctx.undef(vecType);
+                    for (size_t i = 0; i < factor; ++i) {
+                        splat = guardBuilder.add(
+                            new InsertValue(splat, value, { i }, "vec.splat"));
+                    }
+                }
+                return splat;
+            };
+            for (auto* inst: body) {
+                auto name = utl::strcat(inst->name(), ".vec");
+                // clang-format off
+                Value* result = SC_MATCH (*inst) {
+                    [&](GetElementPointer& gep) -> Value* {
+                        return builder.add<GetElementPointer>(
+                            gep.inboundsType(), gep.basePointer(), index,
+                            std::span<size_t const>{}, name);
+                    },
+                    [&](Load& load) -> Value* {
+                        return builder.add<Load>(widen(load.address()),
+                                                 vecType, name);
+                    },
+                    [&](Store& store) -> Value* {
+                        return builder.add<Store>(widen(store.address()),
+                                                  widen(store.value()));
+                    },
+                    [&](ArithmeticInst& arith) -> Value* {
+                        return builder.add<ArithmeticInst>(widen(arith.lhs()),
+                                                           widen(arith.rhs()),
+                                                           arith.operation(),
+                                                           name);
+                    },
+                    [&](Instruction&) -> Value* { SC_UNREACHABLE(); },
+                }; // clang-format on
+                widened[inst] = result;
+            }
+            break;
+        }
+        case WidenMode::Interleave: {
+            for (size_t lane = 0; lane < factor; ++lane) {
+                CloneValueMap map;
+                map.add(inductionVar,
+                        lane == 0 ? index :
+                                    builder.add<ArithmeticInst>(
+                                        index, ctx.intConstant(lane, width),
+                                        ArithmeticOperation::Add, "vec.i.lane"));
+                for (auto* inst: body) {
+                    auto* copy = builder.add(clone(ctx, inst).release());
+                    for (auto [i, operand]:
+                         copy->operands() | ranges::views::enumerate)
+                    {
+                        copy->setOperand(i, map(operand));
+                    }
+                    map.add(inst, copy);
+                }
+            }
+            break;
+        }
+        }
+        auto* next = builder.add<ArithmeticInst>(index, factorValue,
+                                                 ArithmeticOperation::Add,
+                                                 "vec.i.next");
+        index->addArgument(guard, beginValue);
+        index->addArgument(vecBody, next);
+        auto* remaining =
+            builder.add<ArithmeticInst>(endValue, next,
+                                        ArithmeticOperation::Sub,
+                                        "vec.remaining");
+        auto* more = builder.add<CompareInst>(remaining, factorValue,
+                                              CompareMode::Unsigned,
+                                              CompareOperation::GreaterEq,
+                                              "vec.more");
+        builder.add<Branch>(more, vecBody, middle);
+        /* Middle */ {
+            middle->addPredecessor(vecBody);
+            BasicBlockBuilder builder(ctx, middle);
+            auto* rest = builder.add<CompareInst>(next, endValue,
+                                                  CompareMode::Unsigned,
+                                                  CompareOperation::NotEqual,
+                                                  "vec.rest");
+            builder.add<Branch>(rest, header, exit);
+            header->addPredecessor(middle);
+            inductionVar->addArgument(middle, next);
+            exit->addPredecessor(middle);
+        }
+    }
+}
@@ -12,8 +12,9 @@ using namespace scatha;
 using namespace ir;
 using namespace opt;
 
-SC_REGISTER_FUNCTION_PASS(opt::memToReg, "memtoreg",
-                          PassCategory::Simplification, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::memToReg, "memtoreg",
+                                     PassCategory::Simplification,
+                                     PreservedAnalyses::CFG(), {});
 
 bool opt::memToReg(Context& ctx, Function& function) {
     auto& domInfo = function.getOrComputeDomInfo();
@@ -5,6 +5,7 @@
 #include "IR/CFG.h"
 #include "IR/ForEach.h"
 #include "IR/Module.h"
+#include "IR/PassManager.h"
 #include "IR/PassRegistry.h"
 #include "Opt/Passes.h"
 
@@ -17,9 +18,17 @@ SC_REGISTER_MODULE_PASS(opt::optimize, "optimize", PassCategory::Optimization,
 
 bool opt::optimize(Context& ctx, Module& mod, FunctionPass const&,
                    PassArgumentMap const&) {
+    /// We run the registered passes so they appear by name in time traces
+    auto run = [&](std::string_view pass, std::string_view functionPass = {}) {
+        return PassManager::getModulePass(pass)(
+            ctx, mod,
+            functionPass.empty() ? FunctionPass{} :
+                                   PassManager::getFunctionPass(functionPass));
+    };
     bool modified = false;
-    modified |= inlineFunctions(ctx, mod, {});
-    modified |= globalDCE(ctx, mod, {});
-    modified |= forEach(ctx, mod, splitReturns, {});
+    modified |= run("inline");
+    modified |= run("globaldce");
+    modified |= run("foreach", "loopvectorize");
+    modified |= run("foreach", "splitreturns");
     return modified;
 }
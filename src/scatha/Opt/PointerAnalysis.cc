@@ -23,8 +23,9 @@ using namespace opt;
 using namespace ir;
 using namespace ranges::views;
 
-SC_REGISTER_FUNCTION_PASS(opt::pointerAnalysis, "ptranalysis",
-                          PassCategory::Analysis, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::pointerAnalysis, "ptranalysis",
+                                     PassCategory::Analysis,
+                                     PreservedAnalyses::CFG(), {});
 
 #define INFO_NODE_DEF(X)                                                       \
     X(InfoNode, void, Abstract)                                                \
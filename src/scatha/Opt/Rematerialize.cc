@@ -9,8 +9,9 @@ using namespace scatha;
 using namespace ir;
 using namespace opt;
 
-SC_REGISTER_FUNCTION_PASS(opt::rematerialize, "rematerialize",
-                          PassCategory::Experimental, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::rematerialize, "rematerialize",
+                                     PassCategory::Experimental,
+                                     PreservedAnalyses::CFG(), {});
 
 namespace {
 
@@ -59,7 +60,7 @@ bool RematCtx::visitImpl(GetElementPointer& gep) {
         }
         modified = true;
         auto* gepCopy = [&]() -> Instruction* {
-            if (gep.users().size() == 1) {
+            if (gep.userCount() == 1) {
                 return gep.parent()->extract(&gep).release();
             }
             return clone(ctx, &gep).release();
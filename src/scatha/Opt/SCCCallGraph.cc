@@ -245,7 +245,9 @@ using Modification = SCCCallGraph::Modification;
 Modification SCCCallGraph::removeCall(FunctionNode* callerNode,
                                       FunctionNode* calleeNode,
                                       Call const* callInst) {
-    utl::scope_guard val = [&] { validate(); };
+    utl::scope_guard val = [&] {
+        if (validateOnModify) validate();
+    };
     SC_ASSERT(callerNode->isSuccessor(calleeNode),
               "Must be a successor to remove the edge");
     /// We remove `call` from our list of call sites
@@ -399,7 +401,9 @@ Modification SCCCallGraph::addCall(FunctionNode* callerNode,
     if (callerNode == calleeNode) {
         return Modification::None;
     }
-    utl::scope_guard val = [&] { validate(); };
+    utl::scope_guard val = [&] {
+        if (validateOnModify) validate();
+    };
     if (calleeNode->isPredecessor(callerNode)) {
         auto& callsites = callerNode->mutCallsites(calleeNode);
         SC_ASSERT(!callsites.contains(callInst), "");
@@ -501,6 +505,22 @@ SCCCallGraph::RecomputeCalleesResult SCCCallGraph::recomputeCallees(
     return result;
 }
 
+bool SCCCallGraph::hasNewCallees(FunctionNode const& node) const {
+    for (auto& call: node.function()->instructions() | Filter<Call>) {
+        auto* callee = dyncast<Function const*>(call.function());
+        if (!callee || callee == node.function()) {
+            continue;
+        }
+        auto* calleeNode = (*this)[callee];
+        if (!node.isSuccessor(calleeNode) ||
+            !node.callsites(calleeNode).contains(&call))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void SCCCallGraph::validate() const {
 #if SC_DEBUG
     for (auto& function: *mod) {
@@ -35,7 +35,9 @@ using namespace ir;
 using namespace opt;
 using namespace ranges::views;
 
-SC_REGISTER_FUNCTION_PASS(opt::sroa, "sroa", PassCategory::Simplification, {});
+SC_REGISTER_FUNCTION_PASS_PRESERVING(opt::sroa, "sroa",
+                                     PassCategory::Simplification,
+                                     PreservedAnalyses::CFG(), {});
 
 /// Uniform interface to get the associated pointer and type of the load or
 /// store instruction \p inst
@@ -542,9 +544,8 @@ bool Variable::pointerUsePostdominatesPhi(Instruction* user, Value* ptr) {
     if (!phi) {
         return true;
     }
-    auto& domInfo = function.getOrComputePostDomInfo();
-    auto& dominatorSet = domInfo.dominatorSet(phi->parent());
-    return dominatorSet.contains(user->parent());
+    auto& postDomInfo = function.getOrComputePostDomInfo();
+    return postDomInfo.dominates(user->parent(), phi->parent());
 }
 
 bool Variable::valueStrictlyDominatesPhi(Value* value, Value* ptr) {
@@ -560,8 +561,7 @@ bool Variable::valueStrictlyDominatesPhi(Value* value, Value* ptr) {
         return false;
     }
     auto& domInfo = function.getOrComputeDomInfo();
-    auto& dominatorSet = domInfo.dominatorSet(phi->parent());
-    return dominatorSet.contains(inst->parent());
+    return domInfo.dominates(inst->parent(), phi->parent());
 }
 
 /// FIXME: These functions are generic and have little to do with SROA. Move
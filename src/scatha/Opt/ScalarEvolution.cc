@@ -202,7 +202,7 @@ UniquePtr<ScevExpr> ScevCtx::findScevExprImpl(PhiInfo phiInfo,
                                               ArithmeticInst& inst) {
     auto* LHS = inst.lhs();
     auto* RHS = inst.rhs();
-    if (LHS != phiInfo.phi) {
+    if (LHS != phiInfo.phi || isa<VectorType>(inst.type())) {
         return nullptr;
     }
     auto base = getNullary(*phiInfo.phOperand);
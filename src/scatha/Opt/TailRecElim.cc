@@ -420,6 +420,10 @@ bool TREContext::isInterestingCall(Value const* inst) const {
 }
 
 bool TREContext::isCommutativeAndAssociative(ArithmeticInst const* inst) const {
+    /// We have no identity values for vector types
+    if (isa<VectorType>(inst->type())) {
+        return false;
+    }
     return irCtx.isCommutative(inst->operation()) &&
            irCtx.isAssociative(inst->operation());
 }
@@ -28,8 +28,8 @@ Bracket parser::toBracket(Token const& token) {
     }
 }
 
-std::string parser::toString(Bracket bracket) {
-    static std::string const result[3][2] = {
+std::string_view parser::toString(Bracket bracket) {
+    static constexpr std::string_view result[3][2] = {
         { "(", ")" },
         { "[", "]" },
         { "{", "}" },
@@ -1,7 +1,7 @@
 #ifndef SCATHA_PARSER_BRACKET_H_
 #define SCATHA_PARSER_BRACKET_H_
 
-#include <string>
+#include <string_view>
 
 #include <scatha/Common/Base.h>
 #include <scatha/Parser/Token.h>
@@ -23,7 +23,9 @@ struct Bracket {
 
 SCATHA_API Bracket toBracket(Token const& token);
 
-std::string toString(Bracket bracket);
+/// \Returns the spelling of \p bracket. The returned view refers to static
+/// storage
+std::string_view toString(Bracket bracket);
 
 TokenKind toTokenKind(Bracket bracket);
 
@@ -1,372 +1,278 @@
 #include "Parser/Lexer.h"
 
+#include <array>
 #include <optional>
 
-#include <ctre.hpp>
-#include <range/v3/algorithm.hpp>
-#include <utl/function_view.hpp>
 #include <utl/hashtable.hpp>
 #include <utl/stack.hpp>
 
 #include "Common/EscapeSequence.h"
-#include "Common/Expected.h"
 #include "Common/SourceLocation.h"
-#include "Parser/LexerUtil.h"
 #include "Parser/LexicalIssue.h"
 
 using namespace scatha;
 using namespace parser;
-using namespace lex;
 
-namespace {
+/// The lexer makes a single pass over the source text. The kind of each token
+/// is determined by switching on its first character and the token text is a
+/// view into the source text, so no characters are copied except for string
+/// and char literals that contain escape sequences.
 
-template <ctll::fixed_string P>
-struct StringLiteralDelim {
-    static constexpr ctll::fixed_string Pattern = P;
+namespace {
 
-    TokenKind tokenKind;
-    utl::function_view<void()> callback = {};
+/// Bit flags classifying the characters of the source text
+enum CharClass : uint8_t {
+    Space = 1 << 0,
+    IDBegin = 1 << 1,
+    IDContinue = 1 << 2,
+    DecDigit = 1 << 3,
+    FloatDigit = 1 << 4,
 };
 
-struct Context {
-    std::vector<Token> run();
+constexpr std::array<uint8_t, 256> makeCharClassTable() {
+    std::array<uint8_t, 256> table{};
+    for (unsigned char c: { ' ', '\t', '\n', '\v', '\f', '\r' }) {
+        table[c] |= Space;
+    }
+    auto setLetter = [&](unsigned char c) { table[c] |= IDBegin | IDContinue; };
+    for (unsigned char c = 'a'; c <= 'z'; ++c) {
+        setLetter(c);
+    }
+    for (unsigned char c = 'A'; c <= 'Z'; ++c) {
+        setLetter(c);
+    }
+    setLetter('_');
+    for (unsigned char c = '0'; c <= '9'; ++c) {
+        table[c] |= IDContinue | DecDigit | FloatDigit;
+    }
+    table['.'] |= FloatDigit;
+    return table;
+}
 
-    std::optional<Token> getToken();
-
-    bool ignoreSpaces();
-    bool ignoreLineComment();
-    bool ignoreMultiLineComment();
-    std::optional<Token> getPunctuation();
-    std::optional<Token> getOperator();
-    std::optional<Token> getFloatingPointLiteral();
-    std::optional<Token> getIntegerLiteral();
-    template <typename Error, typename Begin, typename... End>
-    std::optional<Token> getStringLiteralImpl(Begin begin, End... end);
-    char getCurrentEscapeSequence();
-    std::optional<Token> getStringLiteral();
-    std::optional<Token> getCharLiteral();
-    std::optional<Token> getBooleanLiteral();
-    std::optional<Token> getIdentifier();
-
-    bool advance();
-    bool advance(size_t count);
-
-    std::pair<std::string, SourceLocation> beginToken() const;
-    Token extractToken(size_t count, TokenKind kind);
-    Token extractToken(size_t count, auto tokenKindFactory);
-    char current() const;
+constexpr std::array<uint8_t, 256> CharClassTable = makeCharClassTable();
 
+bool is(char c, CharClass charClass) {
+    return CharClassTable[static_cast<unsigned char>(c)] & charClass;
+}
+
+struct Context {
     std::string_view text;
     size_t fileIndex;
     IssueHandler& issues;
-    SourceLocation currentLocation{ 0, fileIndex, 1, 1 };
-    utl::stack<int> parenNestingDepthStack = {};
-};
 
-} // namespace
+    /// Index of the current character
+    size_t pos = 0;
 
-std::vector<Token> parser::lex(std::string_view text, IssueHandler& issues,
-                               size_t fileIndex) {
-    Context ctx{ text, fileIndex, issues };
-    return ctx.run();
-}
+    /// Line number of the current character
+    i32 line = 1;
+
+    /// Index of the first character of the current line
+    size_t lineBegin = 0;
+
+    /// Every string interpolation `\(` pushes a counter of unmatched opening
+    /// parentheses. The closing parenthesis that brings the counter back to
+    /// zero continues the enclosing string literal
+    utl::stack<int> parenNestingDepthStack = {};
 
-std::vector<Token> Context::run() {
     std::vector<Token> result;
-    while (!text.empty()) {
-        if (auto token = getToken()) {
-            result.push_back(std::move(*token));
-        }
-    }
-    SC_ASSERT(text.empty(), "The entire string shall be tokenized");
-    result.push_back(
-        Token({}, TokenKind::EndOfFile, { currentLocation, currentLocation }));
-    return result;
-}
 
-std::optional<Token> Context::getToken() {
-    if (text.empty()) {
-        return std::nullopt;
-    }
-    if (ignoreSpaces() || ignoreLineComment() || ignoreMultiLineComment()) {
-        if (issues.haveErrors()) {
-            return std::nullopt;
-        }
-        return getToken();
-    }
-    if (auto floatingPointLiteral = getFloatingPointLiteral()) {
-        return floatingPointLiteral;
-    }
-    if (auto integerLiteral = getIntegerLiteral()) {
-        return integerLiteral;
-    }
-    if (auto stringLiteral = getStringLiteral()) {
-        return stringLiteral;
-    }
-    if (auto charLiteral = getCharLiteral()) {
-        return charLiteral;
-    }
-    if (auto booleanLiteral = getBooleanLiteral()) {
-        return booleanLiteral;
-    }
-    if (auto identifier = getIdentifier()) {
-        return identifier;
-    }
-    if (auto punctuation = getPunctuation()) {
-        return punctuation;
-    }
-    if (auto op = getOperator()) {
-        return op;
-    }
-    return std::nullopt;
-}
+    std::vector<Token> run();
 
-bool Context::ignoreSpaces() {
-    auto m = ctre::starts_with<"\\s+">(text);
-    if (!m) {
-        return false;
-    }
-    return advance(m.size());
-}
+    void skipSpacesAndComments();
+    void lexToken();
+    void lexIdentifier();
+    void lexNumber();
+    template <typename UnterminatedIssue>
+    void lexQuoted(SourceLocation beginLoc, char delim, TokenKind endKind,
+                   std::optional<TokenKind> interpolationKind);
+    void lexCharLiteral();
+    void lexPunctuation(TokenKind kind);
+    void lexOperator();
+
+    void addToken(size_t begin, TokenKind kind, SourceLocation beginLoc);
 
-bool Context::ignoreLineComment() {
-    auto m = ctre::starts_with<"\\/\\/.*?\\n">(text);
-    if (!m) {
-        return false;
+    /// \Returns the source location of the character at \p index, which must
+    /// be on the current line
+    SourceLocation locationAt(size_t index) const {
+        return { static_cast<i64>(index), fileIndex, line,
+                 static_cast<i32>(index - lineBegin + 1) };
     }
-    return advance(m.size());
-}
 
-bool Context::ignoreMultiLineComment() {
-    auto m = ctre::starts_with<"\\/\\*(.|\\n)*?\\*\\/">(text);
-    if (!m) {
-        return false;
+    SourceLocation location() const { return locationAt(pos); }
+
+    /// \Returns the character \p offset characters past the current character
+    /// or `'\0'` past the end of the text
+    char peek(size_t offset = 0) const {
+        return pos + offset < text.size() ? text[pos + offset] : '\0';
     }
-    return advance(m.size());
-}
 
-std::optional<Token> Context::getPunctuation() {
-    auto m = ctre::starts_with<"\\[|\\]|\\(|\\)|\\{|\\}|,|:|;">(text);
-    if (!m) {
-        return std::nullopt;
+    bool atEnd() const { return pos >= text.size(); }
+
+    /// Consumes the newline character at the current position
+    void consumeNewline() {
+        ++pos;
+        ++line;
+        lineBegin = pos;
     }
-    std::string ID = m.to_string();
-    SC_ASSERT(ID.size() == 1, "");
-    auto beginLoc = currentLocation;
-    advance();
-    TokenKind kind = [&] {
-        using enum TokenKind;
-        switch (ID.front()) {
-        case '(':
-            if (!parenNestingDepthStack.empty()) {
-                ++parenNestingDepthStack.top();
-            }
-            return OpenParan;
-        case ')':
-            if (!parenNestingDepthStack.empty()) {
-                --parenNestingDepthStack.top();
-            }
-            return CloseParan;
-        case '{':
-            return OpenBrace;
-        case '}':
-            return CloseBrace;
-        case '[':
-            return OpenBracket;
-        case ']':
-            return CloseBracket;
-        case ',':
-            return Comma;
-        case ';':
-            return Semicolon;
-        case ':':
-            return Colon;
-        default:
-            SC_UNREACHABLE();
-        }
-    }();
-    return Token(ID, kind, { beginLoc, currentLocation });
-}
+};
 
-static TokenKind toOperator(std::string_view str) {
-    if ((false)) (void)0; /// To make following chained `if/else` cases work
-#define SC_OPERATOR_TOKEN_DEF(Token, op)                                       \
-    else if (str == op) { return TokenKind::Token; }
-#include "Parser/Token.def.h"
-    SC_UNREACHABLE();
+} // namespace
+
+std::vector<Token> parser::lex(std::string_view text, IssueHandler& issues,
+                               size_t fileIndex) {
+    Context ctx{ text, fileIndex, issues };
+    return ctx.run();
 }
 
-std::optional<Token> Context::getOperator() {
-    auto [id, beginLoc] = beginToken();
-    if (!isOperatorLetter(current())) {
-        return std::nullopt;
-    }
-    id += current();
+std::vector<Token> Context::run() {
+    result.reserve(text.size() / 8);
     while (true) {
-        if (!advance()) {
-            break;
-        }
-        id += current();
-        if (!isOperator(id)) {
-            id.pop_back();
+        skipSpacesAndComments();
+        if (atEnd()) {
             break;
         }
+        lexToken();
     }
-    return Token(id, toOperator(id), { beginLoc, currentLocation });
+    auto loc = location();
+    result.push_back(Token({}, TokenKind::EndOfFile, { loc, loc }));
+    return std::move(result);
 }
 
-std::optional<Token> Context::getFloatingPointLiteral() {
-    auto m = ctre::starts_with<"([\\d\\.]+)([A-Za-z_][A-Za-z0-9_]*)?">(text);
-    if (!m || m.get<1>().size() == 1) {
-        return std::nullopt;
-    }
-    size_t numDots = (size_t)ranges::count(m.view(), '.');
-    switch (numDots) {
-    case 0:
-        return std::nullopt;
-    case 1:
-        return extractToken(m.size(), TokenKind::FloatLiteral);
-    default:
-        auto beginLoc = currentLocation;
-        advance(m.size());
-        issues.push<InvalidNumericLiteral>(
-            SourceRange{ beginLoc, currentLocation },
-            InvalidNumericLiteral::Kind::FloatingPoint);
-        return std::nullopt;
-    }
-}
-
-std::optional<Token> Context::getIntegerLiteral() {
-    if (auto m =
-            ctre::starts_with<"0x[\\da-fA-F]+([A-Za-z_][A-Za-z0-9_]*)?">(text))
-    {
-        return extractToken(m.size(), TokenKind::IntegerLiteral);
-    }
-    if (auto m = ctre::starts_with<"\\d+([A-Za-z_][A-Za-z0-9_]*)?">(text)) {
-        return extractToken(m.size(), TokenKind::IntegerLiteral);
-    }
-    return std::nullopt;
-}
-
-char Context::getCurrentEscapeSequence() {
-    if (auto seq = toEscapeSequence(current())) {
-        return *seq;
-    }
-    else {
-        auto begin = currentLocation;
-        auto end = currentLocation;
-        --begin.index, --begin.column, ++end.index, ++end.column;
-        issues.push<InvalidEscapeSequence>(current(),
-                                           SourceRange{ begin, end });
-        return current();
+void Context::skipSpacesAndComments() {
+    while (!atEnd()) {
+        char c = text[pos];
+        if (c == '\n') {
+            consumeNewline();
+            continue;
+        }
+        if (is(c, Space)) {
+            ++pos;
+            continue;
+        }
+        if (c != '/') {
+            return;
+        }
+        if (peek(1) == '/') {
+            auto end = text.find('\n', pos);
+            pos = end != text.npos ? end : text.size();
+            continue;
+        }
+        if (peek(1) == '*') {
+            auto beginLoc = location();
+            pos += 2;
+            while (true) {
+                if (atEnd()) {
+                    issues.push<UnterminatedMultiLineComment>(
+                        SourceRange{ beginLoc, location() });
+                    return;
+                }
+                if (text[pos] == '\n') {
+                    consumeNewline();
+                    continue;
+                }
+                if (text[pos] == '*' && peek(1) == '/') {
+                    pos += 2;
+                    break;
+                }
+                ++pos;
+            }
+            continue;
+        }
+        return;
     }
 }
 
-template <size_t N, size_t M>
-static constexpr auto operator+(ctll::fixed_string<N> a,
-                                ctll::fixed_string<M> b) {
-    std::array<char32_t, N + M> buffer{};
-    ranges::copy(a, buffer.data());
-    ranges::copy(b, buffer.data() + N);
-    return ctll::fixed_string<N + M>(ctll::construct_from_pointer,
-                                     buffer.data());
-}
-
-template <typename Error, typename Begin, typename... End>
-std::optional<Token> Context::getStringLiteralImpl(Begin begin, End... end) {
-    auto m = ctre::starts_with<Begin::Pattern>(text);
-    if (!m) {
-        return std::nullopt;
-    }
-    auto [id, beginLoc] = beginToken();
-    advance(m.size());
-    if (begin.callback) {
-        begin.callback();
-    }
-    auto pushError = [&] {
-        issues.push<Error>(SourceRange{ beginLoc, currentLocation });
-    };
-    auto advanceChecked = [&] {
-        if (!text.empty() && advance() && current() != '\n') {
-            return true;
+void Context::lexToken() {
+    using enum TokenKind;
+    char c = text[pos];
+    switch (c) {
+    case '"':
+        lexQuoted<UnterminatedStringLiteral>(location(), '"', StringLiteral,
+                                             FStringLiteralBegin);
+        return;
+    case '\'':
+        lexCharLiteral();
+        return;
+    case '(':
+        if (!parenNestingDepthStack.empty()) {
+            ++parenNestingDepthStack.top();
         }
-        pushError();
-        return false;
-    };
-    if (text.empty()) {
-        pushError();
-    }
-    do {
-        std::optional<Token> tok;
-        ([&] {
-            auto m = ctre::starts_with<End::Pattern>(text);
-            if (!m) {
-                return false;
-            }
-            advance(m.size());
-            tok = Token(id, end.tokenKind, { beginLoc, currentLocation });
-            if (end.callback) {
-                end.callback();
+        lexPunctuation(OpenParan);
+        return;
+    case ')':
+        if (!parenNestingDepthStack.empty()) {
+            if (parenNestingDepthStack.top() == 0) {
+                parenNestingDepthStack.pop();
+                lexQuoted<UnterminatedStringLiteral>(location(), '"',
+                                                     FStringLiteralEnd,
+                                                     FStringLiteralContinue);
+                return;
             }
-            return true;
-        }() || ...);
-        if (tok) {
-            return tok;
+            --parenNestingDepthStack.top();
         }
-        if (current() == '\\') {
-            if (!advanceChecked()) {
-                break;
-            }
-            id += getCurrentEscapeSequence();
+        lexPunctuation(CloseParan);
+        return;
+    case '{':
+        lexPunctuation(OpenBrace);
+        return;
+    case '}':
+        lexPunctuation(CloseBrace);
+        return;
+    case '[':
+        lexPunctuation(OpenBracket);
+        return;
+    case ']':
+        lexPunctuation(CloseBracket);
+        return;
+    case ',':
+        lexPunctuation(Comma);
+        return;
+    case ';':
+        lexPunctuation(Semicolon);
+        return;
+    case ':':
+        lexPunctuation(Colon);
+        return;
+    case '.':
+        /// A single dot is the member access operator, a dot followed by
+        /// digits or more dots is a (possibly invalid) floating point literal
+        if (is(peek(1), FloatDigit)) {
+            lexNumber();
         }
         else {
-            id += current();
+            lexOperator();
         }
-    } while (advanceChecked());
-    return std::nullopt;
-}
-
-std::optional<Token> Context::getStringLiteral() {
-    auto beginExpression = [this] { parenNestingDepthStack.push(0); };
-    auto endExpression = [this] { parenNestingDepthStack.pop(); };
-    if (!parenNestingDepthStack.empty() && parenNestingDepthStack.top() == 0) {
-        auto token = getStringLiteralImpl<UnterminatedStringLiteral>(
-            StringLiteralDelim<"\\)">{ {}, endExpression },
-            StringLiteralDelim<R"(\\\()">{ TokenKind::FStringLiteralContinue,
-                                           beginExpression },
-            StringLiteralDelim<"\"">{ TokenKind::FStringLiteralEnd });
-        if (token) {
-            return token;
+        return;
+    case '+':
+    case '-':
+    case '*':
+    case '/':
+    case '%':
+    case '&':
+    case '|':
+    case '^':
+    case '!':
+    case '~':
+    case '=':
+    case '<':
+    case '>':
+    case '?':
+        lexOperator();
+        return;
+    default:
+        if (is(c, DecDigit)) {
+            lexNumber();
+            return;
         }
+        if (is(c, IDBegin)) {
+            lexIdentifier();
+            return;
+        }
+        auto beginLoc = location();
+        ++pos;
+        issues.push<UnexpectedCharacter>(SourceRange{ beginLoc, location() });
+        return;
     }
-    return getStringLiteralImpl<UnterminatedStringLiteral>(
-        StringLiteralDelim<"\"">{},
-        StringLiteralDelim<R"(\\\()">{ TokenKind::FStringLiteralBegin,
-                                       beginExpression },
-        StringLiteralDelim<"\"">{ TokenKind::StringLiteral });
-}
-
-std::optional<Token> Context::getCharLiteral() {
-    auto token = getStringLiteralImpl<UnterminatedCharLiteral>(
-        StringLiteralDelim<"\'">{},
-        StringLiteralDelim<"\'">{ TokenKind::CharLiteral });
-    if (!token) {
-        return std::nullopt;
-    }
-    if (token->id().size() != 1) {
-        issues.push<InvalidCharLiteral>(token->sourceRange());
-    }
-    return token;
-}
-
-std::optional<Token> Context::getBooleanLiteral() {
-    if (auto m = ctre::starts_with<"true">(text)) {
-        return extractToken(m.size(), TokenKind::True);
-    }
-    if (auto m = ctre::starts_with<"false">(text)) {
-        return extractToken(m.size(), TokenKind::False);
-    }
-    return std::nullopt;
 }
 
 static TokenKind idToTokenKind(std::string_view ID) {
@@ -378,55 +284,209 @@ static TokenKind idToTokenKind(std::string_view ID) {
     return itr != map.end() ? itr->second : TokenKind::Identifier;
 }
 
-std::optional<Token> Context::getIdentifier() {
-    if (auto m = ctre::starts_with<"[a-zA-Z_][a-zA-Z0-9_]*">(text)) {
-        return extractToken(m.size(), [](std::string_view ID) {
-            return idToTokenKind(ID);
-        });
-    }
-    return std::nullopt;
+/// Keywords are lower case and at most as long as `reinterpret`, so most
+/// identifiers never reach the keyword table
+static constexpr size_t MaxKeywordSize = 11;
+
+void Context::lexIdentifier() {
+    auto beginLoc = location();
+    size_t begin = pos;
+    do {
+        ++pos;
+    } while (is(peek(), IDContinue));
+    std::string_view ID = text.substr(begin, pos - begin);
+    bool maybeKeyword =
+        ID.size() <= MaxKeywordSize && ID.front() >= 'a' && ID.front() <= 'z';
+    auto kind = maybeKeyword ? idToTokenKind(ID) : TokenKind::Identifier;
+    result.push_back(Token(InternedString(ID), kind, { beginLoc, location() }));
 }
 
-bool Context::advance() {
-    SC_EXPECT(text.size() > 0);
-    if (text.front() == '\n') {
-        currentLocation.column = 0;
-        ++currentLocation.line;
+void Context::lexNumber() {
+    auto beginLoc = location();
+    size_t begin = pos;
+    size_t numDots = 0;
+    while (is(peek(), FloatDigit)) {
+        numDots += text[pos] == '.';
+        ++pos;
+    }
+    /// Literals may be followed by a suffix like `0xFF` or `1.0f`
+    if (is(peek(), IDBegin)) {
+        do {
+            ++pos;
+        } while (is(peek(), IDContinue));
+    }
+    switch (numDots) {
+    case 0:
+        addToken(begin, TokenKind::IntegerLiteral, beginLoc);
+        return;
+    case 1:
+        addToken(begin, TokenKind::FloatLiteral, beginLoc);
+        return;
+    default:
+        using enum InvalidNumericLiteral::Kind;
+        issues.push<InvalidNumericLiteral>(SourceRange{ beginLoc, location() },
+                                           FloatingPoint);
+        return;
     }
-    ++currentLocation.index;
-    ++currentLocation.column;
-    text = text.substr(1);
-    return !text.empty();
 }
 
-bool Context::advance(size_t count) {
-    for (size_t i = 0; i < count; ++i) {
-        if (!advance()) {
-            return false;
+/// Lexes the string or char literal beginning at the current position, which
+/// is the opening delimiter. If \p interpolationKind is set, `\(` also ends
+/// the literal with that token kind and begins an interpolated expression
+template <typename UnterminatedIssue>
+void Context::lexQuoted(SourceLocation beginLoc, char delim,
+                        TokenKind endKind,
+                        std::optional<TokenKind> interpolationKind) {
+    ++pos;
+    size_t const contentBegin = pos;
+    /// Only literals with escape sequences need their own decoded copy of the
+    /// text
+    std::optional<std::string> decoded;
+    auto finish = [&](size_t contentEnd, size_t delimSize, TokenKind kind) {
+        pos = contentEnd + delimSize;
+        SourceRange range{ beginLoc, location() };
+        if (decoded) {
+            result.push_back(
+                Token::MakeOwning(std::move(*decoded), kind, range));
+        }
+        else {
+            auto ID = text.substr(contentBegin, contentEnd - contentBegin);
+            result.push_back(Token(ID, kind, range));
+        }
+    };
+    auto pushUnterminated = [&] {
+        issues.push<UnterminatedIssue>(SourceRange{ beginLoc, location() });
+    };
+    while (true) {
+        char c = peek();
+        if (atEnd() || c == '\n') {
+            pushUnterminated();
+            return;
+        }
+        if (c == delim) {
+            finish(pos, 1, endKind);
+            return;
+        }
+        if (c != '\\') {
+            if (decoded) {
+                decoded->push_back(c);
+            }
+            ++pos;
+            continue;
         }
+        if (interpolationKind && peek(1) == '(') {
+            finish(pos, 2, *interpolationKind);
+            parenNestingDepthStack.push(0);
+            return;
+        }
+        if (!decoded) {
+            decoded.emplace(text.substr(contentBegin, pos - contentBegin));
+        }
+        ++pos;
+        char seq = peek();
+        if (atEnd() || seq == '\n') {
+            pushUnterminated();
+            return;
+        }
+        if (auto value = toEscapeSequence(seq)) {
+            decoded->push_back(*value);
+        }
+        else {
+            SourceRange range{ locationAt(pos - 1), locationAt(pos + 1) };
+            issues.push<InvalidEscapeSequence>(seq, range);
+            decoded->push_back(seq);
+        }
+        ++pos;
     }
-    return true;
 }
 
-std::pair<std::string, SourceLocation> Context::beginToken() const {
-    return { std::string{}, currentLocation };
+void Context::lexCharLiteral() {
+    size_t numTokens = result.size();
+    lexQuoted<UnterminatedCharLiteral>(location(), '\'', TokenKind::CharLiteral,
+                                       std::nullopt);
+    if (result.size() == numTokens) {
+        return;
+    }
+    auto& token = result.back();
+    if (token.id().size() != 1) {
+        issues.push<InvalidCharLiteral>(token.sourceRange());
+    }
 }
 
-Token Context::extractToken(size_t count, TokenKind kind) {
-    return extractToken(count, [&](auto&&) { return kind; });
+void Context::lexPunctuation(TokenKind kind) {
+    auto beginLoc = location();
+    ++pos;
+    addToken(pos - 1, kind, beginLoc);
 }
 
-Token Context::extractToken(size_t count, auto tokenKindFactory) {
-    auto beginLoc = currentLocation;
-    std::string_view ID = text.substr(0, count);
-    advance(count);
-    return Token(std::string(ID), tokenKindFactory(ID),
-                 { beginLoc, currentLocation });
+void Context::lexOperator() {
+    using enum TokenKind;
+    auto beginLoc = location();
+    size_t begin = pos;
+    char next = peek(1);
+    /// Consumes \p size characters and \Returns \p kind
+    auto take = [&](size_t size, TokenKind kind) {
+        pos += size;
+        return kind;
+    };
+    TokenKind kind = [&] {
+        switch (text[pos]) {
+        case '+':
+            return next == '+' ? take(2, Increment) :
+                   next == '=' ? take(2, PlusAssign) :
+                                 take(1, Plus);
+        case '-':
+            return next == '-' ? take(2, Decrement) :
+                   next == '=' ? take(2, MinusAssign) :
+                   next == '>' ? take(2, Arrow) :
+                                 take(1, Minus);
+        case '*':
+            return next == '=' ? take(2, MultipliesAssign) :
+                                 take(1, Multiplies);
+        case '/':
+            return next == '=' ? take(2, DividesAssign) : take(1, Divides);
+        case '%':
+            return next == '=' ? take(2, RemainderAssign) : take(1, Remainder);
+        case '&':
+            return next == '&' ? take(2, LogicalAnd) :
+                   next == '=' ? take(2, AndAssign) :
+                                 take(1, BitAnd);
+        case '|':
+            return next == '|' ? take(2, LogicalOr) :
+                   next == '=' ? take(2, OrAssign) :
+                                 take(1, BitOr);
+        case '^':
+            return next == '=' ? take(2, XOrAssign) : take(1, BitXOr);
+        case '!':
+            return next == '=' ? take(2, Unequal) : take(1, Exclam);
+        case '~':
+            return take(1, Tilde);
+        case '=':
+            return next == '=' ? take(2, Equal) : take(1, Assign);
+        case '<':
+            if (next == '<') {
+                return peek(2) == '=' ? take(3, LeftShiftAssign) :
+                                        take(2, LeftShift);
+            }
+            return next == '=' ? take(2, LessEqual) : take(1, Less);
+        case '>':
+            if (next == '>') {
+                return peek(2) == '=' ? take(3, RightShiftAssign) :
+                                        take(2, RightShift);
+            }
+            return next == '=' ? take(2, GreaterEqual) : take(1, Greater);
+        case '.':
+            return take(1, Dot);
+        case '?':
+            return take(1, Question);
+        default:
+            SC_UNREACHABLE();
+        }
+    }();
+    addToken(begin, kind, beginLoc);
 }
 
-char Context::current() const {
-    if (text.empty()) {
-        return '\0';
-    }
-    return text.front();
+void Context::addToken(size_t begin, TokenKind kind, SourceLocation beginLoc) {
+    result.push_back(
+        Token(text.substr(begin, pos - begin), kind, { beginLoc, location() }));
 }
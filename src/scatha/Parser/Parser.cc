@@ -174,6 +174,7 @@
 #include "AST/AST.h"
 #include "Common/Base.h"
 #include "Common/Expected.h"
+#include "Common/ThreadPool.h"
 #include "Parser/BracketCorrection.h"
 #include "Parser/Lexer.h"
 #include "Parser/Panic.h"
@@ -301,21 +302,55 @@ struct Context {
 
 } // namespace
 
+namespace {
+
+/// Result of lexing and parsing a single source file
+struct FileResult {
+    /// Declared first so that it outlives `ast`
+    std::unique_ptr<ast::NodeArena> arena =
+        std::make_unique<ast::NodeArena>();
+    IssueHandler lexIssues;
+    IssueHandler parseIssues;
+    UniquePtr<ast::SourceFile> ast;
+};
+
+} // namespace
+
 UniquePtr<ast::ASTNode> parser::parse(std::span<SourceFile const> sourceFiles,
                                       IssueHandler& issueHandler) {
+    /// Files are lexed and parsed independently on the thread pool. Each file
+    /// reports to its own issue handlers, which are merged in file order below
+    std::vector<FileResult> results(sourceFiles.size());
+    ThreadPool::global().parallelFor(sourceFiles.size(), [&](size_t index) {
+        auto& file = sourceFiles[index];
+        auto& result = results[index];
+        auto tokens = lex(file.text(), result.lexIssues, index);
+        if (result.lexIssues.haveErrors()) {
+            return;
+        }
+        bracketCorrection(tokens, result.parseIssues);
+        ast::ArenaScope scope(*result.arena);
+        Context ctx{ .tokens = TokenStream(std::move(tokens)),
+                     .filename = file.path().string(),
+                     .issues = result.parseIssues };
+        result.ast = ctx.run();
+    });
+    /// To report the same diagnostics as parsing the files one after another,
+    /// we stop at the first file that is lexed while errors are present and
+    /// discard the results of all files after it
+    utl::small_vector<std::unique_ptr<ast::NodeArena>> arenas;
     utl::small_vector<UniquePtr<ast::SourceFile>> parsedFiles;
-    for (auto [index, file]: sourceFiles | ranges::views::enumerate) {
-        auto tokens = lex(file.text(), issueHandler, index);
+    for (auto& result: results) {
+        issueHandler.append(std::move(result.lexIssues));
         if (issueHandler.haveErrors()) {
             return nullptr;
         }
-        bracketCorrection(tokens, issueHandler);
-        Context ctx{ .tokens = TokenStream(std::move(tokens)),
-                     .filename = file.path().string(),
-                     .issues = issueHandler };
-        parsedFiles.push_back(ctx.run());
+        issueHandler.append(std::move(result.parseIssues));
+        parsedFiles.push_back(std::move(result.ast));
+        arenas.push_back(std::move(result.arena));
     }
-    return allocate<ast::TranslationUnit>(std::move(parsedFiles));
+    return allocate<ast::TranslationUnit>(std::move(parsedFiles),
+                                          std::move(arenas));
 }
 
 UniquePtr<ast::ASTNode> parser::parse(std::string_view source,
@@ -1250,7 +1285,8 @@ UniquePtr<ast::Expression> Context::parseGeneric() {
 
 static UniquePtr<ast::Literal> allocateStringLit(Token const& token,
                                                  ast::LiteralKind kind) {
-    return allocate<ast::Literal>(token.sourceRange(), kind, token.id());
+    return allocate<ast::Literal>(token.sourceRange(), kind,
+                                  std::string(token.id()));
 }
 
 UniquePtr<ast::Expression> Context::parseFString() {
@@ -1346,7 +1382,7 @@ UniquePtr<ast::Identifier> Context::parseID() {
         return nullptr;
     }
     tokens.eat();
-    return allocate<ast::Identifier>(token.sourceRange(), token.id());
+    return allocate<ast::Identifier>(token.sourceRange(), token.interned());
 }
 
 UniquePtr<ast::Identifier> Context::parseExtID() {
@@ -1355,7 +1391,7 @@ UniquePtr<ast::Identifier> Context::parseExtID() {
         return nullptr;
     }
     tokens.eat();
-    return allocate<ast::Identifier>(token.sourceRange(), token.id());
+    return allocate<ast::Identifier>(token.sourceRange(), token.interned());
 }
 
 UniquePtr<ast::Literal> Context::parseLiteral() {
@@ -1602,7 +1638,7 @@ ast::SpecifierList Context::parseSpecList() {
                 return std::nullopt;
             }
             tokens.eat();
-            return ParseResult{ next.id(), sourceRange };
+            return ParseResult{ std::string(next.id()), sourceRange };
         }
         default:
             return std::nullopt;
@@ -77,12 +77,13 @@ APInt Token::toInteger(size_t bitwidth) const {
     SC_ASSERT(kind() == TokenKind::IntegerLiteral,
               "Token is not an integer literal");
     auto value = [&] {
-        if (_id.size() > 2 &&
-            (_id.substr(0, 2) == "0x" || _id.substr(0, 2) == "0X"))
+        auto id = this->id();
+        if (id.size() > 2 &&
+            (id.substr(0, 2) == "0x" || id.substr(0, 2) == "0X"))
         {
-            return APInt::parse(_id.substr(2, _id.size() - 2), 16);
+            return APInt::parse(id.substr(2), 16);
         }
-        return APInt::parse(_id);
+        return APInt::parse(id);
     }();
     SC_ASSERT(value, "Invalid literal value");
     SC_ASSERT(value->bitwidth() <= bitwidth,
@@ -106,7 +107,7 @@ APFloat Token::toFloat() const { return toFloat(APFloatPrec::Double()); }
 APFloat Token::toFloat(APFloatPrec precision) const {
     SC_ASSERT(kind() == TokenKind::FloatLiteral,
               "Token is not a floating point literal");
-    auto const value = APFloat::parse(_id, precision);
+    auto const value = APFloat::parse(id(), precision);
     SC_ASSERT(value, "Invalid literal value");
     return *value;
 }
@@ -19,6 +19,13 @@ public:
     AnalysisContext(SymbolTable& sym, IssueHandler& issueHandler):
         sym(&sym), iss(&issueHandler) {}
 
+    /// Creates a context to analyze function bodies concurrently with other
+    /// threads. Functions that have been analyzed in \p parent are considered
+    /// analyzed in this context. \p parent must not be modified while this
+    /// context is alive
+    AnalysisContext(AnalysisContext const& parent, IssueHandler& issueHandler):
+        sym(parent.sym), iss(&issueHandler), parent(&parent) {}
+
     /// \Returns the symbol table of this context
     SymbolTable& symbolTable() const& { return *sym; }
 
@@ -47,9 +54,10 @@ public:
         return currentlyAnalyzedFunctions.contains(function);
     }
 
-    /// \Returns `true` if \p function is currently being analyzed
-    bool isAnalyzed(Function const* function) {
-        return analyzedFunctions.contains(function);
+    /// \Returns `true` if \p function has been analyzed
+    bool isAnalyzed(Function const* function) const {
+        return analyzedFunctions.contains(function) ||
+               (parent && parent->isAnalyzed(function));
     }
     /// @}
 
@@ -75,6 +83,7 @@ public:
 private:
     SymbolTable* sym;
     IssueHandler* iss;
+    AnalysisContext const* parent = nullptr;
     utl::hashset<Function const*> analyzedFunctions;
     utl::hashset<Function const*> currentlyAnalyzedFunctions;
 };
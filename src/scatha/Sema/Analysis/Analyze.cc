@@ -1,6 +1,9 @@
 #include "Sema/Analyze.h"
 
+#include <vector>
+
 #include "AST/AST.h"
+#include "Common/ThreadPool.h"
 #include "Sema/Analysis/AnalysisContext.h"
 #include "Sema/Analysis/GatherNames.h"
 #include "Sema/Analysis/Instantiation.h"
@@ -11,6 +14,50 @@
 using namespace scatha;
 using namespace sema;
 
+/// \Returns `true` if \p decl is a function definition with a declared return
+/// type. The bodies of such functions are independent of the bodies of all
+/// other functions
+static bool isIndependent(ast::Declaration const* decl) {
+    auto* def = dyncast<ast::FunctionDefinition const*>(decl);
+    return def && def->function() && def->function()->returnType();
+}
+
+/// Analyzes the global declarations \p globals. Functions with deduced return
+/// types are analyzed on demand by their callers, so we analyze them and all
+/// other dependent declarations first on the calling thread. Then we analyze
+/// the independent function bodies concurrently. Each of these gets its own
+/// issue handler. Because dependent declarations are analyzed first, we sort
+/// the merged issues by source location, so the diagnostics appear in source
+/// order and don't depend on scheduling
+static void analyzeGlobals(AnalysisContext& ctx,
+                           std::span<ast::Declaration* const> globals) {
+    auto& sym = ctx.symbolTable();
+    size_t const firstIssue = ctx.issueHandler().size();
+    std::vector<ast::Declaration*> independent;
+    for (auto* decl: globals) {
+        if (isIndependent(decl)) {
+            independent.push_back(decl);
+            continue;
+        }
+        sym.withScopeCurrent(decl->entity()->parent(),
+                             [&] { analyzeStatement(ctx, decl); });
+    }
+    std::vector<IssueHandler> issues(independent.size());
+    sym.beginConcurrentAnalysis();
+    ThreadPool::global().parallelFor(independent.size(), [&](size_t index) {
+        auto* decl = independent[index];
+        SymbolTable::LocalState localState(sym, issues[index]);
+        AnalysisContext localCtx(ctx, issues[index]);
+        sym.withScopeCurrent(decl->entity()->parent(),
+                             [&] { analyzeStatement(localCtx, decl); });
+    });
+    sym.endConcurrentAnalysis();
+    for (auto& localIssues: issues) {
+        ctx.issueHandler().append(std::move(localIssues));
+    }
+    ctx.issueHandler().sortBySourceLocation(firstIssue);
+}
+
 AnalysisResult sema::analyze(ast::ASTNode& TU, SymbolTable& sym,
                              IssueHandler& iss,
                              AnalysisOptions const& options) {
@@ -19,10 +66,7 @@ AnalysisResult sema::analyze(ast::ASTNode& TU, SymbolTable& sym,
     AnalysisContext ctx(sym, iss);
     auto names = gatherNames(TU, ctx);
     auto structs = instantiateEntities(ctx, names.structs, names.globals);
-    for (auto* decl: names.globals) {
-        sym.withScopeCurrent(decl->entity()->parent(),
-                             [&] { analyzeStatement(ctx, decl); });
-    }
+    analyzeGlobals(ctx, names.globals);
     for (auto* recordType: structs) {
         analyzeProtocolConformance(ctx, const_cast<RecordType&>(*recordType));
     }
@@ -732,9 +732,9 @@ static bool isMemberAccessRHS(ast::Expression const& expr) {
 utl::small_vector<Entity*> ExprContext::findEntities(ast::Identifier& idExpr) {
     auto* scope = findMALookupScope(idExpr);
     if (!scope) {
-        return sym.unqualifiedLookup(idExpr.value());
+        return sym.unqualifiedLookup(idExpr.interned());
     }
-    auto entities = scope->findEntities(idExpr.value()) | ToSmallVector<>;
+    auto entities = scope->findEntities(idExpr.interned()) | ToSmallVector<>;
     if (!entities.empty()) {
         return entities;
     }
@@ -744,7 +744,7 @@ utl::small_vector<Entity*> ExprContext::findEntities(ast::Identifier& idExpr) {
     }
     for (auto* base: record->baseTypes()) {
         auto baseEntities =
-            const_cast<RecordType*>(base)->findEntities(idExpr.value());
+            const_cast<RecordType*>(base)->findEntities(idExpr.interned());
         entities.insert(entities.end(), baseEntities.begin(),
                         baseEntities.end());
     }
@@ -217,6 +217,7 @@ void StmtContext::importUnscopedSymbols(ast::ImportStatement& stmt) {
     SC_EXPECT(stmt.importKind() == ImportKind::Unscoped);
     if (auto* ID = dyncast<ast::Identifier*>(stmt.libExpr())) {
         auto& lib = cast<NativeLibrary&>(*stmt.library());
+        lib.loadAllSymbols();
         for (auto* entity: lib.entities()) {
             sym.declareAlias(*entity, ID, AccessControl::Private);
         }
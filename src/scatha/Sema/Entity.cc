@@ -1,6 +1,9 @@
 #include "Sema/Entity.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 
 #include <range/v3/algorithm.hpp>
@@ -39,7 +42,7 @@ Entity::Entity(EntityType entityType, std::string name, Scope* parent,
                ast::ASTNode* astNode):
     _entityType(entityType),
     _parent(parent),
-    _name(std::move(name)),
+    _name(name),
     _astNode(astNode) {}
 
 void Entity::setParent(Scope* parent) { _parent = parent; }
@@ -131,20 +134,40 @@ Scope::Scope(EntityType entityType, ScopeKind kind, std::string name,
              Scope* parent, ast::ASTNode* astNode):
     Entity(entityType, std::move(name), parent, astNode), _kind(kind) {}
 
+/// Names that have never been interned can't name any entity
 utl::small_ptr_vector<Entity*> Scope::findEntities(std::string_view name,
                                                    bool findHidden) {
-    return findEntitiesImpl<Entity>(this, name, findHidden);
+    auto interned = InternedString::find(name);
+    return interned ? findEntities(*interned, findHidden) :
+                      utl::small_ptr_vector<Entity*>{};
 }
 
 utl::small_ptr_vector<Entity const*> Scope::findEntities(
     std::string_view name, bool findHidden) const {
+    auto interned = InternedString::find(name);
+    return interned ? findEntities(*interned, findHidden) :
+                      utl::small_ptr_vector<Entity const*>{};
+}
+
+utl::small_ptr_vector<Entity*> Scope::findEntities(InternedString name,
+                                                   bool findHidden) {
+    return findEntitiesImpl<Entity>(this, name, findHidden);
+}
+
+utl::small_ptr_vector<Entity const*> Scope::findEntities(
+    InternedString name, bool findHidden) const {
     return findEntitiesImpl<Entity const>(this, name, findHidden);
 }
 
 template <typename E, typename S>
 utl::small_ptr_vector<E*> Scope::findEntitiesImpl(S* self,
-                                                  std::string_view name,
+                                                  InternedString name,
                                                   bool findHidden) {
+    /// Must happen before we lock because loading declares entities
+    if (auto* lib = dyncast<NativeLibrary const*>(self)) {
+        lib->loadSymbols(name);
+    }
+    std::shared_lock lock(self->_mutex);
     auto itr = self->_names.find(name);
     if (itr == self->_names.end()) {
         return {};
@@ -158,6 +181,7 @@ utl::small_ptr_vector<E*> Scope::findEntitiesImpl(S* self,
 }
 
 Property const* Scope::findProperty(PropertyKind kind) const {
+    std::shared_lock lock(_mutex);
     auto const itr = _properties.find(kind);
     return itr == _properties.end() ? nullptr : itr->second;
 }
@@ -183,6 +207,7 @@ utl::small_vector<Function const*> Scope::findFunctions(
 void Scope::addChild(Entity* entity) {
     SC_ASSERT(entity->parent() == nullptr || entity->parent() == this,
               "entity already has a parent");
+    std::lock_guard lock(_mutex);
     entity->setParent(this);
     /// Each scope that we add we add to to our list of child scopes
     if (auto* scope = dyncast<Scope*>(entity)) {
@@ -197,7 +222,7 @@ void Scope::addChild(Entity* entity) {
     /// We add the entity to our own symbol table
     /// We don't add anonymous entities because entities are keyed by their name
     if (!entity->isAnonymous()) {
-        auto& entities = _names[entity->name()];
+        auto& entities = _names[entity->internedName()];
         SC_ASSERT(!ranges::contains(entities, entity),
                   "entity already is our child");
         entities.push_back(entity);
@@ -206,6 +231,7 @@ void Scope::addChild(Entity* entity) {
 
 void Scope::removeChild(Entity* entity) {
     /// This function is basically the reverse of `addChild()`
+    std::lock_guard lock(_mutex);
     if (auto* scope = dyncast<Scope const*>(entity)) {
         _children.erase(scope);
     }
@@ -213,7 +239,7 @@ void Scope::removeChild(Entity* entity) {
         _properties.erase(prop->kind());
     }
     if (!entity->isAnonymous()) {
-        auto& entities = _names[entity->name()];
+        auto& entities = _names[entity->internedName()];
         auto itr = ranges::find(entities, entity);
         SC_ASSERT(itr != entities.end(), "entity is not a child");
         entities.erase(itr);
@@ -221,6 +247,39 @@ void Scope::removeChild(Entity* entity) {
     entity->setParent(nullptr);
 }
 
+void Scope::canonicalizeOrder(utl::hashset<Entity const*> const& added) {
+    std::lock_guard lock(_mutex);
+    utl::small_vector<Entity*> order;
+    utl::small_vector<Entity*> late;
+    auto append = [&](Entity* entity) {
+        (added.contains(entity) ? late : order).push_back(entity);
+    };
+    for (auto* entity: entities()) {
+        append(entity);
+    }
+    /// Named scopes are also listed among the entities
+    for (auto* scope: children()) {
+        if (scope->isAnonymous()) {
+            append(scope);
+        }
+    }
+    std::stable_sort(late.begin(), late.end(), [](auto* a, auto* b) {
+        return a->name() < b->name();
+    });
+    order.insert(order.end(), late.begin(), late.end());
+    /// Properties are keyed by their kind and don't need to be reordered
+    _children.clear();
+    _names.clear();
+    for (auto* entity: order) {
+        if (auto* scope = dyncast<Scope*>(entity)) {
+            _children.insert(scope);
+        }
+        if (!entity->isAnonymous()) {
+            _names[entity->internedName()].push_back(entity);
+        }
+    }
+}
+
 AnonymousScope::AnonymousScope(ScopeKind scopeKind, Scope* parent):
     Scope(EntityType::AnonymousScope, scopeKind, std::string{}, parent) {}
 
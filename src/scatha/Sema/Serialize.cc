@@ -1,5 +1,7 @@
 #include "Sema/Serialize.h"
 
+#include <array>
+#include <atomic>
 #include <charconv>
 #include <functional>
 #include <istream>
@@ -12,6 +14,8 @@
 #include <range/v3/view.hpp>
 #include <utl/function_view.hpp>
 
+#include "Common/BinaryIO.h"
+#include "Common/InternedString.h"
 #include "Common/Utility.h"
 #include "Sema/Analysis/Utility.h"
 #include "Sema/Entity.h"
@@ -515,9 +519,60 @@ struct FieldToType;
 
 #endif
 
-struct Serializer {
+/// Base class of the JSON and binary serializers that collects the libraries
+/// that the serialized symbols depend on
+struct DependencyCollector {
     utl::hashset<NativeLibrary const*> nativeDependencies;
     utl::hashset<ForeignLibrary const*> foreignDependencies;
+
+    void gatherLibraryDependencies(Type const& type) {
+        visit(type, [&](auto const& type) { gatherLibDepsImpl(type); });
+    }
+
+    void gatherLibDepsImpl(FunctionType const& type) {
+        for (auto* argType: type.argumentTypes()) {
+            gatherLibraryDependencies(*argType);
+        }
+        gatherLibraryDependencies(*type.returnType());
+    }
+
+    void gatherLibDepsImpl(RecordType const& type) {
+        if (auto* lib = parentLibrary(type)) {
+            nativeDependencies.insert(lib);
+        }
+    }
+
+    void gatherLibDepsImpl(BuiltinType const&) {}
+
+    void gatherLibDepsImpl(ArrayType const& type) {
+        gatherLibraryDependencies(*type.elementType());
+    }
+
+    void gatherLibDepsImpl(PointerType const& type) {
+        gatherLibraryDependencies(*type.base());
+    }
+
+    void gatherLibDepsImpl(ReferenceType const& type) {
+        gatherLibraryDependencies(*type.base());
+    }
+
+    static NativeLibrary const* parentLibrary(Entity const& entity) {
+        SC_EXPECT(!isa<GlobalScope>(entity));
+        auto* parent = entity.parent();
+        while (true) {
+            SC_ASSERT(parent, "Ill-formed symbol table");
+            if (auto* lib = dyncast<NativeLibrary const*>(parent)) {
+                return lib;
+            }
+            if (isa<FileScope>(parent) || isa<GlobalScope>(parent)) {
+                return nullptr;
+            }
+            parent = parent->parent();
+        }
+    }
+};
+
+struct Serializer: DependencyCollector {
     utl::hashmap<Entity const*, size_t> entityIDMap;
     size_t IDCounter = 0;
 
@@ -658,52 +713,6 @@ struct Serializer {
         }
         return j;
     }
-
-    void gatherLibraryDependencies(Type const& type) {
-        visit(type, [&](auto const& type) { gatherLibDepsImpl(type); });
-    }
-
-    void gatherLibDepsImpl(FunctionType const& type) {
-        for (auto* argType: type.argumentTypes()) {
-            gatherLibraryDependencies(*argType);
-        }
-        gatherLibraryDependencies(*type.returnType());
-    }
-
-    void gatherLibDepsImpl(RecordType const& type) {
-        if (auto* lib = parentLibrary(type)) {
-            nativeDependencies.insert(lib);
-        }
-    }
-
-    void gatherLibDepsImpl(BuiltinType const&) {}
-
-    void gatherLibDepsImpl(ArrayType const& type) {
-        gatherLibraryDependencies(*type.elementType());
-    }
-
-    void gatherLibDepsImpl(PointerType const& type) {
-        gatherLibraryDependencies(*type.base());
-    }
-
-    void gatherLibDepsImpl(ReferenceType const& type) {
-        gatherLibraryDependencies(*type.base());
-    }
-
-    static NativeLibrary const* parentLibrary(Entity const& entity) {
-        SC_EXPECT(!isa<GlobalScope>(entity));
-        auto* parent = entity.parent();
-        while (true) {
-            SC_ASSERT(parent, "Ill-formed symbol table");
-            if (auto* lib = dyncast<NativeLibrary const*>(parent)) {
-                return lib;
-            }
-            if (isa<FileScope>(parent) || isa<GlobalScope>(parent)) {
-                return nullptr;
-            }
-            parent = parent->parent();
-        }
-    }
 };
 
 } // namespace
@@ -1082,3 +1091,757 @@ bool sema::deserialize(SymbolTable& sym, std::istream& istream) {
 bool sema::deserialize(SymbolTable& sym, std::string_view text) {
     return deserializeImpl(sym, [&] { return json::parse(text); });
 }
+
+/// MARK: - Binary format
+
+/// # Format
+///
+/// All integers are LEB128 encoded. A symbol table is encoded as
+///
+///     Magic "SCSY", FormatVersion
+///     Strings:      count, { length, bytes }
+///     Dependencies: count, { native library name },
+///                   count, { foreign library name }
+///     Entries:      count, { name, offset }
+///     IDs:          count, { entry index }
+///     Body:         bytes
+///
+/// Every serialized entity in the global scope is an entry. Entries are encoded
+/// recursively with their children and loaded as a whole. Each serialized
+/// entity has an ID that maps to the entry containing it, so references
+/// between entries can be resolved by loading the referenced entry. Types are
+/// referenced by their serialized typename.
+
+namespace {
+
+constexpr std::array<char, 4> BinaryMagic = { 'S', 'C', 'S', 'Y' };
+
+/// Must be incremented whenever the encoding changes
+constexpr uint64_t BinaryFormatVersion = 1;
+
+constexpr size_t NumEntityTypes = (size_t)EntityType::LAST + 1;
+
+constexpr size_t NumAccessControls = 0
+#define SC_SEMA_ACCESS_CONTROL_DEF(...) +1
+#include "Sema/Lists.def.h"
+    ;
+
+/// \Returns `true` if \p entity is written to serialized symbol tables.
+/// Must agree with the `serializeImpl()` overloads of the JSON serializer
+bool isSerialized(Entity const* entity) {
+    // clang-format off
+    return SC_MATCH (*entity) {
+        [](Function const& function) { return !function.isBuiltin(); },
+        [](RecordType const&) { return true; },
+        [](Variable const&) { return true; },
+        [](BaseClassObject const&) { return true; },
+        [](Entity const&) { return false; },
+    }; // clang-format on
+}
+
+struct BinarySerializer: DependencyCollector {
+    ByteWriter strings, entries, ids, body;
+    size_t numStrings = 0;
+    utl::hashmap<std::string, size_t> stringIndices;
+    utl::hashmap<Entity const*, size_t> IDs;
+    utl::small_vector<size_t> IDEntries;
+
+    void run(GlobalScope const& global, std::ostream& ostream);
+    size_t string(std::string_view text);
+    size_t typeName(Type const* type) { return string(serializeTypename(type)); }
+    void assignIDs(Entity const& entity, size_t entryIndex);
+    void writeID(Entity const* entity);
+    void write(Entity const& entity);
+    void writeImpl(Function const& function);
+    void writeImpl(RecordType const& type);
+    void writeImpl(Variable const& var);
+    void writeImpl(BaseClassObject const& base);
+    void writeImpl(Entity const&) { SC_UNREACHABLE(); }
+    void writeVTable(VTable const& vtable);
+    void writeLifetime(LifetimeMetadata const& md);
+};
+
+} // namespace
+
+void sema::serializeBinary(SymbolTable const& sym, std::ostream& ostream) {
+    BinarySerializer{}.run(sym.globalScope(), ostream);
+}
+
+void BinarySerializer::run(GlobalScope const& global, std::ostream& ostream) {
+    string({});
+    auto topLevel =
+        global.entities() | filter(isSerialized) | ToSmallVector<>;
+    /// IDs are assigned up front because vtables may reference entities that
+    /// are written later
+    for (auto [index, entity]: topLevel | enumerate) {
+        assignIDs(*entity, index);
+    }
+    entries.varint(topLevel.size());
+    for (auto* entity: topLevel) {
+        entries.varint(string(entity->name()));
+        entries.varint(body.size());
+        write(*entity);
+    }
+    ids.varint(IDEntries.size());
+    for (size_t entry: IDEntries) {
+        ids.varint(entry);
+    }
+    for (auto* lib: global.children() | Filter<ForeignLibrary>) {
+        foreignDependencies.insert(lib);
+    }
+    ByteWriter deps;
+    deps.varint(nativeDependencies.size());
+    for (auto* lib: nativeDependencies) {
+        deps.varint(string(lib->name()));
+    }
+    deps.varint(foreignDependencies.size());
+    for (auto* lib: foreignDependencies) {
+        deps.varint(string(lib->name()));
+    }
+    ByteWriter header;
+    header.bytes(std::string_view(BinaryMagic.data(), BinaryMagic.size()));
+    header.varint(BinaryFormatVersion);
+    header.varint(numStrings);
+    for (auto* section: { &header, &strings, &deps, &entries, &ids, &body }) {
+        ostream.write(section->data().data(),
+                      static_cast<std::streamsize>(section->size()));
+    }
+}
+
+size_t BinarySerializer::string(std::string_view text) {
+    auto [itr, success] =
+        stringIndices.insert({ std::string(text), numStrings });
+    if (success) {
+        ++numStrings;
+        strings.varint(text.size());
+        strings.bytes(text);
+    }
+    return itr->second;
+}
+
+void BinarySerializer::assignIDs(Entity const& entity, size_t entryIndex) {
+    IDs.insert({ &entity, IDEntries.size() });
+    IDEntries.push_back(entryIndex);
+    if (auto* type = dyncast<RecordType const*>(&entity)) {
+        for (auto* child: type->entities() | filter(isSerialized)) {
+            assignIDs(*child, entryIndex);
+        }
+    }
+}
+
+void BinarySerializer::writeID(Entity const* entity) {
+    /// Zero denotes an entity that is not part of this symbol table
+    auto itr = IDs.find(entity);
+    body.varint(itr != IDs.end() ? itr->second + 1 : 0);
+}
+
+void BinarySerializer::write(Entity const& entity) {
+    body.enumValue(entity.entityType());
+    body.varint(string(entity.name()));
+    body.enumValue(entity.accessControl());
+    writeID(&entity);
+    visit(entity, [&](auto const& entity) { writeImpl(entity); });
+}
+
+void BinarySerializer::writeImpl(Function const& function) {
+    body.varint(typeName(function.returnType()));
+    body.varint(function.argumentCount());
+    for (auto* argType: function.argumentTypes()) {
+        body.varint(typeName(argType));
+    }
+    body.enumValue(function.kind());
+    body.u8(function.isAbstract());
+    auto address = function.binaryAddress();
+    body.varint(address ? *address + 1 : 0);
+    gatherLibraryDependencies(*function.type());
+}
+
+void BinarySerializer::writeImpl(RecordType const& type) {
+    if (isa<StructType>(type)) {
+        body.varint(type.size());
+        body.varint(type.align());
+        writeLifetime(type.lifetimeMetadata());
+    }
+    body.u8(type.isEmpty());
+    body.u8(type.vtable() != nullptr);
+    if (auto* vtable = type.vtable()) {
+        writeVTable(*vtable);
+    }
+    auto children = type.entities() | filter(isSerialized) | ToSmallVector<>;
+    body.varint(children.size());
+    for (auto* child: children) {
+        write(*child);
+    }
+}
+
+void BinarySerializer::writeImpl(Variable const& var) {
+    body.varint(typeName(var.type()));
+    body.u8(var.isMut());
+    body.varint(isa<StructType>(var.parent()) ? var.index() + 1 : 0);
+    gatherLibraryDependencies(*var.type());
+}
+
+void BinarySerializer::writeImpl(BaseClassObject const& base) {
+    body.varint(typeName(base.type()));
+    body.varint(base.index());
+    gatherLibraryDependencies(*base.type());
+}
+
+void BinarySerializer::writeVTable(VTable const& vtable) {
+    body.varint(vtable.position());
+    writeID(vtable.correspondingType());
+    auto inherited = vtable.sortedInheritedVTables();
+    body.varint(inherited.size());
+    for (auto* other: inherited) {
+        writeVTable(*other);
+    }
+    body.varint(vtable.layout().size());
+    for (auto* F: vtable.layout()) {
+        writeID(F);
+    }
+}
+
+void BinarySerializer::writeLifetime(LifetimeMetadata const& md) {
+    for (auto op: EnumRange<SMFKind>()) {
+        auto& lifetimeOp = md.operation(op);
+        body.enumValue(lifetimeOp.kind());
+        auto* F = lifetimeOp.function();
+        body.u8(F != nullptr);
+        if (F) {
+            body.varint(string(F->name()));
+            body.varint(typeName(F->type()));
+        }
+    }
+}
+
+namespace {
+
+/// Lifetime operation as read from the binary format. The function is resolved
+/// once the functions of the type have been declared
+struct LifetimeOpData {
+    LifetimeOperation::Kind kind;
+    std::optional<std::pair<std::string_view, std::string_view>> function;
+};
+
+/// VTable as read from the binary format. Resolved after all entries that are
+/// loaded together have been declared
+struct VTableData {
+    RecordType* type;
+    size_t position;
+    size_t correspondingTypeID;
+    std::vector<VTableData> inherited;
+    utl::small_vector<size_t> layout;
+};
+
+/// Load state of an entry
+enum class EntryState : uint8_t { Pending, Loading, Loaded };
+
+/// We declare entities in two passes. The first declares all record types of
+/// an entry, the second declares everything else. This way functions and
+/// variables can refer to any type of the entry
+enum class Pass { Declare, Define };
+
+} // namespace
+
+/// The index only refers to the data, so it can be shared by all symbol
+/// tables that import the same library
+struct LazySymbolTable::Index {
+    std::shared_ptr<std::vector<unsigned char> const> data;
+    std::vector<std::string_view> strings;
+    utl::small_vector<std::string_view> nativeDependencies;
+    utl::small_vector<std::string_view> foreignDependencies;
+    std::vector<std::string_view> entryNames;
+    std::vector<size_t> entryOffsets;
+    std::vector<size_t> IDEntries;
+    size_t bodyBegin = 0;
+
+    void read();
+
+    std::string_view string(ByteReader& in) const {
+        return strings[in.index(strings.size())];
+    }
+};
+
+struct LazySymbolTable::Impl {
+    std::shared_ptr<Index const> index;
+    utl::hashmap<InternedString, utl::small_vector<size_t, 1>> nameIndex;
+    std::unique_ptr<std::atomic<EntryState>[]> entryStates;
+    std::vector<Entity*> IDEntities;
+
+    /// Nesting depth of `run()`. Loads are nested when declaring an entity
+    /// looks up a symbol of the same library
+    size_t depth = 0;
+    std::vector<VTableData> pendingVTables;
+    std::vector<size_t> loadedEntries;
+
+    void open();
+    bool run(SymbolTable& sym, auto load);
+    void finish(SymbolTable& sym);
+    void loadEntries(SymbolTable& sym, std::span<size_t const> entries);
+    void readEntity(SymbolTable& sym, ByteReader& in, Pass pass);
+    void readFunction(SymbolTable& sym, ByteReader& in, Pass pass,
+                      std::string_view name, AccessControl access, size_t ID);
+    void readRecord(SymbolTable& sym, ByteReader& in, Pass pass,
+                    EntityType entityType, std::string_view name,
+                    AccessControl access, size_t ID);
+    void readVariable(SymbolTable& sym, ByteReader& in, Pass pass,
+                      std::string_view name, AccessControl access, size_t ID);
+    void readBaseClass(SymbolTable& sym, ByteReader& in, Pass pass,
+                       AccessControl access, size_t ID);
+    VTableData readVTable(ByteReader& in);
+    std::array<LifetimeOpData, 4> readLifetime(ByteReader& in);
+    LifetimeMetadata makeLifetime(SymbolTable& sym, ObjectType* parent,
+                                  std::array<LifetimeOpData, 4> const& ops);
+    std::unique_ptr<VTable> makeVTable(SymbolTable& sym,
+                                       VTableData const& data);
+
+    std::string_view string(ByteReader& in) { return index->string(in); }
+
+    Type const* type(SymbolTable& sym, ByteReader& in) {
+        return parseTypename(sym, string(in));
+    }
+
+    void registerEntity(size_t ID, Entity* entity) {
+        if (!entity) {
+            throw BinaryFormatError{};
+        }
+        IDEntities[ID] = entity;
+    }
+
+    /// \Returns the entity with ID \p ID and loads its entry if necessary
+    template <typename T>
+    T* entityByID(SymbolTable& sym, size_t ID) {
+        if (ID == 0 || ID > index->IDEntries.size()) {
+            throw BinaryFormatError{};
+        }
+        --ID;
+        if (!IDEntities[ID]) {
+            loadEntries(sym, std::span(&index->IDEntries[ID], 1));
+        }
+        auto* entity = IDEntities[ID];
+        auto* result = entity ? dyncast<T*>(entity) : nullptr;
+        if (!result) {
+            throw BinaryFormatError{};
+        }
+        return result;
+    }
+};
+
+LazySymbolTable::LazySymbolTable(std::unique_ptr<Impl> impl):
+    impl(std::move(impl)) {}
+
+LazySymbolTable::~LazySymbolTable() = default;
+
+std::shared_ptr<LazySymbolTable::Index const> LazySymbolTable::ReadIndex(
+    std::shared_ptr<std::vector<unsigned char> const> data) {
+    SC_EXPECT(data);
+    auto index = std::make_shared<Index>();
+    index->data = std::move(data);
+    try {
+        index->read();
+    }
+    catch (BinaryFormatError const&) {
+        return nullptr;
+    }
+    return index;
+}
+
+std::unique_ptr<LazySymbolTable> LazySymbolTable::FromIndex(
+    std::shared_ptr<Index const> index) {
+    if (!index) {
+        return nullptr;
+    }
+    auto impl = std::make_unique<Impl>();
+    impl->index = std::move(index);
+    impl->open();
+    return std::unique_ptr<LazySymbolTable>(
+        new LazySymbolTable(std::move(impl)));
+}
+
+std::unique_ptr<LazySymbolTable> LazySymbolTable::Open(
+    std::vector<unsigned char> data) {
+    return FromIndex(ReadIndex(
+        std::make_shared<std::vector<unsigned char> const>(std::move(data))));
+}
+
+void LazySymbolTable::Index::read() {
+    ByteReader in(*data);
+    auto magic = std::string_view(BinaryMagic.data(), BinaryMagic.size());
+    if (in.bytes(magic.size()) != magic ||
+        in.varint() != BinaryFormatVersion)
+    {
+        throw BinaryFormatError{};
+    }
+    size_t numStrings = in.count();
+    strings.reserve(numStrings);
+    for (size_t i = 0; i < numStrings; ++i) {
+        strings.push_back(in.bytes(in.varint()));
+    }
+    for (auto* deps: { &nativeDependencies, &foreignDependencies }) {
+        size_t count = in.count();
+        for (size_t i = 0; i < count; ++i) {
+            deps->push_back(string(in));
+        }
+    }
+    size_t numEntries = in.count();
+    entryNames.reserve(numEntries);
+    entryOffsets.reserve(numEntries);
+    for (size_t index = 0; index < numEntries; ++index) {
+        entryNames.push_back(string(in));
+        entryOffsets.push_back(in.varint());
+    }
+    size_t numIDs = in.count();
+    IDEntries.reserve(numIDs);
+    for (size_t i = 0; i < numIDs; ++i) {
+        IDEntries.push_back(in.index(numEntries));
+    }
+    bodyBegin = in.position();
+}
+
+void LazySymbolTable::Impl::open() {
+    auto& names = index->entryNames;
+    entryStates = std::make_unique<std::atomic<EntryState>[]>(names.size());
+    for (size_t entry = 0; entry < names.size(); ++entry) {
+        /// Names are interned so lookups of names that have not been declared
+        /// yet find them. We intern them here and not in the index, because
+        /// interned strings may not outlive the compilation
+        nameIndex[InternedString(names[entry])].push_back(entry);
+    }
+    IDEntities.resize(index->IDEntries.size());
+}
+
+void LazySymbolTable::loadDependencies(SymbolTable& sym) {
+    utl::hashset<Library*> dependencies;
+    for (auto name: impl->index->foreignDependencies) {
+        dependencies.insert(sym.importForeignLib(name));
+    }
+    for (auto name: impl->index->nativeDependencies) {
+        dependencies.insert(sym.importNativeLib(name));
+    }
+    if (auto* lib = dyncast<Library*>(&sym.currentScope())) {
+        lib->setDependencies(dependencies.values());
+    }
+}
+
+bool LazySymbolTable::isPending(InternedString name) const {
+    auto itr = impl->nameIndex.find(name);
+    if (itr == impl->nameIndex.end()) {
+        return false;
+    }
+    return ranges::any_of(itr->second, [&](size_t entry) {
+        return impl->entryStates[entry].load(std::memory_order_acquire) !=
+               EntryState::Loaded;
+    });
+}
+
+bool LazySymbolTable::load(SymbolTable& sym, InternedString name) {
+    auto itr = impl->nameIndex.find(name);
+    if (itr == impl->nameIndex.end()) {
+        return true;
+    }
+    return impl->run(sym, [&] { impl->loadEntries(sym, itr->second); });
+}
+
+bool LazySymbolTable::loadAll(SymbolTable& sym) {
+    auto entries = iota(size_t{ 0 }, impl->index->entryOffsets.size()) |
+                   ranges::to<std::vector>;
+    return impl->run(sym, [&] { impl->loadEntries(sym, entries); });
+}
+
+bool LazySymbolTable::Impl::run(SymbolTable& sym, auto load) {
+    ++depth;
+    try {
+        load();
+        /// References between entries are resolved when the outermost load
+        /// completes, because the referenced entries may still be loading
+        if (depth == 1) {
+            finish(sym);
+        }
+    }
+    catch (BinaryFormatError const&) {
+        --depth;
+        return false;
+    }
+    catch (std::exception const&) {
+        --depth;
+        return false;
+    }
+    --depth;
+    return true;
+}
+
+void LazySymbolTable::Impl::finish(SymbolTable& sym) {
+    /// Resolving vtables may load further entries which may add vtables
+    for (size_t i = 0; i < pendingVTables.size(); ++i) {
+        auto data = std::move(pendingVTables[i]);
+        data.type->setVTable(makeVTable(sym, data));
+    }
+    pendingVTables.clear();
+    for (size_t entry: loadedEntries) {
+        entryStates[entry].store(EntryState::Loaded, std::memory_order_release);
+    }
+    loadedEntries.clear();
+}
+
+/// Entries that are loaded together are declared before any of them is
+/// defined, so they may refer to each other's types
+void LazySymbolTable::Impl::loadEntries(SymbolTable& sym,
+                                        std::span<size_t const> entries) {
+    utl::small_vector<size_t> declared;
+    ByteReader in(std::span(*index->data).subspan(index->bodyBegin));
+    for (size_t entry: entries) {
+        auto& state = entryStates[entry];
+        if (state.load(std::memory_order_relaxed) != EntryState::Pending) {
+            continue;
+        }
+        state.store(EntryState::Loading, std::memory_order_relaxed);
+        in.seek(index->entryOffsets[entry]);
+        readEntity(sym, in, Pass::Declare);
+        declared.push_back(entry);
+    }
+    for (size_t entry: declared) {
+        in.seek(index->entryOffsets[entry]);
+        readEntity(sym, in, Pass::Define);
+        loadedEntries.push_back(entry);
+    }
+}
+
+void LazySymbolTable::Impl::readEntity(SymbolTable& sym, ByteReader& in,
+                                       Pass pass) {
+    auto entityType = in.enumValue<EntityType>(NumEntityTypes);
+    auto name = string(in);
+    auto access = in.enumValue<AccessControl>(NumAccessControls);
+    size_t ID = in.index(index->IDEntries.size() + 1);
+    if (ID == 0) {
+        throw BinaryFormatError{};
+    }
+    --ID;
+    switch (entityType) {
+    case EntityType::Function:
+        readFunction(sym, in, pass, name, access, ID);
+        break;
+    case EntityType::StructType:
+        [[fallthrough]];
+    case EntityType::ProtocolType:
+        readRecord(sym, in, pass, entityType, name, access, ID);
+        break;
+    case EntityType::Variable:
+        readVariable(sym, in, pass, name, access, ID);
+        break;
+    case EntityType::BaseClassObject:
+        readBaseClass(sym, in, pass, access, ID);
+        break;
+    default:
+        throw BinaryFormatError{};
+    }
+}
+
+void LazySymbolTable::Impl::readFunction(SymbolTable& sym, ByteReader& in,
+                                         Pass pass, std::string_view name,
+                                         AccessControl access, size_t ID) {
+    auto retTypeName = string(in);
+    size_t argCount = in.count();
+    utl::small_vector<std::string_view> argTypeNames;
+    for (size_t i = 0; i < argCount; ++i) {
+        argTypeNames.push_back(string(in));
+    }
+    auto kind = in.enumValue<FunctionKind>(3);
+    bool isAbstract = in.u8();
+    uint64_t address = in.varint();
+    if (pass != Pass::Define) {
+        return;
+    }
+    auto argTypes = argTypeNames | transform([&](std::string_view typeName) {
+        return parseTypename(sym, typeName);
+    }) | ToSmallVector<>;
+    auto* retType = parseTypename(sym, retTypeName);
+    auto* function = sym.declareFunction(std::string(name),
+                                         sym.functionType(argTypes, retType),
+                                         access);
+    registerEntity(ID, function);
+    function->setKind(kind);
+    function->markAbstract(isAbstract);
+    if (address > 0) {
+        function->setBinaryAddress(address - 1);
+    }
+}
+
+static ast::NodeType toASTNodeType(EntityType entityType) {
+    switch (entityType) {
+    case EntityType::StructType:
+        return ast::NodeType::StructDefinition;
+    case EntityType::ProtocolType:
+        return ast::NodeType::ProtocolDefinition;
+    default:
+        SC_UNREACHABLE();
+    }
+}
+
+void LazySymbolTable::Impl::readRecord(SymbolTable& sym, ByteReader& in,
+                                       Pass pass, EntityType entityType,
+                                       std::string_view name,
+                                       AccessControl access, size_t ID) {
+    bool isStruct = entityType == EntityType::StructType;
+    size_t size = 0, align = 0;
+    std::array<LifetimeOpData, 4> lifetime{};
+    if (isStruct) {
+        size = in.varint();
+        align = in.varint();
+        lifetime = readLifetime(in);
+    }
+    bool isEmpty = in.u8();
+    std::optional<VTableData> vtable;
+    if (in.u8()) {
+        vtable = readVTable(in);
+    }
+    RecordType* type = nullptr;
+    if (pass == Pass::Declare) {
+        type = sym.declareRecordType(std::string(name),
+                                     toASTNodeType(entityType), access);
+        registerEntity(ID, type);
+        if (auto* structType = dyncast<StructType*>(type)) {
+            structType->setSize(size);
+            structType->setAlign(align);
+            structType->setLifetimeMetadata(
+                makeLifetime(sym, nullptr, lifetime));
+        }
+    }
+    else {
+        type = cast<RecordType*>(IDEntities[ID]);
+    }
+    size_t numChildren = in.count();
+    sym.withScopeCurrent(type, [&] {
+        for (size_t i = 0; i < numChildren; ++i) {
+            readEntity(sym, in, pass);
+        }
+    });
+    if (pass != Pass::Define) {
+        return;
+    }
+    if (auto* structType = dyncast<StructType*>(type)) {
+        structType->setLifetimeMetadata(
+            makeLifetime(sym, structType, lifetime));
+        structType->setConstructors(structType->findFunctions("new"));
+    }
+    type->setIsEmpty(isEmpty);
+    if (vtable) {
+        vtable->type = type;
+        pendingVTables.push_back(std::move(*vtable));
+    }
+}
+
+void LazySymbolTable::Impl::readVariable(SymbolTable& sym, ByteReader& in,
+                                         Pass pass, std::string_view name,
+                                         AccessControl access, size_t ID) {
+    auto typeName = string(in);
+    bool isMut = in.u8();
+    uint64_t index = in.varint();
+    if (pass != Pass::Define) {
+        return;
+    }
+    auto* type = parseTypename(sym, typeName);
+    using enum Mutability;
+    auto* var = sym.defineVariable(std::string(name), type,
+                                   isMut ? Mutable : Const, access);
+    registerEntity(ID, var);
+    if (index > 0) {
+        auto* parent = dyncast<RecordType*>(&sym.currentScope());
+        if (!parent) {
+            throw BinaryFormatError{};
+        }
+        var->setIndex(index - 1);
+        parent->setElement(index - 1, var);
+    }
+}
+
+void LazySymbolTable::Impl::readBaseClass(SymbolTable& sym, ByteReader& in,
+                                          Pass pass, AccessControl access,
+                                          size_t ID) {
+    auto typeName = string(in);
+    size_t index = in.varint();
+    if (pass != Pass::Define) {
+        return;
+    }
+    auto* base = sym.defineBaseClass(parseTypename(sym, typeName), access);
+    registerEntity(ID, base);
+    auto* parent = dyncast<RecordType*>(&sym.currentScope());
+    if (!parent) {
+        throw BinaryFormatError{};
+    }
+    base->setIndex(index);
+    parent->setElement(index, base);
+}
+
+VTableData LazySymbolTable::Impl::readVTable(ByteReader& in) {
+    VTableData result{};
+    result.position = in.varint();
+    result.correspondingTypeID = in.varint();
+    size_t numInherited = in.count();
+    for (size_t i = 0; i < numInherited; ++i) {
+        result.inherited.push_back(readVTable(in));
+    }
+    size_t layoutSize = in.count();
+    for (size_t i = 0; i < layoutSize; ++i) {
+        result.layout.push_back(in.varint());
+    }
+    return result;
+}
+
+std::unique_ptr<VTable> LazySymbolTable::Impl::makeVTable(
+    SymbolTable& sym, VTableData const& data) {
+    auto* type = entityByID<RecordType>(sym, data.correspondingTypeID);
+    utl::hashmap<RecordType const*, std::unique_ptr<VTable>> inheritanceMap;
+    for (auto& other: data.inherited) {
+        auto vt = makeVTable(sym, other);
+        inheritanceMap[vt->correspondingType()] = std::move(vt);
+    }
+    VTableLayout layout;
+    for (size_t ID: data.layout) {
+        layout.push_back(entityByID<Function>(sym, ID));
+    }
+    auto vtable = std::make_unique<VTable>(type, std::move(inheritanceMap),
+                                           std::move(layout));
+    vtable->setPosition(data.position);
+    return vtable;
+}
+
+std::array<LifetimeOpData, 4> LazySymbolTable::Impl::readLifetime(
+    ByteReader& in) {
+    std::array<LifetimeOpData, 4> result;
+    for (auto& op: result) {
+        op.kind = in.enumValue<LifetimeOperation::Kind>(4);
+        if (in.u8()) {
+            auto name = string(in);
+            op.function = { name, string(in) };
+        }
+    }
+    return result;
+}
+
+/// Like the JSON deserializer we create the lifetime metadata twice. Once
+/// without functions when the type is declared, because dependent types need
+/// it, and once the functions of the type exist
+LifetimeMetadata LazySymbolTable::Impl::makeLifetime(
+    SymbolTable& sym, ObjectType* parent,
+    std::array<LifetimeOpData, 4> const& ops) {
+    std::array<LifetimeOperation, 4> result;
+    for (auto [index, op]: ops | enumerate) {
+        Function* function = nullptr;
+        if (parent && op.function) {
+            auto [name, typeName] = *op.function;
+            auto* fnType =
+                dyncast<FunctionType const*>(parseTypename(sym, typeName));
+            if (!fnType) {
+                throw BinaryFormatError{};
+            }
+            auto const functions = parent->findFunctions(name);
+            function = findBySignature(std::span(functions),
+                                       fnType->argumentTypes());
+            if (!function) {
+                throw BinaryFormatError{};
+            }
+        }
+        result[index] = LifetimeOperation(op.kind, function);
+    }
+    return LifetimeMetadata(result);
+}
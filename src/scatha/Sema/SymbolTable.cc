@@ -3,7 +3,9 @@
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <vector>
 
 #include <range/v3/algorithm.hpp>
@@ -18,9 +20,9 @@
 
 #include "AST/AST.h"
 #include "Common/Builtin.h"
-#include "Common/FileHandling.h"
 #include "Common/Ranges.h"
 #include "Common/UniquePtr.h"
+#include "Invocation/LibraryCache.h"
 #include "Invocation/TargetNames.h"
 #include "Issue/IssueHandler.h"
 #include "Sema/Analysis/ConstantExpressions.h"
@@ -66,32 +68,117 @@ struct std::hash<FuncSig> {
     }
 };
 
+/// Current scope and issue handler of a thread that analyzes concurrently
+/// with other threads. See `SymbolTable::LocalState`
+struct SymbolTable::LocalStateData {
+    SymbolTable::Impl const* owner;
+    Scope* currentScope;
+    IssueHandler* iss;
+    LocalStateData* prev;
+    size_t temporaryID = 0;
+};
+
+namespace {
+
+/// Map of instantiated types that is read without the symbol table mutex.
+/// Entries are inserted while the mutex is held and published once the type
+/// is fully constructed. A thread that finds no published entry takes the
+/// mutex, so it waits for the creating thread to finish, and looks again with
+/// `find()`. The creating thread itself finds its unpublished entries there
+/// when construction recurses
+template <typename Key, typename T>
+class TypeCache {
+public:
+    /// \Returns the published type for \p key or null
+    T* findPublished(Key const& key) const {
+        std::shared_lock lock(mutex);
+        auto itr = map.find(key);
+        if (itr == map.end() || !itr->second.published) {
+            return nullptr;
+        }
+        return itr->second.type;
+    }
+
+    /// \Returns the type for \p key or null, even if it is not published
+    /// \pre Requires the symbol table mutex
+    T* find(Key const& key) const {
+        std::shared_lock lock(mutex);
+        auto itr = map.find(key);
+        return itr != map.end() ? itr->second.type : nullptr;
+    }
+
+    /// Inserts the unpublished entry \p type for \p key
+    /// \pre Requires the symbol table mutex
+    void insert(Key const& key, T* type) {
+        std::lock_guard lock(mutex);
+        map.insert({ key, { type, false } });
+    }
+
+    /// Makes the entry for \p key visible to `findPublished()`
+    /// \pre Requires the symbol table mutex
+    void publish(Key const& key) {
+        std::lock_guard lock(mutex);
+        auto itr = map.find(key);
+        SC_ASSERT(itr != map.end(), "Type has not been inserted");
+        itr->second.published = true;
+    }
+
+    /// \Returns all types in insertion order
+    utl::small_vector<T*> types() const {
+        std::shared_lock lock(mutex);
+        return map.values() | ranges::views::transform([](auto& elem) {
+            return elem.second.type;
+        }) | ToSmallVector<>;
+    }
+
+private:
+    struct Entry {
+        T* type;
+        bool published;
+    };
+
+    mutable std::shared_mutex mutex;
+    utl::hashmap<Key, Entry> map;
+};
+
+} // namespace
+
+static thread_local SymbolTable::LocalStateData* localState = nullptr;
+
 struct SymbolTable::Impl {
-    /// The currently active scope
-    Scope* currentScope = nullptr;
+    /// The symbol table that owns this. Updated when the table is moved because
+    /// library symbol loaders reach the table through it
+    SymbolTable* owner = nullptr;
+
+    /// The currently active scope of threads without local state
+    Scope* mainScope = nullptr;
+
+    /// Serializes creation of entities and types. Recursive because factory
+    /// functions call each other. Lookups of existing types don't take it,
+    /// see `TypeCache`
+    std::recursive_mutex mutex;
 
     /// Owning list of all entities in this symbol table
     utl::vector<UniquePtr<Entity>> entities;
 
     /// Map of instantiated `RawPtrType`'s
-    utl::hashmap<QualType, RawPtrType*> ptrTypes;
+    TypeCache<QualType, RawPtrType> ptrTypes;
 
     /// Map of instantiated `ReferenceType`'s
-    utl::hashmap<QualType, ReferenceType*> refTypes;
+    TypeCache<QualType, ReferenceType> refTypes;
 
     /// Map of instantiated `UniquePtrType`'s
-    utl::hashmap<QualType, UniquePtrType*> uniquePtrTypes;
+    TypeCache<QualType, UniquePtrType> uniquePtrTypes;
 
     /// Map of instantiated `FunctionType`'s
-    utl::hashmap<FuncSig, FunctionType const*> functionTypes;
+    TypeCache<FuncSig, FunctionType const> functionTypes;
 
     /// Map of instantiated `ArrayTypes`'s
-    utl::hashmap<std::pair<ObjectType const*, size_t>, ArrayType const*>
-        arrayTypes;
+    TypeCache<std::pair<ObjectType const*, size_t>, ArrayType const> arrayTypes;
 
     /// Map of instantiated `TypeDeductionQualifier`'s
     using TypeDeducKey = std::tuple<ReferenceKind, Mutability, PointerBindMode>;
-    utl::hashmap<TypeDeducKey, TypeDeductionQualifier*> typeDeductionQualifiers;
+    TypeCache<TypeDeducKey, TypeDeductionQualifier> typeDeductionQualifiers;
 
     /// List of all functions
     utl::small_vector<Function*> functions;
@@ -114,11 +201,14 @@ struct SymbolTable::Impl {
     /// The global scope
     GlobalScope* globalScope = nullptr;
 
-    /// ID counter for temporaries
+    /// ID counter for temporaries of threads without local state
     size_t temporaryID = 0;
 
-    /// The issue handler
-    IssueHandler* iss = nullptr;
+    /// Number of entities when `beginConcurrentAnalysis()` was called
+    size_t concurrentBegin = 0;
+
+    /// The issue handler of threads without local state
+    IssueHandler* mainIss = nullptr;
 
     /// Pathes to search for imported libraries
     std::vector<std::filesystem::path> libSearchPaths;
@@ -128,8 +218,27 @@ struct SymbolTable::Impl {
     template <typename I, typename... Args>
         requires std::constructible_from<I, Scope*, Args...>
     void issue(Args&&... args) {
+        auto* iss = issueHandler();
         SC_ASSERT(iss, "Forget to set issue handler?");
-        iss->push<I>(currentScope, std::forward<Args>(args)...);
+        iss->push<I>(currentScope(), std::forward<Args>(args)...);
+    }
+
+    /// \Returns the local state of the calling thread if it belongs to this
+    /// symbol table
+    LocalStateData* local() const {
+        return localState && localState->owner == this ? localState : nullptr;
+    }
+
+    /// The currently active scope of the calling thread
+    Scope*& currentScope() {
+        auto* state = local();
+        return state ? state->currentScope : mainScope;
+    }
+
+    /// The issue handler of the calling thread
+    IssueHandler* issueHandler() {
+        auto* state = local();
+        return state ? state->iss : mainIss;
     }
 
     /// Direct accessors to builtin types
@@ -154,12 +263,13 @@ struct SymbolTable::Impl {
     E* addEntity(Args&&... args);
 
     template <typename T>
-    T* ptrLikeImpl(utl::hashmap<QualType, T*>& map, QualType pointee,
+    T* ptrLikeImpl(TypeCache<QualType, T>& cache, QualType pointee,
                    utl::function_view<void(T*)> continuation = {});
 };
 
 SymbolTable::SymbolTable(): impl(std::make_unique<Impl>()) {
-    impl->currentScope = impl->globalScope = impl->addEntity<GlobalScope>();
+    impl->owner = this;
+    impl->mainScope = impl->globalScope = impl->addEntity<GlobalScope>();
 
     using enum Signedness;
     impl->Void = declareBuiltinType<VoidType>();
@@ -196,6 +306,21 @@ SymbolTable::SymbolTable(): impl(std::make_unique<Impl>()) {
     globalScope().addChild(reinterpret);
 }
 
+SymbolTable::LocalState::LocalState(SymbolTable& sym,
+                                    IssueHandler& issueHandler):
+    data(std::make_unique<LocalStateData>(
+        LocalStateData{ .owner = sym.impl.get(),
+                        .currentScope = &sym.globalScope(),
+                        .iss = &issueHandler,
+                        .prev = localState })) {
+    localState = data.get();
+}
+
+SymbolTable::LocalState::~LocalState() {
+    SC_ASSERT(localState == data.get(), "Local states must be nested");
+    localState = data->prev;
+}
+
 SymbolTable::SymbolTable(SymbolTable&& rhs) noexcept:
     impl(std::make_unique<Impl>()) {
     *this = std::move(rhs);
@@ -203,13 +328,16 @@ SymbolTable::SymbolTable(SymbolTable&& rhs) noexcept:
 
 SymbolTable& SymbolTable::operator=(SymbolTable&& rhs) noexcept {
     impl = std::move(rhs.impl);
+    impl->owner = this;
     rhs.impl = SymbolTable().impl;
+    rhs.impl->owner = &rhs;
     return *this;
 }
 
 SymbolTable::~SymbolTable() = default;
 
 FileScope* SymbolTable::declareFileScope(size_t index, std::string filename) {
+    std::lock_guard lock(impl->mutex);
     auto* file = impl->addEntity<FileScope>(index, filename, &globalScope());
     globalScope().addChild(file);
     return file;
@@ -325,9 +453,35 @@ static NativeLibrary* importNativeLib(SymbolTable& sym, SymbolTable::Impl& impl,
     lib->setVisible(false);
     impl.importedLibs.push_back(lib);
     impl.nativeLibMap.insert({ libname, lib });
-    auto archive = Archive::Open(*libpath);
-    SC_RELASSERT(archive, "Failed to open archive even though file exists");
-    auto libsymtext = archive->openTextFile(TargetNames::SymbolTableName);
+    auto files = LibraryCache::load(*libpath);
+    SC_RELASSERT(files, "Failed to open archive even though file exists");
+    if (files->binarySymbolTable) {
+        std::shared_ptr table =
+            LazySymbolTable::FromIndex(files->symbolTableIndex);
+        SC_RELASSERT(table, "Failed to open library symbol table");
+        sym.withScopeCurrent(lib, [&] { table->loadDependencies(sym); });
+        /// Entities are declared when name lookup in the library first
+        /// requests them. Lookups may happen on any thread and may be nested,
+        /// so we serialize loading with the recursive symbol table mutex
+        lib->setSymbolLoader(
+            [&impl, lib, table](std::optional<InternedString> name) {
+            if (name && !table->isPending(*name)) {
+                return;
+            }
+            std::lock_guard lock(impl.mutex);
+            auto& sym = *impl.owner;
+            sym.withScopeCurrent(lib, [&] {
+                bool success =
+                    name ? table->load(sym, *name) : table->loadAll(sym);
+                SC_RELASSERT(success,
+                             "Failed to deserialize libary symbol table");
+            });
+        });
+        return lib;
+    }
+    /// Libraries built before the binary format only have a textual symbol
+    /// table, which we deserialize eagerly
+    auto& libsymtext = files->symbolTable;
     SC_RELASSERT(libsymtext, "Failed to open library symbol table");
     sym.withScopeCurrent(lib, [&] {
         bool success = deserialize(sym, *libsymtext);
@@ -360,6 +514,7 @@ ForeignLibrary* SymbolTable::importForeignLib(std::string_view libname) {
 
 NativeLibrary* SymbolTable::getOrImportNativeLib(std::string_view libname,
                                                  ast::ASTNode* astNode) {
+    std::lock_guard lock(impl->mutex);
     auto itr = impl->nativeLibMap.find(libname);
     if (itr != impl->nativeLibMap.end()) {
         return itr->second;
@@ -369,6 +524,7 @@ NativeLibrary* SymbolTable::getOrImportNativeLib(std::string_view libname,
 
 ForeignLibrary* SymbolTable::getOrImportForeignLib(std::string_view libname,
                                                    ast::ASTNode* astNode) {
+    std::lock_guard lock(impl->mutex);
     auto itr = impl->foreignLibMap.find(libname);
     if (itr != impl->foreignLibMap.end()) {
         return itr->second;
@@ -380,6 +536,7 @@ RecordType* SymbolTable::declareRecordImpl(ast::NodeType nodeType,
                                            ast::RecordDefinition* def,
                                            std::string name,
                                            AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     if (isKeyword(name)) {
         impl->issue<GenericBadStmt>(def, GenericBadStmt::ReservedIdentifier);
         return nullptr;
@@ -440,6 +597,7 @@ T* SymbolTable::declareBuiltinType(Args&&... args) {
 Function* SymbolTable::declareFuncImpl(ast::FunctionDefinition* def,
                                        std::string name,
                                        AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     /// FIXME: This is a quick and dirty solution, we need to find a more
     /// general way to handle this
     if (isKeyword(name) && name != "move") {
@@ -558,6 +716,7 @@ bool SymbolTable::setFunctionType(Function* function,
 
 bool SymbolTable::setFunctionType(Function* function,
                                   FunctionType const* type) {
+    std::lock_guard lock(impl->mutex);
     bool isReset = function->type() != nullptr;
     SC_ASSERT(isReset || function->type() == nullptr,
               "Function type has been set before");
@@ -606,6 +765,7 @@ Function* SymbolTable::declareForeignFunction(std::string name,
                                               FunctionType const* type,
                                               FunctionAttribute attrs,
                                               AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     auto* function = declareFunction(name, type, accessControl);
     if (!function) {
         return nullptr;
@@ -626,6 +786,7 @@ Variable* SymbolTable::declareVarImpl(ast::VarDeclBase* vardecl,
                                       std::string name,
                                       AccessControl accessControl,
                                       Mutability mut) {
+    std::lock_guard lock(impl->mutex);
     if (isKeyword(name)) {
         impl->issue<GenericBadStmt>(vardecl,
                                     GenericBadStmt::ReservedIdentifier);
@@ -661,6 +822,7 @@ Variable* SymbolTable::declareVariable(ast::VarDeclBase* vardecl,
 }
 
 bool SymbolTable::setVariableType(Variable* var, Type const* type) {
+    std::lock_guard lock(impl->mutex);
     var->_type = type;
     return validateAccessControl(*var);
 }
@@ -680,6 +842,7 @@ Variable* SymbolTable::defineVariable(std::string name, Type const* type,
 
 BaseClassObject* SymbolTable::declareBaseImpl(ast::BaseClassDeclaration* decl,
                                               AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     auto* obj = impl->addEntity<BaseClassObject>(std::string{}, &currentScope(),
                                                  decl, accessControl);
     obj->setVisible(false);
@@ -692,13 +855,14 @@ BaseClassObject* SymbolTable::declareBaseClass(
 }
 
 bool SymbolTable::setBaseClassType(BaseClassObject* obj, Type const* type) {
+    std::lock_guard lock(impl->mutex);
     if (!type) {
         return false;
     }
     obj->_type = type;
     bool result = validateAccessControl(*obj);
     auto* parentType = cast<RecordType*>(obj->parent());
-    obj->setName(std::string(type->name()));
+    obj->setName(type->name());
     withScopeCurrent(parentType, [&] {
         addToCurrentScope(obj);
         declareAlias(const_cast<Type&>(*obj->Object::type()), obj->astNode(),
@@ -722,6 +886,7 @@ Property* SymbolTable::addProperty(PropertyKind kind, Type const* type,
                                    ValueCategory valueCat,
                                    AccessControl accessControl,
                                    ast::ASTNode* astNode) {
+    std::lock_guard lock(impl->mutex);
     auto* prop = impl->addEntity<Property>(kind, &currentScope(), type, mut,
                                            bindMode, valueCat, accessControl,
                                            astNode);
@@ -732,14 +897,15 @@ Property* SymbolTable::addProperty(PropertyKind kind, Type const* type,
 }
 
 Temporary* SymbolTable::temporary(ast::ASTNode* astNode, QualType type) {
-    auto* temp = impl->addEntity<Temporary>(impl->temporaryID++,
-                                            &currentScope(), type, astNode);
-    return temp;
+    auto* state = impl->local();
+    size_t id = state ? state->temporaryID++ : impl->temporaryID++;
+    return impl->addEntity<Temporary>(id, &currentScope(), type, astNode);
 }
 
 Alias* SymbolTable::declareAlias(std::string name, Entity& aliased,
                                  ast::ASTNode* astNode,
                                  AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     auto existing = currentScope().findEntities(name);
     if (ranges::contains(existing, &aliased, stripAlias)) {
         return nullptr;
@@ -761,6 +927,7 @@ Alias* SymbolTable::declareAlias(Entity& aliased, ast::ASTNode* astNode,
 PoisonEntity* SymbolTable::declarePoison(ast::Identifier* ID,
                                          EntityCategory cat,
                                          AccessControl accessControl) {
+    std::lock_guard lock(impl->mutex);
     auto name = std::string(ID->value());
     if (isKeyword(name) || !currentScope().findEntities(name).empty()) {
         return nullptr;
@@ -773,6 +940,7 @@ PoisonEntity* SymbolTable::declarePoison(ast::Identifier* ID,
 }
 
 Scope* SymbolTable::addAnonymousScope() {
+    std::lock_guard lock(impl->mutex);
     auto* scope =
         impl->addEntity<AnonymousScope>(currentScope().kind(), &currentScope());
     addToCurrentScope(scope);
@@ -783,13 +951,17 @@ FunctionType const* SymbolTable::functionType(
     std::span<Type const* const> argumentTypes, Type const* returnType) {
     utl::small_vector<Type const*> argTypeVec = argumentTypes | ToSmallVector<>;
     FuncSig key = { argTypeVec, returnType };
-    auto itr = impl->functionTypes.find(key);
-    if (itr != impl->functionTypes.end()) {
-        return itr->second;
+    if (auto* type = impl->functionTypes.findPublished(key)) {
+        return type;
+    }
+    std::lock_guard lock(impl->mutex);
+    if (auto* type = impl->functionTypes.find(key)) {
+        return type;
     }
     auto* functionType =
         impl->addEntity<FunctionType>(std::move(argTypeVec), returnType);
-    impl->functionTypes.insert({ key, functionType });
+    impl->functionTypes.insert(key, functionType);
+    impl->functionTypes.publish(key);
     return functionType;
 }
 
@@ -801,9 +973,12 @@ FunctionType const* SymbolTable::functionType(
 ArrayType const* SymbolTable::arrayType(ObjectType const* elementType,
                                         size_t size) {
     std::pair key = { elementType, size };
-    auto itr = impl->arrayTypes.find(key);
-    if (itr != impl->arrayTypes.end()) {
-        return itr->second;
+    if (auto* type = impl->arrayTypes.findPublished(key)) {
+        return type;
+    }
+    std::lock_guard lock(impl->mutex);
+    if (auto* type = impl->arrayTypes.find(key)) {
+        return type;
     }
     /// Const casting is fine because
     /// - the symbol table is the only factory of types so we can guarantee that
@@ -812,7 +987,7 @@ ArrayType const* SymbolTable::arrayType(ObjectType const* elementType,
     ///   `ArrayType` propagates const-ness.
     auto* arrayType =
         impl->addEntity<ArrayType>(const_cast<ObjectType*>(elementType), size);
-    impl->arrayTypes.insert({ key, arrayType });
+    impl->arrayTypes.insert(key, arrayType);
     auto accessCtrl = arrayType->accessControl();
     withScopeCurrent(arrayType, [&] {
         using enum ValueCategory;
@@ -841,6 +1016,7 @@ ArrayType const* SymbolTable::arrayType(ObjectType const* elementType,
         analyzeLifetime(*arrayType, *this);
     }
     const_cast<ObjectType*>(elementType)->parent()->addChild(arrayType);
+    impl->arrayTypes.publish(key);
     return arrayType;
 }
 
@@ -865,15 +1041,18 @@ IntType const* SymbolTable::intType(size_t width, Signedness signedness) {
 }
 
 template <typename T>
-T* SymbolTable::Impl::ptrLikeImpl(utl::hashmap<QualType, T*>& map,
+T* SymbolTable::Impl::ptrLikeImpl(TypeCache<QualType, T>& cache,
                                   QualType pointee,
                                   utl::function_view<void(T*)> continuation) {
-    auto itr = map.find(pointee);
-    if (itr != map.end()) {
-        return itr->second;
+    if (auto* type = cache.findPublished(pointee)) {
+        return type;
+    }
+    std::lock_guard lock(mutex);
+    if (auto* type = cache.find(pointee)) {
+        return type;
     }
     auto* ptrType = addEntity<T>(pointee);
-    map.insert({ pointee, ptrType });
+    cache.insert(pointee, ptrType);
     if (auto* type = const_cast<ObjectType*>(pointee.get());
         type && type->parent())
     {
@@ -882,6 +1061,7 @@ T* SymbolTable::Impl::ptrLikeImpl(utl::hashmap<QualType, T*>& map,
     if (continuation) {
         continuation(ptrType);
     }
+    cache.publish(pointee);
     return ptrType;
 }
 
@@ -926,31 +1106,46 @@ UniquePtrType const* SymbolTable::uniquePointer(ObjectType const* type,
 
 TypeDeductionQualifier* SymbolTable::typeDeductionQualifier(
     ReferenceKind refKind, Mutability mut, PointerBindMode bindMode) {
-    auto& map = impl->typeDeductionQualifiers;
-    auto itr = map.find({ refKind, mut, bindMode });
-    if (itr != map.end()) {
-        return itr->second;
+    auto& cache = impl->typeDeductionQualifiers;
+    Impl::TypeDeducKey key = { refKind, mut, bindMode };
+    if (auto* qual = cache.findPublished(key)) {
+        return qual;
+    }
+    std::lock_guard lock(impl->mutex);
+    if (auto* qual = cache.find(key)) {
+        return qual;
     }
     auto* qual =
         impl->addEntity<TypeDeductionQualifier>(refKind, mut, bindMode);
-    map.insert({ { refKind, mut, bindMode }, qual });
+    cache.insert(key, qual);
+    cache.publish(key);
     return qual;
 }
 
 void SymbolTable::pushScope(Scope* scope) {
     SC_ASSERT(currentScope().isChildScope(scope),
               "Scope must be a child of the current scope");
-    impl->currentScope = scope;
+    impl->currentScope() = scope;
 }
 
-void SymbolTable::popScope() { impl->currentScope = currentScope().parent(); }
+void SymbolTable::popScope() {
+    impl->currentScope() = currentScope().parent();
+}
 
 void SymbolTable::makeScopeCurrent(Scope* scope) {
-    impl->currentScope = scope ? scope : &globalScope();
+    impl->currentScope() = scope ? scope : &globalScope();
 }
 
 utl::small_vector<Entity*> SymbolTable::unqualifiedLookup(
     std::string_view name, bool findHiddenEntities) {
+    /// Names that have never been interned can't name any entity
+    auto interned = InternedString::find(name);
+    return interned ? unqualifiedLookup(*interned, findHiddenEntities) :
+                      utl::small_vector<Entity*>{};
+}
+
+utl::small_vector<Entity*> SymbolTable::unqualifiedLookup(
+    InternedString name, bool findHiddenEntities) {
     utl::hashset<Entity*> overloadSet;
     for (auto* scope = &currentScope(); scope != nullptr;
          scope = scope->parent())
@@ -979,7 +1174,7 @@ Function* SymbolTable::builtinFunction(size_t index) const {
 }
 
 void SymbolTable::setIssueHandler(IssueHandler& issueHandler) {
-    impl->iss = &issueHandler;
+    impl->mainIss = &issueHandler;
 }
 
 void SymbolTable::setLibrarySearchPaths(
@@ -987,9 +1182,11 @@ void SymbolTable::setLibrarySearchPaths(
     impl->libSearchPaths = paths | ranges::to<std::vector>;
 }
 
-Scope& SymbolTable::currentScope() { return *impl->currentScope; }
+Scope& SymbolTable::currentScope() { return *impl->currentScope(); }
 
-Scope const& SymbolTable::currentScope() const { return *impl->currentScope; }
+Scope const& SymbolTable::currentScope() const {
+    return *impl->currentScope();
+}
 
 GlobalScope& SymbolTable::globalScope() { return *impl->globalScope; }
 
@@ -1056,8 +1253,33 @@ std::vector<Entity const*> SymbolTable::entities() const {
     return impl->entities | ToConstAddress | ranges::to<std::vector>;
 }
 
+void SymbolTable::beginConcurrentAnalysis() {
+    impl->concurrentBegin = impl->entities.size();
+}
+
+void SymbolTable::endConcurrentAnalysis() {
+    utl::hashset<Entity const*> added;
+    for (size_t i = impl->concurrentBegin; i < impl->entities.size(); ++i) {
+        added.insert(impl->entities[i].get());
+    }
+    /// Function scopes and their children are only modified by the thread that
+    /// analyzes the function, so their order is already deterministic
+    utl::hashset<Scope*> sharedScopes;
+    for (size_t i = impl->concurrentBegin; i < impl->entities.size(); ++i) {
+        auto* scope = impl->entities[i]->parent();
+        if (scope && !added.contains(scope) &&
+            scope->kind() != ScopeKind::Function)
+        {
+            sharedScopes.insert(scope);
+        }
+    }
+    for (auto* scope: sharedScopes) {
+        scope->canonicalizeOrder(added);
+    }
+}
+
 void SymbolTable::analyzeMissingLifetimes() {
-    for (auto* type: impl->arrayTypes.values() | values) {
+    for (auto* type: impl->arrayTypes.types()) {
         if (!type->hasLifetimeMetadata() &&
             type->elementType()->hasLifetimeMetadata())
         {
@@ -1113,6 +1335,7 @@ void SymbolTable::prepareExport() {
 template <typename E, typename... Args>
     requires std::constructible_from<E, Args...>
 E* SymbolTable::Impl::addEntity(Args&&... args) {
+    std::lock_guard lock(mutex);
     auto owner = allocate<E>(std::forward<Args>(args)...);
     auto* result = owner.get();
     entities.push_back(std::move(owner));
@@ -3,18 +3,23 @@
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include <range/v3/view.hpp>
 #include <scatha/Assembly/Assembler.h>
 #include <scatha/Assembly/AssemblyStream.h>
 #include <scatha/CodeGen/CodeGen.h>
+#include <scatha/Common/TimeTrace.h>
 #include <scatha/Common/SourceFile.h>
+#include <scatha/IR/AnalysisManager.h>
 #include <scatha/IR/Context.h>
 #include <scatha/IR/Module.h>
 #include <scatha/IR/Print.h>
 #include <scatha/IRGen/IRGen.h>
+#include <scatha/Invocation/CompilationCache.h>
 #include <scatha/Invocation/ExecutableWriter.h>
 #include <scatha/Sema/Entity.h>
 #include <scatha/Sema/Serialize.h>
@@ -42,6 +47,19 @@ struct Timer {
 
 } // namespace
 
+/// \Returns the allocator named by the `--regalloc` option or `std::nullopt`
+/// for `auto`
+static std::optional<cg::RegisterAllocator> parseRegisterAllocator(
+    std::string_view name) {
+    if (name == "graph") {
+        return cg::RegisterAllocator::Graph;
+    }
+    if (name == "linear-scan") {
+        return cg::RegisterAllocator::LinearScan;
+    }
+    return std::nullopt;
+}
+
 int scatha::compilerMain(CompilerOptions options) {
     if (options.outputFile.empty()) {
         options.outputFile = "out";
@@ -70,9 +88,52 @@ int scatha::compilerMain(CompilerOptions options) {
     invocation.setFrontend(deduceFrontend(options.files));
     invocation.setOptLevel(options.optLevel);
     invocation.setOptPipeline(options.pipeline);
+    invocation.setNumThreads(options.jobs);
+    invocation.setRegisterAllocator(
+        parseRegisterAllocator(options.registerAllocator));
     invocation.generateDebugInfo(options.debug);
+    std::optional<CompilationCache> cache;
+    if (!options.cacheDir.empty()) {
+        cache.emplace(options.cacheDir);
+        invocation.setCache(&*cache);
+    }
+    std::optional<TimeTrace> trace;
+    if (options.timeReport || !options.traceOut.empty()) {
+        trace.emplace();
+        invocation.setTimeTrace(&*trace);
+    }
+    if (options.analysisStats) {
+        ir::AnalysisManager::resetStats();
+    }
     timer.reset();
     auto target = invocation.run();
+    if (cache && options.cacheStats) {
+        auto stats = cache->stats();
+        std::cout << "Cache: " << stats.hits << " hits, " << stats.misses
+                  << " misses, " << stats.evictions << " evictions"
+                  << std::endl;
+    }
+    if (trace && options.timeReport) {
+        trace->printReport(std::cout);
+    }
+    if (options.analysisStats) {
+        for (size_t i = 0; i < ir::NumAnalyses; ++i) {
+            auto analysis = ir::Analysis(i);
+            auto stats = ir::AnalysisManager::stats(analysis);
+            std::cout << ir::toString(analysis) << ": " << stats.hits
+                      << " hits, " << stats.misses << " misses, "
+                      << stats.invalidations << " invalidations" << std::endl;
+        }
+    }
+    if (trace && !options.traceOut.empty()) {
+        std::fstream file(options.traceOut, std::ios::out | std::ios::trunc);
+        if (!file) {
+            std::cout << Error << "Failed to open " << options.traceOut
+                      << std::endl;
+            return 1;
+        }
+        trace->writeChromeTrace(file);
+    }
     if (!target) {
         return 1;
     }
@@ -2,6 +2,7 @@
 #define SCATHAC_COMPILER_H_
 
 #include <filesystem>
+#include <string>
 
 #include "Options.h"
 
@@ -14,6 +15,30 @@ struct CompilerOptions: BaseOptions {
 
     /// Set if debug symbols shall be generated
     bool debug;
+
+    /// Number of threads used for compilation. Zero selects the number of
+    /// hardware threads
+    size_t jobs = 0;
+
+    /// Directory of the compilation cache. The cache is disabled if empty
+    std::filesystem::path cacheDir;
+
+    /// Set if cache statistics shall be printed
+    bool cacheStats = false;
+
+    /// Set if the time and memory spent per stage and pass shall be printed
+    bool timeReport = false;
+
+    /// File to write a Chrome trace of the compilation to. No trace is
+    /// written if empty
+    std::filesystem::path traceOut;
+
+    /// Set if statistics of the IR analysis caches shall be printed
+    bool analysisStats = false;
+
+    /// Register allocator: `auto`, `graph` or `linear-scan`. `auto` selects
+    /// the allocator per function
+    std::string registerAllocator = "auto";
 };
 
 /// User facing compiler main function
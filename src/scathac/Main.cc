@@ -1,4 +1,7 @@
+#include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 
@@ -6,6 +9,7 @@
 #include "Graph.h"
 #include "Inspect.h"
 #include "Options.h"
+#include "Server.h"
 #include "Util.h"
 
 using namespace scatha;
@@ -23,7 +27,41 @@ static void commonOptions(CLI::App* app, BaseOptions& opt) {
     app->add_option("-o,--output", opt.outputFile, "Directory to place binary");
 }
 
-int main(int argc, char* argv[]) {
+/// \Returns the arguments of the command line \p argv without the program name
+/// and without the `--server` option
+static std::vector<std::string> stripServerOption(int argc,
+                                                  char const* const* argv) {
+    std::vector<std::string> result;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--server") {
+            ++i;
+            continue;
+        }
+        if (arg.starts_with("--server=")) {
+            continue;
+        }
+        result.push_back(std::string(arg));
+    }
+    return result;
+}
+
+static int runCommandLine(int argc, char const* const* argv,
+                          bool isServerRequest);
+
+/// Runs the command line \p args received by the compiler server
+static int runServerRequest(std::vector<std::string> const& args) {
+    std::vector<char const*> argv = { "scathac" };
+    for (auto& arg: args) {
+        argv.push_back(arg.c_str());
+    }
+    return runCommandLine(static_cast<int>(argv.size()), argv.data(),
+                          /* isServerRequest = */ true);
+}
+
+/// Parses the command line \p argv and runs the selected tool
+static int runCommandLine(int argc, char const* const* argv,
+                          bool isServerRequest) {
     CLI::App compiler("sctool");
     compiler.require_subcommand(0, 1);
 
@@ -34,6 +72,15 @@ int main(int argc, char* argv[]) {
     compiler.add_option("--stdlib", compilerOptions.stdlibDir);
     compiler.add_flag("-d,--debug", compilerOptions.debug, "Generate debug symbols");
     compiler.add_flag("-t,--time", compilerOptions.time, "Measure compilation time");
+    compiler.add_option("-j,--jobs", compilerOptions.jobs, "Number of threads used for compilation");
+    compiler.add_option("--cache-dir", compilerOptions.cacheDir, "Directory of the compilation cache");
+    compiler.add_flag("--cache-stats", compilerOptions.cacheStats, "Print compilation cache statistics")->needs("--cache-dir");
+    compiler.add_flag("--time-report", compilerOptions.timeReport, "Print the time and memory spent per stage and pass");
+    compiler.add_option("--trace-out", compilerOptions.traceOut, "Write a Chrome trace of the compilation to this file");
+    compiler.add_flag("--analysis-stats", compilerOptions.analysisStats, "Print hit rates of the IR analysis caches");
+    compiler.add_option("--regalloc", compilerOptions.registerAllocator, "Register allocator: auto, graph or linear-scan")->check(CLI::IsMember({ "auto", "graph", "linear-scan" }));
+    std::filesystem::path serverSocket;
+    compiler.add_option("--server", serverSocket, "Send the command line to the compiler server listening on this socket");
     
     CLI::App* inspect = compiler.add_subcommand("inspect", "Tool to visualize the state of the compilation pipeline");
     InspectOptions inspectOptions{};
@@ -61,10 +108,26 @@ int main(int argc, char* argv[]) {
     graph->add_flag("--calls", graphOptions.calls, "Draw call graph");
     graph->add_flag("--interference", graphOptions.interference, "Draw interference graph");
     graph->add_flag("--selection-dag", graphOptions.selectiondag, "Draw selection DAG");
+
+    CLI::App* server = compiler.add_subcommand("server", "Run a compiler server that keeps imported libraries in memory");
+    ServerOptions serverOptions{};
+    server->add_option("--socket", serverOptions.socket, "Unix domain socket to listen on")->required();
+    server->add_flag("--stop", serverOptions.stop, "Stop the server listening on the socket");
     // clang-format on
 
     try {
         compiler.parse(argc, argv);
+        if (isServerRequest && (server->parsed() || !serverSocket.empty())) {
+            throw std::runtime_error(
+                "Server options are not allowed in server requests");
+        }
+        if (server->parsed()) {
+            return serverMain(serverOptions, runServerRequest);
+        }
+        if (!serverSocket.empty()) {
+            return serverClientMain(serverSocket,
+                                    stripServerOption(argc, argv));
+        }
         if (inspect->parsed()) {
             return inspectMain(inspectOptions);
         }
@@ -81,3 +144,7 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 }
+
+int main(int argc, char* argv[]) {
+    return runCommandLine(argc, argv, /* isServerRequest = */ false);
+}
@@ -0,0 +1,340 @@
+#include "Server.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include <scatha/Common/InternedString.h>
+#include <scatha/Invocation/LibraryCache.h>
+#include <utl/strcat.hpp>
+
+#include "Util.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SCATHAC_HAVE_SERVER 1
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#else
+#define SCATHAC_HAVE_SERVER 0
+#endif
+
+using namespace scatha;
+
+#if SCATHAC_HAVE_SERVER
+
+/// # Protocol
+///
+/// The client connects, sends one request and reads one response. Integers
+/// are 32 bit little endian, strings are prefixed by their size.
+///
+///     Request:  RequestKind
+///               Compile: working directory, has stdlib dir (u8),
+///                        stdlib dir, argument count, arguments
+///     Response: exit code, output
+
+namespace {
+
+enum class RequestKind : uint8_t { Compile, Stop };
+
+/// Name of the environment variable that overrides the stdlib directory. The
+/// client forwards it so the server finds the same stdlib
+constexpr char const* StdlibEnvVar = "SCATHA_STDLIB_DIR";
+
+/// Owns a socket file descriptor and reads and writes protocol values
+class Connection {
+public:
+    explicit Connection(int fd): fd(fd) {}
+    Connection(Connection const&) = delete;
+    ~Connection() { ::close(fd); }
+
+    int get() const { return fd; }
+
+    void u8(uint8_t value) { writeBytes(&value, 1); }
+
+    void u32(uint32_t value) {
+        unsigned char bytes[4];
+        for (int i = 0; i < 4; ++i) {
+            bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+        writeBytes(bytes, 4);
+    }
+
+    void string(std::string_view text) {
+        u32(static_cast<uint32_t>(text.size()));
+        writeBytes(text.data(), text.size());
+    }
+
+    uint8_t readU8() {
+        uint8_t value;
+        readBytes(&value, 1);
+        return value;
+    }
+
+    uint32_t readU32() {
+        unsigned char bytes[4];
+        readBytes(bytes, 4);
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+        }
+        return value;
+    }
+
+    std::string readString() {
+        std::string result(readU32(), '\0');
+        readBytes(result.data(), result.size());
+        return result;
+    }
+
+private:
+    void writeBytes(void const* data, size_t size) {
+        auto* bytes = static_cast<char const*>(data);
+        while (size > 0) {
+            auto n = ::write(fd, bytes, size);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Failed to write to socket");
+            }
+            bytes += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+    void readBytes(void* data, size_t size) {
+        auto* bytes = static_cast<char*>(data);
+        while (size > 0) {
+            auto n = ::read(fd, bytes, size);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Connection closed unexpectedly");
+            }
+            bytes += n;
+            size -= static_cast<size_t>(n);
+        }
+    }
+
+    int fd;
+};
+
+/// Redirects \p stream to \p buffer for the lifetime of this object
+class StreamRedirect {
+public:
+    StreamRedirect(std::ostream& stream, std::streambuf* buffer):
+        stream(stream), old(stream.rdbuf(buffer)) {}
+    StreamRedirect(StreamRedirect const&) = delete;
+    ~StreamRedirect() { stream.rdbuf(old); }
+
+private:
+    std::ostream& stream;
+    std::streambuf* old;
+};
+
+} // namespace
+
+static sockaddr_un makeAddress(std::filesystem::path const& path) {
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    auto str = path.string();
+    if (str.size() >= sizeof addr.sun_path) {
+        throw std::runtime_error(
+            utl::strcat("Socket path is too long: ", path));
+    }
+    std::memcpy(addr.sun_path, str.c_str(), str.size() + 1);
+    return addr;
+}
+
+/// \Returns a socket connected to \p path or null if no server is listening
+static std::unique_ptr<Connection> connectTo(
+    std::filesystem::path const& path) {
+    auto addr = makeAddress(path);
+    auto conn = std::make_unique<Connection>(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (conn->get() < 0) {
+        throw std::runtime_error("Failed to create socket");
+    }
+    if (::connect(conn->get(), reinterpret_cast<sockaddr const*>(&addr),
+                  sizeof addr) != 0)
+    {
+        return nullptr;
+    }
+    return conn;
+}
+
+/// Sets the environment variable \p name to \p value or unsets it if \p value
+/// is empty
+static void setEnv(char const* name, std::optional<std::string> const& value) {
+    if (value) {
+        ::setenv(name, value->c_str(), /* overwrite = */ 1);
+    }
+    else {
+        ::unsetenv(name);
+    }
+}
+
+/// Handles the compile request on \p conn. Requests are handled one at a time,
+/// so we can change the working directory and the environment of the process.
+/// Failures of \p handler are reported to the client and don't stop the server
+static void handleCompile(Connection& conn, ServerRequestHandler const& handler,
+                          std::filesystem::path const& serverDir) {
+    auto cwd = conn.readString();
+    std::optional<std::string> stdlibDir;
+    if (conn.readU8()) {
+        stdlibDir = conn.readString();
+    }
+    else {
+        conn.readString();
+    }
+    std::vector<std::string> args(conn.readU32());
+    for (auto& arg: args) {
+        arg = conn.readString();
+    }
+    std::stringstream output;
+    int exitCode = 1;
+    {
+        StreamRedirect redirectOut(std::cout, output.rdbuf());
+        StreamRedirect redirectErr(std::cerr, output.rdbuf());
+        std::error_code ec;
+        std::filesystem::current_path(cwd, ec);
+        if (ec) {
+            std::cout << Error << "Failed to change to directory " << cwd
+                      << std::endl;
+        }
+        else {
+            setEnv(StdlibEnvVar, stdlibDir);
+            /// Names interned by this request are freed after it
+            InternedStringScope internScope;
+            try {
+                exitCode = handler(args);
+            }
+            catch (std::exception const& e) {
+                std::cout << Error << e.what() << std::endl;
+                exitCode = 1;
+            }
+        }
+        std::filesystem::current_path(serverDir, ec);
+    }
+    conn.u32(static_cast<uint32_t>(exitCode));
+    conn.string(std::move(output).str());
+}
+
+static int stopServer(std::filesystem::path const& socket) {
+    auto conn = connectTo(socket);
+    if (!conn) {
+        std::cout << Error << "No server is listening on " << socket
+                  << std::endl;
+        return 1;
+    }
+    conn->u8(static_cast<uint8_t>(RequestKind::Stop));
+    return 0;
+}
+
+int scatha::serverMain(ServerOptions options, ServerRequestHandler handler) {
+    if (options.stop) {
+        return stopServer(options.socket);
+    }
+    if (std::filesystem::is_socket(options.socket)) {
+        if (connectTo(options.socket)) {
+            std::cout << Error << "A server is already listening on "
+                      << options.socket << std::endl;
+            return 1;
+        }
+        /// Left behind by a server that was killed
+        std::filesystem::remove(options.socket);
+    }
+    /// Clients that disconnect early must not terminate the server
+    std::signal(SIGPIPE, SIG_IGN);
+    auto addr = makeAddress(options.socket);
+    Connection listener(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if (listener.get() < 0 ||
+        ::bind(listener.get(), reinterpret_cast<sockaddr const*>(&addr),
+               sizeof addr) != 0 ||
+        ::listen(listener.get(), SOMAXCONN) != 0)
+    {
+        std::cout << Error << "Failed to listen on " << options.socket << ": "
+                  << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    LibraryCache::setEnabled(true);
+    /// Fatal errors in a request throw instead of aborting, so they only fail
+    /// the request
+    auto assertHandler = internal::getAssertFailureHandler();
+    internal::setAssertFailureHandler(internal::AssertFailureHandler::Throw);
+    auto serverDir = std::filesystem::current_path();
+    std::cout << "Listening on " << options.socket << std::endl;
+    while (true) {
+        int fd = ::accept(listener.get(), nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cout << Error << "Failed to accept connection: "
+                      << std::strerror(errno) << std::endl;
+            break;
+        }
+        Connection conn(fd);
+        try {
+            auto kind = static_cast<RequestKind>(conn.readU8());
+            if (kind == RequestKind::Stop) {
+                break;
+            }
+            if (kind != RequestKind::Compile) {
+                throw std::runtime_error("Invalid request");
+            }
+            handleCompile(conn, handler, serverDir);
+        }
+        catch (std::exception const& e) {
+            std::cout << Warning << e.what() << std::endl;
+        }
+    }
+    std::filesystem::remove(options.socket);
+    internal::setAssertFailureHandler(assertHandler);
+    return 0;
+}
+
+int scatha::serverClientMain(std::filesystem::path const& socket,
+                             std::vector<std::string> const& args,
+                             std::ostream& out) {
+    auto conn = connectTo(socket);
+    if (!conn) {
+        out << Error << "No server is listening on " << socket
+                  << std::endl;
+        return 1;
+    }
+    conn->u8(static_cast<uint8_t>(RequestKind::Compile));
+    conn->string(std::filesystem::current_path().string());
+    char const* stdlibDir = std::getenv(StdlibEnvVar);
+    conn->u8(stdlibDir != nullptr);
+    conn->string(stdlibDir ? stdlibDir : "");
+    conn->u32(static_cast<uint32_t>(args.size()));
+    for (auto& arg: args) {
+        conn->string(arg);
+    }
+    auto exitCode = static_cast<int>(conn->readU32());
+    out << conn->readString() << std::flush;
+    return exitCode;
+}
+
+#else // SCATHAC_HAVE_SERVER
+
+int scatha::serverMain(ServerOptions, ServerRequestHandler) {
+    throw std::runtime_error("Server mode is not supported on this platform");
+}
+
+int scatha::serverClientMain(std::filesystem::path const&,
+                             std::vector<std::string> const&, std::ostream&) {
+    throw std::runtime_error("Server mode is not supported on this platform");
+}
+
+#endif // SCATHAC_HAVE_SERVER
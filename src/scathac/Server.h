@@ -0,0 +1,42 @@
+#ifndef SCATHAC_SERVER_H_
+#define SCATHAC_SERVER_H_
+
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace scatha {
+
+/// Command line options of the compiler server
+struct ServerOptions {
+    /// Path of the Unix domain socket the server listens on
+    std::filesystem::path socket;
+
+    /// Set if a running server shall be stopped
+    bool stop = false;
+};
+
+/// Handles one command line received by the server and returns the exit code
+using ServerRequestHandler =
+    std::function<int(std::vector<std::string> const& args)>;
+
+/// Runs the compiler server. The server keeps imported libraries in memory and
+/// handles the command lines sent by `serverClientMain()` one after another in
+/// the working directory of the client. Everything \p handler writes to
+/// `std::cout` and `std::cerr` is sent back to the client. While the server
+/// runs, fatal errors throw `AssertionFailure` instead of aborting, so a
+/// request that fails or throws only fails that request. Each request is
+/// handled in its own `InternedStringScope`
+int serverMain(ServerOptions options, ServerRequestHandler handler);
+
+/// Sends the command line \p args to the server listening on \p socket, prints
+/// the output of the server to \p out and returns its exit code
+int serverClientMain(std::filesystem::path const& socket,
+                     std::vector<std::string> const& args,
+                     std::ostream& out = std::cout);
+
+} // namespace scatha
+
+#endif // SCATHAC_SERVER_H_
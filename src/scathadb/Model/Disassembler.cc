@@ -148,6 +148,10 @@ static void print(std::ostream& str, Instruction inst,
                 str << "index: " << inst.arg2;
             }
             break;
+        case OpCode::vop:
+        case OpCode::vsplat:
+            str << " " << inst.arg1 << ", " << inst.arg2;
+            break;
         default:
             assert(false);
         }
@@ -244,6 +248,14 @@ static Instruction readInstruction(uint8_t const* textPtr) {
             arg1 = makeValue8(load<uint8_t>(argData));
             arg2 = makeValue16(load<uint8_t>(argData + 1));
             break;
+        case OpCode::vop:
+            arg1 = makeRegisterIndex(load<uint8_t>(argData + 2));
+            arg2 = makeRegisterIndex(load<uint8_t>(argData + 3));
+            break;
+        case OpCode::vsplat:
+            arg1 = makeRegisterIndex(load<uint8_t>(argData + 1));
+            arg2 = makeRegisterIndex(load<uint8_t>(argData + 2));
+            break;
         default:
             assert(false);
         }
@@ -16,6 +16,7 @@
 #include "Errors.h"
 #include "ExternalFunction.h"
 #include "Memory.h"
+#include "StringOps.h"
 #include "VMImpl.h"
 #include "VirtualMachine.h"
 
@@ -30,6 +31,12 @@ static T* deref(VirtualMachine* vm, VirtualPointer ptr, size_t size, int = 0) {
     return reinterpret_cast<T*>(deref(vm, ptr, size));
 }
 
+/// Same as `deref()` but permits empty ranges which may be null
+static void const* derefRange(VirtualMachine* vm, VirtualPointer ptr,
+                              size_t size) {
+    return size == 0 ? nullptr : deref(vm, ptr, size);
+}
+
 /// Loads two consecutive registers as an array pointer structure
 /// `{ T*, size_t }`
 template <typename T>
@@ -450,6 +457,39 @@ BUILTIN_DEF(rand_i64, u64* regPtr, VirtualMachine*) {
     store(regPtr, randomValue);
 }
 
+/// ## Memory comparison, search and hashing
+
+BUILTIN_DEF(memcmp, u64* regPtr, VirtualMachine* vm) {
+    auto lhs = load<VirtualPointer>(regPtr);
+    auto lhsSize = load<size_t>(regPtr + 1);
+    auto rhs = load<VirtualPointer>(regPtr + 2);
+    auto rhsSize = load<size_t>(regPtr + 3);
+    store(regPtr, compareMemory(derefRange(vm, lhs, lhsSize), lhsSize,
+                                derefRange(vm, rhs, rhsSize), rhsSize));
+}
+
+BUILTIN_DEF(memchr, u64* regPtr, VirtualMachine* vm) {
+    auto data = load<VirtualPointer>(regPtr);
+    auto size = load<size_t>(regPtr + 1);
+    auto value = load<u8>(regPtr + 2);
+    store(regPtr, findByte(derefRange(vm, data, size), size, value));
+}
+
+BUILTIN_DEF(memfind, u64* regPtr, VirtualMachine* vm) {
+    auto data = load<VirtualPointer>(regPtr);
+    auto size = load<size_t>(regPtr + 1);
+    auto needle = load<VirtualPointer>(regPtr + 2);
+    auto needleSize = load<size_t>(regPtr + 3);
+    store(regPtr, findMemory(derefRange(vm, data, size), size,
+                             derefRange(vm, needle, needleSize), needleSize));
+}
+
+BUILTIN_DEF(hash, u64* regPtr, VirtualMachine* vm) {
+    auto data = load<VirtualPointer>(regPtr);
+    auto size = load<size_t>(regPtr + 1);
+    store(regPtr, hashMemory(derefRange(vm, data, size), size));
+}
+
 std::vector<BuiltinFunction> svm::makeBuiltinTable() {
     // clang-format off
     return {
@@ -9,6 +9,7 @@
 #include "Memory.h"
 #include "OpCode.h"
 #include "VMImpl.h"
+#include "VectorOps.h"
 
 #if defined(__GNUC__)
 #define ALWAYS_INLINE __attribute__((always_inline))
@@ -248,6 +249,35 @@ static void convert(u8 const* i, u64* reg) {
     storeReg(&reg[regIdx], static_cast<To>(a));
 }
 
+/// ## Packed vector operations
+
+static void vectorOpRR(u8 const* i, u64* reg) {
+    auto const op = static_cast<VectorOperation>(i[0]);
+    auto const lane = static_cast<VectorLane>(i[1]);
+    size_t const aRegIdx = i[2];
+    size_t const bRegIdx = i[3];
+    reg[aRegIdx] = vectorOp(op, lane, reg[aRegIdx], reg[bRegIdx]);
+}
+
+static void vectorSplatR(u8 const* i, u64* reg) {
+    auto const lane = static_cast<VectorLane>(i[0]);
+    size_t const destRegIdx = i[1];
+    size_t const sourceRegIdx = i[2];
+    reg[destRegIdx] = vectorSplat(lane, reg[sourceRegIdx]);
+}
+
+static void vectorMoveMR(VirtualMemory& memory, u8 const* i, u64* reg) {
+    VirtualPointer ptr = getPointer(reg, i);
+    size_t const sourceRegIdx = i[4];
+    std::memcpy(memory.dereference(ptr, 8), &reg[sourceRegIdx], 8);
+}
+
+static void vectorMoveRM(VirtualMemory& memory, u8 const* i, u64* reg) {
+    size_t const destRegIdx = i[0];
+    VirtualPointer ptr = getPointer(reg, i + 1);
+    std::memcpy(&reg[destRegIdx], memory.dereference(ptr, 8), 8);
+}
+
 /// ## Conditions
 static bool equal(CompareFlags f) { return f.equal; }
 static bool notEqual(CompareFlags f) { return !f.equal; }
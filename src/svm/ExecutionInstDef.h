@@ -660,6 +660,16 @@ INST_END(f64tou32)
 INST_BEGIN(f64tou64) { convert<f64, u64>(opPtr, regPtr); }
 INST_END(f64tou64)
 
+/// ## Packed vector operations
+INST_BEGIN(vop) { vectorOpRR(opPtr, regPtr); }
+INST_END(vop)
+INST_BEGIN(vsplat) { vectorSplatR(opPtr, regPtr); }
+INST_END(vsplat)
+INST_BEGIN(vmovRM) { vectorMoveRM(memory, opPtr, regPtr); }
+INST_END(vmovRM)
+INST_BEGIN(vmovMR) { vectorMoveMR(memory, opPtr, regPtr); }
+INST_END(vmovMR)
+
 #undef INST_BEGIN
 #undef INST_END
 #undef TERMINATE_EXECUTION
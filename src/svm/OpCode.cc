@@ -15,3 +15,67 @@ std::string_view svm::toString(OpCode c) {
 std::ostream& svm::operator<<(std::ostream& str, OpCode c) {
     return str << toString(c);
 }
+
+std::string_view svm::toString(VectorLane lane) {
+    using enum VectorLane;
+    switch (lane) {
+    case S8:
+        return "s8";
+    case S16:
+        return "s16";
+    case S32:
+        return "s32";
+    case S64:
+        return "s64";
+    case U8:
+        return "u8";
+    case U16:
+        return "u16";
+    case U32:
+        return "u32";
+    case U64:
+        return "u64";
+    case F32:
+        return "f32";
+    case F64:
+        return "f64";
+    }
+    unreachable();
+}
+
+std::string_view svm::toString(VectorOperation op) {
+    using enum VectorOperation;
+    switch (op) {
+    case Add:
+        return "add";
+    case Sub:
+        return "sub";
+    case Mul:
+        return "mul";
+    case Div:
+        return "div";
+    case Min:
+        return "min";
+    case Max:
+        return "max";
+    case CmpEq:
+        return "cmpeq";
+    case CmpLt:
+        return "cmplt";
+    case CmpGt:
+        return "cmpgt";
+    case And:
+        return "and";
+    case Or:
+        return "or";
+    case XOr:
+        return "xor";
+    case CmpNe:
+        return "cmpne";
+    case CmpLe:
+        return "cmple";
+    case CmpGe:
+        return "cmpge";
+    }
+    unreachable();
+}
@@ -304,6 +304,15 @@ void svm::print(u8 const* progData, std::ostream& str) {
                 str << printAs<u8>(text, i + 1) << ", "
                     << printAs<u16>(text, i + 2);
                 break;
+            case OpCode::vop:
+                str << toString(VectorOperation(text[i + 1])) << "."
+                    << toString(VectorLane(text[i + 2])) << " "
+                    << reg(text, i + 3) << ", " << reg(text, i + 4);
+                break;
+            case OpCode::vsplat:
+                str << toString(VectorLane(text[i + 1])) << " "
+                    << reg(text, i + 2) << ", " << reg(text, i + 3);
+                break;
             default:
                 assert(false);
             }
@@ -0,0 +1,252 @@
+#include "StringOps.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SVM_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) ||                                 \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SVM_SIMD_SSE2
+#endif
+
+#include "Memory.h"
+
+using namespace svm;
+
+namespace {
+
+/// Thin wrappers around the vector intrinsics so the algorithms below can be
+/// written once for both vector widths
+#if defined(SVM_SIMD_AVX2)
+
+using Vec = __m256i;
+
+constexpr size_t VecWidth = 32;
+
+constexpr u32 FullMask = 0xFFFF'FFFF;
+
+Vec vecLoad(u8 const* ptr) {
+    return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(ptr));
+}
+
+Vec vecSplat(u8 value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+
+/// \Returns a bitmask with bit `i` set iff byte `i` of \p a and \p b are equal
+u32 vecEqualMask(Vec a, Vec b) {
+    return static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)));
+}
+
+#elif defined(SVM_SIMD_SSE2)
+
+using Vec = __m128i;
+
+constexpr size_t VecWidth = 16;
+
+constexpr u32 FullMask = 0xFFFF;
+
+Vec vecLoad(u8 const* ptr) {
+    return _mm_loadu_si128(reinterpret_cast<__m128i const*>(ptr));
+}
+
+Vec vecSplat(u8 value) { return _mm_set1_epi8(static_cast<char>(value)); }
+
+/// \Returns a bitmask with bit `i` set iff byte `i` of \p a and \p b are equal
+u32 vecEqualMask(Vec a, Vec b) {
+    return static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)));
+}
+
+#endif
+
+} // namespace
+
+static i64 sign(i64 value) { return (value > 0) - (value < 0); }
+
+i64 svm::compareMemory(void const* lhs, size_t lhsSize, void const* rhs,
+                       size_t rhsSize) {
+    auto* a = static_cast<u8 const*>(lhs);
+    auto* b = static_cast<u8 const*>(rhs);
+    size_t size = std::min(lhsSize, rhsSize);
+#if defined(SVM_SIMD_AVX2) || defined(SVM_SIMD_SSE2)
+    size_t i = 0;
+    for (; i + VecWidth <= size; i += VecWidth) {
+        u32 mask = vecEqualMask(vecLoad(a + i), vecLoad(b + i));
+        if (mask != FullMask) {
+            size_t j = i + static_cast<size_t>(std::countr_zero(~mask));
+            return sign(i64{ a[j] } - i64{ b[j] });
+        }
+    }
+    for (; i < size; ++i) {
+        if (a[i] != b[i]) {
+            return sign(i64{ a[i] } - i64{ b[i] });
+        }
+    }
+#else
+    if (size > 0) {
+        if (int result = std::memcmp(a, b, size); result != 0) {
+            return sign(result);
+        }
+    }
+#endif
+    return sign(static_cast<i64>(lhsSize) - static_cast<i64>(rhsSize));
+}
+
+i64 svm::findByte(void const* data, size_t size, u8 value) {
+    auto* p = static_cast<u8 const*>(data);
+#if defined(SVM_SIMD_AVX2) || defined(SVM_SIMD_SSE2)
+    size_t i = 0;
+    Vec splat = vecSplat(value);
+    for (; i + VecWidth <= size; i += VecWidth) {
+        u32 mask = vecEqualMask(vecLoad(p + i), splat);
+        if (mask != 0) {
+            return static_cast<i64>(i) + std::countr_zero(mask);
+        }
+    }
+    for (; i < size; ++i) {
+        if (p[i] == value) {
+            return static_cast<i64>(i);
+        }
+    }
+    return -1;
+#else
+    if (size == 0) {
+        return -1;
+    }
+    auto* result = static_cast<u8 const*>(std::memchr(p, value, size));
+    return result ? result - p : -1;
+#endif
+}
+
+i64 svm::findMemory(void const* data, size_t size, void const* needle,
+                    size_t needleSize) {
+    auto* p = static_cast<u8 const*>(data);
+    auto* n = static_cast<u8 const*>(needle);
+    if (needleSize == 0) {
+        return 0;
+    }
+    if (needleSize > size) {
+        return -1;
+    }
+    if (needleSize == 1) {
+        return findByte(p, size, n[0]);
+    }
+    /// Last index at which the needle can start
+    size_t last = size - needleSize;
+    size_t i = 0;
+#if defined(SVM_SIMD_AVX2) || defined(SVM_SIMD_SSE2)
+    /// We compare the first and the last byte of the needle against
+    /// `VecWidth` candidate positions at once and only compare the full needle
+    /// at positions where both match.
+    Vec first = vecSplat(n[0]);
+    Vec back = vecSplat(n[needleSize - 1]);
+    for (; i + VecWidth - 1 <= last; i += VecWidth) {
+        u32 mask = vecEqualMask(vecLoad(p + i), first) &
+                   vecEqualMask(vecLoad(p + i + needleSize - 1), back);
+        while (mask != 0) {
+            size_t j = i + static_cast<size_t>(std::countr_zero(mask));
+            if (std::memcmp(p + j + 1, n + 1, needleSize - 2) == 0) {
+                return static_cast<i64>(j);
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+    while (i <= last) {
+        i64 offset = findByte(p + i, last - i + 1, n[0]);
+        if (offset < 0) {
+            return -1;
+        }
+        i += static_cast<size_t>(offset);
+        if (std::memcmp(p + i + 1, n + 1, needleSize - 1) == 0) {
+            return static_cast<i64>(i);
+        }
+        ++i;
+    }
+    return -1;
+}
+
+/// # wyhash
+
+/// Computes the 128 bit product of \p A and \p B and stores the low half in
+/// \p A and the high half in \p B
+static void wymum(u64& A, u64& B) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = A;
+    r *= B;
+    A = static_cast<u64>(r);
+    B = static_cast<u64>(r >> 64);
+#else
+    u64 ha = A >> 32, hb = B >> 32, la = (u32)A, lb = (u32)B;
+    u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    u64 t = rl + (rm0 << 32);
+    u64 c = t < rl;
+    u64 lo = t + (rm1 << 32);
+    c += lo < t;
+    u64 hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+    A = lo;
+    B = hi;
+#endif
+}
+
+static u64 wymix(u64 A, u64 B) {
+    wymum(A, B);
+    return A ^ B;
+}
+
+static u64 wyr8(u8 const* p) { return load<u64>(p); }
+
+static u64 wyr4(u8 const* p) { return load<u32>(p); }
+
+static u64 wyr3(u8 const* p, size_t k) {
+    return (u64{ p[0] } << 16) | (u64{ p[k >> 1] } << 8) | p[k - 1];
+}
+
+static constexpr u64 WySecret[4] = { 0x2d358dccaa6c78a5ull,
+                                     0x8bb84b93962eacc9ull,
+                                     0x4b33a62ed433d4a3ull,
+                                     0x4d5a2da51de1aa47ull };
+
+u64 svm::hashMemory(void const* data, size_t size, u64 seed) {
+    auto* p = static_cast<u8 const*>(data);
+    auto* secret = WySecret;
+    seed ^= wymix(seed ^ secret[0], secret[1]);
+    u64 a = 0, b = 0;
+    if (SVM_LIKELY(size <= 16)) {
+        if (SVM_LIKELY(size >= 4)) {
+            size_t offset = (size >> 3) << 2;
+            a = (wyr4(p) << 32) | wyr4(p + offset);
+            b = (wyr4(p + size - 4) << 32) | wyr4(p + size - 4 - offset);
+        }
+        else if (SVM_LIKELY(size > 0)) {
+            a = wyr3(p, size);
+        }
+    }
+    else {
+        size_t i = size;
+        if (SVM_UNLIKELY(i > 48)) {
+            u64 see1 = seed, see2 = seed;
+            do {
+                seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+                see1 = wymix(wyr8(p + 16) ^ secret[2], wyr8(p + 24) ^ see1);
+                see2 = wymix(wyr8(p + 32) ^ secret[3], wyr8(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (SVM_LIKELY(i > 48));
+            seed ^= see1 ^ see2;
+        }
+        while (SVM_UNLIKELY(i > 16)) {
+            seed = wymix(wyr8(p) ^ secret[1], wyr8(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = wyr8(p + i - 16);
+        b = wyr8(p + i - 8);
+    }
+    a ^= secret[1];
+    b ^= seed;
+    wymum(a, b);
+    return wymix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
@@ -0,0 +1,38 @@
+#ifndef SVM_STRINGOPS_H_
+#define SVM_STRINGOPS_H_
+
+#include <cstddef>
+
+#include "Common.h"
+
+/// Native implementations of the memory comparison, search and hashing
+/// builtins. On x86 the functions are vectorized with AVX2 or SSE2 depending
+/// on the target flags, on other platforms a scalar fallback is used.
+
+namespace svm {
+
+/// Lexicographically compares the byte ranges `[lhs, lhs + lhsSize)` and
+/// `[rhs, rhs + rhsSize)`
+/// \Returns a negative value if \p lhs is less than \p rhs, zero if both are
+/// equal and a positive value if \p lhs is greater than \p rhs. If one range
+/// is a prefix of the other, the shorter range compares less
+i64 compareMemory(void const* lhs, size_t lhsSize, void const* rhs,
+                  size_t rhsSize);
+
+/// \Returns the index of the first occurence of \p value in
+/// `[data, data + size)` or `-1` if \p value does not occur
+i64 findByte(void const* data, size_t size, u8 value);
+
+/// \Returns the index of the first occurence of the byte sequence
+/// `[needle, needle + needleSize)` in `[data, data + size)` or `-1` if the
+/// sequence does not occur. An empty needle is found at index zero
+i64 findMemory(void const* data, size_t size, void const* needle,
+               size_t needleSize);
+
+/// Fast non-cryptographic 64 bit hash of the byte range `[data, data + size)`
+/// This implements _wyhash_ (https://github.com/wangyi-fudan/wyhash)
+u64 hashMemory(void const* data, size_t size, u64 seed = 0);
+
+} // namespace svm
+
+#endif // SVM_STRINGOPS_H_
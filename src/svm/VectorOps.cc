@@ -0,0 +1,407 @@
+#include "VectorOps.h"
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SVM_SIMD_SSE2
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#define SVM_SIMD_SSE41
+#endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#define SVM_SIMD_SSE42
+#endif
+#endif
+
+#include "ArithmeticOps.h"
+#include "Errors.h"
+
+using namespace svm;
+
+/// # Scalar fallback
+
+/// Applies \p f to all lanes of \p a and \p b interpreted as `T`
+template <typename T>
+static u64 lanewise(u64 a, u64 b, auto f) {
+    constexpr size_t N = sizeof(u64) / sizeof(T);
+    T x[N], y[N];
+    std::memcpy(x, &a, sizeof(u64));
+    std::memcpy(y, &b, sizeof(u64));
+    for (size_t i = 0; i < N; ++i) {
+        x[i] = static_cast<T>(f(x[i], y[i]));
+    }
+    std::memcpy(&a, x, sizeof(u64));
+    return a;
+}
+
+/// Applies the predicate \p pred to all lanes of \p a and \p b interpreted as
+/// `T` and sets all bits of the lanes where \p pred holds
+template <typename T>
+static u64 lanewiseMask(u64 a, u64 b, auto pred) {
+    constexpr size_t N = sizeof(u64) / sizeof(T);
+    T x[N], y[N];
+    std::memcpy(x, &a, sizeof(u64));
+    std::memcpy(y, &b, sizeof(u64));
+    u8 result[sizeof(u64)];
+    for (size_t i = 0; i < N; ++i) {
+        std::memset(result + i * sizeof(T), pred(x[i], y[i]) ? 0xFF : 0,
+                    sizeof(T));
+    }
+    std::memcpy(&a, result, sizeof(u64));
+    return a;
+}
+
+template <typename T>
+static u64 scalarOp(VectorOperation op, u64 a, u64 b) {
+    using Op = VectorOperation;
+    switch (op) {
+    case Op::Add:
+        return lanewise<T>(a, b, svm::Add);
+    case Op::Sub:
+        return lanewise<T>(a, b, svm::Sub);
+    case Op::Mul:
+        return lanewise<T>(a, b, svm::Mul);
+    case Op::Div:
+        return lanewise<T>(a, b, svm::Div);
+    case Op::Min:
+        return lanewise<T>(a, b, [](T x, T y) { return x < y ? x : y; });
+    case Op::Max:
+        return lanewise<T>(a, b, [](T x, T y) { return x > y ? x : y; });
+    case Op::CmpEq:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x == y; });
+    case Op::CmpLt:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x < y; });
+    case Op::CmpGt:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x > y; });
+    case Op::CmpNe:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x != y; });
+    case Op::CmpLe:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x <= y; });
+    case Op::CmpGe:
+        return lanewiseMask<T>(a, b, [](T x, T y) { return x >= y; });
+    case Op::And:
+        return a & b;
+    case Op::Or:
+        return a | b;
+    case Op::XOr:
+        return a ^ b;
+    }
+    throwError<InvalidOpcodeError>(static_cast<u64>(op));
+}
+
+/// Invokes `f.template operator()<T>()` where `T` is the C++ type of \p lane
+static u64 visitLane(VectorLane lane, auto f) {
+    using enum VectorLane;
+    switch (lane) {
+    case S8:
+        return f.template operator()<i8>();
+    case S16:
+        return f.template operator()<i16>();
+    case S32:
+        return f.template operator()<i32>();
+    case S64:
+        return f.template operator()<i64>();
+    case U8:
+        return f.template operator()<u8>();
+    case U16:
+        return f.template operator()<u16>();
+    case U32:
+        return f.template operator()<u32>();
+    case U64:
+        return f.template operator()<u64>();
+    case F32:
+        return f.template operator()<f32>();
+    case F64:
+        return f.template operator()<f64>();
+    }
+    throwError<InvalidOpcodeError>(static_cast<u64>(lane));
+}
+
+/// # SSE implementation
+
+#if defined(SVM_SIMD_SSE2)
+
+/// Loads \p v into the low half of an SSE register. The high half is zero
+static __m128i toSSE(u64 v) {
+    return _mm_loadl_epi64(reinterpret_cast<__m128i const*>(&v));
+}
+
+/// \Returns the low half of \p v
+static u64 fromSSE(__m128i v) {
+    u64 result;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(&result), v);
+    return result;
+}
+
+static __m128 toPS(u64 v) { return _mm_castsi128_ps(toSSE(v)); }
+
+static u64 fromPS(__m128 v) { return fromSSE(_mm_castps_si128(v)); }
+
+static __m128d toPD(u64 v) { return _mm_castsi128_pd(toSSE(v)); }
+
+static u64 fromPD(__m128d v) { return fromSSE(_mm_castpd_si128(v)); }
+
+/// Stores \p v in \p result
+/// \Returns `true` to make returning from `sseOp()` more concise
+static bool assign(u64& result, __m128i v) {
+    result = fromSSE(v);
+    return true;
+}
+
+/// \overload
+static bool assign(u64& result, __m128 v) {
+    result = fromPS(v);
+    return true;
+}
+
+/// \overload
+static bool assign(u64& result, __m128d v) {
+    result = fromPD(v);
+    return true;
+}
+
+/// Computes `a op b` with SSE instructions if the host supports the operation
+/// for the lane type \p lane.
+/// \Returns `false` if no SSE implementation is available
+static bool sseOp(VectorOperation op, VectorLane lane, u64 a, u64 b,
+                  u64& result) {
+    using enum VectorLane;
+    using Op = VectorOperation;
+    __m128i x = toSSE(a), y = toSSE(b);
+    /// Floating point lanes are handled separately because they use different
+    /// register types. Float division by zero must be diagnosed, so we leave
+    /// division to the scalar path if any divisor lane is zero. Only the low
+    /// half of the SSE registers holds our lanes, so we mask the comparison
+    /// results accordingly.
+    if (lane == F32) {
+        __m128 fx = toPS(a), fy = toPS(b);
+        switch (op) {
+        case Op::Add:
+            return assign(result, _mm_add_ps(fx, fy));
+        case Op::Sub:
+            return assign(result, _mm_sub_ps(fx, fy));
+        case Op::Mul:
+            return assign(result, _mm_mul_ps(fx, fy));
+        case Op::Div: {
+            int zeroLanes = _mm_movemask_ps(_mm_cmpeq_ps(fy, _mm_setzero_ps()));
+            if ((zeroLanes & 0b11) != 0) {
+                return false;
+            }
+            return assign(result, _mm_div_ps(fx, fy));
+        }
+        case Op::Min:
+            return assign(result, _mm_min_ps(fx, fy));
+        case Op::Max:
+            return assign(result, _mm_max_ps(fx, fy));
+        case Op::CmpEq:
+            return assign(result, _mm_cmpeq_ps(fx, fy));
+        case Op::CmpLt:
+            return assign(result, _mm_cmplt_ps(fx, fy));
+        case Op::CmpGt:
+            return assign(result, _mm_cmpgt_ps(fx, fy));
+        case Op::CmpNe:
+            return assign(result, _mm_cmpneq_ps(fx, fy));
+        case Op::CmpLe:
+            return assign(result, _mm_cmple_ps(fx, fy));
+        case Op::CmpGe:
+            return assign(result, _mm_cmpge_ps(fx, fy));
+        default:
+            break;
+        }
+    }
+    else if (lane == F64) {
+        __m128d fx = toPD(a), fy = toPD(b);
+        switch (op) {
+        case Op::Add:
+            return assign(result, _mm_add_pd(fx, fy));
+        case Op::Sub:
+            return assign(result, _mm_sub_pd(fx, fy));
+        case Op::Mul:
+            return assign(result, _mm_mul_pd(fx, fy));
+        case Op::Div: {
+            int zeroLanes = _mm_movemask_pd(_mm_cmpeq_pd(fy, _mm_setzero_pd()));
+            if ((zeroLanes & 0b1) != 0) {
+                return false;
+            }
+            return assign(result, _mm_div_pd(fx, fy));
+        }
+        case Op::Min:
+            return assign(result, _mm_min_pd(fx, fy));
+        case Op::Max:
+            return assign(result, _mm_max_pd(fx, fy));
+        case Op::CmpEq:
+            return assign(result, _mm_cmpeq_pd(fx, fy));
+        case Op::CmpLt:
+            return assign(result, _mm_cmplt_pd(fx, fy));
+        case Op::CmpGt:
+            return assign(result, _mm_cmpgt_pd(fx, fy));
+        case Op::CmpNe:
+            return assign(result, _mm_cmpneq_pd(fx, fy));
+        case Op::CmpLe:
+            return assign(result, _mm_cmple_pd(fx, fy));
+        case Op::CmpGe:
+            return assign(result, _mm_cmpge_pd(fx, fy));
+        default:
+            break;
+        }
+    }
+    switch (op) {
+    case Op::Add:
+        switch (lane) {
+        case S8:
+        case U8:
+            return assign(result, _mm_add_epi8(x, y));
+        case S16:
+        case U16:
+            return assign(result, _mm_add_epi16(x, y));
+        case S32:
+        case U32:
+            return assign(result, _mm_add_epi32(x, y));
+        case S64:
+        case U64:
+            return assign(result, _mm_add_epi64(x, y));
+        default:
+            return false;
+        }
+    case Op::Sub:
+        switch (lane) {
+        case S8:
+        case U8:
+            return assign(result, _mm_sub_epi8(x, y));
+        case S16:
+        case U16:
+            return assign(result, _mm_sub_epi16(x, y));
+        case S32:
+        case U32:
+            return assign(result, _mm_sub_epi32(x, y));
+        case S64:
+        case U64:
+            return assign(result, _mm_sub_epi64(x, y));
+        default:
+            return false;
+        }
+    case Op::Mul:
+        switch (lane) {
+        case S16:
+        case U16:
+            return assign(result, _mm_mullo_epi16(x, y));
+#if defined(SVM_SIMD_SSE41)
+        case S32:
+        case U32:
+            return assign(result, _mm_mullo_epi32(x, y));
+#endif
+        default:
+            return false;
+        }
+    case Op::Min:
+        switch (lane) {
+        case U8:
+            return assign(result, _mm_min_epu8(x, y));
+        case S16:
+            return assign(result, _mm_min_epi16(x, y));
+#if defined(SVM_SIMD_SSE41)
+        case S8:
+            return assign(result, _mm_min_epi8(x, y));
+        case U16:
+            return assign(result, _mm_min_epu16(x, y));
+        case S32:
+            return assign(result, _mm_min_epi32(x, y));
+        case U32:
+            return assign(result, _mm_min_epu32(x, y));
+#endif
+        default:
+            return false;
+        }
+    case Op::Max:
+        switch (lane) {
+        case U8:
+            return assign(result, _mm_max_epu8(x, y));
+        case S16:
+            return assign(result, _mm_max_epi16(x, y));
+#if defined(SVM_SIMD_SSE41)
+        case S8:
+            return assign(result, _mm_max_epi8(x, y));
+        case U16:
+            return assign(result, _mm_max_epu16(x, y));
+        case S32:
+            return assign(result, _mm_max_epi32(x, y));
+        case U32:
+            return assign(result, _mm_max_epu32(x, y));
+#endif
+        default:
+            return false;
+        }
+    case Op::CmpEq:
+        switch (lane) {
+        case S8:
+        case U8:
+            return assign(result, _mm_cmpeq_epi8(x, y));
+        case S16:
+        case U16:
+            return assign(result, _mm_cmpeq_epi16(x, y));
+        case S32:
+        case U32:
+            return assign(result, _mm_cmpeq_epi32(x, y));
+#if defined(SVM_SIMD_SSE41)
+        case S64:
+        case U64:
+            return assign(result, _mm_cmpeq_epi64(x, y));
+#endif
+        default:
+            return false;
+        }
+    case Op::CmpLt:
+        std::swap(x, y);
+        [[fallthrough]];
+    case Op::CmpGt:
+        switch (lane) {
+        case S8:
+            return assign(result, _mm_cmpgt_epi8(x, y));
+        case S16:
+            return assign(result, _mm_cmpgt_epi16(x, y));
+        case S32:
+            return assign(result, _mm_cmpgt_epi32(x, y));
+#if defined(SVM_SIMD_SSE42)
+        case S64:
+            return assign(result, _mm_cmpgt_epi64(x, y));
+#endif
+        default:
+            return false;
+        }
+    case Op::And:
+        return assign(result, _mm_and_si128(x, y));
+    case Op::Or:
+        return assign(result, _mm_or_si128(x, y));
+    case Op::XOr:
+        return assign(result, _mm_xor_si128(x, y));
+    default:
+        return false;
+    }
+}
+
+#endif // SVM_SIMD_SSE2
+
+u64 svm::vectorOp(VectorOperation op, VectorLane lane, u64 a, u64 b) {
+#if defined(SVM_SIMD_SSE2)
+    u64 result;
+    if (SVM_LIKELY(sseOp(op, lane, a, b, result))) {
+        return result;
+    }
+#endif
+    return visitLane(lane,
+                     [&]<typename T>() { return scalarOp<T>(op, a, b); });
+}
+
+u64 svm::vectorSplat(VectorLane lane, u64 value) {
+    size_t size = laneSize(lane);
+    u8 bytes[sizeof(u64)];
+    for (size_t i = 0; i < sizeof(u64); i += size) {
+        std::memcpy(bytes + i, &value, size);
+    }
+    u64 result;
+    std::memcpy(&result, bytes, sizeof(u64));
+    return result;
+}
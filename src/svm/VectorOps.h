@@ -0,0 +1,26 @@
+#ifndef SVM_VECTOROPS_H_
+#define SVM_VECTOROPS_H_
+
+#include "Common.h"
+#include "OpCode.h"
+
+/// Native implementations of the packed vector instructions. On x86 the
+/// operations are implemented with SSE intrinsics, other targets and
+/// operations that SSE does not provide use a lane wise scalar fallback.
+/// Each call operates on one register, i.e. on 8 bytes of lanes passed as the
+/// `u64` register value.
+
+namespace svm {
+
+/// Computes `a op b` lane wise
+/// Throws `ArithmeticError` on division by zero and `InvalidOpcodeError` if
+/// \p op or \p lane are invalid
+u64 vectorOp(VectorOperation op, VectorLane lane, u64 a, u64 b);
+
+/// \Returns a vector with all lanes set to the low `laneSize(lane)` bytes of
+/// \p value
+u64 vectorSplat(VectorLane lane, u64 value);
+
+} // namespace svm
+
+#endif // SVM_VECTOROPS_H_
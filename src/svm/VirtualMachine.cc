@@ -242,7 +242,12 @@ void VirtualMachine::beginExecution(size_t startAddress,
 
 bool VirtualMachine::running() const { return impl->running(); }
 
-void VirtualMachine::stepExecution() { impl->stepExecution(); }
+void VirtualMachine::stepExecution() {
+    /// We count here and not in `VMImpl::stepExecution()` because
+    /// `executeNoJumpThread()` uses the latter and shall not be slowed down
+    ++impl->stats.executedInstructions;
+    impl->stepExecution();
+}
 
 u64 const* VirtualMachine::endExecution() { return impl->endExecution(); }
 
@@ -258,6 +263,18 @@ void VirtualMachine::reset() {
           .stackPtr = VirtualMemory::MakeStaticDataPointer(impl->binarySize) });
 }
 
+VMStats VirtualMachine::stats() const {
+    VMStats result = impl->stats;
+    result.heapBytes = impl->memory.allocatedBytes();
+    result.peakHeapBytes = impl->memory.peakAllocatedBytes();
+    return result;
+}
+
+void VirtualMachine::resetStats() {
+    impl->stats.executedInstructions = 0;
+    impl->memory.resetPeakAllocatedBytes();
+}
+
 size_t VirtualMachine::instructionPointerOffset() const {
     return impl->instructionPointerOffset();
 }
@@ -144,6 +144,8 @@ VirtualPointer VirtualMemory::allocate(size_t size, size_t align) {
     if (std::popcount(align) != 1 || size % align != 0) {
         throwError<AllocationError>(AllocationError::InvalidAlign, size, align);
     }
+    numAllocatedBytes += size;
+    numPeakAllocatedBytes = std::max(numPeakAllocatedBytes, numAllocatedBytes);
     if (size <= MaxPoolSize) {
         auto [slotIndex, pool] = getPool(size, align);
         size_t offset = pool.allocate(slots[slotIndex]);
@@ -184,12 +186,14 @@ void VirtualMemory::deallocate(VirtualPointer ptr, size_t size, size_t align) {
         if (!pool.deallocate(slots[slotIndex], ptr.offset)) {
             reportDeallocationError(ptr, size, align);
         }
+        numAllocatedBytes -= size;
         return;
     }
     if (ptr.slotIndex <= LastPoolIndex) {
         reportDeallocationError(ptr, size, align);
     }
     freeSlots.push_back(ptr.slotIndex);
+    numAllocatedBytes -= size;
 }
 
 void VirtualMemory::resizeStaticSlot(size_t size) {
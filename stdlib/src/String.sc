@@ -54,9 +54,8 @@ public struct String {
         if this.buf.count <= this.sz + text.count {
             this.growLeast(this.sz + text.count);
         }
-        for i = 0; i < text.count; ++i {
-            this.buf[this.sz++] = text[i];
-        }
+        __builtin_memcpy(&mut this.buf[this.sz : this.sz + text.count], text);
+        this.sz += text.count;
     }
 
     /// \overload
@@ -95,6 +94,56 @@ public struct String {
     /// \overload 
     fn data(&mut this) -> *mut str { return &mut this.buf[0 : this.sz]; }
 
+    /// # Comparison
+
+    /// \Returns `true` if this string consists of the same characters as \p text
+    fn equal(&this, text: *str) -> bool {
+        return __builtin_memcmp(this.data(), text) == 0;
+    }
+
+    /// \overload
+    fn equal(&this, rhs: &String) -> bool {
+        return this.equal(rhs.data());
+    }
+
+    /// Lexicographically compares this string to \p text
+    /// \Returns `-1` if this string is less than \p text, `0` if both are equal
+    /// and `1` if this string is greater than \p text
+    fn compare(&this, text: *str) -> int {
+        return __builtin_memcmp(this.data(), text);
+    }
+
+    /// \overload
+    fn compare(&this, rhs: &String) -> int {
+        return this.compare(rhs.data());
+    }
+
+    /// # Search
+
+    /// \Returns the index of the first occurence of \p char or `-1` if this
+    /// string does not contain \p char
+    fn find(&this, char: byte) -> int {
+        return __builtin_memchr(this.data(), char);
+    }
+
+    /// \Returns the index of the first occurence of \p text or `-1` if this
+    /// string does not contain \p text
+    fn find(&this, text: *str) -> int {
+        return __builtin_memfind(this.data(), text);
+    }
+
+    /// \Returns `true` if \p text is a substring of this string
+    fn contains(&this, text: *str) -> bool {
+        return this.find(text) >= 0;
+    }
+
+    /// # Hashing
+
+    /// \Returns a hash value of the characters in this string
+    fn hash(&this) -> u64 {
+        return __builtin_hash(this.data());
+    }
+
     /// # Internals
 
     /// Grows the maintained buffer by a factor of two
@@ -52,6 +52,40 @@ fn stringInsertStringRef() {
     check("Insert string", strcmp("Hello World!", s.data()));
 }
 
+fn stringEqual() {
+    let s = std.String("Hello World");
+    check("Equal to same text", s.equal("Hello World"));
+    check("Not equal to prefix", !s.equal("Hello"));
+    check("Not equal to different text", !s.equal("Hello world"));
+    check("Equal to copy", s.equal(std.String("Hello World")));
+}
+
+fn stringCompare() {
+    let s = std.String("abc");
+    check("Compare equal", s.compare("abc") == 0);
+    check("Compare less", s.compare("abd") < 0);
+    check("Compare greater", s.compare("abb") > 0);
+    check("Compare prefix", s.compare("ab") > 0);
+    check("Compare empty", std.String().compare("a") < 0);
+}
+
+fn stringFind() {
+    let s = std.String("Hello World");
+    check("Find char", s.find('o') == 4);
+    check("Find missing char", s.find('x') == -1);
+    check("Find text", s.find("World") == 6);
+    check("Find missing text", s.find("world") == -1);
+    check("Contains", s.contains("lo W"));
+}
+
+fn stringHash() {
+    let s = std.String("Hello World");
+    let t = std.String("Hello World");
+    check("Equal strings have equal hashes", s.hash() == t.hash());
+    check("Different strings have different hashes",
+          s.hash() != std.String("Hello").hash());
+}
+
 fn main() {
     stringCopyCtor();
     stringMoveCtor();
@@ -59,6 +93,10 @@ fn main() {
     stringAppendStringRef();
     stringAppendString();    
     stringInsertStringRef();
+    stringEqual();
+    stringCompare();
+    stringFind();
+    stringHash();
     __builtin_putstr("PASSED: String tests\n");
     return 0;
 }
@@ -0,0 +1,46 @@
+#include <sstream>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "Assembly/AssemblyStream.h"
+#include "CodeGen/CodeGen.h"
+#include "Common/ThreadPool.h"
+#include "IR/Context.h"
+#include "IR/IRParser.h"
+#include "IR/Module.h"
+
+using namespace scatha;
+
+TEST_CASE("Codegen - Assembly does not depend on the number of threads",
+          "[codegen]") {
+    std::string source;
+    for (int i = 0; i < 64; ++i) {
+        auto n = std::to_string(i);
+        auto callee = std::to_string((i * 7 + 3) % 64);
+        source += "func i64 @f" + n + "(i64 %0, i64 %1) {\n  %entry:\n" +
+                  "    %c = scmp ls i64 %0, i64 " + n + "\n" +
+                  "    branch i1 %c, label %then, label %end\n" +
+                  "  %then:\n" + "    %2 = mul i64 %0, i64 %1\n" +
+                  "    %3 = call i64 @f" + callee + ", i64 %2, i64 %0\n" +
+                  "    goto label %end\n" + "  %end:\n" +
+                  "    %4 = phi i64 [label %entry : %1], [label %then : %3]\n" +
+                  "    return i64 %4\n}\n";
+    }
+    auto [ctx, mod] = ir::parse(source).value();
+    auto generate = [&](size_t concurrency, bool logStages) {
+        ThreadPool::setGlobalConcurrency(concurrency);
+        std::stringstream log;
+        cg::DebugLogger debugLogger(log);
+        cg::NullLogger nullLogger;
+        auto assembly = logStages ? cg::codegen(mod, debugLogger) :
+                                    cg::codegen(mod, nullLogger);
+        std::stringstream sstr;
+        Asm::print(assembly, sstr);
+        return std::move(sstr).str();
+    };
+    auto const sequential = generate(1, false);
+    CHECK(generate(4, false) == sequential);
+    CHECK(generate(4, true) == sequential);
+    ThreadPool::setGlobalConcurrency(0);
+}
@@ -11,7 +11,9 @@
 #include "MIR/CFG.h"
 #include "MIR/Context.h"
 #include "MIR/LiveInterval.h"
+#include "MIR/LiveSet.h"
 #include "MIR/Module.h"
+#include "MIR/Register.h"
 #include "Opt/Common.h"
 
 using namespace scatha;
@@ -54,6 +56,63 @@ func i64 @f(i64 %0) {
     CHECK(end->isLiveIn(nReg));
 }
 
+TEST_CASE("Live sets", "[codegen][mir]") {
+    using namespace mir;
+    auto const text = R"(
+func void @f() {
+  %entry:
+    return
+})";
+    auto [irCtx, irMod] = ir::parse(text).value();
+    mir::Context ctx;
+    auto mod = cg::lowerToMIR(ctx, irMod);
+    auto& F = mod.front();
+    std::vector<VirtualRegister*> regs;
+    for (size_t i = 0; i < 150; ++i) {
+        auto* reg = new VirtualRegister();
+        F.virtualRegisters().add(reg);
+        regs.push_back(reg);
+    }
+    auto* callee = new CalleeRegister();
+    F.calleeRegisters().add(callee);
+    LiveSet A, B;
+    CHECK(A.empty());
+    CHECK(A.insert(regs[3]));
+    CHECK(!A.insert(regs[3]));
+    A.insert(regs[70]);
+    A.insert(callee);
+    B.insert(regs[70]);
+    B.insert(regs[140]);
+    CHECK(A.size() == 3);
+    CHECK(A.contains(regs[3]));
+    CHECK(!A.contains(regs[4]));
+    CHECK(!A.contains(regs[140]));
+    CHECK(!A.contains(nullptr));
+    SECTION("Iteration is ordered by kind and index") {
+        std::vector<Register*> elems(A.begin(), A.end());
+        CHECK(elems == std::vector<Register*>{ regs[3], regs[70], callee });
+    }
+    SECTION("Union") {
+        A |= B;
+        CHECK(A.size() == 4);
+        CHECK(A.contains(regs[140]));
+    }
+    SECTION("Difference") {
+        A -= B;
+        CHECK(A.size() == 2);
+        CHECK(!A.contains(regs[70]));
+        CHECK(A.contains(regs[3]));
+    }
+    SECTION("Equality ignores trailing zero words") {
+        CHECK(B.erase(regs[140]));
+        CHECK(!B.erase(regs[140]));
+        LiveSet C;
+        C.insert(regs[70]);
+        CHECK(B == C);
+        CHECK(B != A);
+    }
+}
+
 TEST_CASE("Program intervals", "[codegen][mir]") {
     using namespace mir;
     SECTION("Compare)") {
@@ -0,0 +1,100 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "CodeGen/LinearScan.h"
+#include "CodeGen/Passes.h"
+#include "CodeGen/Utility.h"
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/IRParser.h"
+#include "IR/Module.h"
+#include "MIR/CFG.h"
+#include "MIR/Context.h"
+#include "MIR/LiveInterval.h"
+#include "MIR/Module.h"
+#include "MIR/Register.h"
+
+using namespace scatha;
+
+/// Definitions that are never read still occupy the defining instruction
+static mir::LiveInterval occupied(mir::LiveInterval I) {
+    return { I.begin, std::max(I.end, I.begin + 1), I.reg };
+}
+
+static bool interfere(mir::Register const& a, mir::Register const& b) {
+    for (auto I: a.liveRange()) {
+        for (auto J: b.liveRange()) {
+            if (overlaps(occupied(I), occupied(J))) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_CASE("Linear scan register allocation", "[codegen][mir]") {
+    auto const text = R"(
+func i64 @g(i64 %a, i64 %b) {
+  %entry:
+    %c = mul i64 %a, i64 %b
+    return i64 %c
+}
+func i64 @f(i64 %n, i64 %x) {
+  %entry:
+    goto label %header
+  %header:
+    %i = phi i64 [label %entry : 0], [label %body : %i.1]
+    %s = phi i64 [label %entry : %x], [label %body : %s.1]
+    %ls = scmp ls i64 %i, i64 %n
+    branch i1 %ls, label %body, label %end
+  %body:
+    %a = mul i64 %i, i64 3
+    %b = add i64 %a, i64 %s
+    %c = xor i64 %b, i64 %x
+    %d = call i64 @g, i64 %c, i64 %a
+    %e = sub i64 %d, i64 %b
+    %s.1 = add i64 %e, i64 %c
+    %i.1 = add i64 %i, i64 1
+    goto label %header
+  %end:
+    return i64 %s
+})";
+    auto [irCtx, irMod] = ir::parse(text).value();
+    mir::Context ctx;
+    auto mod = cg::lowerToMIR(ctx, irMod);
+    for (auto& F: mod) {
+        cg::computeLiveSets(ctx, F);
+        cg::destroySSA(ctx, F);
+        cg::coalesceCopies(ctx, F);
+        auto assignment = cg::linearScan(F);
+        /// The allocator renumbers the program points, so we recompute the
+        /// precise live ranges to check against
+        for (auto& reg: F.virtAndCalleeRegs()) {
+            cg::computeLiveRange(F, reg);
+        }
+        std::vector<mir::VirtualRegister*> regs;
+        for (auto& reg: F.virtualRegisters()) {
+            regs.push_back(&reg);
+        }
+        REQUIRE(assignment.colors.size() == F.virtualRegisters().size());
+        for (auto* reg: regs) {
+            auto color = assignment.colors[reg->index()];
+            CHECK(color < assignment.numColors);
+            if (reg->fixed()) {
+                CHECK(color == reg->index());
+            }
+        }
+        for (auto* a: regs) {
+            for (auto* b: regs) {
+                if (a->index() < b->index() && interfere(*a, *b)) {
+                    INFO(F.name() << ": %" << a->index() << " and %"
+                                  << b->index());
+                    CHECK(assignment.colors[a->index()] !=
+                          assignment.colors[b->index()]);
+                }
+            }
+        }
+    }
+}
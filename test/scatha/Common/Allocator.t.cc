@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstddef>
+#include <cstring>
+
 #include "Common/Allocator.h"
 
 using namespace scatha;
@@ -32,3 +35,18 @@ TEST_CASE("MonotonicBufferAllocator") {
         std::memset(ptr, 0, 16);
     }
 }
+
+TEST_CASE("AllocationStats") {
+    size_t const live = AllocationStats::liveBytes();
+    AllocationStats::resetPeakBytes();
+    void* ptr = internal::allocateTracked(100);
+    CHECK(reinterpret_cast<size_t>(ptr) % alignof(std::max_align_t) == 0);
+    CHECK(AllocationStats::liveBytes() == live + 100);
+    {
+        MonotonicBufferAllocator alloc(256);
+        CHECK(AllocationStats::liveBytes() == live + 356);
+    }
+    internal::deallocateTracked(ptr);
+    CHECK(AllocationStats::liveBytes() == live);
+    CHECK(AllocationStats::peakBytes() == live + 356);
+}
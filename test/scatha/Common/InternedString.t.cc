@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Common/InternedString.h"
+#include "Common/ThreadPool.h"
+
+using namespace scatha;
+
+TEST_CASE("InternedString identity", "[common]") {
+    std::string text = "some_identifier";
+    InternedString a(text);
+    InternedString b(std::string_view("some_identifier"));
+    CHECK(a == b);
+    CHECK(a.str() == "some_identifier");
+    CHECK(a.str().data() == b.str().data());
+    CHECK(a != InternedString("other_identifier"));
+    CHECK(InternedString("").empty());
+    CHECK(InternedString() == InternedString(""));
+    CHECK(InternedString::find("some_identifier") == a);
+    CHECK(!InternedString::find("never_interned_identifier_3b1f"));
+}
+
+TEST_CASE("InternedString concurrent interning", "[common]") {
+    ThreadPool pool(4);
+    std::vector<InternedString> strings(4000);
+    pool.parallelFor(strings.size(), [&](size_t index) {
+        strings[index] = InternedString("name" + std::to_string(index % 100));
+    });
+    for (size_t i = 0; i < strings.size(); ++i) {
+        CHECK(strings[i] == strings[i % 100]);
+        CHECK(strings[i].str() == "name" + std::to_string(i % 100));
+    }
+}
+
+TEST_CASE("InternedString scopes free their entries", "[common]") {
+    InternedString permanent("permanent_identifier_7c2d");
+    {
+        InternedStringScope scope;
+        InternedString scoped("scoped_identifier_7c2d");
+        CHECK(InternedString::find("scoped_identifier_7c2d") == scoped);
+        /// Interning an existing string does not move it into the scope
+        CHECK(InternedString("permanent_identifier_7c2d") == permanent);
+        {
+            InternedStringScope nested;
+            CHECK(InternedString("nested_identifier_7c2d").str() ==
+                  "nested_identifier_7c2d");
+        }
+        /// Entries live until the outermost scope ends
+        CHECK(InternedString::find("nested_identifier_7c2d"));
+    }
+    CHECK(!InternedString::find("scoped_identifier_7c2d"));
+    CHECK(!InternedString::find("nested_identifier_7c2d"));
+    CHECK(InternedString::find("permanent_identifier_7c2d") == permanent);
+    CHECK(InternedString("scoped_identifier_7c2d").str() ==
+          "scoped_identifier_7c2d");
+}
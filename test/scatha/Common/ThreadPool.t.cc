@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "Common/ThreadPool.h"
+
+using namespace scatha;
+
+TEST_CASE("ThreadPool runs every index once", "[common]") {
+    for (size_t numThreads: { 0, 1, 4 }) {
+        ThreadPool pool(numThreads);
+        std::vector<std::atomic<int>> counts(1000);
+        pool.parallelFor(counts.size(), [&](size_t index) { ++counts[index]; });
+        for (auto& count: counts) {
+            CHECK(count == 1);
+        }
+    }
+}
+
+TEST_CASE("ThreadPool nested parallelFor", "[common]") {
+    ThreadPool pool(3);
+    std::atomic<size_t> sum = 0;
+    pool.parallelFor(8, [&](size_t i) {
+        pool.parallelFor(8, [&](size_t j) { sum += i * 8 + j; });
+    });
+    CHECK(sum == 63 * 64 / 2);
+}
+
+TEST_CASE("ThreadPool rethrows exception of lowest index", "[common]") {
+    ThreadPool pool(4);
+    auto fn = [](size_t index) {
+        if (index % 10 == 3) {
+            throw std::runtime_error(std::to_string(index));
+        }
+    };
+    try {
+        pool.parallelFor(100, fn);
+        FAIL();
+    }
+    catch (std::runtime_error const& e) {
+        CHECK(std::string(e.what()) == "3");
+    }
+}
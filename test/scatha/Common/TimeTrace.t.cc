@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+
+#include "Common/TimeTrace.h"
+
+using namespace scatha;
+
+TEST_CASE("TraceScope records into the active trace", "[common]") {
+    TimeTrace trace;
+    {
+        TraceScope scope("inactive", "stage");
+        CHECK(!scope.isActive());
+    }
+    {
+        TimeTrace::Activation activation(&trace);
+        TraceScope outer("parse", "stage");
+        outer.trackPeakBytes();
+        {
+            TraceScope inner("dce", "pass");
+            inner.setFunction("main");
+            inner.setInstCountBefore(10);
+            inner.setInstCountAfter(7);
+        }
+    }
+    CHECK(TimeTrace::active() == nullptr);
+    auto events = trace.events();
+    REQUIRE(events.size() == 2);
+    CHECK(events[0].name == "dce");
+    CHECK(events[0].function == "main");
+    CHECK(events[0].instCountBefore == 10);
+    CHECK(events[0].instCountAfter == 7);
+    CHECK(events[1].name == "parse");
+    CHECK(events[1].peakBytes.has_value());
+    CHECK(events[1].begin <= events[0].begin);
+}
+
+TEST_CASE("TimeTrace output formats", "[common]") {
+    TimeTrace trace;
+    {
+        TimeTrace::Activation activation(&trace);
+        TraceScope scope("gvn", "pass");
+        scope.setFunction("f");
+    }
+    std::stringstream report;
+    trace.printReport(report);
+    CHECK(report.str().find("gvn") != std::string::npos);
+    std::stringstream chrome;
+    trace.writeChromeTrace(chrome);
+    auto json = chrome.str();
+    CHECK(json.find("\"traceEvents\"") != std::string::npos);
+    CHECK(json.find("\"name\":\"gvn\"") != std::string::npos);
+    CHECK(json.find("\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"function\":\"f\"") != std::string::npos);
+}
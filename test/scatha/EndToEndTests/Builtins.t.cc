@@ -41,3 +41,41 @@ fn main() -> int {
     return int(x);
 })");
 }
+
+TEST_CASE("Memory comparison and search", "[end-to-end]") {
+    test::runReturnsTest(1, R"(
+fn main() -> bool {
+    return __builtin_memcmp("Hello World", "Hello World") == 0 &&
+           __builtin_memcmp("Hello World", "Hello") == 1 &&
+           __builtin_memcmp("Hello", "Hello World") == -1 &&
+           __builtin_memcmp("abc", "abd") == -1 &&
+           __builtin_memcmp("", "") == 0;
+})");
+    test::runReturnsTest(6, R"(
+fn main() -> int {
+    return __builtin_memchr("Hello World, Hello World", 'W');
+})");
+    test::runReturnsTest(static_cast<u64>(-1), R"(
+fn main() -> int {
+    return __builtin_memchr("Hello World", 'x');
+})");
+    test::runReturnsTest(35, R"(
+fn main() -> int {
+    return __builtin_memfind("The quick brown fox jumps over the lazy dog",
+                             "lazy");
+})");
+    test::runReturnsTest(static_cast<u64>(-1), R"(
+fn main() -> int {
+    return __builtin_memfind("The quick brown fox", "lazy");
+})");
+}
+
+TEST_CASE("Memory hashing", "[end-to-end]") {
+    test::runReturnsTest(1, R"(
+fn main() -> bool {
+    let a = __builtin_hash("Hello World");
+    let b = __builtin_hash("Hello World");
+    let c = __builtin_hash("Hello world");
+    return a == b && a != c;
+})");
+}
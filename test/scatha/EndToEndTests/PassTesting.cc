@@ -86,13 +86,15 @@ static Generator makeIRGenerator(std::string_view text) {
 
 static auto codegenAndAssemble(
     ir::Module const& mod, std::ostream* str = nullptr,
-    std::span<ForeignLibraryDecl const> foreignLibs = {}) {
+    std::span<ForeignLibraryDecl const> foreignLibs = {},
+    cg::CodegenOptions const& options = {}) {
     auto assembly = [&] {
         if (!str) {
-            return cg::codegen(mod);
+            cg::NullLogger logger;
+            return cg::codegen(mod, logger, options);
         }
         cg::DebugLogger logger(*str);
-        return cg::codegen(mod, logger);
+        return cg::codegen(mod, logger, options);
     }();
     auto [prog, sym, unresolved] = Asm::assemble(assembly);
     if (!Asm::link(Asm::LinkerOptions{}, prog, foreignLibs, unresolved)) {
@@ -102,8 +104,9 @@ static auto codegenAndAssemble(
 }
 
 static uint64_t run(ir::Module const& mod, std::ostream* str,
-                    std::span<ForeignLibraryDecl const> foreignLibs) {
-    auto [prog, sym] = codegenAndAssemble(mod, str, foreignLibs);
+                    std::span<ForeignLibraryDecl const> foreignLibs,
+                    cg::CodegenOptions const& options = {}) {
+    auto [prog, sym] = codegenAndAssemble(mod, str, foreignLibs, options);
     return runProgram(prog, findMain(sym).value());
 }
 
@@ -132,10 +135,12 @@ struct Impl {
 
     void runTest(Generator const& generator, utl::function_view<void()> begin,
                  utl::function_view<void(u64)> end) const {
-        /// No optimization
+        /// No optimization. Like `-O0` this uses the linear scan register
+        /// allocator, all other configurations color the interference graph
         {
             auto [ctx, mod, libs] = generator();
-            runChecked("Unoptimized", mod, libs, begin, end);
+            runChecked("Unoptimized", mod, libs, begin, end,
+                       { .optimize = false });
         }
 
         /// Default optimizations
@@ -192,20 +197,21 @@ struct Impl {
     void runChecked(std::string_view msg, ir::Module const& mod,
                     std::span<ForeignLibraryDecl const> foreignLibs,
                     utl::function_view<void()> begin,
-                    utl::function_view<void(u64)> end) const {
+                    utl::function_view<void(u64)> end,
+                    cg::CodegenOptions const& options = {}) const {
         INFO(msg);
         begin();
         size_t result = 0;
         std::string code;
         if (!getOptions().PrintCodegen) {
-            result = run(mod, nullptr, foreignLibs);
+            result = run(mod, nullptr, foreignLibs, options);
         }
         else {
             std::stringstream sstr;
             /// Catch2 breaks strings after 75 characters
             tfmt::setWidth(sstr, 75);
             ir::print(mod, sstr);
-            result = run(mod, &sstr, foreignLibs);
+            result = run(mod, &sstr, foreignLibs, options);
             code = std::move(sstr).str();
         }
         INFO(code);
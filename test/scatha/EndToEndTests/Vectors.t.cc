@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "EndToEndTests/PassTesting.h"
+
+using namespace scatha;
+
+TEST_CASE("Vector arithmetic", "[end-to-end][vectors]") {
+    test::checkIRReturns(4321, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v2i32 undef, i32 1, 0
+    %a = insert_value v2i32 %a.0, i32 20, 1
+    %b.0 = insert_value v2i32 undef, i32 300, 0
+    %b = insert_value v2i32 %b.0, i32 4000, 1
+    %c = add v2i32 %a, v2i32 %b
+    %x = extract_value v2i32 %c, 0
+    %y = extract_value v2i32 %c, 1
+    %s = add i32 %x, i32 %y
+    %r = zext i32 %s to i64
+    return i64 %r
+})");
+}
+
+TEST_CASE("Vector load and store", "[end-to-end][vectors]") {
+    /// The vector at offset 4 is not aligned to its size, which vector loads
+    /// and stores must tolerate
+    test::checkIRReturns(72, R"(
+func i64 @main() {
+  %entry:
+    %data = alloca i32, i32 4
+    %p.0 = getelementptr inbounds i32, ptr %data, i32 0
+    store ptr %p.0, i32 1
+    %p.1 = getelementptr inbounds i32, ptr %data, i32 1
+    store ptr %p.1, i32 2
+    %p.2 = getelementptr inbounds i32, ptr %data, i32 2
+    store ptr %p.2, i32 3
+    %v = load v2i32, ptr %p.1
+    %w = mul v2i32 %v, v2i32 %v
+    %u = sub v2i32 %w, v2i32 %v
+    store ptr %p.1, v2i32 %u
+    %0 = load i32, ptr %p.1
+    %1 = load i32, ptr %p.2
+    %2 = mul i32 %0, i32 %1
+    %3 = mul i32 %2, i32 6
+    %r = zext i32 %3 to i64
+    return i64 %r
+})");
+}
+
+TEST_CASE("Vector arithmetic on register pairs", "[end-to-end][vectors]") {
+    test::checkIRReturns(5000000000001, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v2i64 undef, i64 1, 0
+    %a = insert_value v2i64 %a.0, i64 5000000000000, 1
+    %b.0 = insert_value v2i64 undef, i64 300, 0
+    %b = insert_value v2i64 %b.0, i64 4020, 1
+    %c = add v2i64 %a, v2i64 %b
+    %d = sub v2i64 %c, v2i64 %b
+    %x = extract_value v2i64 %d, 0
+    %y = extract_value v2i64 %d, 1
+    %r = add i64 %x, i64 %y
+    return i64 %r
+})");
+    test::checkIRReturns(11, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v4i32 undef, i32 1, 0
+    %a.1 = insert_value v4i32 %a.0, i32 2, 1
+    %a.2 = insert_value v4i32 %a.1, i32 3, 2
+    %a = insert_value v4i32 %a.2, i32 4, 3
+    %c = mul v4i32 %a, v4i32 %a
+    %x = extract_value v4i32 %c, 0
+    %y = extract_value v4i32 %c, 1
+    %z = extract_value v4i32 %c, 3
+    %s.0 = sub i32 %z, i32 %y
+    %s = sub i32 %s.0, i32 %x
+    %r = zext i32 %s to i64
+    return i64 %r
+})");
+}
+
+TEST_CASE("Vector load and store of register pairs", "[end-to-end][vectors]") {
+    /// The vector at offset 8 is not aligned to its size
+    test::checkIRReturns(15, R"(
+func i64 @main() {
+  %entry:
+    %data = alloca f64, i32 3
+    %p.0 = getelementptr inbounds f64, ptr %data, i32 0
+    store ptr %p.0, f64 1.0
+    %p.1 = getelementptr inbounds f64, ptr %data, i32 1
+    store ptr %p.1, f64 1.5
+    %p.2 = getelementptr inbounds f64, ptr %data, i32 2
+    store ptr %p.2, f64 2.5
+    %v = load v2f64, ptr %p.1
+    %w = fmul v2f64 %v, v2f64 %v
+    %u = fdiv v2f64 %w, v2f64 %v
+    store ptr %p.1, v2f64 %u
+    %0 = load f64, ptr %p.1
+    %1 = load f64, ptr %p.2
+    %2 = fmul f64 %0, f64 %1
+    %3 = fmul f64 %2, f64 4.0
+    %r = ftos f64 %3 to i64
+    return i64 %r
+})");
+}
+
+TEST_CASE("Vector comparison and lane wise select", "[end-to-end][vectors]") {
+    /// `%m` is `{ 0, -1, 0, -1 }`, so `%c` takes the odd lanes from `%a` and
+    /// the even lanes from `%b`
+    test::checkIRReturns(2475, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v4i32 undef, i32 1, 0
+    %a.1 = insert_value v4i32 %a.0, i32 2, 1
+    %a.2 = insert_value v4i32 %a.1, i32 3, 2
+    %a = insert_value v4i32 %a.2, i32 4, 3
+    %b.0 = insert_value v4i32 undef, i32 5, 0
+    %b.1 = insert_value v4i32 %b.0, i32 1, 1
+    %b.2 = insert_value v4i32 %b.1, i32 7, 2
+    %b = insert_value v4i32 %b.2, i32 0, 3
+    %m = scmp grt v4i32 %a, v4i32 %b
+    %c = select v4i32 %m, v4i32 %a, v4i32 %b
+    %x.0 = extract_value v4i32 %c, 0
+    %x.1 = extract_value v4i32 %c, 1
+    %x.2 = extract_value v4i32 %c, 2
+    %x.3 = extract_value v4i32 %c, 3
+    %s.0 = mul i32 %x.1, i32 1000
+    %s.1 = mul i32 %x.3, i32 100
+    %s.2 = mul i32 %x.2, i32 10
+    %t.0 = add i32 %s.0, i32 %s.1
+    %t.1 = add i32 %t.0, i32 %s.2
+    %t = add i32 %t.1, i32 %x.0
+    %r = zext i32 %t to i64
+    return i64 %r
+})");
+}
+
+TEST_CASE("Vector minimum and maximum", "[end-to-end][vectors]") {
+    test::checkIRReturns(7, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v2f64 undef, f64 1.0, 0
+    %a = insert_value v2f64 %a.0, f64 8.0, 1
+    %b.0 = insert_value v2f64 undef, f64 2.0, 0
+    %b = insert_value v2f64 %b.0, f64 6.0, 1
+    %m = fcmp ls v2f64 %a, v2f64 %b
+    %min = select v2i64 %m, v2f64 %a, v2f64 %b
+    %x = extract_value v2f64 %min, 0
+    %y = extract_value v2f64 %min, 1
+    %s = fadd f64 %x, f64 %y
+    %r = ftos f64 %s to i64
+    return i64 %r
+})");
+    test::checkIRReturns(1, R"(
+func i64 @main() {
+  %entry:
+    %a.0 = insert_value v2i64 undef, i64 -5, 0
+    %a = insert_value v2i64 %a.0, i64 -3, 1
+    %b.0 = insert_value v2i64 undef, i64 -7, 0
+    %b = insert_value v2i64 %b.0, i64 6, 1
+    %m = scmp ls v2i64 %a, v2i64 %b
+    %max = select v2i64 %m, v2i64 %b, v2i64 %a
+    %x = extract_value v2i64 %max, 0
+    %y = extract_value v2i64 %max, 1
+    %r = add i64 %x, i64 %y
+    return i64 %r
+})");
+}
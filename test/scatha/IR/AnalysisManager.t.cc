@@ -0,0 +1,103 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "IR/AnalysisManager.h"
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/Dominance.h"
+#include "IR/IRParser.h"
+#include "IR/Loop.h"
+#include "IR/Module.h"
+#include "IR/Pass.h"
+
+using namespace scatha;
+using namespace ir;
+
+static constexpr auto LoopText = R"(
+func i64 @f(i64 %n) {
+  %entry:
+    goto label %header
+  %header:
+    %i = phi i64 [label %entry : 0], [label %header : %j]
+    %j = add i64 %i, i64 1
+    %cond = scmp ls i64 %j, i64 %n
+    branch i1 %cond, label %header, label %end
+  %end:
+    return i64 %j
+})";
+
+TEST_CASE("AnalysisManager - Caching", "[ir]") {
+    auto [ctx, mod] = ir::parse(LoopText).value();
+    auto& F = mod.front();
+    auto& AM = F.analysisManager();
+    auto before = AnalysisManager::stats(Analysis::DomInfo);
+    auto* domInfo = &F.getOrComputeDomInfo();
+    CHECK(&F.getOrComputeDomInfo() == domInfo);
+    auto after = AnalysisManager::stats(Analysis::DomInfo);
+    CHECK(after.misses - before.misses == 1);
+    CHECK(after.hits - before.hits >= 1);
+    CHECK(AM.isCached(Analysis::DomInfo));
+    CHECK(!AM.isCached(Analysis::PostDomInfo));
+    CHECK(!AM.isCached(Analysis::LoopNestingForest));
+}
+
+TEST_CASE("AnalysisManager - Dependency aware invalidation", "[ir]") {
+    auto [ctx, mod] = ir::parse(LoopText).value();
+    auto& F = mod.front();
+    auto& AM = F.analysisManager();
+    F.getOrComputeLNF();
+    F.getOrComputePostDomInfo();
+    REQUIRE(AM.isCached(Analysis::DomInfo));
+    REQUIRE(AM.isCached(Analysis::PostDomInfo));
+    REQUIRE(AM.isCached(Analysis::LoopNestingForest));
+    SECTION("Invalidating the dominator tree invalidates the LNF") {
+        AM.invalidate(Analysis::DomInfo);
+        CHECK(!AM.isCached(Analysis::DomInfo));
+        CHECK(AM.isCached(Analysis::PostDomInfo));
+        CHECK(!AM.isCached(Analysis::LoopNestingForest));
+    }
+    SECTION("Invalidating the LNF keeps the dominator tree") {
+        AM.invalidate(Analysis::LoopNestingForest);
+        CHECK(AM.isCached(Analysis::DomInfo));
+        CHECK(!AM.isCached(Analysis::LoopNestingForest));
+    }
+    SECTION("Preserving the LNF alone does not keep it") {
+        AM.invalidate(PreservedAnalyses().preserve(
+            Analysis::LoopNestingForest));
+        CHECK(!AM.isCached(Analysis::DomInfo));
+        CHECK(!AM.isCached(Analysis::LoopNestingForest));
+    }
+    SECTION("invalidateDomInfo() keeps the LNF") {
+        F.invalidateDomInfo();
+        CHECK(!AM.isCached(Analysis::DomInfo));
+        CHECK(!AM.isCached(Analysis::PostDomInfo));
+        CHECK(AM.isCached(Analysis::LoopNestingForest));
+    }
+}
+
+static FunctionPass makePass(bool modifies, PreservedAnalyses preserved) {
+    return FunctionPass([=](Context&, Function&) { return modifies; }, {},
+                        "test-pass", PassCategory::Other, preserved);
+}
+
+TEST_CASE("AnalysisManager - Passes invalidate what they don't preserve",
+          "[ir]") {
+    auto [ctx, mod] = ir::parse(LoopText).value();
+    auto& F = mod.front();
+    auto& AM = F.analysisManager();
+    auto* LNF = &F.getOrComputeLNF();
+    SECTION("Unmodified") {
+        makePass(false, PreservedAnalyses::None())(ctx, F);
+        CHECK(&F.getOrComputeLNF() == LNF);
+    }
+    SECTION("Preserves CFG") {
+        makePass(true, PreservedAnalyses::CFG())(ctx, F);
+        CHECK(AM.isCached(Analysis::DomInfo));
+        CHECK(AM.isCached(Analysis::LoopNestingForest));
+        CHECK(&F.getOrComputeLNF() == LNF);
+    }
+    SECTION("Preserves nothing") {
+        makePass(true, PreservedAnalyses::None())(ctx, F);
+        CHECK(!AM.isCached(Analysis::DomInfo));
+        CHECK(!AM.isCached(Analysis::LoopNestingForest));
+    }
+}
@@ -0,0 +1,216 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <range/v3/algorithm/find_if.hpp>
+#include <range/v3/range/operations.hpp>
+
+#include "Common/UniquePtr.h"
+#include "IR/BinSerialize.h"
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/IRParser.h"
+#include "IR/Module.h"
+#include "IR/Print.h"
+#include "IR/Type.h"
+
+using namespace scatha;
+
+static std::string printModule(ir::Module const& mod) {
+    std::stringstream sstr;
+    ir::print(mod, sstr);
+    return std::move(sstr).str();
+}
+
+static std::string serialize(ir::Module const& mod) {
+    std::stringstream sstr;
+    ir::serializeBinary(mod, sstr);
+    return std::move(sstr).str();
+}
+
+static std::vector<unsigned char> toBytes(std::string const& data) {
+    return std::vector<unsigned char>(data.begin(), data.end());
+}
+
+static constexpr auto Text = R"(
+struct @Pair { i64, f64 }
+struct @Wrapper { @Pair, [i32, 3] }
+
+@vtable = constant [ptr, 2] [ptr @f, ptr @g]
+@pair = global @Pair { i64 1, f64 2.5 }
+
+ext func i64 @ext.fn(i64)
+
+func i64 @f(i64 %n, i64 %x) {
+  %entry:
+    goto label %header
+  %header:
+    %i = phi i64 [label %entry : 0], [label %body : %i.1]
+    %s = phi i64 [label %entry : %x], [label %body : %s.1]
+    %ls = scmp ls i64 %i, i64 %n
+    branch i1 %ls, label %body, label %end
+  %body:
+    %a = mul i64 %i, i64 3
+    %b = call i64 @ext.fn, i64 %a
+    %s.1 = add i64 %s, i64 %b
+    %i.1 = add i64 %i, i64 1
+    goto label %header
+  %end:
+    %neg = neg i64 %s
+    %f = stof i64 %neg to f64
+    %sel = select i1 %ls, i64 %s, i64 %neg
+    return i64 %sel
+}
+
+func void @g(ptr valret(@Pair) %0 #ptr(align: 8), ptr byval(@Wrapper) %1) {
+  %entry:
+    %w = load @Wrapper, ptr %1
+    %p = extract_value @Wrapper %w, 0
+    %q = insert_value @Pair %p, i64 7, 0
+    store ptr %0, @Pair %q
+    %a = alloca i32, i32 3 #ptr(align: 4, validsize: 12, nonnull)
+    %e = getelementptr inbounds i32, ptr %a, i64 2
+    %fp = getelementptr inbounds ptr, ptr @vtable, i32 1
+    %fn = load ptr, ptr %fp
+    %r = call i64 %fn, i64 1, i64 2
+    return
+})";
+
+TEST_CASE("Binary IR round trip", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto data = toBytes(serialize(mod));
+    ir::Context ctx2;
+    ir::Module mod2;
+    REQUIRE(ir::deserializeBinary(ctx2, mod2, data));
+    CHECK(printModule(mod2) == printModule(mod));
+    SECTION("Serialization is deterministic") {
+        CHECK(serialize(mod2) == serialize(mod));
+    }
+    SECTION("Pointer info is preserved") {
+        auto& g = mod2.back();
+        auto* paramInfo = g.parameters().front().pointerInfo();
+        REQUIRE(paramInfo);
+        CHECK(paramInfo->align() == 8);
+        CHECK(paramInfo->provenance().value() == &g.parameters().front());
+    }
+}
+
+TEST_CASE("Binary IR type callbacks", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto data = toBytes(serialize(mod));
+    ir::Context ctx2;
+    ir::Module mod2;
+    mod2.addStructure(allocate<ir::StructType>(
+        "Pair",
+        std::array<ir::Type const*, 2>{ ctx2.intType(64), ctx2.floatType(64) }));
+    size_t numIgnored = 0;
+    auto typeCallback = [&](ir::StructType& type, ir::DeclToken& token) {
+        if (type.name() == "Pair") {
+            token.ignore();
+            ++numIgnored;
+        }
+    };
+    REQUIRE(ir::deserializeBinary(ctx2, mod2, data,
+                                  { .typeParseCallback = typeCallback }));
+    CHECK(numIgnored == 1);
+    CHECK(ranges::distance(mod2.structTypes()) == 2);
+}
+
+TEST_CASE("Binary IR rejects malformed input", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto data = toBytes(serialize(mod));
+    SECTION("Truncated") {
+        data.resize(data.size() / 2);
+    }
+    SECTION("Wrong magic") {
+        data[0] = 'X';
+    }
+    SECTION("Trailing bytes") {
+        data.push_back(0);
+    }
+    ir::Context ctx2;
+    ir::Module mod2;
+    CHECK(!ir::deserializeBinary(ctx2, mod2, data));
+}
+
+TEST_CASE("Binary IR rejects invalid IR", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto& f = mod.front();
+    auto itr = ranges::find_if(f.instructions(), [](auto& inst) {
+        return inst.name() == "s.1";
+    });
+    REQUIRE(itr != f.instructions().end());
+    auto& add = *itr;
+    SECTION("Operand type mismatch") {
+        add.setOperand(1, ctx.intConstant(1, 32));
+    }
+    SECTION("Block as value operand") {
+        add.setOperand(1, &f.entry());
+    }
+    auto data = toBytes(serialize(mod));
+    ir::Context ctx2;
+    ir::Module mod2;
+    CHECK(!ir::deserializeBinary(ctx2, mod2, data,
+                                 { .assertInvariants = false }));
+    ir::Context ctx3;
+    ir::Module mod3;
+    auto import = ir::LazyModuleImport::Open(ctx3, mod3, data);
+    REQUIRE(import);
+    CHECK(!import->materialize(mod3.front()));
+}
+
+/// Feeds every truncation and many single byte corruptions of a valid module
+/// to the decoder. It must reject or accept them without crashing, and what it
+/// accepts must be valid IR
+TEST_CASE("Binary IR fuzzing", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto const data = toBytes(serialize(mod));
+    for (size_t size = 0; size < data.size(); ++size) {
+        std::vector<unsigned char> truncated(data.begin(),
+                                             data.begin() + size);
+        ir::Context ctx2;
+        ir::Module mod2;
+        CHECK(!ir::deserializeBinary(ctx2, mod2, truncated));
+    }
+    for (size_t pos = 0; pos < data.size(); ++pos) {
+        for (unsigned char mask: { 0x01, 0x7F, 0x80, 0xFF }) {
+            auto corrupted = data;
+            corrupted[pos] ^= mask;
+            ir::Context ctx2;
+            ir::Module mod2;
+            INFO("Byte " << pos << " ^ " << int(mask));
+            CHECK_NOTHROW(ir::deserializeBinary(ctx2, mod2, corrupted));
+        }
+    }
+}
+
+TEST_CASE("Lazy binary IR import", "[ir][serialize]") {
+    auto [ctx, mod] = ir::parse(Text).value();
+    auto data = toBytes(serialize(mod));
+    ir::Context ctx2;
+    ir::Module mod2;
+    auto import = ir::LazyModuleImport::Open(ctx2, mod2, data);
+    REQUIRE(import);
+    REQUIRE(ranges::distance(mod2) == 2);
+    auto& f = mod2.front();
+    auto& g = mod2.back();
+    CHECK(import->isImported(f));
+    CHECK(import->isPending(f));
+    CHECK(import->isPending(g));
+    CHECK(f.empty());
+    /// Global variables are defined eagerly
+    for (auto& global: mod2.globals()) {
+        if (auto* var = dyncast<ir::GlobalVariable const*>(&global)) {
+            CHECK(var->initializer());
+        }
+    }
+    REQUIRE(import->materialize(g));
+    CHECK(!import->isPending(g));
+    CHECK(!g.empty());
+    CHECK(import->isPending(f));
+    REQUIRE(import->materialize(f));
+    CHECK(printModule(mod2) == printModule(mod));
+}
@@ -10,6 +10,7 @@
 #include "IR/IRParser.h"
 #include "IR/Module.h"
 #include "IR/Print.h"
+#include "Opt/Common.h"
 
 using namespace scatha;
 
@@ -134,3 +135,89 @@ func i64 @f() {
         setEqual(df(BB3), std::array{ BB1->basicBlock(), BB4->basicBlock() }));
     CHECK(df(BB4).empty());
 }
+
+/// Requires the dominator tree and the dominance frontiers of \p domInfo to
+/// match those of a fresh computation
+static void checkAgainstRecomputation(ir::Function& F,
+                                      ir::DominanceInfo const& domInfo) {
+    auto ref = ir::DominanceInfo::compute(F);
+    for (auto& BB: F) {
+        INFO(BB.name());
+        auto& domTree = domInfo.domTree();
+        auto& refTree = ref->domTree();
+        REQUIRE(domTree.isReachable(&BB) == refTree.isReachable(&BB));
+        if (!refTree.isReachable(&BB)) {
+            continue;
+        }
+        CHECK(domTree.idom(&BB) == refTree.idom(&BB));
+        CHECK(domTree[&BB]->level() == refTree[&BB]->level());
+        CHECK(setEqual(domInfo.domFront(&BB), ref->domFront(&BB)));
+        for (auto& other: F) {
+            CHECK(domInfo.dominates(&other, &BB) ==
+                  ref->dominates(&other, &BB));
+        }
+    }
+}
+
+TEST_CASE("Dominance - Incremental updates", "[opt]") {
+    auto const text = R"(
+func i64 @f() {
+  %entry:
+    %cond = scmp leq i64 1, i64 2
+    branch i1 %cond, label %1, label %2
+  %1:
+    goto label %3
+  %2:
+    goto label %4
+  %3:
+    branch i1 %cond, label %1, label %4
+  %4:
+    return i64 0
+})";
+    auto [ctx, mod] = ir::parse(text).value();
+    auto& f = mod.front();
+    auto& domInfo = f.getOrComputeDomInfo();
+    auto* entry = &f.entry();
+    auto* BB1 = entry->successor(0);
+    auto* BB2 = entry->successor(1);
+    auto* BB3 = BB1->successor(0);
+    auto* BB4 = BB2->successor(0);
+    CHECK(domInfo.dominates(entry, BB3));
+    CHECK(domInfo.dominates(BB1, BB3));
+    CHECK(!domInfo.dominates(BB3, BB1));
+    CHECK(domInfo.domTree().nearestCommonDominator(BB3, BB2) == entry);
+    SECTION("Split edge") {
+        auto* split = opt::splitEdge(ctx, BB3, BB4);
+        domInfo.insertJoiningBlock(split, BB4);
+        checkAgainstRecomputation(f, domInfo);
+        CHECK(domInfo.domTree().idom(split) == BB3);
+        CHECK(domInfo.domTree().idom(BB4) == entry);
+    }
+    SECTION("Joining predecessor") {
+        std::array preds = { BB2, BB3 };
+        auto* join = opt::addJoiningPredecessor(ctx, BB4, preds, "join");
+        domInfo.insertJoiningBlock(join, BB4);
+        checkAgainstRecomputation(f, domInfo);
+        CHECK(domInfo.domTree().idom(BB4) == join);
+        CHECK(domInfo.domTree().idom(join) == entry);
+    }
+    SECTION("Delete edge") {
+        /// Replace `branch %cond, %1, %4` in `%3` by `goto %1`
+        BB3->erase(BB3->terminator());
+        BB3->pushBack(new ir::Goto(ctx, BB1));
+        BB4->removePredecessor(BB3);
+        domInfo.deleteEdge(BB3, BB4);
+        checkAgainstRecomputation(f, domInfo);
+        CHECK(domInfo.domTree().idom(BB4) == BB2);
+    }
+    SECTION("Insert edge") {
+        /// Replace `goto %4` in `%2` by `branch %cond, %3, %4`
+        auto* cond = &entry->front();
+        BB2->erase(BB2->terminator());
+        BB2->pushBack(new ir::Branch(ctx, cond, BB3, BB4));
+        BB3->addPredecessor(BB2);
+        domInfo.insertEdge(BB2, BB3);
+        checkAgainstRecomputation(f, domInfo);
+        CHECK(domInfo.domTree().idom(BB3) == entry);
+    }
+}
@@ -1,5 +1,126 @@
 #include <catch2/catch_test_macros.hpp>
+#include <range/v3/range.hpp>
+
+#include <vector>
 
 #include "IR/CFG.h"
+#include "IR/Clone.h"
+#include "IR/Context.h"
+#include "IR/Type.h"
 
 using namespace scatha;
+
+TEST_CASE("Use lists", "[ir]") {
+    ir::Context ctx;
+    auto* a = ctx.intConstant(1, 64);
+    auto* b = ctx.intConstant(2, 64);
+    ir::ArithmeticInst add(a, a, ir::ArithmeticOperation::Add, "add");
+    CHECK(a->userCount() == 1);
+    CHECK(ranges::distance(a->users()) == 1);
+    CHECK(b->unused());
+    ir::ArithmeticInst mul(&add, b, ir::ArithmeticOperation::Mul, "mul");
+    add.setOperand(1, b);
+    CHECK(a->userCount() == 1);
+    CHECK(b->userCount() == 2);
+    add.swapOperands();
+    CHECK(add.lhs() == b);
+    CHECK(add.rhs() == a);
+    CHECK(a->userCount() == 1);
+    CHECK(b->userCount() == 2);
+    add.replaceAllUsesWith(b);
+    CHECK(add.unused());
+    CHECK(b->userCount() == 2);
+    CHECK(ranges::distance(b->users()) == 2);
+    SECTION("Growing operand lists keeps uses linked") {
+        ir::Phi phi(ctx.intType(64), 0, "phi");
+        for (int i = 0; i < 20; ++i) {
+            phi.addArgument(nullptr, i % 2 == 0 ? a : b);
+        }
+        CHECK(a->userCount() == 2);
+        CHECK(b->userCount() == 3);
+        size_t numUses = 0;
+        for (auto* use = a->firstUse(); use; use = use->next()) {
+            CHECK(use->value() == a);
+            ++numUses;
+        }
+        CHECK(numUses == 11);
+        phi.clearOperands();
+        CHECK(a->userCount() == 1);
+        CHECK(b->userCount() == 2);
+    }
+    SECTION("Exactly one use counts the user") {
+        std::vector<ir::PhiMapping> args;
+        for (int i = 0; i < 20; ++i) {
+            args.push_back({ nullptr, i % 3 == 0 ? a : b });
+        }
+        ir::Phi phi(args, "phi");
+        auto countingUses = [&](ir::Value const* value) {
+            size_t result = 0;
+            for (size_t i = 0; i < phi.numOperands(); ++i) {
+                auto& use = phi.useAt(i);
+                CHECK(use.isLinked());
+                result += use.value() == value && use.countsUser();
+            }
+            return result;
+        };
+        CHECK(a->userCount() == 2);
+        CHECK(b->userCount() == 3);
+        CHECK(countingUses(a) == 1);
+        CHECK(countingUses(b) == 1);
+        /// Removing the counting use passes counting on to another use
+        phi.setArgument(size_t{ 0 }, b);
+        CHECK(a->userCount() == 2);
+        CHECK(countingUses(a) == 1);
+        phi.updateOperand(a, b);
+        CHECK(a->userCount() == 1);
+        CHECK(b->userCount() == 3);
+        CHECK(countingUses(b) == 1);
+        CHECK(ranges::distance(b->users()) == 3);
+        phi.setArgument(size_t{ 5 }, a);
+        CHECK(a->userCount() == 2);
+        CHECK(countingUses(a) == 1);
+    }
+}
+
+TEST_CASE("Node allocator", "[ir]") {
+    ir::Context ctx;
+    auto function = allocate<ir::Function>(ctx, ctx.voidType(),
+                                           List<ir::Parameter>{}, "f",
+                                           ir::FunctionAttribute::None);
+    auto& allocator = function->nodeAllocator();
+    auto* a = ctx.intConstant(1, 64);
+    {
+        ir::NodeAllocatorScope scope(*function);
+        auto* BB = new ir::BasicBlock(ctx, "entry");
+        function->pushBack(BB);
+        auto* add = new ir::ArithmeticInst(a, a, ir::ArithmeticOperation::Add,
+                                           "add");
+        BB->pushBack(add);
+        CHECK(allocator.liveNodes() == 2);
+        CHECK(allocator.slabBytes() > 0);
+        auto addAddress = reinterpret_cast<uintptr_t>(add);
+        BB->erase(add);
+        CHECK(allocator.liveNodes() == 1);
+        /// The freed memory is reused for the next node of the same size
+        auto* sub = new ir::ArithmeticInst(a, a, ir::ArithmeticOperation::Sub,
+                                           "sub");
+        CHECK(reinterpret_cast<uintptr_t>(sub) == addAddress);
+        BB->pushBack(sub);
+        CHECK(allocator.liveNodes() == 2);
+    }
+    /// Outside of a scope nodes are allocated on the heap
+    function->pushBack(new ir::BasicBlock(ctx, "heap"));
+    CHECK(allocator.liveNodes() == 2);
+    /// Functions that are created in the scope of another function allocate
+    /// their parameters on the heap and their bodies in their own allocator,
+    /// because the functions may be processed on different threads
+    ir::NodeAllocatorScope scope(*function);
+    List<ir::Parameter> params;
+    params.push_back(new ir::Parameter(ctx.intType(64), 0, nullptr));
+    auto other = allocate<ir::Function>(ctx, ctx.voidType(), std::move(params),
+                                        "g", ir::FunctionAttribute::None);
+    auto copy = ir::clone(ctx, function.get());
+    CHECK(allocator.liveNodes() == 2);
+    CHECK(other->nodeAllocator().liveNodes() == 0);
+    CHECK(copy->nodeAllocator().liveNodes() == 3);
+}
@@ -145,3 +145,83 @@ func void @f(ptr valret(@ret.type) %0,
         CHECK(attrib->type()->name() == "arg.type");
     }
 }
+
+TEST_CASE("Reject vector operations without a packed instruction",
+          "[ir][parser]") {
+    auto const text = R"(
+func v2i32 @f(v2i32 %a, v2i32 %b) {
+  %entry:
+    %c = lshl v2i32 %a, v2i32 %b
+    return v2i32 %c
+})";
+    auto result = ir::parse(text);
+    REQUIRE(!result);
+    auto* issue = std::get_if<ir::SemanticIssue>(&result.error());
+    REQUIRE(issue);
+    CHECK(issue->reason() == ir::SemanticIssue::InvalidType);
+}
+
+TEST_CASE("Parse vector types of one and two registers", "[ir][parser]") {
+    auto const text = R"(
+func void @f(v2i32 %a, v4i32 %b, v2i64 %c, v2f64 %d) {
+  %entry:
+    return
+})";
+    auto [ctx, mod] = ir::parse(text).value();
+    auto& f = mod.front();
+    std::vector<ir::VectorType const*> params;
+    for (auto& param: f.parameters()) {
+        params.push_back(cast<ir::VectorType const*>(param.type()));
+    }
+    REQUIRE(params.size() == 4);
+    CHECK(params[0]->numRegisters() == 1);
+    CHECK(params[1]->numRegisters() == 2);
+    CHECK(params[2]->numRegisters() == 2);
+    CHECK(params[3]->numRegisters() == 2);
+    CHECK(params[3]->elementType() == ctx.floatType(64));
+}
+
+TEST_CASE("Reject vector types that don't fill registers", "[ir][parser]") {
+    for (std::string type: { "v3i32", "v4i64", "v2i8" }) {
+        INFO(type);
+        auto const text = "func void @f(" + type + R"( %a) {
+  %entry:
+    return
+})";
+        auto result = ir::parse(text);
+        REQUIRE(!result);
+        auto* issue = std::get_if<ir::SemanticIssue>(&result.error());
+        REQUIRE(issue);
+        CHECK(issue->reason() == ir::SemanticIssue::InvalidType);
+    }
+}
+
+TEST_CASE("Parse vector comparisons and lane wise select", "[ir][parser]") {
+    auto const text = R"(
+func v2f64 @f(v2f64 %a, v2f64 %b) {
+  %entry:
+    %m = fcmp ls v2f64 %a, v2f64 %b
+    %c = select v2i64 %m, v2f64 %b, v2f64 %a
+    return v2f64 %c
+})";
+    auto [ctx, mod] = ir::parse(text).value();
+    auto& entry = mod.front().front();
+    auto& cmp = cast<ir::CompareInst&>(entry.front());
+    CHECK(cmp.type() == ctx.vectorType(ctx.intType(64), 2));
+    auto& select = cast<ir::Select&>(*cmp.next());
+    CHECK(select.type() == ctx.vectorType(ctx.floatType(64), 2));
+}
+
+TEST_CASE("Reject lane wise select with mismatched mask", "[ir][parser]") {
+    auto const text = R"(
+func v4i32 @f(v2i64 %m, v4i32 %a, v4i32 %b) {
+  %entry:
+    %c = select v2i64 %m, v4i32 %a, v4i32 %b
+    return v4i32 %c
+})";
+    auto result = ir::parse(text);
+    REQUIRE(!result);
+    auto* issue = std::get_if<ir::SemanticIssue>(&result.error());
+    REQUIRE(issue);
+    CHECK(issue->reason() == ir::SemanticIssue::InvalidType);
+}
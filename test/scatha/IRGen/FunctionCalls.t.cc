@@ -1,3 +1,6 @@
+#include <string>
+#include <vector>
+
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/generators/catch_generators_all.hpp>
 
@@ -171,3 +174,35 @@ fn make() -> &[int] {}
     CHECK(secondCall.argumentAt(1) == &count);
     CHECK_NOTHROW(view.nextAs<Return>());
 }
+
+TEST_CASE("Module order does not depend on thread scheduling", "[irgen]") {
+    std::string source;
+    for (int i = 0; i < 8; ++i) {
+        auto n = std::to_string(i);
+        source +=
+            "fn helper" + n + "() { __builtin_putstr(\"" + n + "\"); }\n";
+    }
+    /// Every function also uses a literal that all of them share, so the
+    /// name of its global must not depend on which function creates it
+    for (int i = 0; i < 64; ++i) {
+        source += "public fn f" + std::to_string(i) + "() { helper" +
+                  std::to_string(i % 8) + "(); helper" +
+                  std::to_string(i * 5 % 8) +
+                  "(); __builtin_putstr(\"shared\"); }\n";
+    }
+    auto globalNames = [&] {
+        auto [ctx, mod] = makeIR({ source });
+        std::vector<std::string> names;
+        for (auto& F: mod) {
+            names.emplace_back(F.name());
+        }
+        for (auto& global: mod.globals()) {
+            names.emplace_back(global.name());
+        }
+        return names;
+    };
+    auto const expected = globalNames();
+    for (int i = 0; i < 8; ++i) {
+        CHECK(globalNames() == expected);
+    }
+}
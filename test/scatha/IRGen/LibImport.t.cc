@@ -0,0 +1,41 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <string_view>
+
+#include <range/v3/algorithm.hpp>
+
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/Module.h"
+#include "Util/FrontendWrapper.h"
+#include "Util/LibUtil.h"
+
+using namespace scatha;
+using namespace test;
+
+TEST_CASE("Only reached library functions are imported", "[irgen][lib]") {
+    compileLibrary("libs/irgenlib", "libs", R"(
+public fn called() -> int { return calledHelper(); }
+fn calledHelper() -> int { return 1; }
+public fn ignored() -> int { return ignoredHelper(); }
+fn ignoredHelper() -> int { return 2; }
+)");
+    auto [ctx, mod] = makeIR({ R"(
+import irgenlib;
+public fn main() -> int { return irgenlib.called(); }
+)" },
+                             { .librarySearchPaths = { "libs" } });
+    auto contains = [&](std::string_view name) {
+        return ranges::any_of(mod, [&](ir::Function const& F) {
+            return F.name().find(name) != std::string_view::npos;
+        });
+    };
+    CHECK(contains("called"));
+    /// Library functions are declared without body and are only decoded when
+    /// they are reached. Unreached ones are erased while still pending
+    CHECK(!contains("ignored"));
+    for (auto& F: mod) {
+        INFO(F.name());
+        CHECK(!F.empty());
+    }
+}
@@ -77,3 +77,23 @@ TEST_CASE("Local variable array pointer to array reference argument",
     CHECK(store.value() == &p);
     CHECK_NOTHROW(view.nextAs<Return>());
 }
+
+TEST_CASE("Functions own the nodes generated for them", "[irgen]") {
+    /// The getter of `g` and the declaration of `h` are generated while
+    /// generating `main`. Their nodes must not be placed in the allocator of
+    /// `main`, because the functions may be optimized on different threads
+    auto [ctx, mod] = makeIR({ R"(
+var g: int = f(1);
+fn f(n: int) -> int { return n + 1; }
+public fn main() -> int { return g + h(2); }
+fn h(n: int) -> int { return n * 2; }
+)" });
+    for (auto& F: mod) {
+        size_t numNodes = 0;
+        for (auto& BB: F) {
+            numNodes += 1 + static_cast<size_t>(ranges::distance(BB));
+        }
+        INFO(F.name());
+        CHECK(F.nodeAllocator().liveNodes() <= numNodes);
+    }
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <svm/VirtualMachine.h>
+
+#include "Invocation/CompilationCache.h"
+#include "Invocation/CompilerInvocation.h"
+#include "Sema/Entity.h"
+#include "Sema/SymbolTable.h"
+
+using namespace scatha;
+
+static std::filesystem::path makeCacheDir(std::string name) {
+    auto dir = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+static std::vector<unsigned char> bytes(std::string_view text) {
+    return std::vector<unsigned char>(text.begin(), text.end());
+}
+
+TEST_CASE("Compilation cache store and lookup", "[invocation][cache]") {
+    CompilationCache cache(makeCacheDir("scatha-cache-test"));
+    CHECK(!cache.lookup("a"));
+    cache.store("a", bytes("Hello"));
+    CHECK(cache.lookup("a") == bytes("Hello"));
+    CHECK(cache.stats().hits == 1);
+    CHECK(cache.stats().misses == 1);
+    SECTION("Corrupted entries are misses") {
+        for (auto& file:
+             std::filesystem::directory_iterator(cache.directory()))
+        {
+            std::ofstream(file.path(), std::ios::app) << "garbage";
+        }
+        CHECK(!cache.lookup("a"));
+        CHECK(cache.stats().misses == 2);
+        CHECK(cache.size() == 0);
+    }
+    SECTION("Clear") {
+        cache.clear();
+        CHECK(!cache.lookup("a"));
+    }
+}
+
+TEST_CASE("Compilation cache eviction", "[invocation][cache]") {
+    CompilationCache cache(makeCacheDir("scatha-cache-eviction-test"), 1000);
+    std::string data(300, 'x');
+    for (int i = 0; i < 10; ++i) {
+        cache.store(std::to_string(i), bytes(data));
+    }
+    CHECK(cache.size() <= 1000);
+    CHECK(cache.stats().evictions >= 7);
+    CHECK(cache.lookup("9"));
+    /// Entries larger than the cache are not stored
+    cache.store("big", bytes(std::string(2000, 'x')));
+    CHECK(!cache.lookup("big"));
+    SECTION("Entries of earlier sessions count towards the limit") {
+        CompilationCache reopened(cache.directory(), 1000);
+        reopened.store("10", bytes(data));
+        CHECK(reopened.size() <= 1000);
+        CHECK(reopened.stats().evictions > 0);
+    }
+}
+
+TEST_CASE("Cached compiler invocation", "[invocation][cache][end-to-end]") {
+    CompilationCache cache(makeCacheDir("scatha-cache-invocation-test"));
+    /// Number of times the frontend and IR generation ran or were skipped
+    /// because the module was loaded from the cache
+    int numFrontendRuns = 0;
+    int numModules = 0;
+    auto compile = [&](int optLevel) {
+        CompilerInvocation inv(TargetType::BinaryOnly, "test");
+        inv.addInput(SourceFile::make(R"(
+public fn foo() -> int { return 42; }
+)"));
+        inv.setOptLevel(optLevel);
+        inv.setCache(&cache);
+        inv.setCallbacks({
+            .frontendCallback = [&](auto&, auto&) { ++numFrontendRuns; },
+            .irgenCallback = [&](auto&, auto&) { ++numModules; },
+        });
+        auto target = inv.run();
+        REQUIRE(target);
+        svm::VirtualMachine vm;
+        vm.loadBinary(target->binary().data());
+        auto* foo =
+            target->symbolTable().globalScope().findFunctions("foo").front();
+        CHECK(*vm.execute(foo->binaryAddress().value(), {}) == 42);
+    };
+    compile(0);
+    CHECK(numFrontendRuns == 1);
+    CHECK(numModules == 1);
+    /// The target is found in the cache, so no module is generated or loaded
+    compile(0);
+    CHECK(numFrontendRuns == 1);
+    CHECK(numModules == 1);
+    /// Different options reuse the cached module but don't run the frontend
+    compile(1);
+    CHECK(numFrontendRuns == 1);
+    CHECK(numModules == 2);
+}
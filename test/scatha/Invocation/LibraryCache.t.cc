@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+
+#include <utl/strcat.hpp>
+
+#include "Invocation/LibraryCache.h"
+#include "Invocation/TargetNames.h"
+#include "Util/LibUtil.h"
+
+using namespace scatha;
+using namespace test;
+
+static std::filesystem::path libraryPath(std::string_view name) {
+    return std::filesystem::path("libs") /
+           utl::strcat(name, ".", TargetNames::LibraryExt);
+}
+
+TEST_CASE("Library cache", "[invocation][cache]") {
+    compileLibrary("libs/cachelib", "libs", R"(
+public fn f() -> int { return 1; }
+)");
+    auto path = libraryPath("cachelib");
+    SECTION("Disabled cache reads from disk") {
+        LibraryCache::setEnabled(false);
+        auto a = LibraryCache::load(path);
+        auto b = LibraryCache::load(path);
+        REQUIRE(a);
+        REQUIRE(b);
+        CHECK(a != b);
+        CHECK(a->binarySymbolTable);
+        CHECK(a->symbolTableIndex);
+        CHECK(a->objectCode);
+        CHECK(!LibraryCache::load(libraryPath("missing")));
+    }
+    SECTION("Enabled cache reuses unchanged libraries") {
+        LibraryCache::setEnabled(true);
+        auto a = LibraryCache::load(path);
+        REQUIRE(a);
+        CHECK(LibraryCache::load(path) == a);
+        CHECK(LibraryCache::load(std::filesystem::absolute(path)) == a);
+        CHECK(!LibraryCache::load(libraryPath("missing")));
+        /// Rebuilding the library changes its file, so it is read again
+        compileLibrary("libs/cachelib", "libs", R"(
+public fn f() -> int { return 2; }
+public fn g() -> int { return 3; }
+)");
+        auto b = LibraryCache::load(path);
+        REQUIRE(b);
+        CHECK(b != a);
+        CHECK(b->objectCode != a->objectCode);
+        CHECK(b->symbolTableIndex != a->symbolTableIndex);
+        CHECK(LibraryCache::load(path) == b);
+        LibraryCache::clear();
+        CHECK(LibraryCache::load(path) != b);
+        LibraryCache::setEnabled(false);
+        CHECK(!LibraryCache::isEnabled());
+    }
+}
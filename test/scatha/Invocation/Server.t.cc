@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Common/Base.h"
+#include "Common/InternedString.h"
+#include "Invocation/LibraryCache.h"
+#include "Server.h"
+
+using namespace scatha;
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/// Sends \p args to the server listening on \p socket and returns the exit code
+/// and the output. Retries while the server is starting up
+static std::pair<int, std::string> request(std::filesystem::path const& socket,
+                                           std::vector<std::string> args) {
+    for (int retries = 0;; ++retries) {
+        std::stringstream out;
+        int exitCode = serverClientMain(socket, args, out);
+        auto output = std::move(out).str();
+        if (retries < 1000 &&
+            output.find("No server is listening") != std::string::npos)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        return { exitCode, std::move(output) };
+    }
+}
+
+static int handleRequest(std::vector<std::string> const& args) {
+    if (args == std::vector<std::string>{ "abort" }) {
+        SC_ABORT();
+    }
+    if (args == std::vector<std::string>{ "throw" }) {
+        throw std::runtime_error("Request failed");
+    }
+    [[maybe_unused]] InternedString str("scatha-server-test-string");
+    for (auto& arg: args) {
+        std::cout << arg << ";";
+    }
+    return static_cast<int>(args.size());
+}
+
+TEST_CASE("Compiler server round trip", "[invocation][server]") {
+    auto socket =
+        std::filesystem::temp_directory_path() / "scatha-server-test.sock";
+    std::filesystem::remove(socket);
+    auto assertHandler = internal::getAssertFailureHandler();
+    std::thread server(
+        [&] { serverMain({ .socket = socket }, handleRequest); });
+    auto [exitCode, output] = request(socket, { "a", "b" });
+    CHECK(exitCode == 2);
+    CHECK(output == "a;b;");
+    /// Strings interned by a request are freed after it
+    CHECK(!InternedString::find("scatha-server-test-string"));
+    /// Failing requests are reported to the client and the server keeps
+    /// running
+    std::tie(exitCode, output) = request(socket, { "abort" });
+    CHECK(exitCode == 1);
+    CHECK(output.find("Fatal error") != std::string::npos);
+    std::tie(exitCode, output) = request(socket, { "throw" });
+    CHECK(exitCode == 1);
+    CHECK(output.find("Request failed") != std::string::npos);
+    std::tie(exitCode, output) = request(socket, { "c" });
+    CHECK(exitCode == 1);
+    CHECK(output == "c;");
+    CHECK(serverMain({ .socket = socket, .stop = true }, nullptr) == 0);
+    server.join();
+    CHECK(!std::filesystem::exists(socket));
+    CHECK(internal::getAssertFailureHandler() == assertHandler);
+    LibraryCache::setEnabled(false);
+}
+
+#endif
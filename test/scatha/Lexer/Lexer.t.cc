@@ -469,3 +469,35 @@ TEST_CASE("Float literals", "[lex]") {
         CHECK(tok.toFloat() == APFloat(1.0, APFloatPrec::Double()));
     }
 }
+
+TEST_CASE("Lexer recovery", "[lex]") {
+    IssueHandler iss;
+    SECTION("Keyword prefix") {
+        auto tokens = parser::lex("trueValue falsey true", iss);
+        CHECK(iss.empty());
+        REQUIRE(tokens.size() == 4);
+        CHECK(tokens[0].kind() == TokenKind::Identifier);
+        CHECK(tokens[0].id() == "trueValue");
+        CHECK(tokens[1].kind() == TokenKind::Identifier);
+        CHECK(tokens[2].kind() == TokenKind::True);
+    }
+    SECTION("Line comment at end of file") {
+        auto tokens = parser::lex("x // comment", iss);
+        CHECK(iss.empty());
+        REQUIRE(tokens.size() == 2);
+        CHECK(tokens[0].id() == "x");
+    }
+    SECTION("Unterminated multi line comment") {
+        auto tokens = parser::lex("x /* comment", iss);
+        REQUIRE(!iss.empty());
+        CHECK(dynamic_cast<UnterminatedMultiLineComment const*>(&iss.front()));
+        REQUIRE(tokens.size() == 2);
+    }
+    SECTION("Unexpected character") {
+        auto tokens = parser::lex("a @ b", iss);
+        REQUIRE(!iss.empty());
+        CHECK(dynamic_cast<UnexpectedCharacter const*>(&iss.front()));
+        REQUIRE(tokens.size() == 3);
+        CHECK(tokens[1].id() == "b");
+    }
+}
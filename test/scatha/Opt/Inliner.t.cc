@@ -1,5 +1,14 @@
+#include <sstream>
+#include <string>
+
 #include <catch2/catch_test_macros.hpp>
 
+#include "Common/ThreadPool.h"
+#include "IR/Context.h"
+#include "IR/IRParser.h"
+#include "IR/Module.h"
+#include "IR/PipelineParser.h"
+#include "IR/Print.h"
 #include "Opt/PassTest.h"
 #include "Opt/Passes.h"
 
@@ -54,3 +63,39 @@ func void @main() {
     return
 })");
 }
+
+TEST_CASE("Inliner - Result does not depend on the number of threads",
+          "[opt][inliner]") {
+    std::string source;
+    for (int i = 0; i < 32; ++i) {
+        auto n = std::to_string(i);
+        source += "func i64 @leaf" + n + "(i64 %0) {\n  %entry:\n" +
+                  "    %1 = mul i64 %0, i64 " + n + "\n" +
+                  "    %2 = add i64 %1, i64 %0\n" + "    return i64 %2\n}\n";
+    }
+    for (int i = 0; i < 16; ++i) {
+        auto n = std::to_string(i);
+        auto a = std::to_string(i), b = std::to_string((i * 7 + 3) % 32);
+        source += "func i64 @mid" + n + "(i64 %0) {\n  %entry:\n" +
+                  "    %1 = call i64 @leaf" + a + ", i64 %0\n" +
+                  "    %2 = call i64 @leaf" + b + ", i64 %1\n" +
+                  "    return i64 %2\n}\n";
+    }
+    source += "func i64 @main(i64 %0) {\n  %entry:\n";
+    for (int i = 0; i < 16; ++i) {
+        source += "    %r" + std::to_string(i) + " = call i64 @mid" +
+                  std::to_string(i) + ", i64 %0\n";
+    }
+    source += "    return i64 %r15\n}\n";
+    auto optimize = [&](size_t concurrency) {
+        ThreadPool::setGlobalConcurrency(concurrency);
+        auto [ctx, mod] = ir::parse(source).value();
+        ir::parsePipeline("inline")(ctx, mod);
+        std::stringstream sstr;
+        ir::print(mod, sstr);
+        return std::move(sstr).str();
+    };
+    auto const sequential = optimize(1);
+    CHECK(optimize(4) == sequential);
+    ThreadPool::setGlobalConcurrency(0);
+}
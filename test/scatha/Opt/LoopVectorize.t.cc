@@ -0,0 +1,409 @@
+#include <catch2/catch_test_macros.hpp>
+#include <svm/VirtualMachine.h>
+
+#include "Assembly/Assembler.h"
+#include "Assembly/AssemblyStream.h"
+#include "CodeGen/CodeGen.h"
+#include "IR/CFG.h"
+#include "IR/Context.h"
+#include "IR/ForEach.h"
+#include "IR/IRParser.h"
+#include "IR/Module.h"
+#include "IR/Type.h"
+#include "Opt/Passes.h"
+
+using namespace scatha;
+
+static uint64_t run(ir::Module const& mod) {
+    auto obj = Asm::assemble(cg::codegen(mod));
+    auto linkresult = Asm::link({}, obj.program, {}, obj.unresolvedSymbols);
+    REQUIRE(linkresult);
+    svm::VirtualMachine VM;
+    VM.loadBinary(obj.program.data());
+    VM.execute({});
+    return VM.getRegister(0);
+}
+
+static bool hasVectorInstructions(ir::Module const& mod) {
+    for (auto& function: mod) {
+        for (auto& inst: function.instructions()) {
+            if (isa<ir::VectorType>(inst.type())) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/// \Returns `true` if any instruction in \p mod has type \p type
+static bool hasInstructionsOfType(ir::Module const& mod, ir::Type const* type) {
+    for (auto& function: mod) {
+        for (auto& inst: function.instructions()) {
+            if (inst.type() == type) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_CASE("Vectorize and interleave loops", "[loopvectorize]") {
+    /// The first loop uses the induction variable as a value and is
+    /// interleaved, the second loop is vectorized
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca i32, i32 11
+    %b = alloca i32, i32 11
+    goto label %fill
+
+  %fill: // preds: entry, fill
+    %i = phi i64 [label %entry : 0], [label %fill : %i.next]
+    %v = trunc i64 %i to i32
+    %pa = getelementptr inbounds i32, ptr %a, i64 %i
+    store ptr %pa, i32 %v
+    %w = mul i32 %v, i32 3
+    %pb = getelementptr inbounds i32, ptr %b, i64 %i
+    store ptr %pb, i32 %w
+    %i.next = add i64 %i, i64 1
+    %fill.cond = scmp ls i64 %i.next, i64 11
+    branch i1 %fill.cond, label %fill, label %fill.end
+
+  %fill.end: // preds: fill
+    goto label %compute
+
+  %compute: // preds: fill.end, compute
+    %j = phi i64 [label %fill.end : 0], [label %compute : %j.next]
+    %pa.j = getelementptr inbounds i32, ptr %a, i64 %j
+    %x = load i32, ptr %pa.j
+    %pb.j = getelementptr inbounds i32, ptr %b, i64 %j
+    %y = load i32, ptr %pb.j
+    %s = add i32 %x, i32 %y
+    %t = mul i32 %s, i32 2
+    store ptr %pa.j, i32 %t
+    %j.next = add i64 %j, i64 1
+    %compute.cond = scmp ls i64 %j.next, i64 11
+    branch i1 %compute.cond, label %compute, label %compute.end
+
+  %compute.end: // preds: compute
+    goto label %sum
+
+  %sum: // preds: compute.end, sum
+    %k = phi i64 [label %compute.end : 0], [label %sum : %k.next]
+    %acc = phi i32 [label %compute.end : 0], [label %sum : %acc.next]
+    %pa.k = getelementptr inbounds i32, ptr %a, i64 %k
+    %z = load i32, ptr %pa.k
+    %acc.next = add i32 %acc, i32 %z
+    %k.next = add i64 %k, i64 1
+    %sum.cond = scmp ls i64 %k.next, i64 11
+    branch i1 %sum.cond, label %sum, label %end
+
+  %end: // preds: sum
+    %r = zext i32 %acc.next to i64
+    return i64 %r
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 440);
+    CHECK(ir::forEach(ctx, mod, opt::loopVectorize, {}));
+    CHECK(hasVectorInstructions(mod));
+    CHECK(run(mod) == 440);
+    /// The vector loops step by more than one and are not vectorized again
+    CHECK(!ir::forEach(ctx, mod, opt::loopVectorize, {}));
+}
+
+TEST_CASE("Overlapping accesses run the scalar loop", "[loopvectorize]") {
+    /// `%p` points one element past `%a`, so every iteration reads the value
+    /// written by the previous one
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca i32, i32 11
+    %p = getelementptr inbounds i32, ptr %a, i64 1
+    store ptr %a, i32 0
+    goto label %loop
+
+  %loop: // preds: entry, loop
+    %i = phi i64 [label %entry : 0], [label %loop : %i.next]
+    %src = getelementptr inbounds i32, ptr %a, i64 %i
+    %x = load i32, ptr %src
+    %y = add i32 %x, i32 1
+    %dest = getelementptr inbounds i32, ptr %p, i64 %i
+    store ptr %dest, i32 %y
+    %i.next = add i64 %i, i64 1
+    %cond = scmp ls i64 %i.next, i64 10
+    branch i1 %cond, label %loop, label %end
+
+  %end: // preds: loop
+    %last = getelementptr inbounds i32, ptr %a, i64 10
+    %r.0 = load i32, ptr %last
+    %r = zext i32 %r.0 to i64
+    return i64 %r
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 10);
+    CHECK(ir::forEach(ctx, mod, opt::loopVectorize, {}));
+    CHECK(run(mod) == 10);
+}
+
+TEST_CASE("Interleaved loops emit no alias checks", "[loopvectorize]") {
+    /// The second loop stores through two and loads through three base
+    /// pointers. That needs more alias checks than the vectorizer emits, so
+    /// the loop is interleaved instead
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca i32, i32 11
+    %b = alloca i32, i32 11
+    %c = alloca i32, i32 11
+    %d = alloca i32, i32 11
+    %e = alloca i32, i32 11
+    goto label %fill
+
+  %fill: // preds: entry, fill
+    %i = phi i64 [label %entry : 0], [label %fill : %i.next]
+    %v = trunc i64 %i to i32
+    %pb = getelementptr inbounds i32, ptr %b, i64 %i
+    store ptr %pb, i32 %v
+    %pc = getelementptr inbounds i32, ptr %c, i64 %i
+    store ptr %pc, i32 %v
+    %pe = getelementptr inbounds i32, ptr %e, i64 %i
+    store ptr %pe, i32 %v
+    %i.next = add i64 %i, i64 1
+    %fill.cond = scmp ls i64 %i.next, i64 11
+    branch i1 %fill.cond, label %fill, label %fill.end
+
+  %fill.end: // preds: fill
+    goto label %compute
+
+  %compute: // preds: fill.end, compute
+    %j = phi i64 [label %fill.end : 0], [label %compute : %j.next]
+    %pb.j = getelementptr inbounds i32, ptr %b, i64 %j
+    %x = load i32, ptr %pb.j
+    %pc.j = getelementptr inbounds i32, ptr %c, i64 %j
+    %y = load i32, ptr %pc.j
+    %pe.j = getelementptr inbounds i32, ptr %e, i64 %j
+    %z = load i32, ptr %pe.j
+    %s = add i32 %x, i32 %y
+    %pa.j = getelementptr inbounds i32, ptr %a, i64 %j
+    store ptr %pa.j, i32 %s
+    %t = add i32 %s, i32 %z
+    %pd.j = getelementptr inbounds i32, ptr %d, i64 %j
+    store ptr %pd.j, i32 %t
+    %j.next = add i64 %j, i64 1
+    %compute.cond = scmp ls i64 %j.next, i64 11
+    branch i1 %compute.cond, label %compute, label %compute.end
+
+  %compute.end: // preds: compute
+    goto label %sum
+
+  %sum: // preds: compute.end, sum
+    %k = phi i64 [label %compute.end : 0], [label %sum : %k.next]
+    %acc = phi i32 [label %compute.end : 0], [label %sum : %acc.next]
+    %pd.k = getelementptr inbounds i32, ptr %d, i64 %k
+    %w = load i32, ptr %pd.k
+    %acc.next = add i32 %acc, i32 %w
+    %k.next = add i64 %k, i64 1
+    %sum.cond = scmp ls i64 %k.next, i64 11
+    branch i1 %sum.cond, label %sum, label %end
+
+  %end: // preds: sum
+    %r = zext i32 %acc.next to i64
+    return i64 %r
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 165);
+    CHECK(ir::forEach(ctx, mod, opt::loopVectorize, {}));
+    CHECK(!hasVectorInstructions(mod));
+    for (auto& function: mod) {
+        for (auto& inst: function.instructions()) {
+            INFO(inst.name());
+            CHECK(!inst.name().starts_with("vec.alias"));
+        }
+    }
+    CHECK(run(mod) == 165);
+}
+
+TEST_CASE("Vectorize i64 loops", "[loopvectorize]") {
+    /// 64 bit lanes fill a pair of registers
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca i64, i32 11
+    %b = alloca i64, i32 11
+    goto label %fill
+
+  %fill: // preds: entry, fill
+    %i = phi i64 [label %entry : 0], [label %fill : %i.next]
+    %pa = getelementptr inbounds i64, ptr %a, i64 %i
+    store ptr %pa, i64 %i
+    %w = mul i64 %i, i64 3
+    %pb = getelementptr inbounds i64, ptr %b, i64 %i
+    store ptr %pb, i64 %w
+    %i.next = add i64 %i, i64 1
+    %fill.cond = scmp ls i64 %i.next, i64 11
+    branch i1 %fill.cond, label %fill, label %fill.end
+
+  %fill.end: // preds: fill
+    goto label %compute
+
+  %compute: // preds: fill.end, compute
+    %j = phi i64 [label %fill.end : 0], [label %compute : %j.next]
+    %pa.j = getelementptr inbounds i64, ptr %a, i64 %j
+    %x = load i64, ptr %pa.j
+    %pb.j = getelementptr inbounds i64, ptr %b, i64 %j
+    %y = load i64, ptr %pb.j
+    %s = add i64 %x, i64 %y
+    %t = mul i64 %s, i64 2
+    store ptr %pa.j, i64 %t
+    %j.next = add i64 %j, i64 1
+    %compute.cond = scmp ls i64 %j.next, i64 11
+    branch i1 %compute.cond, label %compute, label %compute.end
+
+  %compute.end: // preds: compute
+    goto label %sum
+
+  %sum: // preds: compute.end, sum
+    %k = phi i64 [label %compute.end : 0], [label %sum : %k.next]
+    %acc = phi i64 [label %compute.end : 0], [label %sum : %acc.next]
+    %pa.k = getelementptr inbounds i64, ptr %a, i64 %k
+    %z = load i64, ptr %pa.k
+    %acc.next = add i64 %acc, i64 %z
+    %k.next = add i64 %k, i64 1
+    %sum.cond = scmp ls i64 %k.next, i64 11
+    branch i1 %sum.cond, label %sum, label %end
+
+  %end: // preds: sum
+    return i64 %acc.next
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 440);
+    CHECK(ir::forEach(ctx, mod, opt::loopVectorize, {}));
+    CHECK(hasInstructionsOfType(mod, ctx.vectorType(ctx.intType(64), 2)));
+    CHECK(run(mod) == 440);
+}
+
+TEST_CASE("Vectorize f64 loops", "[loopvectorize]") {
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca f64, i32 11
+    %b = alloca f64, i32 11
+    goto label %fill
+
+  %fill: // preds: entry, fill
+    %i = phi i64 [label %entry : 0], [label %fill : %i.next]
+    %v = stof i64 %i to f64
+    %pa = getelementptr inbounds f64, ptr %a, i64 %i
+    store ptr %pa, f64 %v
+    %w = fmul f64 %v, f64 3.0
+    %pb = getelementptr inbounds f64, ptr %b, i64 %i
+    store ptr %pb, f64 %w
+    %i.next = add i64 %i, i64 1
+    %fill.cond = scmp ls i64 %i.next, i64 11
+    branch i1 %fill.cond, label %fill, label %fill.end
+
+  %fill.end: // preds: fill
+    goto label %compute
+
+  %compute: // preds: fill.end, compute
+    %j = phi i64 [label %fill.end : 0], [label %compute : %j.next]
+    %pa.j = getelementptr inbounds f64, ptr %a, i64 %j
+    %x = load f64, ptr %pa.j
+    %pb.j = getelementptr inbounds f64, ptr %b, i64 %j
+    %y = load f64, ptr %pb.j
+    %s = fadd f64 %x, f64 %y
+    %t = fmul f64 %s, f64 0.5
+    store ptr %pa.j, f64 %t
+    %j.next = add i64 %j, i64 1
+    %compute.cond = scmp ls i64 %j.next, i64 11
+    branch i1 %compute.cond, label %compute, label %compute.end
+
+  %compute.end: // preds: compute
+    goto label %sum
+
+  %sum: // preds: compute.end, sum
+    %k = phi i64 [label %compute.end : 0], [label %sum : %k.next]
+    %acc = phi f64 [label %compute.end : 0.0], [label %sum : %acc.next]
+    %pa.k = getelementptr inbounds f64, ptr %a, i64 %k
+    %z = load f64, ptr %pa.k
+    %acc.next = fadd f64 %acc, f64 %z
+    %k.next = add i64 %k, i64 1
+    %sum.cond = scmp ls i64 %k.next, i64 11
+    branch i1 %sum.cond, label %sum, label %end
+
+  %end: // preds: sum
+    %r = ftos f64 %acc.next to i64
+    return i64 %r
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 110);
+    CHECK(ir::forEach(ctx, mod, opt::loopVectorize, {}));
+    CHECK(hasInstructionsOfType(mod, ctx.vectorType(ctx.floatType(64), 2)));
+    CHECK(run(mod) == 110);
+}
+
+TEST_CASE("Loops whose lanes don't fit a vector stay scalar",
+          "[loopvectorize]") {
+    /// `i1` lanes are not whole bytes, so no vector type holds them
+    auto text = R"(
+func i64 @main() {
+  %entry:
+    %a = alloca i1, i32 11
+    %b = alloca i1, i32 11
+    goto label %fill
+
+  %fill: // preds: entry, fill
+    %i = phi i64 [label %entry : 0], [label %fill : %i.next]
+    %v = trunc i64 %i to i1
+    %pa = getelementptr inbounds i1, ptr %a, i64 %i
+    store ptr %pa, i1 %v
+    %pb = getelementptr inbounds i1, ptr %b, i64 %i
+    store ptr %pb, i1 1
+    %i.next = add i64 %i, i64 1
+    %fill.cond = scmp ls i64 %i.next, i64 11
+    branch i1 %fill.cond, label %fill, label %fill.end
+
+  %fill.end: // preds: fill
+    goto label %compute
+
+  %compute: // preds: fill.end, compute
+    %j = phi i64 [label %fill.end : 0], [label %compute : %j.next]
+    %pa.j = getelementptr inbounds i1, ptr %a, i64 %j
+    %x = load i1, ptr %pa.j
+    %pb.j = getelementptr inbounds i1, ptr %b, i64 %j
+    %y = load i1, ptr %pb.j
+    %s = xor i1 %x, i1 %y
+    store ptr %pa.j, i1 %s
+    %j.next = add i64 %j, i64 1
+    %compute.cond = scmp ls i64 %j.next, i64 11
+    branch i1 %compute.cond, label %compute, label %compute.end
+
+  %compute.end: // preds: compute
+    goto label %sum
+
+  %sum: // preds: compute.end, sum
+    %k = phi i64 [label %compute.end : 0], [label %sum : %k.next]
+    %acc = phi i64 [label %compute.end : 0], [label %sum : %acc.next]
+    %pa.k = getelementptr inbounds i1, ptr %a, i64 %k
+    %z = load i1, ptr %pa.k
+    %z.ext = zext i1 %z to i64
+    %acc.next = add i64 %acc, i64 %z.ext
+    %k.next = add i64 %k, i64 1
+    %sum.cond = scmp ls i64 %k.next, i64 11
+    branch i1 %sum.cond, label %sum, label %end
+
+  %end: // preds: sum
+    return i64 %acc.next
+}
+)";
+    auto [ctx, mod] = ir::parse(text).value();
+    CHECK(run(mod) == 6);
+    ir::forEach(ctx, mod, opt::loopVectorize, {});
+    CHECK(!hasVectorInstructions(mod));
+    CHECK(run(mod) == 6);
+}
@@ -1,6 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include "AST/AST.h"
+#include "Parser/Parser.h"
 #include "Parser/SimpleParser.h"
 #include "Util/IssueHelper.h"
 
@@ -281,3 +282,59 @@ TEST_CASE("Parse fstrings", "[parse]") {
         CHECK(end->value<std::string>() == "");
     }
 }
+
+TEST_CASE("Parse multiple files", "[parse]") {
+    std::vector<scatha::SourceFile> sources;
+    for (int i = 0; i < 16; ++i) {
+        auto index = std::to_string(i);
+        sources.push_back(scatha::SourceFile::make(
+            "fn f" + index + "() -> int { return " + index + " }"));
+    }
+    IssueHandler iss;
+    auto ast = parser::parse(sources, iss);
+    REQUIRE(ast);
+    auto* tu = cast<TranslationUnit*>(ast.get());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        auto* function = tu->sourceFile(i)->statement<FunctionDefinition>(0);
+        CHECK(function->name() == "f" + std::to_string(i));
+    }
+    /// Every file is missing a semicolon. Issues are reported in file order
+    REQUIRE(!iss.empty());
+    size_t lastFileIndex = 0;
+    for (auto* issue: iss) {
+        size_t fileIndex = issue->sourceLocation().fileIndex;
+        CHECK(fileIndex >= lastFileIndex);
+        lastFileIndex = fileIndex;
+    }
+    CHECK(lastFileIndex == sources.size() - 1);
+}
+
+TEST_CASE("Mutate arena allocated AST", "[parse]") {
+    auto [ast, iss] = test::parse("fn f() -> int { return 1; }");
+    REQUIRE(iss.empty());
+    auto* file = cast<TranslationUnit*>(ast.get())->sourceFile(0);
+    auto* function = file->statement<FunctionDefinition>(0);
+    auto* ret = function->body()->statement<ReturnStatement>(0);
+    /// The replacement is allocated on the heap and the replaced arena
+    /// allocated node is destroyed
+    auto* repl =
+        ret->expression()->replace(allocate<Identifier>(SourceRange{}, "x"));
+    CHECK(ret->expression() == repl);
+    auto extracted = file->extractStatement<FunctionDefinition>(0);
+    CHECK(extracted.get() == function);
+    file->setStatement(0, std::move(extracted));
+    CHECK(file->statement<FunctionDefinition>(0)->name() == "f");
+}
+
+TEST_CASE("Arenas count their live nodes", "[parse]") {
+    NodeArena arena;
+    UniquePtr<Identifier> id;
+    {
+        ArenaScope scope(arena);
+        id = allocate<Identifier>(SourceRange{}, "x");
+    }
+    CHECK(arena.liveAllocations() == 1);
+    /// An extracted node must be destroyed before its arena goes away
+    id.reset();
+    CHECK(arena.liveAllocations() == 0);
+}
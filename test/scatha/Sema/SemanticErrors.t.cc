@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <string>
+
 #include "Sema/Entity.h"
 #include "Sema/SemaIssues.h"
 #include "Sema/SimpleAnalzyer.h"
@@ -844,3 +846,38 @@ fn test() { P(); }
 )");
     CHECK(iss.findOnLine<BadExpr>(3, CannotConstructType));
 }
+
+TEST_CASE("Issues of concurrently analyzed functions", "[sema][issue]") {
+    std::string source = "fn deduced() { return 1; }\n";
+    size_t const numFunctions = 64;
+    for (size_t i = 0; i < numFunctions; ++i) {
+        auto n = std::to_string(i % 5 + 1);
+        source += "fn f" + std::to_string(i) + "() -> int { var a: [int, " +
+                  n + "]; let r = &a; return deduced() + undeclared; }\n";
+    }
+    auto iss = test::getSemaIssues(source);
+    ssize_t line = 0;
+    size_t count = 0;
+    for (auto* issue: iss.iss) {
+        REQUIRE(dynamic_cast<BadExpr const*>(issue));
+        CHECK(issue->sourceLocation().line > line);
+        line = issue->sourceLocation().line;
+        ++count;
+    }
+    CHECK(count == numFunctions);
+}
+
+TEST_CASE("Issues of deduced functions appear in source order",
+          "[sema][issue]") {
+    auto const iss = test::getSemaIssues(R"(
+fn f() -> int { return undeclaredInF; }
+fn g() { return undeclaredInG; }
+)");
+    REQUIRE(iss.iss.size() >= 2);
+    CHECK(iss.iss[0].sourceLocation().line == 2);
+    ssize_t line = 0;
+    for (auto* issue: iss.iss) {
+        CHECK(issue->sourceLocation().line >= line);
+        line = issue->sourceLocation().line;
+    }
+}
@@ -1,4 +1,5 @@
 #include <sstream>
+#include <vector>
 
 #include <catch2/catch_test_macros.hpp>
 
@@ -168,3 +169,108 @@ TEST_CASE("Symbol table erroneous deserialization", "[sema]") {
     SymbolTable sym;
     CHECK(!deserialize(sym, sstr));
 }
+
+static std::vector<unsigned char> serializeBinary(SymbolTable const& sym) {
+    std::stringstream sstr;
+    serializeBinary(sym, sstr);
+    auto data = std::move(sstr).str();
+    return std::vector<unsigned char>(data.begin(), data.end());
+}
+
+TEST_CASE("Binary symbol table serialize/deserialize", "[sema]") {
+    auto [ast, sym, iss] = produceDecoratedASTAndSymTable(R"(
+public struct X {
+    struct Y { var k: int; }
+    fn foo(n: int) -> double {}
+    var baz: [Y, 2];
+    var quux: int;
+}
+public struct Lifetime {
+    fn new(&mut this) {}
+    fn delete(&mut this) {}
+}
+public protocol P {
+    fn test(&this) -> void;
+}
+public struct Dyn: P {
+    fn test(&dyn this) -> void {}
+}
+public fn useX(x: &X) {}
+)");
+    REQUIRE(iss.empty());
+    sym.prepareExport();
+    auto table = LazySymbolTable::Open(serializeBinary(sym));
+    REQUIRE(table);
+    SymbolTable sym2;
+    Finder find{ sym2 };
+    SECTION("Load all") {
+        REQUIRE(table->loadAll(sym2));
+        find("X", [&](Scope const* XScope) {
+            auto* X = dyncast<StructType const*>(XScope);
+            REQUIRE(X);
+            CHECK(X->size() == 3 * sym2.Int()->size());
+            REQUIRE(X->memberVariables().size() == 2);
+            CHECK(X->memberVariables().back()->name() == "quux");
+            auto* foo = dyncast<Function const*>(find("foo"));
+            REQUIRE(foo);
+            CHECK(foo->returnType() == sym2.Double());
+        });
+        find("Lifetime", [&](Scope const* LScope) {
+            auto& md = cast<StructType const&>(*LScope).lifetimeMetadata();
+            CHECK(md.defaultConstructor().function() == find("new"));
+            CHECK(md.destructor().function() == find("delete"));
+        });
+        auto* P = find("P");
+        find("Dyn", [&](Scope const* DynScope) {
+            auto& Dyn = cast<StructType const&>(*DynScope);
+            REQUIRE(Dyn.vtable());
+            auto inherited = Dyn.vtable()->sortedInheritedVTables();
+            REQUIRE(inherited.size() == 1);
+            CHECK(inherited[0]->correspondingType() == P);
+            REQUIRE(inherited[0]->layout().size() == 1);
+            CHECK(inherited[0]->layout().front() == find("test"));
+        });
+        CHECK(!table->isPending(InternedString("X")));
+        CHECK(table->loadAll(sym2));
+    }
+    SECTION("Load by name") {
+        CHECK(table->isPending(InternedString("X")));
+        CHECK(table->isPending(InternedString("Lifetime")));
+        CHECK(!table->isPending(InternedString("Unknown")));
+        REQUIRE(table->load(sym2, InternedString("X")));
+        CHECK(!table->isPending(InternedString("X")));
+        CHECK(table->isPending(InternedString("Lifetime")));
+        CHECK(isa<StructType>(find("X")));
+        CHECK(sym2.globalScope().findEntities("Lifetime").empty());
+        CHECK(sym2.globalScope().findEntities("Dyn").empty());
+        /// Loading the same name again does nothing
+        REQUIRE(table->load(sym2, InternedString("X")));
+        CHECK(sym2.globalScope().findEntities("X").size() == 1);
+    }
+    SECTION("Tables opened from the same index load independently") {
+        auto index = LazySymbolTable::ReadIndex(
+            std::make_shared<std::vector<unsigned char> const>(
+                serializeBinary(sym)));
+        REQUIRE(index);
+        auto first = LazySymbolTable::FromIndex(index);
+        auto second = LazySymbolTable::FromIndex(index);
+        REQUIRE(first);
+        REQUIRE(second);
+        REQUIRE(first->load(sym2, InternedString("X")));
+        CHECK(!first->isPending(InternedString("X")));
+        CHECK(second->isPending(InternedString("X")));
+        SymbolTable sym3;
+        REQUIRE(second->loadAll(sym3));
+        CHECK(sym3.globalScope().findEntities("X").size() == 1);
+        CHECK(sym3.globalScope().findEntities("Dyn").size() == 1);
+    }
+}
+
+TEST_CASE("Binary symbol table erroneous deserialization", "[sema]") {
+    std::vector<unsigned char> data = { 'r', 'a', 'n', 'd', 'o', 'm' };
+    CHECK(!LazySymbolTable::Open(data));
+    CHECK(!LazySymbolTable::Open({}));
+    CHECK(!LazySymbolTable::ReadIndex(
+        std::make_shared<std::vector<unsigned char> const>(data)));
+    CHECK(!LazySymbolTable::FromIndex(nullptr));
+}
@@ -27,7 +27,8 @@ static void validateEmpty(std::span<SourceFile const> sources,
 }
 
 std::pair<ir::Context, ir::Module> test::makeIR(
-    std::vector<std::string> sourceTexts) {
+    std::vector<std::string> sourceTexts,
+    sema::AnalysisOptions const& options) {
     IssueHandler issues;
     auto sourceFiles = sourceTexts | ranges::views::transform([](auto& text) {
         return SourceFile::make(std::move(text));
@@ -35,7 +36,7 @@ std::pair<ir::Context, ir::Module> test::makeIR(
     auto ast = parser::parse(sourceFiles, issues);
     validateEmpty(sourceFiles, issues);
     sema::SymbolTable sym;
-    auto analysisResult = sema::analyze(*ast, sym, issues);
+    auto analysisResult = sema::analyze(*ast, sym, issues, options);
     validateEmpty(sourceFiles, issues);
     ir::Context ctx;
     ir::Module mod;
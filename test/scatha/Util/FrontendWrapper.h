@@ -6,10 +6,13 @@
 #include <vector>
 
 #include "IR/Fwd.h"
+#include "Sema/Fwd.h"
 
 namespace scatha::test {
 
-std::pair<ir::Context, ir::Module> makeIR(std::vector<std::string> sourceTexts);
+std::pair<ir::Context, ir::Module> makeIR(
+    std::vector<std::string> sourceTexts,
+    sema::AnalysisOptions const& options = {});
 
 } // namespace scatha::test
 
@@ -207,3 +207,17 @@ TEST_CASE("Zero size allocation", "[virtual-memory]") {
     auto ptr = mem.allocate(0, 8);
     CHECK_NOTHROW([&] { mem.deallocate(ptr, 0, 8); }());
 }
+
+TEST_CASE("Allocated bytes", "[virtual-memory]") {
+    VirtualMemory mem;
+    auto small = mem.allocate(32, 8);
+    auto large = mem.allocate(4096, 8);
+    CHECK(mem.allocatedBytes() == 4128);
+    mem.deallocate(large, 4096, 8);
+    CHECK(mem.allocatedBytes() == 32);
+    CHECK(mem.peakAllocatedBytes() == 4128);
+    mem.resetPeakAllocatedBytes();
+    CHECK(mem.peakAllocatedBytes() == 32);
+    mem.deallocate(small, 32, 8);
+    CHECK(mem.allocatedBytes() == 0);
+}